@@ -29,10 +29,21 @@
 #include <stdlib.h>
 #include <string.h>
 #include "ABI_Toolkit.h"
+#include "util.h"
 
-static char   *gFile = NULL;
-unsigned long  dirloc;
-unsigned long  tag_count;
+static TT_THREAD_LOCAL char          *gFile = NULL;
+static TT_THREAD_LOCAL unsigned long  dirloc;
+static TT_THREAD_LOCAL unsigned long  tag_count;
+
+/* Directory entries sorted by tag, id and location in the file */
+typedef struct {
+    char  tag[4];
+    int   id;
+    char *entry;
+} DirIndexEntry;
+
+static TT_THREAD_LOCAL DirIndexEntry *gDirIndex = NULL;
+static TT_THREAD_LOCAL long           gDirIndexLen = 0;
 
 unsigned long get_offset(unsigned char *cptr)
 {
@@ -51,6 +62,70 @@ unsigned long get_offset(unsigned char *cptr)
     return total;
 }
 
+static int compare_dir_index_entries(const void *a, const void *b)
+{
+    const DirIndexEntry *e1 = (const DirIndexEntry *) a;
+    const DirIndexEntry *e2 = (const DirIndexEntry *) b;
+    int r = memcmp(e1->tag, e2->tag, 4);
+
+    if (r != 0)
+        return r;
+    if (e1->id != e2->id)
+        return e1->id < e2->id ? -1 : 1;
+    if (e1->entry != e2->entry)
+        return e1->entry < e2->entry ? -1 : 1;
+    return 0;
+}
+
+/*
+ *  Parse the tag directory once, so that find_dir_entry can locate 
+ *  the entries by binary search. If the index cannot be built, 
+ *  find_dir_entry scans the directory.
+ */
+static void build_dir_index(size_t size)
+{
+    long i, n = (long)tag_count;
+    char *tagptr = gFile + dirloc;
+
+    if ((size - dirloc) / 28 < tag_count)
+        n = (long)((size - dirloc) / 28);
+    if (n <= 0)
+        return;
+
+    gDirIndex = (DirIndexEntry *) malloc(n * sizeof(DirIndexEntry));
+    if (gDirIndex == NULL)
+        return;
+
+    for (i = 0; i < n; i++)
+    {
+        memcpy(gDirIndex[i].tag, tagptr, 4);
+        gDirIndex[i].id = *((unsigned char *) tagptr + 7);
+        gDirIndex[i].entry = tagptr;
+        tagptr += 28;
+    }
+    qsort(gDirIndex, n, sizeof(DirIndexEntry), compare_dir_index_entries);
+    gDirIndexLen = n;
+}
+
+static void free_dir_index(void)
+{
+    free(gDirIndex);
+    gDirIndex = NULL;
+    gDirIndexLen = 0;
+}
+
+/*
+ *  Decode num big-endian 16-bit values stored in the file at offset start
+ */
+static void decode_int16(int *dest, unsigned long start, unsigned long num)
+{
+    const unsigned char *src = (const unsigned char *) (gFile + start);
+    unsigned long i;
+
+    for (i = 0; i < num; i++, src += 2)
+        dest[i] = (src[0] << 8) | src[1];
+}
+
 ABIError ABI_Open(void *file, size_t size)
 {
     ABIError error = kNoError;
@@ -67,6 +142,9 @@ ABIError ABI_Open(void *file, size_t size)
             error = kBadCatalogLocation;
 
         tag_count = get_offset((unsigned char *)((unsigned char *)file + 18));
+
+        if (error == kNoError)
+            build_dir_index(size);
     }
     return error;
 }
@@ -78,7 +156,10 @@ ABIError ABI_Close(void *file)
     if (gFile != file)
         error = kFileNotOpen;
     else
+    {
         gFile = NULL;
+        free_dir_index();
+    }
 
     return error;
 }
@@ -90,6 +171,27 @@ char *find_dir_entry(char *tag, int id)
     int curid;
     char *tagptr = gFile + dirloc;
 
+    if (gDirIndex != NULL)
+    {
+        long lo = 0, hi = gDirIndexLen, mid;
+        int r;
+
+        /* Find the first entry not less than (tag, id) */
+        while (lo < hi)
+        {
+            mid = (lo + hi) / 2;
+            r = memcmp(gDirIndex[mid].tag, tag, 4);
+            if (r < 0 || (r == 0 && gDirIndex[mid].id < id))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < gDirIndexLen && gDirIndex[lo].id == id &&
+            memcmp(gDirIndex[lo].tag, tag, 4) == 0)
+            return gDirIndex[lo].entry;
+        return NULL;
+    }
+
     for (i = 0; i < (int)tag_count; i++)
     {
         curtag[0] = *tagptr;
@@ -452,7 +554,6 @@ ABIError ABI_RawData(short lane, short dye, int *raw_array)
     char *location;
     unsigned long num_data;
     unsigned long data_start;
-    int i;
 
     lane =0;
 
@@ -462,13 +563,7 @@ ABIError ABI_RawData(short lane, short dye, int *raw_array)
         num_data = get_offset((unsigned char *)(location + 12));
         data_start = get_offset((unsigned char *)(location + 20));
 
-        for (i = 0; i < (int)num_data; i++)
-        {
-            raw_array[i] =
-               *((unsigned char *) (gFile + data_start + (i * 2))) * 256;
-            raw_array[i] +=
-               *((unsigned char *) (gFile + data_start + (i * 2) + 1));
-        }
+        decode_int16(raw_array, data_start, num_data);
         error = kNoError;
     }
     return error;
@@ -480,7 +575,6 @@ ABIError ABI_AnalyzedData(short lane, short dye, int *analyzed_array)
     char *location;
     unsigned long num_data;
     unsigned long data_start;
-    int i;
 
     lane =0;
 
@@ -490,13 +584,7 @@ ABIError ABI_AnalyzedData(short lane, short dye, int *analyzed_array)
         num_data = get_offset((unsigned char *)(location + 12));
         data_start = get_offset((unsigned char *)(location + 20));
 
-        for (i = 0; i < (int)num_data; i++)
-        {
-	    analyzed_array[i] = 
-               *((unsigned char *) (gFile + data_start + (i * 2))) * 256;
-	    analyzed_array[i] += 
-               *((unsigned char *) (gFile + data_start + (i * 2) + 1));
-	}
+        decode_int16(analyzed_array, data_start, num_data);
 	error = kNoError;
     }
     return error;
@@ -508,7 +596,7 @@ ABIError ABI_AnalyzedData(short lane, short dye, int *analyzed_array)
  */
 char *ABI_ErrorString(ABIError k)
 {
-    static char line[80];
+    static TT_THREAD_LOCAL char line[80];
 
     switch(k) {
         case kNoError:
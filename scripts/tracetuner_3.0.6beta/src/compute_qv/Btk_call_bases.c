@@ -66,6 +66,7 @@
 #define CHECK_NUM_CALLED_PEAKS         0
 #define CHECK_PEAK_POSITION            0
 #define CHECK_REORDERING               0
+#define CHECK_SCAN_INDEX               0
 #define COMPLETE_MOB_SHIFTS            1  
 #define DEBUG_CURTIS                   0 
 #define DELETE_BASES                   1
@@ -120,7 +121,7 @@ extern double
 mobShiftQuality(Peak * const peak[], int n_peaks);
 
 extern int
-collect_some_stats( Data *data, Options *options, BtkMessage *message,
+collect_some_stats( Data *data, const Options *options, BtkMessage *message,
                     Results *results );
 
 static void
@@ -420,11 +421,30 @@ check_num_called_peaks(Data *data)
     fprintf(stderr, "...done\n");
 }
 
+static void
+check_scan_index(ColorData *cd, int given_position, int peak_index)
+{
+    int k, expected = -1;
+
+    for (k=0; k<cd->peak_list_len; k++) {
+        if (given_position >= cd->peak_list[k].beg &&
+            given_position <  cd->peak_list[k].end) 
+        {
+            expected = k;
+            break;
+        }
+    }
+    if (peak_index != expected)
+        fprintf(stderr, 
+            "Error: scan index gives peak %d at position %d instead of %d\n",
+            peak_index, given_position, expected);
+}
+
 static double
 get_spacing_from_good_region(int base_index, Data *data);
 
 static void
-output_spacing_curve(Data *data, Options *options)
+output_spacing_curve(Data *data, const Options *options)
 {
     int i, l=0, base_index = 1, base_spacing;
     double sum_devs=0., curr_spacing1, curr_spacing2, curr_spacing;
@@ -448,7 +468,7 @@ output_spacing_curve(Data *data, Options *options)
         if ((i == 0) || (i % 20) != 0)
             continue;
 
-        curr_spacing1 = spacing_curve(i);
+        curr_spacing1 = spacing_curve(data, i);
         curr_spacing2 = get_spacing_from_good_region(base_index, data);
         curr_spacing = (curr_spacing1 + curr_spacing2)/2.;
 
@@ -483,7 +503,7 @@ output_spacing_curve(Data *data, Options *options)
         if ((i == 0) || (i % 20) != 0)
             continue;
 
-        curr_spacing1 = spacing_curve(i);
+        curr_spacing1 = spacing_curve(data, i);
         curr_spacing2 = get_spacing_from_good_region(base_index, data);
         curr_spacing = (curr_spacing1 + curr_spacing2)/2.;
 
@@ -510,6 +530,137 @@ output_spacing_curve(Data *data, Options *options)
     fclose(xgraphout);
 }
 
+/*******************************************************************************
+ * Function: colordata_build_scan_index
+ * Purpose:  for each scan of a given color, store the index of the peak 
+ *           whose area contains the scan, or -1, so that the peak can be 
+ *           found by location in constant time. The index is built only if 
+ *           the peak areas are ordered and do not overlap, in which case 
+ *           it gives the same result as the binary search over the peaks.
+ *           The index should be released or marked stale before the peak 
+ *           list is edited
+ *******************************************************************************
+ */
+int
+colordata_build_scan_index(ColorData *color_data, BtkMessage *message)
+{
+    int i, k, len = color_data->peak_list_len;
+    Peak *pl = color_data->peak_list;
+
+    colordata_release_scan_index(color_data);
+
+    if (len < 2 || pl[0].beg < 0)
+        return SUCCESS;
+
+    for (k = 0; k < len; k++) {
+        if (pl[k].end < pl[k].beg)
+            return SUCCESS;
+        if (k > 0 && pl[k].beg < pl[k-1].end)
+            return SUCCESS;
+    }
+
+    color_data->scan_peak_index = CALLOC(int, pl[len-1].end);
+    MEM_ERROR(color_data->scan_peak_index);
+    color_data->scan_peak_index_len = pl[len-1].end;
+
+    for (i = 0; i < pl[0].beg; i++)
+        color_data->scan_peak_index[i] = -1;
+    for (k = 0; k < len; k++) {
+        for (i = pl[k].beg; i < pl[k].end; i++)
+            color_data->scan_peak_index[i] = k;
+        if (k < len-1) {
+            for (i = pl[k].end; i < pl[k+1].beg; i++)
+                color_data->scan_peak_index[i] = -1;
+        }
+    }
+
+    return SUCCESS;
+
+error:
+    color_data->scan_peak_index_len = 0;
+    return ERROR;
+}
+
+/*******************************************************************************
+ * Function: colordata_release_scan_index
+ *******************************************************************************
+ */
+void
+colordata_release_scan_index(ColorData *color_data)
+{
+    FREE(color_data->scan_peak_index);
+    color_data->scan_peak_index_len = 0;
+    color_data->scan_peak_index_stale = 0;
+}
+
+/*******************************************************************************
+ * Function: colordata_mark_scan_index_stale
+ * Purpose:  release the scan index of a color whose peak list is being 
+ *           edited, so that it is rebuilt by the next lookup by scan
+ *******************************************************************************
+ */
+void
+colordata_mark_scan_index_stale(ColorData *color_data)
+{
+    colordata_release_scan_index(color_data);
+    color_data->scan_peak_index_stale = 1;
+}
+
+/*******************************************************************************
+ * Function: data_release_scan_index
+ *******************************************************************************
+ */
+void
+data_release_scan_index(Data *data)
+{
+    int j;
+
+    for (j = 0; j < NUM_COLORS; j++)
+        colordata_release_scan_index(&data->color_data[j]);
+}
+
+/*******************************************************************************
+ * Function: data_mark_scan_index_stale
+ *******************************************************************************
+ */
+void
+data_mark_scan_index_stale(Data *data)
+{
+    int j;
+
+    for (j = 0; j < NUM_COLORS; j++)
+        colordata_mark_scan_index_stale(&data->color_data[j]);
+}
+
+/*******************************************************************************
+ * Function: colordata_find_peak_index_by_scan_index
+ * Purpose:  if the scan index of a given color has been built, set 
+ *           peak_index to the index of the peak whose area contains a given
+ *           position, or to -1, and return 1; otherwise, return 0.
+ *           A stale index is rebuilt first
+ *******************************************************************************
+ */
+int
+colordata_find_peak_index_by_scan_index(ColorData *color_data, 
+    int given_position, Peak *peak, int *peak_index)
+{
+    BtkMessage msg;
+
+    if (color_data->scan_peak_index_stale)
+        (void)colordata_build_scan_index(color_data, &msg);
+
+    if (color_data->scan_peak_index == NULL)
+        return 0;
+
+   *peak_index = (given_position >= 0 && 
+        given_position < color_data->scan_peak_index_len) ?
+        color_data->scan_peak_index[given_position] : -1;
+    if (*peak_index >= 0)
+       *peak = color_data->peak_list[*peak_index];
+
+    return 1;
+}
+
 /*******************************************************************************
  * Function: colordata_find_peak_index_by_location
  * Purpose: In the list of peaks of given color, find the peak such that a 
@@ -546,6 +697,14 @@ colordata_find_peak_index_by_location(ColorData *color_data, int given_position,
         }
     }
 
+    if (colordata_find_peak_index_by_scan_index(color_data, given_position,
+        peak, peak_index))
+    {
+        if (CHECK_SCAN_INDEX) 
+            check_scan_index(color_data, given_position, *peak_index);
+        return SUCCESS;
+    }
+
     lo = 0;
     hi = color_data->peak_list_len - 1;
     do {
@@ -743,6 +902,64 @@ bc_reorder_called_bases_and_peaks(Data *data, BtkMessage *message)
     return SUCCESS;
 }
 
+/*******************************************************************************
+ * Merging the peak lists of the 4 colors
+ * The head of each color's list is kept as a MergeKey, and the next peak is
+ * found by scanning the 4 heads in color order. The comparisons tolerate
+ * rounding, so they do not define a total order, and the scan order decides
+ * between peaks that neither goes first nor equals the other.
+ *******************************************************************************
+ */
+typedef struct {
+    double ipos;
+    double iheight;
+    double area;
+    int    base_index;
+} MergeKey;
+
+/*******************************************************************************
+ * Function: merge_key_goes_first
+ * Purpose: return 1 if the peak with key a should precede the one with key b:
+ *          left position first, then lower base index, then higher peak, 
+ *          then bigger area
+ *******************************************************************************
+ */
+static int
+merge_key_goes_first(const MergeKey *a, const MergeKey *b)
+{
+    if (DBL_GT_DBL(b->ipos, a->ipos))
+        return 1;
+    if (!DBL_EQ_DBL(a->ipos, b->ipos))
+        return 0;
+    if (a->base_index != b->base_index)
+        return a->base_index < b->base_index;
+    if (DBL_GT_DBL(a->iheight, b->iheight))
+        return 1;
+    return DBL_EQ_DBL(a->iheight, b->iheight) && 
+           DBL_GT_DBL(a->area, b->area);
+}
+
+/*******************************************************************************
+ * Function: merge_set_head
+ *******************************************************************************
+ */
+static void
+merge_set_head(Data *data, int color, int *shift, int *curr_index, 
+    MergeKey *key, int *live)
+{
+    ColorData *cd = &data->color_data[color];
+    Peak      *peak;
+
+    live[color] = (curr_index[color] < cd->peak_list_len);
+    if (!live[color])
+        return;
+    peak = &cd->peak_list[curr_index[color]];
+    key[color].ipos       = shift[color] + peak->ipos;
+    key[color].iheight    = peak->iheight;
+    key[color].area       = peak->area;
+    key[color].base_index = peak->base_index;
+}
+
 /*******************************************************************************
  * Function: bc_data_create_single_ordered_peak_list
  * Purpose: create an array of pointers to the peaks of any color,
@@ -753,82 +970,53 @@ int
 bc_data_create_single_ordered_peak_list(Data *data, int *shift, 
     BtkMessage *message)
 {
-    int    i, color;
-    int    best_color, best_base_index;
-    double best_ipos, best_iheight, best_area;
+    int    i, color, total, best_color;
+    int    live[NUM_COLORS];
     int    curr_index[NUM_COLORS] = {0, 0, 0, 0};
     /* current index in the list of peaks of a given color
      * that is put into a single peak list
      */
-    FREE(data->peak_list);
-    data->peak_list_len = 0;
+    MergeKey key[NUM_COLORS], *best;
+    MergeKey none = { INF, -1., -1., INF };  /* must go after any peak */
 
 #if 1
     for (i=0; i<NUM_COLORS; i++) {
         shift[i]=0;
     }
 #endif
-    i = data->color_data[0].peak_list_len +
-        data->color_data[1].peak_list_len +
-        data->color_data[2].peak_list_len +
-        data->color_data[3].peak_list_len;
+    total = data->color_data[0].peak_list_len +
+            data->color_data[1].peak_list_len +
+            data->color_data[2].peak_list_len +
+            data->color_data[3].peak_list_len;
 
-    data->peak_list = CALLOC(Peak *, i);
+    /* Reuse the array unless it is too short. Keep peak_list_max_len 
+     * equal to its size, which is what code growing the list relies on 
+     */
+    if (data->peak_list == NULL || total > data->peak_list_max_len) {
+        if (total > data->peak_list_max_len)
+            data->peak_list_max_len = total;
+        FREE(data->peak_list);
+        data->peak_list = CALLOC(Peak *, data->peak_list_max_len);
+        MEM_ERROR(data->peak_list);
+    }
+    data->peak_list_len = 0;
+
+    for (color=0; color < NUM_COLORS; color++) {
+        merge_set_head(data, color, shift, curr_index, key, live);
+    }
 
     /* Order peaks with respect to their position and put them into the list */
-    i = 0;
-    while ((curr_index[0] < data->color_data[0].peak_list_len) ||
-           (curr_index[1] < data->color_data[1].peak_list_len) ||
-           (curr_index[2] < data->color_data[2].peak_list_len) ||
-           (curr_index[3] < data->color_data[3].peak_list_len))
+    for (i = 0; i < total; i++)
     {
         /* Find the leftmost peak  */
-        best_ipos       = INF;
-        best_base_index = INF;
-        best_iheight    = -1.;
-        best_area       = -1;
-        best_color      = -1;
-
-        for (color=0; color < NUM_COLORS; color++)
-        {
-            double new_ipos = shift[color] +
-                data->color_data[color].peak_list[curr_index[color]].ipos;
-            int new_base_index =
-                data->color_data[color].peak_list[curr_index[color]].base_index;
-            double new_iheight =
-                data->color_data[color].peak_list[curr_index[color]].iheight;
-            double new_area =
-                data->color_data[color].peak_list[curr_index[color]].area;
-            
-            if (curr_index[color] >= data->color_data[color].peak_list_len) {
-                continue;
-            }
-
-            /* Peak with left position goes first */
-            if (DBL_GT_DBL(best_ipos, new_ipos) ||
-
-            /* Peak with lower base index goes first */
-               (DBL_EQ_DBL(new_ipos, best_ipos) &&
-                new_base_index < best_base_index)  ||
-
-            /* Higher peak goes first */
-               (DBL_EQ_DBL(new_ipos, best_ipos) &&
-                new_base_index == best_base_index  &&
-                DBL_GT_DBL(new_iheight, best_iheight)) ||                
-
-            /* Peak with bigger area goes first */
-               (DBL_EQ_DBL(new_ipos, best_ipos) &&
-                new_base_index == best_base_index  &&
-                DBL_EQ_DBL(new_iheight, best_iheight) &&
-                DBL_GT_DBL(new_area, best_area)))
-            {
-                best_color      = color;
-                best_ipos       = new_ipos;
-                best_base_index = new_base_index;
-                best_iheight    = new_iheight;
-                best_area       = new_area;
+        best_color = -1;
+        best = &none;
+        for (color=0; color < NUM_COLORS; color++) {
+            if (live[color] && merge_key_goes_first(&key[color], best)) {
+                best_color = color;
+                best = &key[color];
             }
-        } /* loo through all colors */
+        }
 
         if (best_color >= 0) 
         {
@@ -846,7 +1034,7 @@ bc_data_create_single_ordered_peak_list(Data *data, int *shift,
                     dpl[i]->base_index, dpl[i]->iheight, dpl[i]->area);
             }
             curr_index[best_color]++;
-            i++;
+            merge_set_head(data, best_color, shift, curr_index, key, live);
         }
         else {
             fprintf(stderr, "Best color not found for i=%d:\n", i);
@@ -860,7 +1048,6 @@ bc_data_create_single_ordered_peak_list(Data *data, int *shift,
             fprintf(stderr, "   shift = %d %d %d %d \n\n",
                 shift[0], shift[1], shift[2], shift[3]);
             break;
-            break;
         }
     }
     data->peak_list_len = i;
@@ -868,6 +1055,9 @@ bc_data_create_single_ordered_peak_list(Data *data, int *shift,
     if (CHECK_REORDERING) check_reordering(data);
 
     return SUCCESS;
+
+error:
+    return ERROR;
 }
 
 
@@ -991,7 +1181,7 @@ adjust_called_base_position(int base_index, Data *data)
 int
 insert_and_resolve_peaks(Data *data, int jc, int base_ind1, int base_ind2,
     int cd_peak_ind, int data_peak_ind, Peak peak1, Peak peak2, int Case, 
-    Options *options, BtkMessage *message)
+    const Options *options, BtkMessage *message)
 {
     int    j, base_index, il, ir;
     double max_resolution;
@@ -1014,6 +1204,8 @@ insert_and_resolve_peaks(Data *data, int jc, int base_ind1, int base_ind2,
         return ERROR;
     }
  
+    colordata_mark_scan_index_stale(&data->color_data[jc]);
+
     /* Insert peak1 into peak list */
     peak1.cd_peak_ind = cd_peak_ind;
     data->color_data[jc].peak_list[cd_peak_ind] = peak1;
@@ -1467,7 +1659,7 @@ is_dye_blob(int pos, Peak *peak, Data *data, int het)
  *******************************************************************************
  */
 int
-is_dip(Peak **peak_list, int peak_list_len, int i, int *shift, Options *options,
+is_dip(Peak **peak_list, int peak_list_len, int i, int *shift, const Options *options,
     Data *data)
 {
     int j, il, ir, base_index;
@@ -1569,7 +1761,7 @@ get_truncated_width(Peak *peak, Data *data)
  */
 static int
 get_representative_peak_signal(int position, Peak *peak, Data *data, 
-    Options *options)
+    const Options *options)
 {
     int        signal, color = peak->color_index;
     ColorData *cd = &data->color_data[color];
@@ -1616,12 +1808,12 @@ get_representative_peak_signal(int position, Peak *peak, Data *data,
  */
 static int
 is_better_peak(Peak *peak1, Peak *peak2, int position, Data *data, 
-    Options *options)
+    const Options *options)
 {
     int signal1, is_dye_blob1=0, lb1, width1;
     int signal2, is_dye_blob2=0, lb2, width2;
-    int *d1;
-    int *d2;
+    TT_Sample *d1;
+    TT_Sample *d2;
     int i;
     ColorData *cd1 = &data->color_data[peak1->color_index];
     ColorData *cd2 = &data->color_data[peak2->color_index];
@@ -1781,7 +1973,7 @@ is_better_peak(Peak *peak1, Peak *peak2, int position, Data *data,
  *****************************************************************************/
 int
 create_DIP_list(Data *data, int beg_pos, int end_pos, int *shift,
-    Peak ***dip, int *num_DIPs, Options *options, BtkMessage *message)
+    Peak ***dip, int *num_DIPs, const Options *options, BtkMessage *message)
 {
     int         n_peak = data->peak_list_len;
     int         i, *idip = CALLOC(int, n_peak);
@@ -1906,7 +2098,7 @@ get_coefficients( Data* data, ReadInfo* read_info )
  */
 static int
 get_weighted_peak_heights(Data *data, char *color2base, ContextTable *ctable,
-    ReadInfo *read_info, Options *options, BtkMessage *message)
+    ReadInfo *read_info, const Options *options, BtkMessage *message)
 {
     int i, color, base_index=-1;
     double  nweight, cweight;
@@ -2120,7 +2312,7 @@ getBDF(int base_index)
 *******************************************************************************
  */
 static double
-get_base_insertion_factor(int base_index, Options *options)
+get_base_insertion_factor(int base_index, const Options *options)
 {
     double insertion_factor, max_insertion_factor=1.;
 
@@ -2146,7 +2338,7 @@ get_base_insertion_factor(int base_index, Options *options)
  */
 static int
 can_delete_base(Data *data, int prev_base_index, int next_base_index,
-    double ave_spacing, double base_deletion_factor, Options *options)
+    double ave_spacing, double base_deletion_factor, const Options *options)
 {
     int prev_pos, next_pos;    /* Two spacings instead of 1 */
     int level = 0;
@@ -2277,7 +2469,7 @@ can_delete_base(Data *data, int prev_base_index, int next_base_index,
 int
 can_insert_base(Data *data, int prev_base_index, int next_base_index,     
     int num_add_peaks, double ave_spacing, double base_insertion_factor, 
-    Options *options)
+    const Options *options)
 {
     int prev_pos, next_pos, num_spacings;    /* Two spacings instead of 1 */
     int level = 0;
@@ -2431,7 +2623,7 @@ peak_outside_data_range(Peak *peak, Data *data)
  *******************************************************************************
  */
 static int
-check_spacing(int data_peak_ind, Data *data, double expect_spacing, Options *op)
+check_spacing(int data_peak_ind, Data *data, double expect_spacing, const Options *op)
 {
    int base_index, ins=1, del=-1;
    double left_spacing, right_spacing, delta_left, delta_right;
@@ -2485,7 +2677,7 @@ check_spacing(int data_peak_ind, Data *data, double expect_spacing, Options *op)
  */
 static int
 get_worst_inserted_base(int base_index, Data *data, double curr_spacing,
-    Options *options)
+    const Options *options)
 {
     int i, j, worst_base=-1, spacing, spacing1, spacing2, worst_spacing=INF;
     int spacing_problems = 1;
@@ -2589,6 +2781,8 @@ delete_uncalled_peak(int cd_peak_ind, int data_peak_ind, ColorData *cd,
         return ERROR;
     }
 
+    colordata_mark_scan_index_stale(cd);
+
     /* Shift subsequent cd peaks to the left one spot to make room */
     (void)memmove(&cd->peak_list[cd_peak_ind  ],
                   &cd->peak_list[cd_peak_ind+1],
@@ -2656,7 +2850,7 @@ merge_two_called_peaks(int base_ind1, int base_ind2, Data *data,
     peak.iend    = peak2.iend;
     peak.area    = peak1.area + peak2.area;
     peak.relative_area = peak1.relative_area + peak2.relative_area;
-    peak.pos     = get_peak_position(cd->data, peak.beg, peak.end, peak.area,
+    peak.pos     = colordata_peak_position(cd, peak.beg, peak.end, peak.area,
                    message);
 //  peak.pos     = peak1.pos;
     peak.height  =         cd->data[peak.pos];
@@ -2667,6 +2861,7 @@ merge_two_called_peaks(int base_ind1, int base_ind2, Data *data,
     peak.is_truncated = QVMAX(peak1.is_truncated, peak2.is_truncated);
 
     /* Insert new peak */
+    colordata_mark_scan_index_stale(cd);
     cd->peak_list[cd_peak_ind] = peak;
 
     /* Now remove peak2, which is no longer needed.
@@ -2701,11 +2896,11 @@ get_spacing_from_good_region(int base_index, Data *data)
 
     if (base_index>=data->bases.length) {
         int ind = data->bases.length-1;
-        return spacing_curve(data->bases.called_peak_list[ind]->ipos);
+        return spacing_curve(data, data->bases.called_peak_list[ind]->ipos);
     }
 
     if (base_index <= MAX_SIZE_OF_SEARCH_REGION)
-        return spacing_curve(data->bases.called_peak_list[base_index]->ipos);
+        return spacing_curve(data, data->bases.called_peak_list[base_index]->ipos);
 
     delta_spacing= 1;
     max_spacing  = 0;
@@ -2776,7 +2971,7 @@ get_spacing_from_good_region(int base_index, Data *data)
     if ((sum_spacings > 0.) && (j > 0))
         return sum_spacings/(double)j;
 
-    new_spacing = QVMAX(MIN_PEAK_SPACING, (int)spacing_curve(Pl[base_index]->ipos));
+    new_spacing = QVMAX(MIN_PEAK_SPACING, (int)spacing_curve(data, Pl[base_index]->ipos));
 
     return new_spacing;
 }
@@ -2830,13 +3025,13 @@ split_observed_peak(ColorData *cd, Peak peak, int prev_pos, int next_pos,
         peak1->end++;
         bound_pos = peak1->end;
     }
-    peak1->max = get_peak_max(cd->data,  peak1->beg, peak1->end, message);
-    peak1->area= get_peak_area(cd->data, peak1->beg, peak1->end, message);
+    peak1->max = colordata_peak_max(cd,  peak1->beg, peak1->end, message);
+    peak1->area= colordata_peak_area(cd, peak1->beg, peak1->end, message);
     if (peak1->area < 0 ) {
         sprintf(message->text, "Error computing peak1.area while splitting\n");
         return ERROR;
     }
-    peak1->pos = get_peak_position(cd->data, peak1->beg, peak1->end,
+    peak1->pos = colordata_peak_position(cd, peak1->beg, peak1->end,
         peak1->area, message);
     peak1->ipos = peak1->pos;
     if ((peak1->pos < peak1->beg) || (peak1->pos > peak1->end)) {
@@ -2857,14 +3052,14 @@ split_observed_peak(ColorData *cd, Peak peak, int prev_pos, int next_pos,
     if (peak2->end <= peak2->beg) {
         peak2->end  = peak2->beg+1;
     }
-    peak2->max = get_peak_max(cd->data,  peak2->beg, peak2->end, message);
-    peak2->area= get_peak_area(cd->data, peak2->beg, peak2->end, message);
+    peak2->max = colordata_peak_max(cd,  peak2->beg, peak2->end, message);
+    peak2->area= colordata_peak_area(cd, peak2->beg, peak2->end, message);
     if (peak2->area < 0 ) {
         sprintf(message->text,
             "Error computing peak2.area while splitting\n");
         return ERROR;
     }
-    peak2->pos = get_peak_position(cd->data, peak2->beg, peak2->end, 
+    peak2->pos = colordata_peak_position(cd, peak2->beg, peak2->end, 
         peak2->area, message);
     peak2->ipos = peak2->pos;
     if ((peak2->pos < peak2->beg) || (peak2->pos > peak2->end)) {
@@ -2910,7 +3105,7 @@ build_new_peak(ColorData *cd, int beg, int pos, int end,
     peak->end  = end;
     peak->height = cd->data[pos];
     peak->iheight= peak->height;
-    peak->area = get_peak_area(cd->data, peak->beg, peak->end, message);
+    peak->area = colordata_peak_area(cd, peak->beg, peak->end, message);
     prev_type = (*peak_index > 0) ? cd->peak_list[*peak_index-1].type : 11; 
     next_type = (*peak_index < cd->peak_list_len-1) ? 
                 cd->peak_list[*peak_index+1].type : 11;
@@ -2965,7 +3160,7 @@ adjust_peak_position(int base_ind, Peak *peak, int peak_index, int peak_beg,
 }
 
 void
-preset_base_calls(Data *data, char *color2base, Options options,
+preset_base_calls(Data *data, char *color2base, const Options *options,
     BtkMessage *message)
 {
     int i;
@@ -2982,7 +3177,7 @@ static int
 get_best_peak_color_and_index_by_base_and_location(int *color_index,
     int *peak_index, int base, char *color2base, int location, 
     int prev_location, int next_location, Data *data, BtkMessage *message, 
-    Options options)
+    const Options *options)
 {
     int    j, k, r, l, jc;
     int    new_peak_index, new_location = location;
@@ -3023,7 +3218,7 @@ get_best_peak_color_and_index_by_base_and_location(int *color_index,
                 data->color_data[j].peak_list[*peak_index].orig_width/2.,
                 data->color_data[j].peak_list[*peak_index].beta,
                (double)(data->color_data[j].peak_list[*peak_index].ipos -
-                location), &options);
+                location), options);
             }
             else {
                 height = data->color_data[j].data[location];
@@ -3048,9 +3243,9 @@ get_best_peak_color_and_index_by_base_and_location(int *color_index,
                 data->color_data[0].peak_list[*peak_index].orig_width/2.,
                 data->color_data[0].peak_list[*peak_index].beta,
                (double)(data->color_data[0].peak_list[*peak_index].ipos -
-                location), &options);
+                location), options);
 
-            if (options.recallndb && is_dye_blob(location, &peak, data, 0))
+            if (options->recallndb && is_dye_blob(location, &peak, data, 0))
             {
                 if (peak.is_truncated)
                     height =
@@ -3084,9 +3279,9 @@ get_best_peak_color_and_index_by_base_and_location(int *color_index,
                     data->color_data[k].peak_list[new_peak_index].orig_width/2.,
                     data->color_data[k].peak_list[new_peak_index].beta,
                    (double)(data->color_data[k].peak_list[new_peak_index].ipos-
-                    location), &options);
+                    location), options);
 
-                if (options.recallndb &&
+                if (options->recallndb &&
                     is_dye_blob(location, &new_peak, data, 0))
                 {
                     if (new_peak.is_truncated)
@@ -3194,10 +3389,9 @@ initialize_peak()
 int
 call_peak_by_location_color_and_index(int location, int base_ind, int color, 
     char *color2base, int *peak_index, int prev_peak_index, int *Case,
-    Data *data, BtkMessage *message, Options options)
+    Data *data, BtkMessage *message, const Options *options)
 {
     int i = base_ind, jc = color, j, l, r, k;
-    static int peaks_added[4]={0,0,0,0};
     ColorData *cd = &data->color_data[jc];
     char    base = color2base[jc];
     Peak peak = initialize_peak(), peak1 = initialize_peak(), 
@@ -3228,7 +3422,7 @@ call_peak_by_location_color_and_index(int location, int base_ind, int color,
         peak.base   = base;
         peak.base_index = i;
         peak.is_called  = *Case;
-        peak.area = get_peak_area(data->color_data[jc].data,
+        peak.area = colordata_peak_area(&data->color_data[jc],
                 peak.beg, peak.end, message);
 
         peak.height = cd->data[peak.pos];
@@ -3313,6 +3507,7 @@ call_peak_by_location_color_and_index(int location, int base_ind, int color,
         }
 
         /* Insert peak1 into peak lists */
+        colordata_mark_scan_index_stale(cd);
         data->color_data[j].peak_list[prev_peak_index] = peak1;
         data->bases.called_peak_list[l<i ? l : i] =
             &data->color_data[j].peak_list[prev_peak_index];
@@ -3387,7 +3582,6 @@ call_peak_by_location_color_and_index(int location, int base_ind, int color,
         cd->peak_list[*peak_index]=peak2;
         cpl[l<i?i:l] = &cd->peak_list[*peak_index];
         data->bases.bases[l<i?i:l] = base;
-        peaks_added[j]++;
 
 #if SHOW_CASE
         fprintf(stderr,
@@ -3421,8 +3615,8 @@ call_peak_by_location_color_and_index(int location, int base_ind, int color,
         if (location <  lbound) location  = lbound;
         if (location >= rbound) location  = rbound-1;
 
+        colordata_mark_scan_index_stale(cd);
         build_new_peak(cd, lbound, location, rbound, &peak, peak_index, message);
-        peaks_added[jc]++;
 
         peak.base   = color2base[jc];
         peak.base_index = i;
@@ -3511,7 +3705,7 @@ static int get_previous_peak_index(int i, int jc, int peak_ind,
 }
 
 /*******************************************************************************
- * Function: mark_called_peaks
+ * Function: bc_mark_called_peaks
  * Purpose: In the list of all peaks, mark those which are called
  *          This function is similar to the data_mark_called_peaks in
  *          TraceTuner 1.0, but differs from it in that intrinsic peak
@@ -3533,9 +3727,9 @@ static int get_previous_peak_index(int i, int jc, int peak_ind,
  *
  *******************************************************************************
  */
-int
-mark_called_peaks(Data *data, char *color2base, Options options, 
-    BtkMessage *message)
+static int
+bc_mark_called_peaks(Data *data, char *color2base, 
+    const Options *options, BtkMessage *message)
 {
     char  *debug;
     char   base;
@@ -3611,7 +3805,7 @@ mark_called_peaks(Data *data, char *color2base, Options options,
                 last_peak_ind++;
 
             resolve_multiple_peaks(data, prev_color_index, first_peak_ind,
-                   last_peak_ind-first_peak_ind+1, &max_res, &options, message);
+                   last_peak_ind-first_peak_ind+1, &max_res, options, message);
         }    
         prev_color_index = jc;
 
@@ -3669,7 +3863,26 @@ mark_called_peaks(Data *data, char *color2base, Options options,
 }
 
 /*******************************************************************************
- * Function: Btk_call_bases             
+ * Function: mark_called_peaks
+ * Purpose:  mark the called peaks, looking the peaks up by scan through 
+ *           an index that is rebuilt after the peak lists are edited
+ *******************************************************************************
+ */
+int
+mark_called_peaks(Data *data, char *color2base, const Options *options, 
+    BtkMessage *message)
+{
+    int r;
+
+    data_mark_scan_index_stale(data);
+    r = bc_mark_called_peaks(data, color2base, options, message);
+    data_release_scan_index(data);
+
+    return r;
+}
+
+/*******************************************************************************
+ * Function: bc_call_bases             
  *
  * Purpose: 
  *     1) In the list of all peaks, mark those which are called
@@ -3683,9 +3896,9 @@ mark_called_peaks(Data *data, char *color2base, Options options,
  * 
  *******************************************************************************
  */
-int
-Btk_call_bases(Data *data, char *color2base, ReadInfo *read_info, 
-    ContextTable *ctable, Options *options, BtkMessage *message, 
+static int
+bc_call_bases(Data *data, char *color2base, ReadInfo *read_info, 
+    ContextTable *ctable, const Options *options, BtkMessage *message, 
     Results *results )
 {
     char    *debug, base, *context=NULL;
@@ -4055,7 +4268,7 @@ Btk_call_bases(Data *data, char *color2base, ReadInfo *read_info,
          */
         lbound = (i == 0) ? 0 : (coord[i] + coord[i-1])/2;
         rbound = (i == data->bases.length-1) ?
-                data->color_data[jc].length-1 :
+                data->color_data[0].length-1 :
                (coord[i]+coord[i+1])/2;
 
         /* Does the base location fall into a good peak's area? */
@@ -4329,7 +4542,7 @@ Btk_call_bases(Data *data, char *color2base, ReadInfo *read_info,
          */
         lbound = (i == 0) ? 0 : (coord[i] + coord[i-1])/2;
         rbound = (i == data->bases.length-1) ?
-                  data->color_data[jc].length-1 :
+                  data->color_data[0].length-1 :
                   (coord[i]+coord[i+1])/2;
 
         if ((data->bases.called_peak_list[i] != NULL &&
@@ -4740,9 +4953,9 @@ Btk_call_bases(Data *data, char *color2base, ReadInfo *read_info,
 
                 peak.is_called = Case[i];
                 base = color2base[jc];
-                peak.area = get_peak_area(cd->data, peak.beg,
+                peak.area = colordata_peak_area(cd, peak.beg,
                     peak.end, message);
-                peak.pos = get_peak_position(cd->data,
+                peak.pos = colordata_peak_position(cd,
                     peak.beg, peak.end, peak.area, message); 
                 if (peak.pos < location)
                     (void)split_observed_peak(cd, peak,
@@ -4859,7 +5072,7 @@ Btk_call_bases(Data *data, char *color2base, ReadInfo *read_info,
 
                     if (get_best_peak_color_and_index_by_base_and_location(&jc, 
                         &peak_ind, base, color2base, location, prev_location, 
-                        next_location, data, message, *options) != SUCCESS)
+                        next_location, data, message, options) != SUCCESS)
                         return ERROR;
                        
                     previous_peak_index = get_previous_peak_index(i, jc, peak_ind,
@@ -4867,7 +5080,7 @@ Btk_call_bases(Data *data, char *color2base, ReadInfo *read_info,
                  
                     if (call_peak_by_location_color_and_index(location, i, jc, 
                         color2base, &peak_ind, previous_peak_index, &Case[i],
-                        data, message, *options) != SUCCESS)
+                        data, message, options) != SUCCESS)
                         return ERROR;
                 }
             }
@@ -4952,7 +5165,7 @@ Btk_call_bases(Data *data, char *color2base, ReadInfo *read_info,
             if (base_index > data->bases.length) 
                 continue;
          
-            curr_spacing1 = spacing_curve(data->peak_list[i]->ipos);
+            curr_spacing1 = spacing_curve(data, data->peak_list[i]->ipos);
             curr_spacing2 = get_spacing_from_good_region(base_index, data);
          
             if (base_index < 500)       
@@ -5681,3 +5894,25 @@ Btk_call_bases(Data *data, char *color2base, ReadInfo *read_info,
     FREE(Case);
     return SUCCESS;
 }
+
+/*******************************************************************************
+ * Function: Btk_call_bases
+ * Purpose:  call bases as described for bc_call_bases, looking the peaks up
+ *           by scan through an index that is rebuilt after the peak lists 
+ *           are edited
+ *******************************************************************************
+ */
+int
+Btk_call_bases(Data *data, char *color2base, ReadInfo *read_info, 
+    ContextTable *ctable, const Options *options, BtkMessage *message, 
+    Results *results )
+{
+    int r;
+
+    data_mark_scan_index_stale(data);
+    r = bc_call_bases(data, color2base, read_info, ctable, options, message,
+        results);
+    data_release_scan_index(data);
+
+    return r;
+}
@@ -32,19 +32,26 @@
 #define MIN_CALLED_PEAK_HEIGHT 5.
 
 extern int bc_data_create_single_ordered_peak_list(Data *, int *, BtkMessage *);
+extern int colordata_build_scan_index(ColorData *, BtkMessage *);
+extern void colordata_release_scan_index(ColorData *);
+extern void data_release_scan_index(Data *);
+extern void colordata_mark_scan_index_stale(ColorData *);
+extern void data_mark_scan_index_stale(Data *);
+extern int colordata_find_peak_index_by_scan_index(ColorData *, int, Peak *, 
+    int *);
 extern int colordata_find_peak_index_by_location(ColorData *, int,
     Peak *, int *, BtkMessage *);
 extern int uncall_peak(int, Data *, BtkMessage *);
 extern int can_insert_base(Data *, int, int, int,
-    double, double, Options *);
+    double, double, const Options *);
 extern int is_dye_blob(int pos, Peak *, Data *, int); 
 extern int mk_dip_list(Peak **, int, Peak ***, int *, 
-    Options *, BtkMessage *, Data *);
+    const Options *, BtkMessage *, Data *);
 extern int Btk_call_bases(Data *, char *, ReadInfo *, 
-    ContextTable *, Options *, BtkMessage *, Results * );
-extern int mark_called_peaks(Data *, char *, Options, BtkMessage *);
+    ContextTable *, const Options *, BtkMessage *, Results * );
+extern int mark_called_peaks(Data *, char *, const Options *, BtkMessage *);
 extern int create_DIP_list(Data *, int, int, int *, Peak ***, int *, 
-    Options *, BtkMessage *);
-extern void preset_base_calls(Data *, char *, Options, BtkMessage *);
+    const Options *, BtkMessage *);
+extern void preset_base_calls(Data *, char *, const Options *, BtkMessage *);
 extern void check_base_index(Data *data);
 extern Peak initialize_peak();
@@ -88,7 +88,7 @@ get_quality_value(double phr3, double phr7, double psr7, double pres,
  */
 int
 assign_quality(int num_called_bases, int *quality_values, 
-    double **params, Options *options, BtkLookupTable *table)
+    double **params, const Options *options, BtkLookupTable *table)
 {
     int i;
 
@@ -112,7 +112,7 @@ Btk_compute_qv(int *num_called_bases, char **called_bases,
 #if USE_CONTEXT_TABLE
                ContextTable *ctable,
 #endif
-               int **quality_values, Options options, BtkMessage *message, 
+               int **quality_values, const Options *options, BtkMessage *message, 
                Results *results)
 {
     int           i, r;
@@ -129,17 +129,8 @@ Btk_compute_qv(int *num_called_bases, char **called_bases,
         params[i] = NULL;
     }
 
-    /* Reset parameters depending on the lookup table used 
-     * Default is ABI3100 table
-     */
-    options.sf = CALLOC(double, 4);
-    options.sf[0] = 0.8; 
-    options.sf[1] = 3.5;
-    options.sf[2] = 0.1;
-    options.sf[3] = 1.4;
-
-    if ((!options.het && !options.mix) || options.recalln || options.recallndb 
-        || options.ladder) 
+    if ((!options->het && !options->mix) || options->recalln || options->recallndb 
+        || options->ladder) 
     { 
         if (Btk_compute_tpars(num_called_bases, called_bases, called_peak_locs, 
             num_datapoints, chromatogram, color2base, 
@@ -150,25 +141,25 @@ Btk_compute_qv(int *num_called_bases, char **called_bases,
                 goto error;
         }
 
-        if (options.process_bases) 
+        if (options->process_bases) 
         {
            *quality_values = REALLOC(*quality_values, int, *num_called_bases);
             MEM_ERROR(*quality_values);
 
             if ((r = assign_quality(*num_called_bases, *quality_values,
-                params, &options, table)) != SUCCESS) {
+                params, options, table)) != SUCCESS) {
                 goto error;
             }
 
         } 
     }
   
-    if (options.het || options.mix) 
+    if (options->het || options->mix) 
     {
         /* Notes: 
          * 1) function Btk_get_mixed_bases will repeat most of the calls made by 
          *    Btk_compute_tpars
-         * 2) If options.het > 0 AND options.poly > 0, then heterozygotes 
+         * 2) If options->het > 0 AND options->poly > 0, then heterozygotes 
          *    will be processed as usual, but instead of mixed base they
          *    will be assigned a pure base character corresponding to the 
          *    highest peak (at Tim's request). These pure bases will be
@@ -189,7 +180,6 @@ Btk_compute_qv(int *num_called_bases, char **called_bases,
     FREE(iheight);
     FREE(iheight2);
     FREE(ave_iheight);
-    FREE(options.sf);
     return SUCCESS;
 
 error:
@@ -199,7 +189,6 @@ error:
     FREE(iheight);
     FREE(iheight2);
     FREE(ave_iheight);
-    FREE(options.sf);
 
     return ERROR;
 }
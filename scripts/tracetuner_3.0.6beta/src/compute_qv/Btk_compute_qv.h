@@ -27,7 +27,7 @@
  *  Btk_compute_qv.h  $Revision: 1.7 $
  */
 
-extern int assign_quality(int, int *, double **, Options *, 
+extern int assign_quality(int, int *, double **, const Options *, 
     BtkLookupTable *);
 extern int Btk_compute_qv(
     int *,	       /* pointer to input length of the array of called bases*/
@@ -47,7 +47,7 @@ extern int Btk_compute_qv(
                         */
 #endif
     int **,            /* pointer to output array of quality values */
-    Options,           /* options structure: includes file_name, nocall, etc. */
+    const Options *,   /* options structure: includes file_name, nocall, etc. */
     BtkMessage *,      /* error code and descriptive text */
     Results *
 );
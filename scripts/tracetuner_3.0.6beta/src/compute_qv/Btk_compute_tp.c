@@ -78,7 +78,7 @@
  */
 static void   
 get_window(Data *data, int data_peak_ind,  int data_peak_ind2, int window, 
-    int *il, int *ir, int *lwin, int *rwin, Options *options)
+    int *il, int *ir, int *lwin, int *rwin, const Options *options)
 {
     int  i=data_peak_ind, half_window=window/2;
 
@@ -135,7 +135,7 @@ get_window(Data *data, int data_peak_ind,  int data_peak_ind2, int window,
  */
 double
 get_max_uncalled_height(Data *data, int data_peak_ind2, double frac, 
-    int il, int ir, double *max_uncalled_ipos, Options *options)
+    int il, int ir, double *max_uncalled_ipos, const Options *options)
 {
    int    j;
    double max_uncalled_iheight = 0., iheight, ipos,
@@ -191,7 +191,7 @@ get_max_uncalled_height(Data *data, int data_peak_ind2, double frac,
 static int   
 get_min_max_called_height(int data_peak_ind, int data_peak_ind2,
     double *min_called, double *max_called, double *min_called_ipos,
-    double frac, Data *data, int il, int ir, Options *options)
+    double frac, Data *data, int il, int ir, const Options *options)
 {
    int    j;
    double iheight; 
@@ -254,7 +254,7 @@ get_min_max_called_height(int data_peak_ind, int data_peak_ind2,
 static int
 get_min_max_spacing(int data_peak_ind, int data_peak_ind2, double *min_spacing, 
     double *max_spacing, double *min_spacing_ipos, double *max_spacing_ipos, 
-    Data *data, int il, int ir, Options *options, BtkMessage *message)
+    Data *data, int il, int ir, const Options *options, BtkMessage *message)
 {
     int    j, prev_called_ind;
     double called_pos, prev_called_pos;
@@ -327,7 +327,7 @@ get_min_max_spacing(int data_peak_ind, int data_peak_ind2, double *min_spacing,
  */
 double 
 get_peak_height_ratio(Data *data, int data_peak_ind, int data_peak_ind2, 
-    int window, double frac, double min_uncalled, Options *options, 
+    int window, double frac, double min_uncalled, const Options *options, 
     BtkMessage *message)
 {
     int il, ir; 
@@ -386,7 +386,7 @@ get_peak_height_ratio(Data *data, int data_peak_ind, int data_peak_ind2,
  */
 double
 get_peak_spacing_ratio(Data *data, int data_peak_ind, int data_peak_ind2,
-    int window, Options *options, BtkMessage *message)
+    int window, const Options *options, BtkMessage *message)
 {
     int    j, il, ir, lwin, rwin;
     double min_spacing, max_spacing;
@@ -444,7 +444,7 @@ get_peak_spacing_ratio(Data *data, int data_peak_ind, int data_peak_ind2,
  *******************************************************************************
  */
 double
-get_peak_resolution(Data *data, int data_peak_ind, Options *options,
+get_peak_resolution(Data *data, int data_peak_ind, const Options *options,
     BtkMessage *message)
 {
     double res = data->peak_list[data_peak_ind]->resolution;
@@ -460,7 +460,7 @@ get_peak_resolution(Data *data, int data_peak_ind, Options *options,
  *******************************************************************************
  */
 static double
-get_peak_resolution_parameter(Data *data, int data_peak_ind, Options *options, 
+get_peak_resolution_parameter(Data *data, int data_peak_ind, const Options *options, 
     BtkMessage *message)
 {
     int i;
@@ -502,7 +502,7 @@ get_peak_resolution_parameter(Data *data, int data_peak_ind, Options *options,
  */
 int
 get_trace_parameters_of_pure_bases(int base_index, Data *data, char *color2base, 
-    Options *opts, BtkMessage *message)
+    const Options *opts, BtkMessage *message)
 {
     int i;
 
@@ -622,6 +622,248 @@ populate_params_array(int i, Data* data, double** params)
     return SUCCESS;
 }
 
+/*******************************************************************************
+ * Monotone queue of indexes used to maintain the minimum or maximum of 
+ * an array over a window which slides only to the right. Both window 
+ * boundaries should be non-decreasing from one call to the next.
+ *******************************************************************************
+ */
+typedef struct {
+    int    *ind;      /* indexes of candidate extrema; values are monotone */
+    int     head;
+    int     tail;
+    int     next;     /* next index to enter the window */
+    int     is_max;   /* 1 to maintain maximum, 0 to maintain minimum */
+} ExtremumQueue;
+
+static void
+extremum_queue_init(ExtremumQueue *q, int *buffer, int is_max)
+{
+    q->ind    = buffer;
+    q->head   = 0;
+    q->tail   = 0;
+    q->next   = 0;
+    q->is_max = is_max;
+}
+
+/*******************************************************************************
+ * Function: extremum_queue_slide
+ * Purpose:  move the window to [beg, end] and return the index of the 
+ *           extremal value in it, or -1 if the window is empty
+ *******************************************************************************
+ */
+static int
+extremum_queue_slide(ExtremumQueue *q, double *val, int beg, int end)
+{
+    if (q->next < beg) {
+        q->next = beg;
+    }
+    for (; q->next <= end; q->next++) {
+        while (q->tail > q->head && 
+               (q->is_max ? val[q->ind[q->tail-1]] <= val[q->next] :
+                            val[q->ind[q->tail-1]] >= val[q->next]))
+            q->tail--;
+        q->ind[q->tail++] = q->next;
+    }
+    while (q->tail > q->head && q->ind[q->head] < beg)
+        q->head++;
+
+    return (q->tail > q->head) ? q->ind[q->head] : -1;
+}
+
+/*******************************************************************************
+ * Function: get_trace_parameters_of_pure_bases_in_one_sweep
+ * Purpose:  compute the 4 trace parameters of all called bases in a single
+ *           left-to-right pass through the data peak list. This produces the 
+ *           same results as calling get_trace_parameters_of_pure_bases for 
+ *           every base, but the boundaries of the 3- and 7-peak windows are 
+ *           maintained incrementally, the height and spacing extrema are 
+ *           taken from monotone queues and the dye blob status of each peak 
+ *           is evaluated only once.
+ *           Returns ERROR if the peak list does not fit the assumptions of 
+ *           the single sweep (every called base is a single, ordered peak),
+ *           in which case the caller should fall back to the per base code.
+ *******************************************************************************
+ */
+static int
+get_trace_parameters_of_pure_bases_in_one_sweep(Data *data, const Options *options,
+    BtkMessage *message)
+{
+    int      j, k, m, w, num_called = 0;
+    int      len = data->peak_list_len;
+    int      windows[2] = {WINDOW_3, WINDOW_7};
+    int      adjust_dye_blobs = !options->recalln && !options->recallndb && 
+                                !options->ladder;
+    int     *called_ind   = NULL;   /* data peak indexes of called peaks */
+    int     *queue_buffer = NULL;
+    double  *uncalled_height = NULL;
+    double  *called_height = NULL;
+    double  *min_spacing_val = NULL;
+    double  *max_spacing_val = NULL;
+    Peak   **pl  = data->peak_list;
+    Peak   **cpl = data->bases.called_peak_list;
+    ExtremumQueue uncalled_max[2], called_min[2], spacing_min, spacing_max;
+
+    if (options->het || options->mix || data->bases.length < 2)
+        return ERROR;
+
+    /* Check the assumptions and collect the called peaks in the peak order */
+    for (j = 0; j < len; j++) {
+        if (pl[j]->data_peak_ind != j)
+            return ERROR;
+        if (!pl[j]->is_called || pl[j]->base_index < 0)
+            continue;
+        if ((pl[j]->base_index != num_called) || 
+            (pl[j]->data_peak_ind2 != j) ||
+            (num_called >= data->bases.length) ||
+            (cpl[num_called] != pl[j]))
+            return ERROR;
+        num_called++;
+    }
+    if (num_called != data->bases.length)
+        return ERROR;
+
+    called_ind      = CALLOC(int, num_called);
+    MEM_ERROR(called_ind);
+    queue_buffer    = CALLOC(int, 6*len);
+    MEM_ERROR(queue_buffer);
+    uncalled_height = CALLOC(double, len);
+    MEM_ERROR(uncalled_height);
+    called_height   = CALLOC(double, num_called);
+    MEM_ERROR(called_height);
+    min_spacing_val = CALLOC(double, num_called);
+    MEM_ERROR(min_spacing_val);
+    max_spacing_val = CALLOC(double, num_called);
+    MEM_ERROR(max_spacing_val);
+
+    /* Evaluate the adjusted height of each peak once. Peaks of undefined
+     * height never win a comparison in the per base code, so they are
+     * given neutral values here
+     */
+    for (j = 0, m = 0; j < len; j++) {
+        double iheight = pl[j]->iheight;
+        int    is_blob;
+
+        if ((pl[j]->is_called != 0) != (pl[j]->base_index >= 0))
+            continue;
+
+        is_blob = adjust_dye_blobs && is_dye_blob(pl[j]->ipos, pl[j], data, 
+                  QVMAX(options->het, options->mix));
+
+        if (pl[j]->is_called) {
+            if (is_blob) {
+                iheight *= DYE_BLOB_FRACTION;
+                if (iheight < MIN_CALLED_PEAK_HEIGHT)
+                    iheight = MIN_CALLED_PEAK_HEIGHT;
+            }
+            called_ind[m]    = j;
+            called_height[m] = isnan(iheight) ? DBL_MAX : iheight;
+            m++;
+        }
+        else {
+            if (adjust_dye_blobs) {
+                if (is_blob)
+                    iheight *= DYE_BLOB_FRACTION;
+                if (iheight < MIN_CALLED_PEAK_HEIGHT)
+                    iheight = MIN_CALLED_PEAK_HEIGHT;
+            }
+            uncalled_height[j] = isnan(iheight) ? 0. : iheight;
+        }
+    }
+
+    /* Spacing m is the distance between m-th called peak and the called
+     * peak (or, for m=0, the first peak) to the left of it
+     */
+    for (m = 0; m < num_called; m++) {
+        double spacing = pl[called_ind[m]]->ipos - 
+            (double)pl[m > 0 ? called_ind[m-1] : 0]->ipos;
+
+        min_spacing_val[m] = isnan(spacing) ?  DBL_MAX : spacing;
+        max_spacing_val[m] = isnan(spacing) ? -DBL_MAX : spacing;
+    }
+
+    for (w = 0; w < 2; w++) {
+        extremum_queue_init(&uncalled_max[w], &queue_buffer[ w   *len], 1);
+        extremum_queue_init(&called_min[w],   &queue_buffer[(w+2)*len], 0);
+    }
+    extremum_queue_init(&spacing_min, &queue_buffer[4*len], 0);
+    extremum_queue_init(&spacing_max, &queue_buffer[5*len], 1);
+
+    for (k = 0; k < num_called; k++) 
+    {
+        int    center = called_ind[k];
+        double phr[2];
+
+        for (w = 0; w < 2; w++) {
+            int    half_window = windows[w]/2;
+            int    il = (k - half_window >= 0) ? called_ind[k-half_window] : 0;
+            int    ir = (k + half_window < num_called) ? 
+                        called_ind[k+half_window] : len-1;
+            int    imax, imin;
+            double max_uncalled_height, min_called_height;
+
+            imax = extremum_queue_slide(&uncalled_max[w], uncalled_height, 
+                il, ir);
+            max_uncalled_height = (imax >= 0) ? 
+                QVMAX(0., uncalled_height[imax]) : 0.;
+
+            imin = extremum_queue_slide(&called_min[w], called_height,
+                QVMAX(k - half_window, 0), 
+                QVMIN(k + half_window, num_called-1));
+            min_called_height = isnan(pl[center]->iheight) ?
+                pl[center]->iheight : 
+                QVMIN(pl[center]->iheight, called_height[imin]);
+
+            phr[w] = (min_called_height > 0) ?
+                max_uncalled_height / min_called_height : 100.0;
+        }
+        data->trace_parameters.phr3[k] = phr[0];
+        data->trace_parameters.phr7[k] = phr[1];
+
+        /* Spacing ratio in the window of 7 called peaks */
+        {
+            int    half_window = WINDOW_7/2;
+            int    sbeg = (k - half_window >= 0) ? k - half_window + 1 :
+                          (called_ind[0] == 0) ? 1 : 0;
+            int    send = QVMIN(k + half_window, num_called-1);
+            double min_spacing, max_spacing;
+
+            min_spacing = max_spacing = (k > 0) ? 
+                cpl[k]->ipos - cpl[k-1]->ipos : cpl[k+1]->ipos - cpl[k]->ipos;
+            if (!isnan(min_spacing)) {
+                min_spacing = QVMIN(min_spacing, 
+                    min_spacing_val[extremum_queue_slide(&spacing_min, 
+                    min_spacing_val, sbeg, send)]);
+                max_spacing = QVMAX(max_spacing, 
+                    max_spacing_val[extremum_queue_slide(&spacing_max, 
+                    max_spacing_val, sbeg, send)]);
+            }
+
+            data->trace_parameters.psr7[k] = 
+                max_spacing / (min_spacing>0?min_spacing:1.);
+        }
+        data->trace_parameters.pres[k] = 
+            get_peak_resolution_parameter(data, center, options, message);
+    }
+
+    FREE(called_ind);
+    FREE(queue_buffer);
+    FREE(uncalled_height);
+    FREE(called_height);
+    FREE(min_spacing_val);
+    FREE(max_spacing_val);
+    return SUCCESS;
+
+error:
+    FREE(called_ind);
+    FREE(queue_buffer);
+    FREE(uncalled_height);
+    FREE(called_height);
+    FREE(min_spacing_val);
+    FREE(max_spacing_val);
+    return ERROR;
+}
+
 /*******************************************************************************
  * Function: Btk_compute_tp
  * Purpose: Calculate trace parameters 
@@ -632,7 +874,7 @@ populate_params_array(int i, Data* data, double** params)
  */
 int
 Btk_compute_tp(Data *data, char *color2base, double *params[NUM_PARAMS],
-    ReadInfo *read_info, ContextTable *ctable, Options *options,
+    ReadInfo *read_info, ContextTable *ctable, const Options *options,
     BtkMessage *message)
 {
     int i;
@@ -649,6 +891,19 @@ Btk_compute_tp(Data *data, char *color2base, double *params[NUM_PARAMS],
         }
     }
 
+    if (get_trace_parameters_of_pure_bases_in_one_sweep(data, options, 
+        message) == SUCCESS) 
+    {
+        for (i=0; i<data->bases.length; i++)
+        {
+            if (populate_params_array(i, data, params) != SUCCESS) {
+                sprintf(message->text, "Error calling populate_params_array\n");
+                goto error;
+            }
+        }
+        return SUCCESS;
+    }
+
     for (i=0; i<data->bases.length; i++)
     {    
         if (get_trace_parameters_of_pure_bases(i, data, color2base, options,
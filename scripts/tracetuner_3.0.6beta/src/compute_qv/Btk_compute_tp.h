@@ -29,14 +29,14 @@
  */
 
 extern int Btk_compute_tp(Data *, char *, double *[], ReadInfo *,
-    ContextTable *, Options *, BtkMessage *);
+    ContextTable *, const Options *, BtkMessage *);
 extern double get_peak_height_ratio(Data *, int, int, int, double,
-    double,  Options *, BtkMessage *);
+    double,  const Options *, BtkMessage *);
 extern double get_peak_spacing_ratio(Data *, int, int, int, 
-    Options *, BtkMessage *);
+    const Options *, BtkMessage *);
 extern double get_peak_resolution(Data *, int, 
-    Options *, BtkMessage *);
+    const Options *, BtkMessage *);
 extern int get_trace_parameters_of_pure_bases(int, Data *, char *, 
-    Options *, BtkMessage *);
+    const Options *, BtkMessage *);
 extern int populate_params_array(int, Data* , double** );
 extern double get_context_weight(char *context);
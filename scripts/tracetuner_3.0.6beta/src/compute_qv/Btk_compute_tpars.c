@@ -64,8 +64,6 @@
 #define STORE_IS_RESOLVED            0
 #define STORE_CASE                   0
 
-extern unsigned int max_colordata_value;
-
 /*******************************************************************************
  * Function: colordata_release
  * Purpose: free the memory allocated by colordata_create()
@@ -76,6 +74,8 @@ colordata_release(ColorData *color_data)
 {
     FREE(color_data->data);
     FREE(color_data->peak_list);
+    FREE(color_data->scan_peak_index);
+    colordata_release_signal_index(color_data);
 }
  
 /*******************************************************************************
@@ -120,6 +120,7 @@ data_release(Data *data)
     }
     bases_release(&data->bases);
     trace_parameters_release(&data->trace_parameters);
+    spacing_model_release(&data->spacing);
  
     FREE(data->peak_list);
 }
@@ -136,11 +137,18 @@ colordata_create(ColorData *color_data, int length, int color,
     color_data->length = length;
     color_data->peak_list_len = 0;
     color_data->peak_list_max_len = MAX_NUM_OF_PEAK;
+    color_data->scan_peak_index = NULL;
+    color_data->scan_peak_index_len = 0;
+    color_data->scan_peak_index_stale = 0;
+    color_data->signal_sum = NULL;
+    color_data->signal_max = NULL;
+    color_data->signal_max_levels = 0;
+    color_data->signal_index_len = 0;
 
     color_data->peak_list = CALLOC(Peak, color_data->peak_list_max_len);
     MEM_ERROR(color_data->peak_list);
 
-    color_data->data = CALLOC(int, color_data->length);
+    color_data->data = CALLOC(TT_Sample, color_data->length);
     MEM_ERROR(color_data->data);
  
     color_data->dye_number = color + 1;
@@ -214,6 +222,7 @@ data_create(Data *data, int length_cd, int length_bs, char *color2base,
     int i, r;
     (void)memset(data, 0, sizeof(data));
 
+    spacing_model_init(&data->spacing);
     data->length = 0; 
     for (i = 0; i < NUM_COLORS; i++) {
         if ((r = colordata_create(&data->color_data[i], length_cd, i, 
@@ -317,7 +326,7 @@ quicksort_locations(int *locs, int p, int r)
  */
 int
 bases_populate(int *num_bases, char **bases, int edited_bases,
-    int **locs, Data *data, Options *options, BtkMessage *message)
+    int **locs, Data *data, const Options *options, BtkMessage *message)
 {
     int i, m=0;
  
@@ -380,9 +389,8 @@ colordata_populate(int num_datapoints, int **chromatogram, char *color2base,
 {
     int i, j, max_value;
 
-    max_colordata_value = 0;
-
     for (j = 0; j < NUM_COLORS; j++) {
+        colordata_release_signal_index(&data->color_data[j]);
         data->color_data[j].base = color2base[j];
         /*
          * Fill in the data points.  Along the way, find the maximum data
@@ -391,12 +399,12 @@ colordata_populate(int num_datapoints, int **chromatogram, char *color2base,
         max_value = 0;
         for (i = 0; i < data->color_data[j].length; i++) {
             if (chromatogram[j][i]>=0) {
-                data->color_data[j].data[i] = chromatogram[j][i];
+                data->color_data[j].data[i] = TT_SAMPLE(chromatogram[j][i]);
             }
             else {
 //              data->color_data[j].data[i] = 0;
 #if 1
-                data->color_data[j].data[i] = - chromatogram[j][i];
+                data->color_data[j].data[i] = TT_SAMPLE(- chromatogram[j][i]);
 #endif
 
             }
@@ -406,9 +414,6 @@ colordata_populate(int num_datapoints, int **chromatogram, char *color2base,
         }
 
         data->color_data[j].max_value = max_value;
-
-        if (max_value > (int)max_colordata_value)
-            max_colordata_value = max_value;
     }
 
     return SUCCESS;
@@ -457,7 +462,7 @@ output_data(Data *data, BtkMessage *message)
 int
 data_populate(int *num_bases, char **bases, int edited_bases,
     int **locs, int num_datapoints, int **chromatogram, 
-    char *color2base, Data *data, Options *options, BtkMessage *message)
+    char *color2base, Data *data, const Options *options, BtkMessage *message)
 {
     int r;
  
@@ -544,6 +549,13 @@ populate_iheight_array(Data* data, double* iheight, double* iheight2,
     Peak peak;
     int peak_index;
 
+    /* The peaks are not edited below, so locate them by scan */
+    for (j=0; j<NUM_COLORS; j++) {
+        if (colordata_build_scan_index(&data->color_data[j], msg) 
+            != SUCCESS)
+            return ERROR;
+    }
+
     for (i=0; i<data->peak_list_len; i++) 
     {
         if (!data->peak_list[i]->is_called) {
@@ -579,6 +591,7 @@ populate_iheight_array(Data* data, double* iheight, double* iheight2,
 
             if (colordata_find_peak_index_by_location(&(data->color_data[j]),
                 position, &peak, &peak_index, msg) != SUCCESS) {
+                data_release_scan_index(data);
                 return ERROR;
             }
 
@@ -604,6 +617,8 @@ populate_iheight_array(Data* data, double* iheight, double* iheight2,
         ave_iheight[base_index] = get_average_called_peak_height(data, 
             base_index);
     }
+    data_release_scan_index(data);
+
     return SUCCESS;
 }
 
@@ -612,7 +627,7 @@ populate_iheight_array(Data* data, double* iheight, double* iheight2,
  *******************************************************************************
  */
 void
-show_input_options(Options *options)
+show_input_options(const Options *options)
 {
     fprintf(stderr, "\nInput options:\nFile_name=%s lut_type=%d path=%s\n",
         options->file_name, options->lut_type, options->path);
@@ -623,8 +638,9 @@ show_input_options(Options *options)
     "recalln=%d renorm=%d shift=%d het=%d tab_dir=%s tal_dir=%s tip_dir=%s Verbose=%d\n",
         options->recalln, options->renorm, options->shift, options->het,
         options->tab_dir, options->tal_dir, options->tip_dir, options->Verbose);
-    fprintf(stderr, "scaling factors = %f %f %f %f\n\n",
-        options->sf[0], options->sf[1], options->sf[2], options->sf[3]);
+    if (options->sf != NULL)
+        fprintf(stderr, "scaling factors = %f %f %f %f\n\n",
+            options->sf[0], options->sf[1], options->sf[2], options->sf[3]);
 }
 
 /*******************************************************************************
@@ -643,7 +659,7 @@ total_number_of_peaks(Data *data)
 
 static int
 get_trace_parameters_of_mixed_base(int i, int data_peak_ind, int data_peak_ind2, 
-    double **params, double r, Options *op, Data *data, BtkMessage *msg)
+    double **params, double r, const Options *op, Data *data, BtkMessage *msg)
 {
     double psr1, psr2;
     
@@ -709,7 +725,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
     double **params0, double **params1, double **params2, double **params3,  
     double **iheight, double **iheight2, double **ave_iheight, 
     ReadInfo *read_info, BtkLookupTable *table, ContextTable *ctable,
-    Options options, BtkMessage *message, Results *results )
+    const Options *options, BtkMessage *message, Results *results )
 {
     int      i;
     Data     data; 
@@ -719,7 +735,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
     char    *orig_bases = "";
 
     if (SHOW_INPUT_OPTIONS)
-        show_input_options(&options);
+        show_input_options(options);
 
     if (*num_bases > MAX_NUM_BASES)
     {
@@ -729,7 +745,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
     }
 
     /* Store original bases */
-    if (options.het || options.mix)
+    if (options->het || options->mix)
     {
         orig_bases = CALLOC(char, *num_bases);
         for (i=0; i<*num_bases; i++)
@@ -745,16 +761,16 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
         return ERROR;
     }
 
-    if (data_populate(num_bases, bases, options.edited_bases,
+    if (data_populate(num_bases, bases, options->edited_bases,
         peak_locs, *num_datapoints, chromatogram, color2base, &data,
-        &options, message) != SUCCESS)
+        options, message) != SUCCESS)
     {
         sprintf(message->text, "Error calling data_populate\n");
         fprintf(stderr, "Error calling  data_populate - 1\n");
         goto error;
     }
 
-    if (options.raw_data) {
+    if (options->raw_data) {
         if (Btk_process_raw_data(num_datapoints, chromatogram, "ACGT",
                  &data, options, message) == ERROR)
         {
@@ -762,9 +778,9 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
             goto error;
         }
 
-        if (data_populate(num_bases, bases, options.edited_bases,
+        if (data_populate(num_bases, bases, options->edited_bases,
             peak_locs, *num_datapoints, chromatogram, color2base, &data,
-            &options, message) != SUCCESS)
+            options, message) != SUCCESS)
         {
             sprintf(message->text, "Error calling data_populate\n");
             fprintf(stderr, "Error calling  data_populate - 2\n");
@@ -772,7 +788,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
         }
     }
     else {
-        if (options.xgr) {
+        if (options->xgr) {
             output_chromatogram("0_Orig_analyzed_data.xgr",
             "Analyzed data", 
             chromatogram[0], chromatogram[1], chromatogram[2], chromatogram[3], 
@@ -780,16 +796,16 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
         }
     }
 
-    if (options.process_bases) 
+    if (options->process_bases) 
     {
-        if (options.time) {
+        if (options->time) {
             curr_clock = clock();
             fprintf(stderr, "Data structure populated in %f sec. \n",
                 (float)(curr_clock - start_clock)/(float)CLOCKS_PER_SEC);
             start_clock = curr_clock;
         }
     
-        if (Btk_process_peaks(&data, &options, message) != SUCCESS) {
+        if (Btk_process_peaks(&data, options, message) != SUCCESS) {
             if (total_number_of_peaks(&data) >= 10) {
                 sprintf(message->text, "Error calling process_peaks\n");
                 fprintf(stderr, "Error calling process_peaks\n");
@@ -810,48 +826,48 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
             }
         }
 
-        if (options.time) {
+        if (options->time) {
             curr_clock = clock();
             fprintf(stderr, "Peaks processed in %f sec. \n",
                 (float)(curr_clock - start_clock)/(float)CLOCKS_PER_SEC);
             start_clock = curr_clock;
         }
 
-        if (!options.recalln && !options.recallndb && !options.ladder &&
-            !options.het     && !options.mix) 
+        if (!options->recalln && !options->recallndb && !options->ladder &&
+            !options->het     && !options->mix) 
             // the last two options may be passed only from train.c
         {
             if (Btk_call_bases(&data, color2base, read_info, ctable,
-                &options, message, results ) != SUCCESS) {
+                options, message, results ) != SUCCESS) {
                 fprintf(stderr, "Error calling bases\n");
                 goto error;
             }
-            if (options.time) {
+            if (options->time) {
                 curr_clock = clock();
                 fprintf(stderr, "Bases called in %f sec. \n",
                     (float)(curr_clock - start_clock)/(float)CLOCKS_PER_SEC);
                 start_clock = curr_clock;
             }
         }
-        else if (options.recalln || options.recallndb || options.ladder ||
-                 options.het     || options.mix)
+        else if (options->recalln || options->recallndb || options->ladder ||
+                 options->het     || options->mix)
         {
-            if (options.recalln && (options.Verbose > 1)) {
+            if (options->recalln && (options->Verbose > 1)) {
                 fprintf(stderr, "Using original base calls with Ns recalled ");
                 fprintf(stderr, "to the best guess\n");
             }
-            else if (options.recallndb && (options.Verbose > 1)) {
+            else if (options->recallndb && (options->Verbose > 1)) {
                 fprintf(stderr,
                     "Using original base calls with Ns and dye blobs recalled ");
                 fprintf(stderr, "to the best guess\n");
             }
-             else if (options.ladder && (options.Verbose > 1)) {
+             else if (options->ladder && (options->Verbose > 1)) {
                 fprintf(stderr,
                     "Recalling all the bases to the best guess ");
                 fprintf(stderr, "at their original locations");
             }
 
-            if (options.ladder)
+            if (options->ladder)
             {
                preset_base_calls(&data, color2base, options, message);
             }
@@ -870,7 +886,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
                     data.bases.called_peak_list[i]->pos  = 1;
                 }
             }
-            if (options.time) {
+            if (options->time) {
                 curr_clock = clock();
                 fprintf(stderr, "Bases called in %f sec. \n",
                     (float)(curr_clock - start_clock)/(float)CLOCKS_PER_SEC);
@@ -879,7 +895,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
         }
 
         // Retain the original mixed bases (this will only be used by train)
-        if (options.het || options.mix)
+        if (options->het || options->mix)
         {
             for (i=0; i< *num_bases; i++)
             {
@@ -935,9 +951,9 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
             (*peak_locs)[i] = data.bases.called_peak_list[i]->ipos;
         }
 
-        if (!options.indel_detect && !options.indel_resolve) 
+        if (!options->indel_detect && !options->indel_resolve) 
         {
-            if (options.het || options.mix)
+            if (options->het || options->mix)
             {
                 Peak **dpl = data.peak_list;
                 Peak **cpl = data.bases.called_peak_list;
@@ -982,7 +998,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
                                 data_peak_ind, data_peak_ind2);
 
                             get_trace_parameters_of_mixed_base(i, data_peak_ind,
-                                data_peak_ind2, params, ratio, &options, &data, message);
+                                data_peak_ind2, params, ratio, options, &data, message);
 #if 0
                         fprintf(stderr, "i= %d params_mixed = %f %f %f %f \n", i, params[0][i], params[1][i], params[2][i], params[3][i]);
 #endif
@@ -999,7 +1015,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
                     if (is_mixed_base(data.bases.bases[i]))
                         continue;
 
-                    if (get_trace_parameters_of_pure_bases(i, &data, color2base, &options,
+                    if (get_trace_parameters_of_pure_bases(i, &data, color2base, options,
                         message) != SUCCESS) {
                             sprintf(message->text, "Error calling get_trace_parameters_of_pure_bases\n");
                             goto error;
@@ -1016,34 +1032,22 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
             }
             else
             {
-                for (i = 0; i < data.bases.length; i++)
-                {
-                    if (get_trace_parameters_of_pure_bases(i, &data, color2base, &options,
-                            message) != SUCCESS) {
-                        sprintf(message->text, "Error calling get_trace_parameters_of_pure_bases\n");
-                        goto error;
-                    }
-                    if (populate_params_array(i, &data, params) != SUCCESS) {
-                        sprintf(message->text, "Error calling populate_params_array\n");
-                        goto error;
-                    }
+                if (Btk_compute_tp(&data, color2base, params, read_info, ctable,
+                    options, message) != SUCCESS) {
+                    fprintf(stderr, "Error calling Btk_compute_tp\n");
+                    goto error;
                 }
             }
         }
         else
         {
             if (Btk_compute_tp(&data, color2base, params, read_info, ctable,
-                &options, message) != SUCCESS) {
+                options, message) != SUCCESS) {
                 fprintf(stderr, "Error calling Btk_compute_tp\n");
                 goto error;
             }
 
             quality_values = CALLOC(int, data.bases.length);
-            if (Btk_compute_tp(&data, color2base, params, read_info, ctable,
-                &options, message) != SUCCESS) {
-                fprintf(stderr, "Error calling Btk_compute_tp\n");
-                goto error;
-            }
 
             for (i=0; i<data.bases.length; i++)
             {
@@ -1051,7 +1055,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
                                 params[1][i], params[2][i],
                                 params[3][i], table);
             }
-            if (Btk_process_indels(options.file_name, num_datapoints, 
+            if (Btk_process_indels(options->file_name, num_datapoints, 
                 chromatogram, color2base, quality_values, &data, read_info, 
                 ctable, options, message) != SUCCESS)
                 goto error;
@@ -1067,15 +1071,15 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
         fprintf(stderr, "params_mixed_2 = %f %f %f %f \n", params[0][357], params[1][357], params[2][357], params[3][357]);
 #endif
         /* Output .poly file */
-        if (options.poly) {
-            if (Btk_output_poly_file(&data, &options, message) != SUCCESS)
+        if (options->poly) {
+            if (Btk_output_poly_file(&data, options, message) != SUCCESS)
             {
                 fprintf(stderr, "Error creating  poly file\n");
                 goto error;
             }
         }
 
-        if (options.time) {   
+        if (options->time) {   
             curr_clock = clock();
             fprintf(stderr, "Trace parameters computed in %f sec. \n",
                 (float)(curr_clock - start_clock)/(float)CLOCKS_PER_SEC);
@@ -1141,7 +1145,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
         fprintf(stderr, "params_mixed_last = %f %f %f %f \n", (*params0)[357], (*params1)[357], (*params2)[357], (*params3)[357]);
 #endif
 
-        if (options.tip_dir[0] != '\0') {
+        if (options->tip_dir[0] != '\0') {
             if (Btk_output_tip_file(&data, color2base, options)
                 != SUCCESS)
             {
@@ -1154,7 +1158,7 @@ Btk_compute_tpars(int *num_bases, char **bases, int **peak_locs,
         }
     }
     data_release(&data);
-    if (options.het || options.mix)
+    if (options->het || options->mix)
         FREE(orig_bases);
 
     return SUCCESS;
@@ -1164,7 +1168,7 @@ error:
     for (i = 0; i < NUM_PARAMS; i++) {
         FREE(params[i]);
     }
-    if (options.het || options.mix)
+    if (options->het || options->mix)
         FREE(orig_bases);
 
     return ERROR;
@@ -41,14 +41,14 @@ extern int  colordata_create(ColorData *, int, int, char *, BtkMessage *);
 extern int bases_create(TT_Bases *, int, BtkMessage *);
 extern int trace_parameters_create(TraceParameters *, int, BtkMessage *);
 extern int data_create(Data *, int, int, char *, BtkMessage *);
-extern int bases_populate(int *, char **, int, int **, Data *, Options *,
+extern int bases_populate(int *, char **, int, int **, Data *, const Options *,
     BtkMessage *);
 extern int colordata_populate(int, int **, char *, Data *, BtkMessage *);
 extern int data_populate(int *, char **, int,
-    int **, int, int **, char *, Data *, Options *, BtkMessage *);
+    int **, int, int **, char *, Data *, const Options *, BtkMessage *);
 extern void data_nelease(Data *);
 extern int bc_reorder_called_bases_and_peaks(Data *, BtkMessage *);
-extern void show_input_options(Options *);
+extern void show_input_options(const Options *);
 
 extern int 
 Btk_compute_tpars(
@@ -72,7 +72,7 @@ Btk_compute_tpars(
                          */
     BtkLookupTable *,   /* pointer to a lookup table */
     ContextTable * ,    /* pointer to a context table */ 
-    Options options,    /* structure including file_name, nocall, etc. */
+    const Options *options, /* structure including file_name, nocall, etc. */
     BtkMessage *,	/* error code and descriptive text */
     Results *           /* statistical results used by train (not ttuner) */
 );
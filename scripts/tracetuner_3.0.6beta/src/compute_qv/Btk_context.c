@@ -0,0 +1,234 @@
+/**************************************************************************
+ * This file is part of TraceTuner, the DNA sequencing quality value,
+ * base calling and trace processing software.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received (LICENSE.txt) a copy of the GNU General Public
+ * License along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *************************************************************************/
+
+/*
+ *  Btk_context.c
+ *
+ *  Reentrant entry points of the library: process traces held in memory,
+ *  keeping all per-trace state in a TTContext.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Btk_qv.h"
+#include "util.h"
+#include "Btk_lookup_table.h"
+#include "Btk_default_table.h"
+#include "Btk_qv_data.h"
+#include "train.h"
+#include "Btk_compute_qv.h"
+#include "Btk_match_data.h"
+#include "Btk_qv_io.h"
+#include "Btk_context.h"
+
+struct TTContext {
+    Options         options;      /* private copy of the configuration */
+    BtkLookupTable *table;
+    BtkMessage      message;
+    char            status_code[BTKMESSAGE_LENGTH];
+    Results         results;
+
+    /* Arrays of the last trace processed */
+    int             num_bases;
+    char           *bases;
+    int            *locations;
+    int            *quality_values;
+    int             num_datapoints;
+    int            *chromatogram[NUM_COLORS];
+    char           *call_method;
+    char           *chemistry;
+};
+
+/*******************************************************************************
+ * Function: context_release_trace
+ * Purpose:  free the arrays of the last trace processed in the context
+ *******************************************************************************
+ */
+static void
+context_release_trace(TTContext *ctx)
+{
+    Btk_release_file_data(ctx->bases, ctx->locations, ctx->quality_values,
+        ctx->chromatogram, &ctx->call_method, &ctx->chemistry);
+    ctx->bases          = NULL;
+    ctx->locations      = NULL;
+    ctx->quality_values = NULL;
+    ctx->num_bases      = 0;
+    ctx->num_datapoints = 0;
+}
+
+/*******************************************************************************
+ * Function: tt_context_create
+ * Purpose:  create a context for processing traces with the given options
+ *           and lookup table
+ * Comments: The table is not copied; it must outlive the context and may be
+ *           shared by several contexts, since processing only reads it.
+ *           If table is NULL, the built-in table of config->lut_type is
+ *           used (ABI 3730 Pop-7 if no type is set).
+ *           Returns NULL if there is not enough memory.
+ *******************************************************************************
+ */
+TTContext *
+tt_context_create(const Options *config, BtkLookupTable *table)
+{
+    TTContext *ctx = CALLOC(TTContext, 1);
+
+    if (ctx == NULL)
+        return NULL;
+
+    ctx->options = *config;
+    ctx->options.chemistry = NULL;
+    ctx->options.sf        = NULL;
+
+    if (table == NULL) {
+        switch (ctx->options.lut_type) {
+        case ABI3700pop5:
+            table = Btk_get_3700pop5_table();
+            break;
+        case ABI3700pop6:
+            table = Btk_get_3700pop6_table();
+            break;
+        case ABI3100:
+            table = Btk_get_3100pop6_table();
+            break;
+        case MegaBACE:
+            table = Btk_get_mbace_table();
+            break;
+        default:
+            table = Btk_get_3730pop7_table();
+            ctx->options.lut_type = ABI3730pop7;
+            break;
+        }
+    }
+    ctx->table = table;
+
+    return ctx;
+}
+
+/*******************************************************************************
+ * Function: tt_context_destroy
+ * Purpose:  free the context and the arrays of the last trace
+ *******************************************************************************
+ */
+void
+tt_context_destroy(TTContext *ctx)
+{
+    if (ctx == NULL)
+        return;
+
+    context_release_trace(ctx);
+    FREE(ctx);
+}
+
+/*******************************************************************************
+ * Function: tt_context_message
+ * Purpose:  return the description of the last error in the context
+ *******************************************************************************
+ */
+const char *
+tt_context_message(const TTContext *ctx)
+{
+    return ctx->message.text;
+}
+
+/*******************************************************************************
+ * Function: tt_process_buffer
+ * Purpose:  call bases and assign quality values to the trace whose ABI or
+ *           SCF sample file contents are in buffer
+ * Return:   SUCCESS or ERROR; on error tt_context_message() tells why
+ * Comments: The result points to arrays of the context, which are replaced
+ *           by the next call. Nothing is written to the file system.
+ *******************************************************************************
+ */
+int
+tt_process_buffer(TTContext *ctx, const void *buffer, long size,
+    TTResult *result)
+{
+    int         i;
+    BtkMessage *message = &ctx->message;
+    Options    *options = &ctx->options;
+
+    context_release_trace(ctx);
+    (void)memset(result, 0, sizeof(*result));
+    message->text[0]     = '\0';
+    ctx->status_code[0]  = '\0';
+
+    if (Btk_read_sample_buffer(buffer, size,
+        (options->file_name[0] != '\0') ? options->file_name : NULL,
+        &ctx->num_bases, &ctx->bases, options->edited_bases,
+        &ctx->locations, &ctx->quality_values, &ctx->num_datapoints,
+        &ctx->chromatogram[0], &ctx->chromatogram[1],
+        &ctx->chromatogram[2], &ctx->chromatogram[3],
+        &ctx->call_method, &ctx->chemistry, ctx->status_code,
+        options, message) != SUCCESS)
+    {
+        /* The reader frees what it has allocated on error */
+        ctx->bases          = NULL;
+        ctx->locations      = NULL;
+        ctx->quality_values = NULL;
+        for (i = 0; i < NUM_COLORS; i++)
+            ctx->chromatogram[i] = NULL;
+        ctx->call_method    = NULL;
+        return ERROR;
+    }
+    message->text[0] = '\0';  /* message may have been set with no error */
+
+    if ((ctx->num_bases <= 0) && !options->raw_data) {
+        sprintf(message->text, "Can't process - no base calls in trace.");
+        goto error;
+    }
+    if (ctx->num_datapoints <= 0) {
+        sprintf(message->text, "Can't process - no peak locations in trace.");
+        goto error;
+    }
+
+    if (!options->nocall || (ctx->quality_values == NULL))
+    {
+        if (!options->inp_phd && (ctx->quality_values == NULL)) {
+            ctx->quality_values = CALLOC(int, ctx->num_bases);
+            MEM_ERROR(ctx->quality_values);
+        }
+
+        if (Btk_compute_qv(&ctx->num_bases, &ctx->bases, &ctx->locations,
+            &ctx->num_datapoints, ctx->chromatogram, "ACGT", ctx->table,
+#if USE_CONTEXT_TABLE
+            NULL,
+#endif
+            &ctx->quality_values, options, message, &ctx->results) != SUCCESS)
+        {
+            goto error;
+        }
+    }
+
+    result->num_bases      = ctx->num_bases;
+    result->bases          = ctx->bases;
+    result->locations      = ctx->locations;
+    result->quality_values = ctx->quality_values;
+    result->num_datapoints = ctx->num_datapoints;
+    for (i = 0; i < NUM_COLORS; i++)
+        result->chromatogram[i] = ctx->chromatogram[i];
+    result->results        = &ctx->results;
+
+    return SUCCESS;
+
+error:
+    context_release_trace(ctx);
+    return ERROR;
+}
@@ -0,0 +1,63 @@
+/**************************************************************************
+ * This file is part of TraceTuner, the DNA sequencing quality value,
+ * base calling and trace processing software.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received (LICENSE.txt) a copy of the GNU General Public
+ * License along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *************************************************************************/
+
+/*
+ *  Btk_context.h
+ *
+ *  Library interface for applications that embed TraceTuner and hand it
+ *  traces from memory. A TTContext holds everything needed to process a
+ *  trace: a private copy of the options, the lookup table, the arrays of
+ *  the last trace processed and its statistics. Contexts share no mutable
+ *  state, so any number of threads may process traces at the same time
+ *  as long as each uses its own context.
+ *
+ *  Needs Btk_qv.h, Btk_qv_data.h, Btk_lookup_table.h and train.h.
+ */
+
+#ifndef BTK_CONTEXT_H_
+#define BTK_CONTEXT_H_
+
+typedef struct TTContext TTContext;
+
+/* Results of one trace. The arrays belong to the context and remain valid
+ * until the next call of tt_process_buffer() or tt_context_destroy()
+ */
+typedef struct {
+    int      num_bases;
+    char    *bases;                   /* called bases */
+    int     *locations;               /* peak locations of the called bases */
+    int     *quality_values;
+    int      num_datapoints;
+    int     *chromatogram[NUM_COLORS];  /* processed traces, A,C,G,T */
+    Results *results;                 /* statistics of the trace */
+} TTResult;
+
+extern TTContext *
+tt_context_create(const Options *, BtkLookupTable *);
+
+extern void
+tt_context_destroy(TTContext *);
+
+extern int
+tt_process_buffer(TTContext *, const void *, long, TTResult *);
+
+extern const char *
+tt_context_message(const TTContext *);
+
+#endif
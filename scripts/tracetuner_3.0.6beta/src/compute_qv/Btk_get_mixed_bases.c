@@ -74,8 +74,6 @@
 #define USE_BEST_BASE_POS  0
 #define WINDOW_7 7
 
-extern unsigned int max_colordata_value;
-
 /*******************************************************************************
  * Function: get_mixed_base_position
  * Purpose:  for mixed base, return the position of the peak with the "worst" 
@@ -85,7 +83,7 @@ extern unsigned int max_colordata_value;
  */
 int
 get_mixed_base_position(Data *data, int data_peak_ind, int data_peak_ind2,
-    Options *options, BtkMessage *message)
+    const Options *options, BtkMessage *message)
 {
     if (data_peak_ind == data_peak_ind2) {
         return data->peak_list[data_peak_ind]->ipos;
@@ -182,7 +180,7 @@ get_base(Data *data, int data_peak_ind, int data_peak_ind2, char *color2base)
 static int 
 store_alternative_base_call(Data *data, char *color2base, int base_index, 
     int qv, int data_peak_ind, int data_peak_ind2, int *curr_num2, 
-    int *max_num2, AltBase **altbases, Options *options, BtkMessage *message)
+    int *max_num2, AltBase **altbases, const Options *options, BtkMessage *message)
 {
     int temp_base_index;
 
@@ -339,7 +337,7 @@ get_average_called_peak_height(Data *data, int i)
  */
 static void
 get_constraints(int *MIN_QV, double *MAX_PHR3, double *MAX_PHR7, 
-    double *MAX_PSR7, double *MAX_PRES, Options *options)
+    double *MAX_PSR7, double *MAX_PRES, const Options *options)
 {
    *MIN_QV   = 10;
    *MAX_PHR3 = 4.5;
@@ -382,10 +380,10 @@ static int
 find_alternative_peaks(Data *data, int i, int *found_peak_ind,
     int *found_peak_is_called, int *num_peaks_found, 
     int *next_called_peak_found, int *prev_right_bound, double max_pres, 
-    double min_peak_height, Options *options, BtkMessage *message) 
+    double min_peak_height, const Options *options, BtkMessage *message) 
 {
     int        j, jc, k, pind, pos[3]; 
-    static int left_bound=0, right_bound=0;
+    int        left_bound=0, right_bound=0;
     double     iheight = data->bases.called_peak_list[i]->iheight,
                ave_spacing;
     Peak       peak;
@@ -499,11 +497,11 @@ find_alternative_peaks(Data *data, int i, int *found_peak_ind,
                 (i>0) &&
                 (i<data->bases.length-1) &&
                  ( can_insert_base(data, i-1, i+1, 1,
-                   spacing_curve(data->bases.called_peak_list[i]->ipos) *
+                   spacing_curve(data, data->bases.called_peak_list[i]->ipos) *
                    BASE_MERGE_FACTOR, -1., options) ||
                   ((i<data->bases.length-2) &&
                    can_insert_base(data, i, i+2, 1,
-                   spacing_curve(data->bases.called_peak_list[i+1]->ipos) *
+                   spacing_curve(data, data->bases.called_peak_list[i+1]->ipos) *
                    BASE_MERGE_FACTOR, -1., options))))
                 continue;
 
@@ -566,7 +564,7 @@ get_mixed_qv(int qv1, int qv2)
 int
 get_pure_base_quality(Data *data, int data_peak_ind, int data_peak_ind2,
     double frac, double min_uncalled, BtkLookupTable *table, ReadInfo *read_info, 
-    Options *options, BtkMessage *message)
+    const Options *options, BtkMessage *message)
 {
     double phr3, phr7, psr7, pres;
 
@@ -590,7 +588,7 @@ get_pure_base_quality(Data *data, int data_peak_ind, int data_peak_ind2,
 static int
 get_quality_of_alternative_call(int i, int j, int k, int *found_peak_ind, 
     int *found_peak_is_called, Data *data, BtkLookupTable *table, 
-    ReadInfo *read_info, Options *options, BtkMessage *message) 
+    ReadInfo *read_info, const Options *options, BtkMessage *message) 
 {
     int    qv = 0, qv1 =0, qv2 = 0;
     Peak **dpl = data->peak_list;
@@ -668,7 +666,7 @@ get_quality_of_alternative_call(int i, int j, int k, int *found_peak_ind,
  */
 static int
 set_best_base_call(int i, int dpi_best, int dpi2_best, int *data_peak_ind1, 
-    int *data_peak_ind2, char *color2base, Data *data, Options *options) 
+    int *data_peak_ind2, char *color2base, Data *data, const Options *options) 
 {
     char b1, b2, base;
     Peak **dpl = data->peak_list;
@@ -734,7 +732,7 @@ static int
 call_mixed_bases(Data *data, char *color2base, int *quality_values,
     int *max_num2, AltBase **altbases, int **data_peak_ind1, 
     int **data_peak_ind2, ReadInfo *read_info, BtkLookupTable *table, 
-    ContextTable *ctable, Options *options, BtkMessage *message)
+    ContextTable *ctable, const Options *options, BtkMessage *message)
 {
     char   base, base2,*context = NULL;
     int    i, j, k, n, pos, jbest, kbest, curr_num2, prev_right_bound=0;
@@ -1198,17 +1196,18 @@ int
 Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs, 
     int num_datapoints, int **chromatogram, char *color2base, 
     int **quality_values, ReadInfo *read_info, BtkLookupTable *table, 
-    ContextTable *ctable, Options options, BtkMessage *message, 
+    ContextTable *ctable, const Options *options, BtkMessage *message, 
     Results *results)
 {
-    int      i, num2, renorm;
+    int      i, num2;
+    Options  mixed_options;
     int     *data_peak_ind1=NULL, *data_peak_ind2=NULL; /* for .poly file */
-    AltBase *altbases;
+    AltBase *altbases = NULL;
     Data     data; 
     clock_t start_clock = clock(), curr_clock;
 
     if (SHOW_INPUT_OPTIONS)
-        show_input_options(&options);
+        show_input_options(options);
 
     if (data_create(&data, num_datapoints, *num_bases, color2base, message)
 	!= SUCCESS)
@@ -1217,23 +1216,23 @@ Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs,
         return ERROR;
     }
  
-    if (data_populate(num_bases, bases, options.edited_bases,
+    if (data_populate(num_bases, bases, options->edited_bases,
         peak_locs, num_datapoints, chromatogram, color2base, &data, 
-        &options, message) != SUCCESS)
+        options, message) != SUCCESS)
     {
         sprintf(message->text, "Error calling data_populate\n");
         fprintf(stderr, "Error calling  data_populate\n");
         goto error;
     }
 
-    if (options.time) {  
+    if (options->time) {  
         curr_clock = clock();
         fprintf(stderr, "Data structure populated in %f sec. \n",
             (float)(curr_clock - start_clock)/(float)CLOCKS_PER_SEC);
         start_clock = curr_clock;
     }
 
-    if (Btk_process_peaks(&data, &options, message) != SUCCESS) {
+    if (Btk_process_peaks(&data, options, message) != SUCCESS) {
         if (total_number_of_peaks(&data) >= 10) {
             sprintf(message->text, "Error calling Btk_process_peaks\n");
             fprintf(stderr, "Error calling Btk_process_peaks\n");
@@ -1241,7 +1240,7 @@ Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs,
         goto error;
     }
  
-    if (options.time) {
+    if (options->time) {
         curr_clock = clock();
         fprintf(stderr, "Peaks processed in %f sec. \n",
             (float)(curr_clock - start_clock)/(float)CLOCKS_PER_SEC);
@@ -1250,7 +1249,7 @@ Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs,
 
 #if INSERT_BASES
     if (Btk_call_bases(&data, color2base, read_info, ctable,
-        &options, message, results ) != SUCCESS) {
+        options, message, results ) != SUCCESS) {
         fprintf(stderr, "Error calling bases\n");
         goto error;
     }
@@ -1263,8 +1262,8 @@ Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs,
 #endif
 
     /* Output .poly file */
-    if (options.poly) {
-        if (Btk_output_poly_file(&data, &options, message) != SUCCESS)
+    if (options->poly) {
+        if (Btk_output_poly_file(&data, options, message) != SUCCESS)
         {
             fprintf(stderr, "Error creating  poly file\n");
             goto error;
@@ -1293,7 +1292,7 @@ Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs,
         }
     }
 
-    if (options.time) {  
+    if (options->time) {  
             curr_clock = clock();
             fprintf(stderr, "Bases called in %f sec. \n",
                 (float)(curr_clock - start_clock)/(float)CLOCKS_PER_SEC);
@@ -1307,25 +1306,23 @@ Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs,
    *quality_values = REALLOC(*quality_values, int, data.bases.length);
     MEM_ERROR(*quality_values);
 
-    if (options.het || options.mix)
+    if (options->het || options->mix)
     {
-        if (options.Verbose > 1) {
+        if (options->Verbose > 1) {
             fprintf(stderr, "Calling mixed bases; min_ratio==%.2f\n", 
-                options.min_ratio);
+                options->min_ratio);
         }
       
         /* Don't renormalize in call_mixed_bases */ 
-        renorm = options.renorm;
-        options.renorm = 0; 
+        mixed_options = *options;
+        mixed_options.renorm = 0; 
         if (call_mixed_bases(&data, color2base, *quality_values, 
             &num2, &altbases, &data_peak_ind1, &data_peak_ind2,
-            read_info, table, ctable, &options, message) != SUCCESS) 
+            read_info, table, ctable, &mixed_options, message) != SUCCESS) 
         {
             fprintf(stderr, "Error calling mixed bases\n");
             goto error;
         }
-         
-        options.renorm = renorm;
     }
     else {
         num2 = 0;
@@ -1349,11 +1346,11 @@ Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs,
             (*peak_locs)[i] = get_mixed_base_position(&data, 
             data.bases.called_peak_list[i]->data_peak_ind,
             data.bases.called_peak_list[i]->data_peak_ind2, 
-            &options, message);
+            options, message);
     }
 
 
-    if (options.time) {   
+    if (options->time) {   
         curr_clock = clock();
         fprintf(stderr, "Trace parameters computed in %f sec. \n",
             (float)(curr_clock - start_clock)/(float)CLOCKS_PER_SEC);
@@ -1410,7 +1407,7 @@ Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs,
         }
     }
 
-    if (options.tip_dir[0] != '\0') {
+    if (options->tip_dir[0] != '\0') {
         if (Btk_output_tip_file(&data, color2base, options)
             != SUCCESS)
         {
@@ -1419,7 +1416,7 @@ Btk_get_mixed_bases(int *num_bases, char **bases, int **peak_locs,
         }
     }
 
-    if (options.tab_dir[0] != '\0') {
+    if (options->tab_dir[0] != '\0') {
         /* Output alternative base calls */
         if (Btk_output_tab_file(num2, altbases, options) != SUCCESS)
         {
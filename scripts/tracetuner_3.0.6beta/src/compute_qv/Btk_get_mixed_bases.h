@@ -28,7 +28,7 @@
 #include "train.h"    // typedef Results
 #endif
 
-extern int get_mixed_base_position(Data *, int, int, Options *, BtkMessage *);
+extern int get_mixed_base_position(Data *, int, int, const Options *, BtkMessage *);
 extern int is_mixed_base(char);
 extern char mixed_base(char, char);
 extern double get_average_called_peak_height(Data *, int);
@@ -48,7 +48,7 @@ Btk_get_mixed_bases(
                          */
     BtkLookupTable *,   /* pointer to a lookup table */
     ContextTable * ,    /* pointer to a context table */ 
-    Options options,    /* structure including file_name, nocall, etc. */
+    const Options *options, /* structure including file_name, nocall, etc. */
     BtkMessage *,	/* error code and descriptive text */
     Results *           /* statistical results used by train (not ttuner) */
 );
@@ -26,7 +26,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifndef __WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
 #include "Btk_qv.h"
+#include "util.h"
 #include "Btk_lookup_table.h"
 #include "Btk_default_table.h"
 #include "Btk_atod.h"
@@ -35,6 +43,168 @@
 #define CHUNK	(1000)
 #define MAX_NUM_TPAR_THRESHOLDS	(100)
 
+/* Binary lookup table file: a header, then the threshold array at
+ * tpar_offset and the entry array at entries_offset, both laid out
+ * exactly as in memory, so that the file can be mapped and used in place.
+ * Files are written in the byte order of the machine that writes them.
+ */
+#define BINARY_LUT_MAGIC        "TTLUTBIN"
+#define BINARY_LUT_MAGIC_LEN    (8)
+#define BINARY_LUT_FORMAT       (1)
+#define BINARY_LUT_BYTE_ORDER   (0x01020304)
+#define BINARY_LUT_HEADER_SIZE  (64)
+
+typedef struct {
+    char magic[BINARY_LUT_MAGIC_LEN]; /* BINARY_LUT_MAGIC, not terminated */
+    int  format;                      /* BINARY_LUT_FORMAT */
+    int  byte_order;                  /* BINARY_LUT_BYTE_ORDER as written */
+    char tt_version[16];              /* TT_VERSION of the writer */
+    int  num_tpar_entries;
+    int  num_lut_entries;
+    int  tpar_offset;                 /* offsets from the start of file */
+    int  entries_offset;
+} BinaryLutHeader;
+
+/*******************************************************************************
+ * Function: check_binary_lookup_table
+ * Purpose:  make sure that the image of a binary lookup table file is
+ *           complete and was written by this version of TraceTuner on a
+ *           machine with the same byte order
+ *******************************************************************************
+ */
+static int
+check_binary_lookup_table(const char *path, const char *image, long size)
+{
+    BinaryLutHeader header;
+
+    if (size < BINARY_LUT_HEADER_SIZE) {
+        fprintf(stderr, "\nLookup table %s is truncated\n", path);
+        return ERROR;
+    }
+    (void)memcpy(&header, image, sizeof(header));
+
+    if ((header.format != BINARY_LUT_FORMAT) ||
+        (header.byte_order != BINARY_LUT_BYTE_ORDER))
+    {
+        fprintf(stderr,
+            "\nLookup table %s has an unknown format or byte order\n", path);
+        return ERROR;
+    }
+    if (strncmp(header.tt_version, TT_VERSION, 6) != 0) {
+        fprintf(stderr,
+            "\nLookup table version %.16s does not match the ttuner version %s\n",
+            header.tt_version, TT_VERSION);
+        return ERROR;
+    }
+    if ((header.num_tpar_entries < 1) || (header.num_lut_entries < 1) ||
+        (header.tpar_offset < BINARY_LUT_HEADER_SIZE) ||
+        (header.tpar_offset % sizeof(double) != 0) ||
+        (header.entries_offset < header.tpar_offset +
+            header.num_tpar_entries * (long)sizeof(TraceParamEntry)) ||
+        (size < header.entries_offset +
+            header.num_lut_entries * (long)sizeof(BtkLookupEntry)))
+    {
+        fprintf(stderr, "\nLookup table %s is corrupt or truncated\n", path);
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Function: read_binary_lookup_table
+ * Purpose:  load a binary lookup table file. The file is mapped read-only,
+ *           so that processes using the same table share one copy of it
+ *           and loading does not depend on the size of the table.
+ *******************************************************************************
+ */
+static BtkLookupTable *
+read_binary_lookup_table(const char *path)
+{
+    BtkLookupTable  *table;
+    BinaryLutHeader  header;
+    char            *image = NULL;
+    long             size;
+    int              i, n;
+#ifdef __WIN32
+    FILE            *fp;
+
+    if ((fp = fopen(path, "rb")) == NULL) {
+        return NULL;
+    }
+    (void)fseek(fp, 0L, SEEK_END);
+    size = ftell(fp);
+    rewind(fp);
+    if ((size <= 0) || ((image = (char *)malloc(size)) == NULL) ||
+        (fread(image, 1, size, fp) != (size_t)size))
+    {
+        (void)fclose(fp);
+        FREE(image);
+        return NULL;
+    }
+    (void)fclose(fp);
+#else
+    int              fd;
+    struct stat      statbuf;
+
+    if ((fd = open(path, O_RDONLY)) < 0) {
+        return NULL;
+    }
+    if ((fstat(fd, &statbuf) != 0) || (statbuf.st_size <= 0)) {
+        (void)close(fd);
+        return NULL;
+    }
+    size  = (long)statbuf.st_size;
+    image = (char *)mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (image == (char *)MAP_FAILED) {
+        return NULL;
+    }
+#endif
+
+    if (check_binary_lookup_table(path, image, size) != SUCCESS) {
+        goto error_return;
+    }
+    (void)memcpy(&header, image, sizeof(header));
+
+    if ((table = CALLOC(BtkLookupTable, 1)) == NULL) {
+        goto error_return;
+    }
+    table->num_tpar_entries = header.num_tpar_entries;
+    table->tpar             = (TraceParamEntry *)(image + header.tpar_offset);
+    table->num_lut_entries  = header.num_lut_entries;
+    table->entries          = (BtkLookupEntry *)(image + header.entries_offset);
+    table->image            = image;
+    table->image_size       = size;
+
+    /* Same checks of the entries as for a text table */
+    n = table->num_tpar_entries;
+    for (i = 0; i < table->num_lut_entries; i++) {
+        const BtkLookupEntry *e = &table->entries[i];
+
+        if ((e->qval < 0)
+            || (e->phr3i < 0) || (e->phr3i >= n)
+            || (e->phr7i < 0) || (e->phr7i >= n)
+            || (e->psr7i < 0) || (e->psr7i >= n)
+            || (e->presi < 0) || (e->presi >= n))
+        {
+            fprintf(stderr, "\nLookup table %s is corrupt\n", path);
+            table->image = NULL;
+            FREE(table);
+            goto error_return;
+        }
+    }
+
+    return table;
+
+error_return:
+#ifdef __WIN32
+    FREE(image);
+#else
+    (void)munmap(image, (size_t)size);
+#endif
+    return NULL;
+}
+
 // --------------------------------------------------------------------
 /*
  * This function reads in and parses a lookup table.  Its synopsis is:
@@ -47,6 +217,9 @@
  *	table	is a BtkLookupTable allocated and populated by this function
  *		on success, NULL otherwise.
  *
+ * The file may be either a text table, as written by lut, or a binary
+ * table, as written by Btk_write_binary_lookup_table().
+ *
  * If this function returns a table, then the caller should free up the
  * resources (when through with it) by calling Btk_destroy_lookup_table().
  */
@@ -64,6 +237,13 @@ Btk_read_lookup_table(char *path)
     if ((fp = fopen(path, "r")) == NULL) {
 	return(table);
     }
+    if ((fread(linebuf, 1, BINARY_LUT_MAGIC_LEN, fp) == BINARY_LUT_MAGIC_LEN)
+        && (memcmp(linebuf, BINARY_LUT_MAGIC, BINARY_LUT_MAGIC_LEN) == 0))
+    {
+        (void)fclose(fp);
+        return read_binary_lookup_table(path);
+    }
+    rewind(fp);
 
     table = CALLOC(BtkLookupTable, 1);
     size = CHUNK;
@@ -187,6 +367,60 @@ error_return:
 }
 
 
+/*
+ * This function writes a lookup table in the binary format understood by
+ * Btk_read_lookup_table().  Its synopsis is:
+ *
+ * result = Btk_write_binary_lookup_table(table, path)
+ *
+ * where
+ *	table	is the BtkLookupTable to write
+ *	path	is the name of the file to create
+ *
+ *	result	is SUCCESS, or ERROR if the table is empty, which
+ *		Btk_read_lookup_table() would reject, or the file can't be
+ *		written
+ */
+int
+Btk_write_binary_lookup_table(const BtkLookupTable *table, const char *path)
+{
+    FILE            *fp;
+    BinaryLutHeader  header;
+    char             pad[BINARY_LUT_HEADER_SIZE];
+
+    if ((table->num_tpar_entries < 1) || (table->num_lut_entries < 1)) {
+        return ERROR;
+    }
+
+    (void)memset(&header, 0, sizeof(header));
+    (void)memcpy(header.magic, BINARY_LUT_MAGIC, BINARY_LUT_MAGIC_LEN);
+    header.format           = BINARY_LUT_FORMAT;
+    header.byte_order       = BINARY_LUT_BYTE_ORDER;
+    (void)strncpy(header.tt_version, TT_VERSION, sizeof(header.tt_version));
+    header.num_tpar_entries = table->num_tpar_entries;
+    header.num_lut_entries  = table->num_lut_entries;
+    header.tpar_offset      = BINARY_LUT_HEADER_SIZE;
+    header.entries_offset   = header.tpar_offset +
+        table->num_tpar_entries * (int)sizeof(TraceParamEntry);
+    (void)memset(pad, 0, sizeof(pad));
+
+    if ((fp = fopen(path, "wb")) == NULL) {
+        return ERROR;
+    }
+    if ((fwrite(&header, sizeof(header), 1, fp) != 1) ||
+        (fwrite(pad, BINARY_LUT_HEADER_SIZE - sizeof(header), 1, fp) != 1) ||
+        (fwrite(table->tpar, sizeof(TraceParamEntry),
+             table->num_tpar_entries, fp) != (size_t)table->num_tpar_entries) ||
+        (fwrite(table->entries, sizeof(BtkLookupEntry),
+             table->num_lut_entries, fp) != (size_t)table->num_lut_entries))
+    {
+        (void)fclose(fp);
+        return ERROR;
+    }
+    return (fclose(fp) == 0) ? SUCCESS : ERROR;
+}
+
+
 /*
  * This function reclaims the storage taken up by a lookup table previously
  * returned by Btk_read_lookup_table().  Its synopsis is:
@@ -207,6 +441,16 @@ Btk_destroy_lookup_table(BtkLookupTable *table)
     if (table == Btk_get_3100pop6_table()) {  return;  }
     if (table == Btk_get_mbace_table())    {  return;  }
 
+    if (table->image != NULL) {
+#ifdef __WIN32
+        FREE(table->image);
+#else
+        (void)munmap(table->image, (size_t)table->image_size);
+#endif
+        FREE(table);
+        return;
+    }
+
     FREE(table->entries);
     FREE(table->tpar);
     FREE(table);
@@ -43,8 +43,13 @@ typedef struct _btk_quality_lookup_table {
     TraceParamEntry *tpar;
 	int              num_lut_entries;
 	BtkLookupEntry  *entries;
+    void            *image;       /* binary table file that tpar and entries
+                                   * point into, or NULL */
+    long             image_size;
 } BtkLookupTable;
 
 
 extern BtkLookupTable *Btk_read_lookup_table(char * /*path*/);
+extern int Btk_write_binary_lookup_table(const BtkLookupTable * /*table*/,
+    const char * /*path*/);
 extern void Btk_destroy_lookup_table(BtkLookupTable * /*table*/);
@@ -187,6 +187,12 @@ colordata_find_peak_index_by_location_idp(ColorData *color_data, int given_posit
         }
     }
 
+    if (colordata_find_peak_index_by_scan_index(color_data, given_position,
+        peak, peak_index))
+    {
+        return SUCCESS;
+    }
+
     lo = 0;
     hi = color_data->peak_list_len - 1;
     do {
@@ -216,7 +222,7 @@ colordata_find_peak_index_by_location_idp(ColorData *color_data, int given_posit
 static void
 get_highest_peaks(int base_ind, float *highest1_signal, float *highest2_signal, 
     int *pind1, int *pind2, int *color1, int *color2, int *pos1, int *pos2,
-    Data *data, Options *options)
+    Data *data, const Options *options)
 {
     int  i, peak_ind, loc, prev_loc, next_loc;
     float weight, min_weight, signal;
@@ -385,7 +391,7 @@ get_end_of_trace(Data *data)
  *******************************************************************************
  */
 static void
-get_autocorrelation(int pos_indel_scan, int *chromatogram, 
+get_autocorrelation(int pos_indel_scan, TT_Sample *chromatogram, 
     int num_datapoints, float *ans, int n)
 {
     int    i;
@@ -550,7 +556,7 @@ get_lag_scans(int indel_scan, int shift_scans, float *fdata, int len,
  *******************************************************************************
  */
 static void
-output_autocorrelation_functions(char *seq_name, float **ans, int n)
+output_autocorrelation_functions(const char *seq_name, float **ans, int n)
 {
     int color, i;
     FILE *fp;
@@ -637,7 +643,7 @@ count_identical_bases(int start, int end, int *c1, int *c2, float *h1,
  */
 static int
 get_autocorrelation_indel_size(int ind_loc, int shift_scans, int data_end_scan,
-    char *seq_name, Data *data, Options options)
+    const char *seq_name, Data *data, const Options *options)
 {
     int    i, j, color, best_color, n=1;
     int    lag_scans=0, best_lag_scans;
@@ -703,7 +709,7 @@ get_autocorrelation_indel_size(int ind_loc, int shift_scans, int data_end_scan,
 //           fprintf(stderr, "color=%d lag_scans=%d height_ratio=%f max_height_ratio=%f\n",
 //              i, lag_scans, height_ratio, max_height_ratio);
 
-            if (options.xgr)
+            if (options->xgr)
                 (void)output_autocorrelation_functions(seq_name, ans, n);
         }
     }
@@ -999,7 +1005,7 @@ get_ave10_height(int i, float *h)
  */
 static int   
 get_stretch_pure_peaks(int i, int *c1, int *c2, float *h1, float *h2, 
-    Data *data, Options options)
+    Data *data, const Options *options)
 {
     int   j;
     int   n = QVMIN(MIN_LEN_STRETCH_PURE_PEAKS, data->bases.length-i-1);
@@ -1007,7 +1013,7 @@ get_stretch_pure_peaks(int i, int *c1, int *c2, float *h1, float *h2,
  
     for (j=i; j < i+n; j++)
     {
-        if ((h2[j]/h1[j] > options.min_ratio) && 
+        if ((h2[j]/h1[j] > options->min_ratio) && 
             (h2[j]/ave10_height > H2_TO_AVE10_RATIO))
             return 0;      
     }
@@ -1131,9 +1137,9 @@ get_qv_jump(int base_ind, int *quality_values, int num_bases)
  *******************************************************************************
  */
 static void
-output_indels(char *seq_name, int *num_ident_bases, int *base_ind, int indcount, 
+output_indels(const char *seq_name, int *num_ident_bases, int *base_ind, int indcount, 
     int *indsize, int *indloc, char *bases, int num_bases, char *donor, 
-    char *amplicon, int *quality_values, Options options) 
+    char *amplicon, int *quality_values, const Options *options) 
 {
     int i, size;
     float qv_jump;
@@ -1154,7 +1160,7 @@ output_indels(char *seq_name, int *num_ident_bases, int *base_ind, int indcount,
                 fprintf(stdout,
                 "%s: stutter_base_ind= %d lag_scans= %d loc= %d string= ?\n",
                     seq_name, base_ind[i], indsize[i], indloc[i]);
-                if (options.Verbose != 1)
+                if (options->Verbose != 1)
                     fprintf(stderr,"    donor= %s amplicon= %s qv_jump= %f\n",
                         donor, amplicon, qv_jump);
             }
@@ -1173,7 +1179,7 @@ output_indels(char *seq_name, int *num_ident_bases, int *base_ind, int indcount,
                 "%s: indel_base_ind= %d lag_scans= %d loc= %d string= %s\n",
                     seq_name, base_ind[i], indsize[i], indloc[i], string);
                 FREE(string);
-                if (options.Verbose == 1)
+                if (options->Verbose == 1)
                     fprintf(stdout,"\n");
                 else
                     fprintf(stderr," donor= %s amplicon= %s qv_jump= %f\n", 
@@ -1183,7 +1189,7 @@ output_indels(char *seq_name, int *num_ident_bases, int *base_ind, int indcount,
     }
     else
     {
-        if (options.Verbose == 1) { }
+        if (options->Verbose == 1) { }
         else
             fprintf(stdout," donor= %s amplicon= %s qv_jump= %f\n", donor, amplicon,
                qv_jump);
@@ -1198,7 +1204,7 @@ output_indels(char *seq_name, int *num_ident_bases, int *base_ind, int indcount,
 static void
 detect_indels_from_chromatogram(int *indcount, int *num_ident_bases, 
     int **indloc, int **indbind, int **indsize, Data *data, int *quality_values, 
-    Options options)
+    const Options *options)
 {
     int    i, stretch_of_pure_peaks_found = 0; 
     float *h1, *h2, *h3;                                   /* peak heights */
@@ -1210,7 +1216,8 @@ detect_indels_from_chromatogram(int *indcount, int *num_ident_bases,
 
     float  qv_jump;
     int    data_end_scan = data->bases.coordinate[data->bases.length-1];
-    char  *seq_name;
+    const char *seq_name;
+    BtkMessage msg;
 
     /* Allocate */
     c1      = CALLOC(int,   data->bases.length);
@@ -1232,24 +1239,29 @@ detect_indels_from_chromatogram(int *indcount, int *num_ident_bases,
     for (i=0; i< MAX_NUM_INDELS; i++)
       (*indloc)[i]  = (*indbind)[i] = (*indsize)[i] = -1;
 
+    /* The peaks are not edited in this loop, so locate them by scan */
+    for (i=0; i<NUM_COLORS; i++)
+        (void)colordata_build_scan_index(&data->color_data[i], &msg);
+
     for (i=0; i< data->bases.length; i++)
     {
         c1[i] = c2[i] = pi1[i] = pi2[i] = -1;
         h1[i] = h2[i] = 0.;
 
         get_highest_peaks(i, &h1[i], &h2[i], &pi1[i], &pi2[i],
-            &c1[i], &c2[i], &pos1[i], &pos2[i], data, &options);
+            &c1[i], &c2[i], &pos1[i], &pos2[i], data, options);
 #if 0
         fprintf(stderr, "i= %d c1=%d c2=%d \n", i, c1[i], c2[i]);
 #endif
     }
+    data_release_scan_index(data);
 
     
-    if ((seq_name = strrchr(options.file_name, '/')) != NULL) {
+    if ((seq_name = strrchr(options->file_name, '/')) != NULL) {
         seq_name++;
     }
     else {
-        seq_name = options.file_name;
+        seq_name = options->file_name;
     }
 
     data->length = get_end_of_trace(data);
@@ -1306,7 +1318,7 @@ detect_indels_from_chromatogram(int *indcount, int *num_ident_bases,
    
             num_ident_bases[*indcount] = count_identical_bases(i,
                 QVMAX(i - MIN_LEN_SEARCH_STUTTER - 2, 0),
-                c1, c2, h1, h2, data->bases.bases, options.min_ratio);
+                c1, c2, h1, h2, data->bases.bases, options->min_ratio);
 
             /* Indel */
             if ((num_ident_bases[*indcount] < MIN_LEN_STUTTER) || 
@@ -1315,7 +1327,7 @@ detect_indels_from_chromatogram(int *indcount, int *num_ident_bases,
                 /* Use autocorrelation curve to determine the indel size */
                 (*indloc)[*indcount]  = loc;
                 (*indsize)[*indcount] = get_autocorrelation_indel_size(loc, shift,
-                        data_end_scan, options.file_name, data, options);
+                        data_end_scan, options->file_name, data, options);
                 if ((*indsize)[*indcount] <= 0)
                     (*indsize)[*indcount] = shift*12;
                 (*indbind)[*indcount] = i;
@@ -1355,7 +1367,7 @@ detect_indels_from_chromatogram(int *indcount, int *num_ident_bases,
  *******************************************************************************
  */
 static void
-get_intrinsic_signal(int h, float B, int *y, int *num_points, Options *options)
+get_intrinsic_signal(int h, float B, int *y, int *num_points, const Options *options)
 {
     int i;
     for (i=0; i<MAX_WIDTH_OF_PEAK; i++)
@@ -1466,7 +1478,7 @@ get_frac(int loc, int locm, int locp, ColorData *cd)
 static int 
 produce_new_chromatogram(CHROMAT_TYPE type, int indsize_scans, int indbind,
     char *color2base, int **new_chromatogram, Data *data, 
-    char *called_seq, Options options)
+    char *called_seq, const Options *options)
 {
     int   i, *y, num_points=0;
     int   color1, color2, pind1, pind2, pos1, pos2;
@@ -1493,7 +1505,7 @@ produce_new_chromatogram(CHROMAT_TYPE type, int indsize_scans, int indbind,
         color2 = -1;
         get_highest_peaks(i, &highest1_signal, &highest2_signal,
             &pind1, &pind2, &color1, &color2, &pos1, &pos2, data,
-            &options);
+            options);
 
         if (highest2_signal/highest1_signal < INDEL_RATIO)
             color2 = -1;
@@ -1531,7 +1543,7 @@ produce_new_chromatogram(CHROMAT_TYPE type, int indsize_scans, int indbind,
             pos1 = peak->pos;
         }
         nearest_h = (right_pind >= 0) ? peak->height : right_height;
-        get_intrinsic_signal(nearest_h, nearest_B, y, &num_points, &options);
+        get_intrinsic_signal(nearest_h, nearest_B, y, &num_points, options);
         if (add_intrinsic_signal(pos1, y, num_points,
             1.0, new_chromatogram[right_color], cd->length) != SUCCESS)
             return ERROR;
@@ -1549,7 +1561,7 @@ produce_new_chromatogram(CHROMAT_TYPE type, int indsize_scans, int indbind,
             pos2 = peak->pos;
         }
         nearest_h = (other_pind >= 0) ? peak->height : other_height; 
-        get_intrinsic_signal(nearest_h, nearest_B, y, &num_points, &options);
+        get_intrinsic_signal(nearest_h, nearest_B, y, &num_points, options);
         if (subtract_intrinsic_signal(pos2, y, num_points, 
             1.0, new_chromatogram[other_color], cd->length) != SUCCESS)
             return ERROR;     
@@ -1570,7 +1582,7 @@ produce_new_chromatogram(CHROMAT_TYPE type, int indsize_scans, int indbind,
 
         get_highest_peaks(i, &highest1_signal, &highest2_signal,
             &pind1, &pind2, &color1, &color2, &pos1, &pos2, data,
-            &options);
+            options);
 
         if (highest2_signal/highest1_signal < INDEL_RATIO)
             color2 = -1;
@@ -1606,7 +1618,7 @@ produce_new_chromatogram(CHROMAT_TYPE type, int indsize_scans, int indbind,
             if (frac < 1. - get_frac(loc1-3, loc1m-3, loc1p-3, cd))
                 frac = 1. - get_frac(loc1-3, loc1m-3, loc1p-3, cd);
         }
-        get_intrinsic_signal(nearest_h, nearest_B, y, &num_points, &options);
+        get_intrinsic_signal(nearest_h, nearest_B, y, &num_points, options);
         (void)subtract_intrinsic_signal(loc1, y, num_points,
                 1.0, new_chromatogram[color1], cd->length);
         (void)add_intrinsic_signal(loc1, y, num_points,
@@ -1644,7 +1656,7 @@ produce_new_chromatogram(CHROMAT_TYPE type, int indsize_scans, int indbind,
             if (frac < 1. - get_frac(loc2-3, loc2m-3, loc2p-3, cd))
                 frac = 1. - get_frac(loc2-3, loc2m-3, loc2p-3, cd);
         }
-        get_intrinsic_signal(nearest_h, nearest_B, y, &num_points, &options);
+        get_intrinsic_signal(nearest_h, nearest_B, y, &num_points, options);
         (void)subtract_intrinsic_signal(loc2, y, num_points,
                 1.0, new_chromatogram[color2], cd->length);
         (void)add_intrinsic_signal(loc2, y, num_points,
@@ -1991,7 +2003,7 @@ compare_long_and_short_reads(int m, int len, int *color1,
 static int
 call_long_and_short_sequences(int ibind, int isize, char *color2base,
     char *long_called_seq, char *short_called_seq,
-    Data *data, Options options)
+    Data *data, const Options *options)
 {
     int    i, len;
     int    indsize_bases = (isize+3)/12.;
@@ -2035,7 +2047,7 @@ call_long_and_short_sequences(int ibind, int isize, char *color2base,
         called_color_short[i] = -1;
         get_highest_peaks(i, &(highest1_signal[i]), &(highest2_signal[i]),
             &(pind1[i]), &(pind2[i]), &(color1[i]), &(color2[i]),
-            &(pos1[i]), &(pos2[i]), data, &options);
+            &(pos1[i]), &(pos2[i]), data, options);
 
         if (highest2_signal[i]/highest1_signal[i] < INDEL_RATIO)
             color2[i] = -1;
@@ -2281,9 +2293,9 @@ get_base_index_by_position(int given_position, int *coordinate, int len)
  *******************************************************************************
  */
 int
-Btk_process_indels(char *path, int *num_datapoints, int **chromatogram, 
+Btk_process_indels(const char *path, int *num_datapoints, int **chromatogram, 
     char *color2base, int *quality_values, Data *data, 
-    ReadInfo *read_info, ContextTable *ctable, Options options, 
+    ReadInfo *read_info, ContextTable *ctable, const Options *options, 
     BtkMessage *msg)
 {
     int     i, indcount = 0;
@@ -2291,7 +2303,7 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
     int    *num_ident_bases = NULL;
     double *params[NUM_PARAMS] = {NULL, NULL, NULL, NULL};
     char   *prefix_name = NULL, *scf_file_name = NULL;
-    char   *seq_name = NULL; 
+    const char *seq_name = NULL; 
     char   *long_called_seq  = NULL, 
            *short_called_seq = NULL; 
     char    amplicon_name[MAXPATHLEN], donor_name[MAXPATHLEN];
@@ -2306,14 +2318,14 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
 
     num_ident_bases[0] = 1;
 
-    if ((seq_name = strrchr(options.file_name, '/')) != NULL) {
+    if ((seq_name = strrchr(options->file_name, '/')) != NULL) {
         seq_name++;
     }
     else {
-        seq_name = options.file_name;
+        seq_name = options->file_name;
     }
 
-    if (options.Verbose > 1)
+    if (options->Verbose > 1)
     {
         /* Need this because subsequent processing will spoil the path */
         strcpy(path1, path);
@@ -2363,7 +2375,7 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
 //  call_mixed_bases(color2base, data, options);
 
     /* 2. Detect indel location and size */
-    if ((options.indloc < 0) && (options.indsize <= 0))
+    if ((options->indloc < 0) && (options->indsize <= 0))
     {
         (void)detect_indels_from_chromatogram(&indcount, num_ident_bases,
             &indloc, &indbind, &indsize_scans, data, quality_values,
@@ -2371,23 +2383,23 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
 
 //      fprintf(stderr, "Indloc = %d\n", indloc[0]);
     }
-    else if ((options.indloc < 0) && (options.indsize > 0))
+    else if ((options->indloc < 0) && (options->indsize > 0))
     {
         (void)detect_indels_from_chromatogram(&indcount, num_ident_bases,
             &indloc, &indbind, &indsize_scans, data, quality_values,
             options);
         
         indsize_scans[0] =
-            get_autocorrelation_indel_size(indloc[0]+6, options.indsize,
-            data->length, options.file_name, data, options);
+            get_autocorrelation_indel_size(indloc[0]+6, options->indsize,
+            data->length, options->file_name, data, options);
 
     }
-    else if ((options.indloc >= 0) && (options.indsize <= 0))
+    else if ((options->indloc >= 0) && (options->indsize <= 0))
     {
-        indloc[0] = options.indloc;
+        indloc[0] = options->indloc;
         indsize_scans[0] =
             get_autocorrelation_indel_size(indloc[0]+6, -1,
-            data->length, options.file_name, data, options);
+            data->length, options->file_name, data, options);
 
         indbind[0] = get_base_index_by_position(indloc[0]+6, 
             data->bases.coordinate, data->bases.length);
@@ -2398,10 +2410,10 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
     else
     {
         indcount++; 
-        indloc[0]        = options.indloc;
+        indloc[0]        = options->indloc;
         indsize_scans[0] = 
-            get_autocorrelation_indel_size(indloc[0]+6, options.indsize,
-            data->length, options.file_name, data, options);
+            get_autocorrelation_indel_size(indloc[0]+6, options->indsize,
+            data->length, options->file_name, data, options);
 
         indbind[0] = get_base_index_by_position(indloc[0]+6, 
             data->bases.coordinate, data->bases.length);
@@ -2411,7 +2423,7 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
 #endif
 
 //  fprintf(stderr, "options.indsize=%d indcount=%d indsize_scans = %d num_ident_bases = %d indbind=%d \n", 
-//      options.indsize, indcount, indsize_scans[0], num_ident_bases[0], indbind[0]);
+//      options->indsize, indcount, indsize_scans[0], num_ident_bases[0], indbind[0]);
 
     /* 3. Output detected indel location and size */
     if (indcount == 0)
@@ -2454,7 +2466,7 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
     fprintf(stderr, "Indbind = %d\n", indbind);
 #endif
     
-    if (options.indel_resolve)
+    if (options->indel_resolve)
     {
         int   prefix_len, indsize_bases = ROUND((float)indsize_scans[0]/12.);
         char *suffix = NULL;
@@ -2465,15 +2477,15 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
         prefix_name   = CALLOC(char, MAXPATHLEN);
         scf_file_name = CALLOC(char, MAXPATHLEN);
 
-        if ((suffix = strchr(options.file_name, '.')) != NULL)
+        if ((suffix = strchr(options->file_name, '.')) != NULL)
             suffix++;
-        prefix_len = strlen(options.file_name) - strlen(suffix);
-        strncpy(prefix_name, options.file_name, prefix_len-1);
+        prefix_len = strlen(options->file_name) - strlen(suffix);
+        strncpy(prefix_name, options->file_name, prefix_len-1);
         prefix_name[prefix_len] = '\0';
 
 #if 0
         fprintf(stderr, "File_name=%s Prefix=%s Suffix = %s\n", 
-            options.file_name, prefix_name, suffix);
+            options->file_name, prefix_name, suffix);
 #endif
         if ((strncmp(suffix, "_long" , 5)  == 0) ||
             (strncmp(suffix, "_short", 6) == 0))
@@ -2605,12 +2617,12 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
 
         /* Output the results */
         sprintf(scf_file_name, "%s_long", prefix_name);
-        if (output_scf_file(scf_file_name, options.scf_dir,
+        if (output_scf_file(scf_file_name, options->scf_dir,
             long_called_seq, long_locs,
             quality_values, long_bases_len, long_data_len,
             long_chromatogram[0], long_chromatogram[1],
             long_chromatogram[2], long_chromatogram[3],
-            color2base, options.chemistry) == ERROR)
+            color2base, options->chemistry) == ERROR)
         {
             fprintf(stderr, "Error producing long SCF file\n");
             goto error;
@@ -2618,31 +2630,31 @@ Btk_process_indels(char *path, int *num_datapoints, int **chromatogram,
 
         prefix_name[prefix_len-1] = '\0';
         sprintf(scf_file_name, "%s_short", prefix_name);
-        if (output_scf_file(scf_file_name, options.scf_dir,
+        if (output_scf_file(scf_file_name, options->scf_dir,
             short_called_seq, data->bases.coordinate,
             quality_values, data->bases.length - indsize_bases, 
             data->length - indsize_scans[0],
             short_chromatogram[0], short_chromatogram[1],      
             short_chromatogram[2], short_chromatogram[3],      
-            color2base, options.chemistry) == ERROR)
+            color2base, options->chemistry) == ERROR)
         {
             fprintf(stderr, "Error producing short SCF file\n");
             goto error;
         }
 
-        if (options.xgr)
+        if (options->xgr)
         {
+            int zero_shift[NUM_COLORS] = {0, 0, 0, 0};
+
             output_chromatogram("1_Deconvolved_data_long.xgr",
             "Long deconvolved chromatogram",
             long_chromatogram[0], long_chromatogram[1],
             long_chromatogram[2], long_chromatogram[3],        
             long_data_len, data);
 
-            output_chromatogram("1_Deconvolved_data_short.xgr",
+            output_colordata("1_Deconvolved_data_short.xgr",
             "Short deconvolved chromatogram",
-            data->color_data[0].data, data->color_data[1].data,
-            data->color_data[2].data, data->color_data[3].data,
-            data->length, data);
+            0, data->length, zero_shift, -1, data);
        
             /* Output sum of separated chromatograms */ 
             for (color=0; color<NUM_COLORS; color++)
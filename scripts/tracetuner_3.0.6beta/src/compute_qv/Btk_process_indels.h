@@ -26,6 +26,6 @@
  */
 
 extern int 
-Btk_process_indels(char *path, int *, int **, char *, int *qvs,
-    Data *, ReadInfo *, ContextTable *, Options , BtkMessage *);
+Btk_process_indels(const char *path, int *, int **, char *, int *qvs,
+    Data *, ReadInfo *, ContextTable *, const Options *, BtkMessage *);
 
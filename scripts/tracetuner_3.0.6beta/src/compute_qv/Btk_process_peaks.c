@@ -47,6 +47,7 @@
 /* ONE_PLUS & ONE_MINUS to avoid difference between platforms !!! */ 
 
 #define AVE_HEIGHT_FACTOR              (0.75*ONE_PLUS)
+#define CHECK_PEAK_WIDTHS               0 /* compare cached and computed */
 #define DEFAULT_ABI_SPACING            12.
 #define DEFAULT_RATIO                   0.95
 #define DEFAULT_WIDTH2                  8.0
@@ -73,6 +74,7 @@
 #define SHOW_MULTIPLE_RESOLUTION        0
 #define SHOW_PEAK_MULTIPLICITY          0
 #define SHOW_PEAK_CHARACTERISTICS       0
+#define SHAPE_CHUNK                    64  /* points per ShapeArray call */
 #define SHOW_SPLITTING                  0 
 #define SHOW_REDEFINE_CASE              0
 #define SPLIT_BIAS                      0.000001 
@@ -207,7 +209,7 @@ test_broken_peak_lists( FILE *fp, const Data *data, BtkMessage *message )
  *******************************************************************************
  */ 
 double 
-get_peak_area(int *data, int peak_beg, int peak_end, 
+get_peak_area(TT_Sample *data, int peak_beg, int peak_end, 
                 BtkMessage *message) 
 { 
     int i, area;
@@ -282,7 +284,7 @@ get_peak_area_double(double *data, int peak_beg, int peak_end,
  ****************************************************************************** 
  */ 
 int  
-get_peak_position(int *data, int peak_beg, int peak_end, 
+get_peak_position(TT_Sample *data, int peak_beg, int peak_end, 
 			    double peak_area, BtkMessage *message) 
 { 
     int j; 
@@ -330,7 +332,7 @@ get_peak_position(int *data, int peak_beg, int peak_end,
  ******************************************************************************
  */
 int
-get_peak_max(int *data, int peak_beg, int peak_end, BtkMessage *message)
+get_peak_max(TT_Sample *data, int peak_beg, int peak_end, BtkMessage *message)
 {
     int j, max=-1, signal=-1;
 
@@ -343,6 +345,260 @@ get_peak_max(int *data, int peak_beg, int peak_end, BtkMessage *message)
     return max;
 }
 
+/*******************************************************************************
+ * Function: colordata_build_signal_index
+ * Purpose:  build the signal index of a given color: the prefix sums of 
+ *           its data, which give the area of any range of scans in constant 
+ *           time, and a sparse table of range maxima, where signal_max[k*len+i]
+ *           is the position of the first maximum of data[i .. i+2^k-1]. 
+ *           The table is limited to SIGNAL_MAX_LEVELS rows, which covers the
+ *           widths of peaks; longer ranges are covered block by block. 
+ *           The index is built only if no data point is negative, in which 
+ *           case the queries below return the same values as the scans of 
+ *           the data. It must be released whenever the data are rewritten
+ *******************************************************************************
+ */
+int
+colordata_build_signal_index(ColorData *cd, BtkMessage *message)
+{
+    int  i, k, len = cd->length, levels;
+    int *prev, *curr;
+
+    colordata_release_signal_index(cd);
+
+    if (len < 2 || cd->data == NULL)
+        return SUCCESS;
+
+    for (i = 0; i < len; i++) {
+        if (cd->data[i] < 0) {
+            cd->signal_index_len = -1;
+            return SUCCESS;
+        }
+    }
+
+    levels = 1;
+    while ((levels < SIGNAL_MAX_LEVELS) && ((1 << levels) <= len))
+        levels++;
+
+    cd->signal_sum = CALLOC(double, len + 1);
+    MEM_ERROR(cd->signal_sum);
+    cd->signal_max = CALLOC(int, levels * len);
+    MEM_ERROR(cd->signal_max);
+
+    cd->signal_sum[0] = 0.;
+    for (i = 0; i < len; i++) {
+        cd->signal_sum[i+1] = cd->signal_sum[i] + cd->data[i];
+        cd->signal_max[i] = i;
+    }
+    for (k = 1; k < levels; k++) {
+        prev = &cd->signal_max[(k-1) * len];
+        curr = &cd->signal_max[k * len];
+        for (i = 0; i + (1 << k) <= len; i++) {
+            int a = prev[i], b = prev[i + (1 << (k-1))];
+            curr[i] = (cd->data[b] > cd->data[a]) ? b : a;
+        }
+    }
+    cd->signal_max_levels = levels;
+    cd->signal_index_len  = len;
+
+    return SUCCESS;
+
+error:
+    colordata_release_signal_index(cd);
+    return ERROR;
+}
+
+/*******************************************************************************
+ * Function: colordata_release_signal_index
+ *******************************************************************************
+ */
+void
+colordata_release_signal_index(ColorData *cd)
+{
+    FREE(cd->signal_sum);
+    FREE(cd->signal_max);
+    cd->signal_max_levels = 0;
+    cd->signal_index_len  = 0;
+}
+
+/*******************************************************************************
+ * Function: data_release_signal_index
+ *******************************************************************************
+ */
+void
+data_release_signal_index(Data *data)
+{
+    int j;
+
+    for (j = 0; j < NUM_COLORS; j++)
+        colordata_release_signal_index(&data->color_data[j]);
+}
+
+/*******************************************************************************
+ * Function: signal_index_ready
+ * Purpose:  build the signal index of a given color if needed; return 1 if 
+ *           it can answer queries ending at scan peak_end, 0 otherwise
+ *******************************************************************************
+ */
+static int
+signal_index_ready(ColorData *cd, int peak_end)
+{
+    if (cd->signal_sum == NULL) {
+        BtkMessage msg;
+
+        /* The data contain negative values; don't retry until released */
+        if (cd->signal_index_len < 0)
+            return 0;
+        if (colordata_build_signal_index(cd, &msg) != SUCCESS ||
+            cd->signal_sum == NULL)
+        {
+            cd->signal_index_len = -1;
+            return 0;
+        }
+    }
+    return (peak_end < cd->signal_index_len);
+}
+
+/*******************************************************************************
+ * Function: signal_index_area
+ * Purpose:  the area of data[beg .. end] as defined by get_peak_area
+ *******************************************************************************
+ */
+static double
+signal_index_area(ColorData *cd, int beg, int end)
+{
+    return (TWO * (cd->signal_sum[end+1] - cd->signal_sum[beg]) 
+            - cd->data[beg] - cd->data[end]) / TWO;
+}
+
+/*******************************************************************************
+ * Function: colordata_peak_area
+ * Purpose:  get_peak_area of the data of a given color, using its signal 
+ *           index
+ *******************************************************************************
+ */
+double
+colordata_peak_area(ColorData *cd, int peak_beg, int peak_end, 
+    BtkMessage *message)
+{
+    if ((peak_beg < 0) || (peak_end < peak_beg) || 
+        !signal_index_ready(cd, peak_end))
+    {
+        return get_peak_area(cd->data, peak_beg, peak_end, message);
+    }
+
+    return signal_index_area(cd, peak_beg, peak_end);
+}
+
+/*******************************************************************************
+ * Function: colordata_peak_position
+ * Purpose:  get_peak_position of the data of a given color, using its signal
+ *           index. Since the data are not negative, the area accumulated from
+ *           peak_beg grows with the scan, so the two scans at which the loop
+ *           of get_peak_position may stop are found by binary search
+ *******************************************************************************
+ */
+int
+colordata_peak_position(ColorData *cd, int peak_beg, int peak_end, 
+    double peak_area, BtkMessage *message)
+{
+    int    lo, hi, mid, j_eq, j_above;
+    double area, old_area;
+
+    if ((peak_end - peak_beg <= 2) || (peak_beg < 0) || !(peak_area > 0.) ||
+        !signal_index_ready(cd, peak_end))
+    {
+        return get_peak_position(cd->data, peak_beg, peak_end, peak_area, 
+            message);
+    }
+
+    /* First scan at which the area is not below peak_area/2 */
+    lo = peak_beg + 1;
+    hi = peak_end + 1;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (peak_area/TWO - signal_index_area(cd, peak_beg, mid) 
+            < 16.0*DBL_EPSILON)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    j_eq = lo;
+
+    if (j_eq <= peak_end &&
+        DBL_EQ_DBL(signal_index_area(cd, peak_beg, j_eq), peak_area/TWO)) 
+    {
+        return j_eq;
+    }
+
+    /* First scan at which the area exceeds half of peak_area */
+    lo = j_eq;
+    hi = peak_end + 1;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (signal_index_area(cd, peak_beg, mid) > ONE_PLUS * peak_area / 2.0)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    j_above = lo;
+
+    if (j_above <= peak_end) {
+        area     = signal_index_area(cd, peak_beg, j_above);
+        old_area = signal_index_area(cd, peak_beg, j_above - 1);
+        if ((area - peak_area / 2.0) < 
+            ONE_PLUS * (peak_area / 2.0 - old_area)) { 
+            return (j_above);
+        } 
+        else { 
+            return (j_above - 1); 
+        } 
+    }
+
+    (void)sprintf(message->text, 
+        "couldn't determine position of peak @ %d-%d", peak_beg, peak_end); 
+    return ERROR; 
+}
+
+/*******************************************************************************
+ * Function: colordata_peak_max
+ * Purpose:  get_peak_max of the data of a given color, using its signal
+ *           index
+ *******************************************************************************
+ */
+int
+colordata_peak_max(ColorData *cd, int peak_beg, int peak_end, 
+    BtkMessage *message)
+{
+    int j, k = 0, a, b, len;
+
+    if ((peak_beg < 0) || (peak_end < peak_beg) || 
+        !signal_index_ready(cd, peak_end))
+    {
+        return get_peak_max(cd->data, peak_beg, peak_end, message);
+    }
+
+    len = cd->signal_index_len;
+    while ((k + 1 < cd->signal_max_levels) && 
+           ((2 << k) <= peak_end - peak_beg + 1))
+    {
+        k++;
+    }
+    a = cd->signal_max[k * len + peak_beg];
+
+    /* Ranges longer than two rows of the table are covered block by block */
+    for (j = peak_beg + (1 << k); j + (1 << k) - 1 < peak_end; 
+         j += (1 << k))
+    {
+        b = cd->signal_max[k * len + j];
+        if (cd->data[b] > cd->data[a])
+            a = b;
+    }
+    b = cd->signal_max[k * len + peak_end - (1 << k) + 1];
+
+    return (cd->data[b] > cd->data[a]) ? b : a;
+}
+
 #if 1 
 
 /*******************************************************************************
@@ -428,7 +684,7 @@ get_default_peak(ColorData *cd, Peak *peak)
  *******************************************************************************
  */
 static int
-is_minimum(int n, int *data, int length)
+is_minimum(int n, TT_Sample *data, int length)
 {
     if ((n < 1) || (n > length-2)) 
         return 0;
@@ -507,17 +763,71 @@ is_dp(Peak *pk, int *shift, Data *data)
     return is_dp;
 }
 
+/* Classes of scans, as computed by colordata_classify_scans */
+#define SCAN_D2_NEG     1       /* second derivative is negative */
+#define SCAN_D2_POS     2       /* second derivative is positive */
+#define SCAN_MINIMUM    4       /* is_minimum() is true */
+#define SCAN_NONPOS     8       /* signal is <= 0 */
+#define SCAN_FLAT_TOP  16       /* signal is truncated and flat for 3 scans */
+
+/*******************************************************************************
+ * Function: colordata_classify_scans
+ * Purpose: compute in one pass the sign of the second derivative, the local 
+ *          minima and the truncation of the signal at each scan of a given 
+ *          color, which are all that the peak detection needs to know of
+ *          a scan besides its signal. The interior scans are classified 
+ *          without branches, so that the loop can be vectorized 
+ *******************************************************************************
+ */ 
+static void
+colordata_classify_scans(ColorData *cd, unsigned char *scan_class)
+{
+    int i, len = cd->length, d2;
+    TT_Sample *d = cd->data;
+
+    for (i = 0; i < len; i++) {
+        scan_class[i] = 0;
+    }
+    for (i = 1; i < len-1; i++) {
+        d2 = d[i-1] - 2*d[i] + d[i+1];
+        scan_class[i] = (unsigned char)(
+              ((d2 < 0)    ? SCAN_D2_NEG : 0)
+            | ((d2 > 0)    ? SCAN_D2_POS : 0)
+            | ((d[i] <= 0) ? SCAN_NONPOS : 0));
+    }
+    for (i = 2; i < len-2; i++) {
+        scan_class[i] |= (unsigned char)(
+              ((((d[i] < d[i-1]) & (d[i] < d[i+1])) |
+                ((d[i] <= d[i-1]) & (d[i-1] < d[i-2]) & 
+                 (d[i] <= d[i+1]) & (d[i+1] < d[i+2]))) ? SCAN_MINIMUM : 0)
+            | (((d[i] >= TRUNCATED_HEIGHT) & (d[i] == d[i-1]) & 
+                (d[i-1] == d[i-2])) ? SCAN_FLAT_TOP : 0));
+    }
+    for (i = 1; i < len-1 && i < 2; i++) {
+        if (is_minimum(i, d, len)) 
+            scan_class[i] |= SCAN_MINIMUM;
+    }
+    for (i = QVMAX(2, len-2); i < len-1; i++) {
+        if (is_minimum(i, d, len)) 
+            scan_class[i] |= SCAN_MINIMUM;
+        if ((d[i] >= TRUNCATED_HEIGHT) && (d[i] == d[i-1]) && 
+            (d[i-1] == d[i-2]))
+            scan_class[i] |= SCAN_FLAT_TOP;
+    }
+}
+
 /*******************************************************************************
  * Function: colordata_detect_peaks
  * Purpose: Create a list of peaks of a given color 
  *******************************************************************************
  */ 
 static int 
-colordata_detect_peaks(Data *data, int color, Options *options, 
+colordata_detect_peaks(Data *data, int color, const Options *options, 
     BtkMessage *message) 
 { 
     ColorData *cd; 
     int i, j, k, l, derivative_2, endscan; 
+    unsigned char *scan_class = NULL;
     Peak peak = initialize_peak(), temp_peak = initialize_peak(); 
     double ave_peak_area=0., start_avg_peak_area, prev_peak_area; 
     double avg_peak_width=0., start_avg_peak_width, sum_peak_area, 
@@ -581,7 +891,7 @@ colordata_detect_peaks(Data *data, int color, Options *options,
                  !temp_peak.is_truncated) 
             { 
                 start_avg_peak_width += (temp_peak.iend-temp_peak.ibeg); 
-                start_avg_peak_area += get_peak_area(cd->data,temp_peak.ibeg, 
+                start_avg_peak_area += colordata_peak_area(cd,temp_peak.ibeg, 
                                                       temp_peak.iend,message); 
                 j += 1; 
             } 
@@ -609,46 +919,48 @@ colordata_detect_peaks(Data *data, int color, Options *options,
      * between the two points 
      ************************************************************************
      */ 
+    scan_class = CALLOC(unsigned char, cd->length > 0 ? cd->length : 1);
+    MEM_ERROR(scan_class);
+    colordata_classify_scans(cd, scan_class);
+
     peak.ibeg = -1;
     for (i = data->pos_data_beg + 1; i < data->pos_data_end - 2; i++) {
-        derivative_2 = cd->data[i-1] - 2*cd->data[i] + cd->data[i+1]; 
  
         /* Peak begins */ 
-        if ((cd->peak_list_len < MAX_NUM_OF_PEAK-1) &&
-            (derivative_2 < 0) && (peak.ibeg < 0)) { 
+        if (peak.ibeg < 0) {
+            if ((cd->peak_list_len >= MAX_NUM_OF_PEAK-1) ||
+                !(scan_class[i] & SCAN_D2_NEG)) 
+            {
+                continue;
+            }
             peak.ibeg = peak.max = i; 
         } 
  
-        if ((peak.ibeg >= 0) && (i > peak.ibeg + 1) &&
-            (cd->data[i  ] >= TRUNCATED_HEIGHT) &&
-            (cd->data[i  ] == cd->data[i-1]) &&
-            (cd->data[i-1] == cd->data[i-2]))
+        if ((i > peak.ibeg + 1) && (scan_class[i] & SCAN_FLAT_TOP))
         {
             peak.is_truncated = 1;
             if (options->Verbose >= 5)
                fprintf(stderr, "Truncated peak detected at scan %d\n", i); 
         }
  
-        if ((peak.ibeg >= 0) && (cd->data[peak.max] < cd->data[i])) {
+        if (cd->data[peak.max] < cd->data[i]) {
             peak.max = i; 
         } 
 
         /* Peak ends */ 
-        if ((peak.ibeg >= 0) &&
-               (((derivative_2 > 0) && 
-               INT_GT_DBL(i-peak.ibeg, MIN_PEAK_WIDTH_FACTOR*avg_peak_width)) ||
-               is_minimum(i, cd->data, cd->length) ||
-               (cd->data[i] <=0))
-            )
+        if ((scan_class[i] & (SCAN_MINIMUM | SCAN_NONPOS)) ||
+            ((scan_class[i] & SCAN_D2_POS) && 
+             INT_GT_DBL(i-peak.ibeg, MIN_PEAK_WIDTH_FACTOR*avg_peak_width)))
         { 
             peak.iend = i; 
             /* Determine the peak's position between peak.ibeg and peak.iend */ 
-            peak.area = get_peak_area(cd->data, peak.ibeg, peak.iend, message); 
-            peak.pos = get_peak_position(cd->data, peak.ibeg, peak.iend, 
+            peak.area = colordata_peak_area(cd, peak.ibeg, peak.iend, message); 
+            peak.pos = colordata_peak_position(cd, peak.ibeg, peak.iend, 
                 peak.area, message); 
             peak.ipos = peak.pos; 
             if (peak.pos == ERROR) { 
                 sprintf(message->text, "Error in get_peak_position\n"); 
+                FREE(scan_class);
                 return ERROR; 
             } 
  
@@ -772,9 +1084,11 @@ colordata_detect_peaks(Data *data, int color, Options *options,
 #if SHOW_NUM_SPLIT_PEAKS 
     fprintf(stderr, "Number of splitted peaks=%d\n", num_splitted); 
 #endif 
+    FREE(scan_class);
     return SUCCESS; 
  
 error: 
+    FREE(scan_class);
     return ERROR; 
 } 
  
@@ -802,22 +1116,78 @@ output_peak_list(Data *data, BtkMessage *message)
     fclose(fp);
 } 
  
+/*******************************************************************************
+ * Per-color stages
+ * Each task below only touches the ColorData of its own color and writes its
+ * errors to its own copy of the message, so the 4 colors can be processed
+ * concurrently (see run_tasks() and options->color_threads). 
+ *******************************************************************************
+ */
+typedef struct {
+    Data          *data;
+    const Options *options;
+    int            first_color;  /* first color with a nonempty peak list */
+    int            status[NUM_COLORS];
+    BtkMessage     message[NUM_COLORS];
+} ColorStage;
+
+static void
+color_stage_init(ColorStage *cs, Data *data, const Options *options, 
+    BtkMessage *message)
+{
+    int color;
+
+    cs->data = data;
+    cs->options = options;
+    cs->first_color = 0;
+    for (color = 0; color < NUM_COLORS; color++) {
+        cs->status[color] = SUCCESS;
+        cs->message[color] = *message;
+    }
+}
+
+/* Report the error of the lowest failed color, as a serial loop would */
+static int
+color_stage_finish(ColorStage *cs, int r, BtkMessage *message)
+{
+    int color;
+
+    if (r == SUCCESS)
+        return SUCCESS;
+    for (color = 0; color < NUM_COLORS; color++) {
+        if (cs->status[color] == ERROR) {
+            *message = cs->message[color];
+            break;
+        }
+    }
+    return ERROR;
+}
+
+static int
+detect_peaks_task(int color, void *arg)
+{
+    ColorStage *cs = (ColorStage *)arg;
+
+    cs->status[color] = colordata_detect_peaks(cs->data, color, cs->options,
+        &cs->message[color]);
+    return cs->status[color];
+}
+
 /*******************************************************************************
  * Function: data_detect_peaks 
  * Purpose: for each of 4 colordata arrays, create a list of "observed" peaks 
  *******************************************************************************
  */ 
 int 
-data_detect_peaks(Data *data, Options *options, BtkMessage *message) 
+data_detect_peaks(Data *data, const Options *options, BtkMessage *message) 
 { 
     int r; 
-    int color; 
+    ColorStage cs;
  
-    for (color = 0; color < NUM_COLORS; color++) { 
-        if ((r = colordata_detect_peaks(data, color, options, message)) == ERROR) 
-    { 
-            return ERROR; 
-        }
+    color_stage_init(&cs, data, options, message);
+    r = run_tasks(detect_peaks_task, NUM_COLORS, &cs, options->color_threads);
+    if (color_stage_finish(&cs, r, message) == ERROR) {
+        return ERROR;
     } 
  
     if (OUTPUT_DETECTED_PEAK_LIST) {
@@ -857,7 +1227,7 @@ is_true_peak(Peak peak)
  *******************************************************************************
  */ 
 static double 
-get_left_half_width1(int *data, int peak_beg, int peak_end, int peak_pos, 
+get_left_half_width1(TT_Sample *data, int peak_beg, int peak_end, int peak_pos, 
     int peak_height, BtkMessage *message) 
 { 
     int    l; 
@@ -909,7 +1279,7 @@ get_left_half_width1(int *data, int peak_beg, int peak_end, int peak_pos,
  */ 
  
 static double 
-get_right_half_width1(int *data, int peak_beg, int peak_end, int peak_pos,  
+get_right_half_width1(TT_Sample *data, int peak_beg, int peak_end, int peak_pos,  
     int peak_height, BtkMessage *message) 
 { 
     int    r; 
@@ -1011,11 +1381,13 @@ get_peak_width1(ColorData *cd, int peak_index, BtkMessage *message)
  *******************************************************************************
  */ 
 static double 
-get_left_half_width2(int *data, int peak_beg, int peak_end, int peak_pos, 
+get_left_half_width2(ColorData *cd, int peak_beg, int peak_end, int peak_pos, 
     int peak_height, BtkMessage *message) 
 { 
+    TT_Sample *data = cd->data;
+
     if (peak_end - peak_beg < 4) { 
-        return get_peak_area(data, peak_beg, peak_end, message) 
+        return colordata_peak_area(cd, peak_beg, peak_end, message) 
             /2./(double)data[peak_pos]; 
     } 
  
@@ -1028,7 +1400,7 @@ get_left_half_width2(int *data, int peak_beg, int peak_end, int peak_pos,
           data[peak_pos], peak_pos); 
        return ERROR; 
     } 
-    return get_peak_area(data, peak_beg, peak_pos, message)/data[peak_pos]; 
+    return colordata_peak_area(cd, peak_beg, peak_pos, message)/data[peak_pos]; 
 } 
  
 /*******************************************************************************
@@ -1037,11 +1409,13 @@ get_left_half_width2(int *data, int peak_beg, int peak_end, int peak_pos,
  *******************************************************************************
  */ 
 static double 
-get_right_half_width2(int *data, int peak_beg, int peak_end, int peak_pos, 
+get_right_half_width2(ColorData *cd, int peak_beg, int peak_end, int peak_pos, 
     int peak_height, BtkMessage *message) 
 { 
+    TT_Sample *data = cd->data;
+
     if (peak_end - peak_beg < 4) { 
-        return get_peak_area(data, peak_beg, peak_end, message)/2. 
+        return colordata_peak_area(cd, peak_beg, peak_end, message)/2. 
             /data[peak_pos]; 
     } 
     if ((peak_end - peak_pos == 1) || (peak_end - peak_pos == 0)) { 
@@ -1052,7 +1426,7 @@ get_right_half_width2(int *data, int peak_beg, int peak_end, int peak_pos,
           data[peak_pos], peak_pos); 
        return ERROR; 
     } 
-    return get_peak_area(data, peak_pos, peak_end, message)/ 
+    return colordata_peak_area(cd, peak_pos, peak_end, message)/ 
         (double)data[peak_pos]; 
 } 
  
@@ -1077,7 +1451,7 @@ get_peak_width2(ColorData *cd, int peak_index, BtkMessage *message)
     if ((cd->peak_list[peak_index].type != 12) && 
         (cd->peak_list[peak_index].type != 21)) 
     { 
-        if ((left_half_width2 = get_left_half_width2(cd->data,  
+        if ((left_half_width2 = get_left_half_width2(cd,  
              cd->peak_list[peak_index].beg, 
              cd->peak_list[peak_index].end, cd->peak_list[peak_index].pos, 
              cd->peak_list[peak_index].height, message)) < 0) { 
@@ -1090,7 +1464,7 @@ get_peak_width2(ColorData *cd, int peak_index, BtkMessage *message)
                 cd->data[cd->peak_list[peak_index].pos]); 
             return ERROR; 
         } 
-        if ((right_half_width2 = get_right_half_width2(cd->data,  
+        if ((right_half_width2 = get_right_half_width2(cd,  
              cd->peak_list[peak_index].beg, 
              cd->peak_list[peak_index].end, cd->peak_list[peak_index].pos, 
              cd->peak_list[peak_index].height, message)) <= 0) { 
@@ -1102,7 +1476,7 @@ get_peak_width2(ColorData *cd, int peak_index, BtkMessage *message)
         width2 = left_half_width2 + left_half_width2; 
     } 
     else if (cd->peak_list[peak_index].type == 12) { 
-        if ((left_half_width2 = get_left_half_width2(cd->data, 
+        if ((left_half_width2 = get_left_half_width2(cd, 
              cd->peak_list[peak_index].beg, 
              cd->peak_list[peak_index].end, cd->peak_list[peak_index].pos, 
              cd->peak_list[peak_index].height, message)) <= 0) { 
@@ -1114,7 +1488,7 @@ get_peak_width2(ColorData *cd, int peak_index, BtkMessage *message)
         width2 = 2.* left_half_width2; 
     } 
     else if (cd->peak_list[peak_index].type == 21) { 
-        if ((right_half_width2 = get_right_half_width2(cd->data, 
+        if ((right_half_width2 = get_right_half_width2(cd, 
              cd->peak_list[peak_index].beg, 
              cd->peak_list[peak_index].end, cd->peak_list[peak_index].pos, 
              cd->peak_list[peak_index].height, message)) <= 0) { 
@@ -1129,15 +1503,101 @@ get_peak_width2(ColorData *cd, int peak_index, BtkMessage *message)
 } 
  
 /*******************************************************************************
- * Function: get_average_width2 
- * Purpose: compute the average width2 among num_upstream+num_downstream 
+ * The widths and the dominance of the peaks of the data peak list, which
+ * are computed on the first use and reused by the averages of all the 
+ * peaks whose windows contain the peak
+ *******************************************************************************
+ */
+typedef struct {
+    double width[2];            /* width1 and width2 of the peak */
+    char   has_width[2];        /* 1 if width[w_ind-1] has been computed */
+    char   is_dp;               /* is_dp() of the peak, or -1 if not known */
+} PeakWidths;
+
+/*******************************************************************************
+ * Function: peak_widths_create
+ * Purpose:  allocate the width cache for the data peak list
+ *******************************************************************************
+ */
+static PeakWidths *
+peak_widths_create(Data *data, BtkMessage *message)
+{
+    int i;
+    PeakWidths *pw;
+
+    pw = CALLOC(PeakWidths, data->peak_list_len > 0 ? data->peak_list_len : 1);
+    MEM_ERROR(pw);
+    for (i = 0; i < data->peak_list_len; i++)
+        pw[i].is_dp = -1;
+
+    return pw;
+
+error:
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function: peak_is_dp
+ * Purpose:  return is_dp() of the i-th peak of the data peak list, taking 
+ *           it from the cache if there is one
+ *******************************************************************************
+ */
+static int
+peak_is_dp(int i, PeakWidths *pw, int *shift, Data *data)
+{
+    if (pw == NULL)
+        return is_dp(data->peak_list[i], shift, data);
+
+    if (pw[i].is_dp < 0)
+        pw[i].is_dp = (char)is_dp(data->peak_list[i], shift, data);
+    else if (CHECK_PEAK_WIDTHS)
+        assert(pw[i].is_dp == is_dp(data->peak_list[i], shift, data));
+
+    return pw[i].is_dp;
+}
+
+/*******************************************************************************
+ * Function: peak_width
+ * Purpose:  return width1 or width2 of the i-th peak of the data peak list, 
+ *           taking it from the cache if there is one
+ *******************************************************************************
+ */
+static double
+peak_width(int w_ind, int i, PeakWidths *pw, Data *data, BtkMessage *message)
+{
+    Peak      *pk = data->peak_list[i];
+    ColorData *cd = &data->color_data[pk->color_index];
+
+    if ((pw != NULL) && pw[i].has_width[w_ind-1]) {
+        if (CHECK_PEAK_WIDTHS)
+            assert(pw[i].width[w_ind-1] == ((w_ind == 1) ?
+                get_peak_width1(cd, pk->cd_peak_ind, message) :
+                get_peak_width2(cd, pk->cd_peak_ind, message)));
+        return pw[i].width[w_ind-1];
+    }
+
+    if (pw == NULL)
+        return (w_ind == 1) ? get_peak_width1(cd, pk->cd_peak_ind, message) :
+                              get_peak_width2(cd, pk->cd_peak_ind, message);
+
+    pw[i].width[w_ind-1] = (w_ind == 1) ?
+        get_peak_width1(cd, pk->cd_peak_ind, message) :
+        get_peak_width2(cd, pk->cd_peak_ind, message);
+    pw[i].has_width[w_ind-1] = 1;
+
+    return pw[i].width[w_ind-1];
+}
+
+/*******************************************************************************
+ * Function: average_width 
+ * Purpose: compute the average width among num_upstream+num_downstream 
  *          non-truncated peaks of types 11, 12 and 21 upstream and downstream 
- *          from the current peak 
+ *          from the current peak, using the width cache pw if not NULL
  *******************************************************************************
  */ 
-double 
-get_average_width(int w_ind, int peak_index, int num_upstream, 
-    int num_downstream, double *stderr_width, 
+static double 
+average_width(int w_ind, int peak_index, int num_upstream, 
+    int num_downstream, double *stderr_width, PeakWidths *pw,
     Data *data, BtkMessage *message) 
 { 
     int    i, j, cd_peak_ind; 
@@ -1187,7 +1647,7 @@ get_average_width(int w_ind, int peak_index, int num_upstream,
         while (i >0 && j < num_downstream) { 
             cd = &(data->color_data[data->peak_list[i]->color_index]); 
 
-            if (!is_dp(data->peak_list[i], shift, data))
+            if (!peak_is_dp(i, pw, shift, data))
             {
                 i--;
                 continue;
@@ -1196,10 +1656,7 @@ get_average_width(int w_ind, int peak_index, int num_upstream,
             if (!data->peak_list[i]->is_truncated && 
                 (data->peak_list[i]->type == 11)) 
             { 
-                cd_peak_ind = data->peak_list[i]->cd_peak_ind; 
-                width = (w_ind == 1) ?
-                    get_peak_width1(cd, cd_peak_ind, message) :
-                    get_peak_width2(cd, cd_peak_ind, message); 
+                width = peak_width(w_ind, i, pw, data, message); 
                 sum  += width; 
                 sum2 += width * width;
                 if (width > max_width) max_width = width; 
@@ -1212,7 +1669,7 @@ get_average_width(int w_ind, int peak_index, int num_upstream,
         while (i<data->peak_list_len-1 && j < num_upstream+num_downstream) { 
             cd = &(data->color_data[data->peak_list[i]->color_index]); 
 
-            if (!is_dp(data->peak_list[i], shift, data))
+            if (!peak_is_dp(i, pw, shift, data))
             {
                 i++;
                 continue;
@@ -1230,10 +1687,7 @@ get_average_width(int w_ind, int peak_index, int num_upstream,
                  * AVE_HEIGHT_FACTOR))
             )) 
             { 
-                cd_peak_ind = data->peak_list[i]->cd_peak_ind; 
-                width = (w_ind == 1) ?
-                        get_peak_width1(cd, cd_peak_ind, message) :
-                        get_peak_width2(cd, cd_peak_ind, message); 
+                width = peak_width(w_ind, i, pw, data, message); 
                 sum  += width; 
                 sum2 += width * width;
                 if (width > max_width) max_width = width; 
@@ -1279,6 +1733,22 @@ get_average_width(int w_ind, int peak_index, int num_upstream,
     } 
 } 
 
+/*******************************************************************************
+ * Function: get_average_width 
+ * Purpose: compute the average width1 (w_ind=1) or width2 (w_ind=2) among 
+ *          num_upstream+num_downstream non-truncated peaks of types 11, 12 
+ *          and 21 upstream and downstream from the current peak 
+ *******************************************************************************
+ */ 
+double 
+get_average_width(int w_ind, int peak_index, int num_upstream, 
+    int num_downstream, double *stderr_width, 
+    Data *data, BtkMessage *message) 
+{ 
+    return average_width(w_ind, peak_index, num_upstream, num_downstream,
+        stderr_width, NULL, data, message);
+}
+
 /*******************************************************************************
  * Function: get_abi_base_index_by_position
  * Purpose:  given a position in chromatogram, determine the base index
@@ -1368,7 +1838,7 @@ get_average_abi_spacing(int position, Data *data, BtkMessage *message)
  */
 static int
 is_first_poorly_resolved_peak_sub( const Peak pk[], int peak_list_len,
-                                   const int data_array[], BtkMessage *message)
+                                   const TT_Sample data_array[], BtkMessage *message)
 {
     int        beg = pk->beg,
                end = pk->end,
@@ -1416,7 +1886,7 @@ is_first_poorly_resolved_peak(const Data *data, int jc, int peak_cd_ind,
 {
     const ColorData *cd = &(data->color_data[jc]);
     const Peak* pk = &(cd->peak_list[peak_cd_ind]);
-    int* data_array = cd->data;
+    TT_Sample* data_array = cd->data;
     return is_first_poorly_resolved_peak_sub( pk, cd->peak_list_len, 
                                               data_array, message );
 }
@@ -1427,7 +1897,7 @@ is_first_poorly_resolved_peak(const Data *data, int jc, int peak_cd_ind,
  */
 static int
 is_last_poorly_resolved_peak_sub( const Peak pk[], int peak_list_len, 
-                                  const int data_array[], BtkMessage *message )
+                                  const TT_Sample data_array[], BtkMessage *message )
 
 {
     int        end = pk->end,
@@ -1457,7 +1927,7 @@ is_last_poorly_resolved_peak( const Data *data, int jc, int peak_cd_ind,
 {
     const ColorData *cd = &(data->color_data[jc]);
     const Peak* pk = &(cd->peak_list[peak_cd_ind]);
-    int* data_array = cd->data;
+    TT_Sample* data_array = cd->data;
     return is_last_poorly_resolved_peak_sub( pk, cd->peak_list_len,
                                              data_array, message );
 }
@@ -1599,13 +2069,13 @@ colordata_expand_peaks(ColorData *cd, BtkMessage *message)
             cd->peak_list[i-1].type = 1 + 10*cd->peak_list[i-1].type; 
             cd->peak_list[i  ].type = 1; 
             cd->peak_list[i-1].area =  
-                get_peak_area(cd->data, cd->peak_list[i-1].beg,  
+                colordata_peak_area(cd, cd->peak_list[i-1].beg,  
                               cd->peak_list[i-1].end, message); 
             cd->peak_list[i-1].pos =  
-                get_peak_position(cd->data, cd->peak_list[i-1].beg, 
+                colordata_peak_position(cd, cd->peak_list[i-1].beg, 
                     cd->peak_list[i-1].end, cd->peak_list[i-1].area, message); 
             cd->peak_list[i-1].max =
-                get_peak_max(cd->data, cd->peak_list[i-1].beg,
+                colordata_peak_max(cd, cd->peak_list[i-1].beg,
                                   cd->peak_list[i-1].end, message);
             if (cd->peak_list[i-1].pos == ERROR) { 
                 return ERROR; 
@@ -1679,13 +2149,13 @@ colordata_expand_peaks(ColorData *cd, BtkMessage *message)
                 cd->peak_list[i-1].type = 1 + 10*cd->peak_list[i-1].type; 
                 cd->peak_list[i  ].type = 1; 
                 cd->peak_list[i-1].area =  
-                    get_peak_area(cd->data, cd->peak_list[i-1].beg,  
+                    colordata_peak_area(cd, cd->peak_list[i-1].beg,  
                                             cd->peak_list[i-1].end, message); 
-                cd->peak_list[i-1].pos = get_peak_position(cd->data,  
+                cd->peak_list[i-1].pos = colordata_peak_position(cd,  
                     cd->peak_list[i-1].beg, cd->peak_list[i-1].end, 
                     cd->peak_list[i-1].area, message); 
                 cd->peak_list[i-1].max =
-                    get_peak_max(cd->data, cd->peak_list[i-1].beg,
+                    colordata_peak_max(cd, cd->peak_list[i-1].beg,
                                   cd->peak_list[i-1].end, message);
                 if (cd->peak_list[i-1].pos == ERROR) { 
                     return ERROR; 
@@ -1755,13 +2225,13 @@ colordata_expand_peaks(ColorData *cd, BtkMessage *message)
                 cd->peak_list[i-1].type = 2 + 10*cd->peak_list[i-1].type; 
                 cd->peak_list[i  ].type = 2; 
                 cd->peak_list[i-1].area =  
-                    get_peak_area(cd->data, cd->peak_list[i-1].beg,  
+                    colordata_peak_area(cd, cd->peak_list[i-1].beg,  
                                             cd->peak_list[i-1].end, message); 
                 cd->peak_list[i-1].pos =  
-                    get_peak_position(cd->data, cd->peak_list[i-1].beg, 
+                    colordata_peak_position(cd, cd->peak_list[i-1].beg, 
                     cd->peak_list[i-1].end, cd->peak_list[i-1].area, message); 
                 cd->peak_list[i-1].max =
-                    get_peak_max(cd->data, cd->peak_list[i-1].beg,
+                    colordata_peak_max(cd, cd->peak_list[i-1].beg,
                     cd->peak_list[i-1].end, message);
                 if (cd->peak_list[i-1].pos == ERROR) { 
                     return ERROR; 
@@ -1819,13 +2289,13 @@ colordata_expand_peaks(ColorData *cd, BtkMessage *message)
                 cd->peak_list[i-1].end = midpoint; 
                 cd->peak_list[i  ].beg = midpoint; 
                 cd->peak_list[i-1].area = 
-                    get_peak_area(cd->data, cd->peak_list[i-1].beg,  
+                    colordata_peak_area(cd, cd->peak_list[i-1].beg,  
                                             cd->peak_list[i-1].end, message);  
                 cd->peak_list[i-1].pos =  
-                    get_peak_position(cd->data, cd->peak_list[i-1].beg, 
+                    colordata_peak_position(cd, cd->peak_list[i-1].beg, 
                     cd->peak_list[i-1].end, cd->peak_list[i-1].area, message); 
                 cd->peak_list[i-1].max =
-                    get_peak_max(cd->data, cd->peak_list[i-1].beg,
+                    colordata_peak_max(cd, cd->peak_list[i-1].beg,
                     cd->peak_list[i-1].end, message);
                 cd->peak_list[i-1].height = cd->data[cd->peak_list[i-1].pos]; 
                 cd->peak_list[i-1].iheight = (double)cd->peak_list[i-1].height; 
@@ -1883,12 +2353,12 @@ colordata_expand_peaks(ColorData *cd, BtkMessage *message)
      * resolving multiple peaks  
      */ 
     cd->peak_list[i].type = 1 + 10*cd->peak_list[i].type; 
-    cd->peak_list[i].area = get_peak_area(cd->data, cd->peak_list[i].beg,  
+    cd->peak_list[i].area = colordata_peak_area(cd, cd->peak_list[i].beg,  
         cd->peak_list[i].end, message); 
-    cd->peak_list[i].pos = get_peak_position(cd->data, cd->peak_list[i].beg,  
+    cd->peak_list[i].pos = colordata_peak_position(cd, cd->peak_list[i].beg,  
         cd->peak_list[i].end, cd->peak_list[i].area, message); 
     cd->peak_list[i].max =
-        get_peak_max(cd->data, cd->peak_list[i].beg,
+        colordata_peak_max(cd, cd->peak_list[i].beg,
         cd->peak_list[i].end, message);
     if (cd->peak_list[i].pos == ERROR) { 
         return ERROR; 
@@ -2094,10 +2564,10 @@ populate_group_of_peaks( Data *data, int color, int indx, int n,
         }
 
         /* -1 ==> don't care */
-        pk->area= get_peak_area(cd->data, pk->beg, pk->end, message);
-        pk->pos = get_peak_position(cd->data, pk->beg, pk->end, pk->area,
+        pk->area= colordata_peak_area(cd, pk->beg, pk->end, message);
+        pk->pos = colordata_peak_position(cd, pk->beg, pk->end, pk->area,
                   message);
-        pk->max = get_peak_max(cd->data, pk->beg, pk->end, message);
+        pk->max = colordata_peak_max(cd, pk->beg, pk->end, message);
         pk->ipos_orig      = pk->pos;
         pk->ipos           = pk->pos;
         pk->base           = base[color];
@@ -2224,7 +2694,7 @@ compute_num_peaks_expected( int num_peaks_observed,
     return num_peaks_expected;
 }
 double
-array_inverse_CDF( const int h[], int size, double p )
+array_inverse_CDF( const TT_Sample h[], int size, double p )
 {
     double sum, v0, v1, vtest, d0, d1, retval;
     int i, i0, i1;
@@ -2265,14 +2735,16 @@ array_inverse_CDF( const int h[], int size, double p )
 }
 
 void
-flesh_out_peak( int data[], int color, int cd_peak_ind,
+flesh_out_peak( ColorData *cd, int color, int cd_peak_ind,
                 Peak *pk, BtkMessage *message )
 {
     static char base[] = { 'A', 'C', 'G', 'T' };
-    pk->area = get_peak_area(data, pk->beg, pk->end, message);
-    pk->pos  = get_peak_position(data, pk->beg, pk->end, pk->area,
+    TT_Sample *data = cd->data;
+
+    pk->area = colordata_peak_area(cd, pk->beg, pk->end, message);
+    pk->pos  = colordata_peak_position(cd, pk->beg, pk->end, pk->area,
                                 message);
-    pk->max  = get_peak_max(data, pk->beg, pk->end, message);
+    pk->max  = colordata_peak_max(cd, pk->beg, pk->end, message);
     pk->ipos_orig      = pk->pos;
     pk->ipos           = pk->pos;
     pk->base           = base[color];
@@ -2329,7 +2801,7 @@ add_one_peak( Data *data, int color, int indx, int num_old,
     p2 = &cd->peak_list[indx+j_max_beg_end+2];
 
     {
-        int *local_data = &cd->data[p0->beg];
+        TT_Sample *local_data = &cd->data[p0->beg];
         int size = p0->end - p0->beg + 1;
         double boundary = p0->beg + array_inverse_CDF( local_data, size, 0.5 );
         p1->end = p0->end;
@@ -2341,8 +2813,8 @@ add_one_peak( Data *data, int color, int indx, int num_old,
     p0->type = 10*t0 + 3;
     p1->type = 30 + t1;
 
-    flesh_out_peak( cd->data, color, indx+j_max_beg_end+0, p0, message );
-    flesh_out_peak( cd->data, color, indx+j_max_beg_end+1, p1, message );
+    flesh_out_peak( cd, color, indx+j_max_beg_end+0, p0, message );
+    flesh_out_peak( cd, color, indx+j_max_beg_end+1, p1, message );
 }
 
 static void
@@ -2380,35 +2852,73 @@ rem_one_peak( Data *data, int color, int indx, int num_old,
     p0->beg = beg;
     p0->end = end;
 
-    flesh_out_peak( cd->data, color, indx+j_min_beg_end+0, p0, message );
+    flesh_out_peak( cd, color, indx+j_min_beg_end+0, p0, message );
 }
 
 /*******************************************************************************
- * Function: set_peak_widths      
+ * Function: colordata_set_peak_widths      
  *******************************************************************************
  */
 
 static void 
-set_peak_widths(Data *data, BtkMessage *message)
+colordata_set_peak_widths(ColorData *cd, BtkMessage *message)
 {
-    int i, j;
+    int j;
 
-    for (i=0; i<NUM_COLORS; i++)
+    for (j=0; j<cd->peak_list_len; j++)
     {
-        for (j=0; j<data->color_data[i].peak_list_len; j++)
-        {
-            Peak *peak = &data->color_data[i].peak_list[j];
-            ColorData *cd = &data->color_data[i];
+        Peak *peak = &cd->peak_list[j];
  
-            if (peak->width1 < EPSILON)
-                peak->width1 = get_peak_width1(cd, peak->cd_peak_ind, message);
+        if (peak->width1 < EPSILON)
+            peak->width1 = get_peak_width1(cd, peak->cd_peak_ind, message);
             
-            if (peak->width2 < EPSILON)
-                peak->width2 = get_peak_width2(cd, peak->cd_peak_ind, message);
-        }
+        if (peak->width2 < EPSILON)
+            peak->width2 = get_peak_width2(cd, peak->cd_peak_ind, message);
     }
 }
 
+/*******************************************************************************
+ * Function: set_peak_widths      
+ *******************************************************************************
+ */
+
+static void 
+set_peak_widths(Data *data, BtkMessage *message)
+{
+    int i;
+
+    for (i=0; i<NUM_COLORS; i++)
+        colordata_set_peak_widths(&data->color_data[i], message);
+}
+
+/*******************************************************************************
+ * Function: expand_peaks_task
+ * Purpose: expand the peaks of one color and fill in their missing widths.
+ *          The serial version of data_expand_peaks filled in the widths of
+ *          all colors after expanding each one, so colors after the first
+ *          nonempty one also get their widths before being expanded
+ *******************************************************************************
+ */
+static int
+expand_peaks_task(int color, void *arg)
+{
+    ColorStage *cs = (ColorStage *)arg;
+    ColorData  *cd = &cs->data->color_data[color];
+
+    if (cd->peak_list_len == 0) {
+        return SUCCESS;
+    }
+    if (color > cs->first_color) {
+        colordata_set_peak_widths(cd, &cs->message[color]);
+    }
+    if (colordata_expand_peaks(cd, &cs->message[color]) == ERROR) {
+        cs->status[color] = ERROR;
+        return ERROR;
+    }
+    colordata_set_peak_widths(cd, &cs->message[color]);
+    return SUCCESS;
+}
+
 /*******************************************************************************
  * Function: data_expand_peaks              
  * Purpose: modify peaks in each of 4 peak lists using a new peak definition, 
@@ -2417,19 +2927,18 @@ set_peak_widths(Data *data, BtkMessage *message)
  *******************************************************************************
  */ 
 int 
-data_expand_peaks(Data *data, Options *options, BtkMessage *message) 
+data_expand_peaks(Data *data, const Options *options, BtkMessage *message) 
 { 
-    int color;
-
-    for (color = 0; color < NUM_COLORS; color++) { 
-        ColorData *cd = &data->color_data[color]; 
-        if (cd->peak_list_len == 0) { 
-            continue; 
-        } 
-        if (colordata_expand_peaks(cd, message) == ERROR) { 
-            return ERROR; 
-        }  
-        set_peak_widths(data, message);
+    int color, r;
+    ColorStage cs;
+
+    color_stage_init(&cs, data, options, message);
+    while (cs.first_color < NUM_COLORS - 1 &&
+           data->color_data[cs.first_color].peak_list_len == 0)
+        cs.first_color++;
+    r = run_tasks(expand_peaks_task, NUM_COLORS, &cs, options->color_threads);
+    if (color_stage_finish(&cs, r, message) == ERROR) { 
+        return ERROR; 
     }
 
 #if 0
@@ -2573,7 +3082,7 @@ data_expand_peaks(Data *data, Options *options, BtkMessage *message)
  *******************************************************************************
  */ 
 static double
-single_peak_resolution( Data* data, const Peak* peak, Options* options )
+single_peak_resolution( Data* data, const Peak* peak, const Options *options )
 {
     int j;
     double x, mdata, model, resolution;
@@ -2624,7 +3133,7 @@ update_ipos(float B, int pos,  int height, int lpos, int lheight,
  */
 static int 
 fit_single_peak(Peak *pk, double stderr_w1, double stderr_w2,
-    Data *data, Options *options, BtkMessage *message) 
+    Data *data, const Options *options, BtkMessage *message) 
 { 
     double w1, w2, width_ratio;    
     int color = pk->color_index;
@@ -2647,8 +3156,9 @@ fit_single_peak(Peak *pk, double stderr_w1, double stderr_w2,
 
     if( options->gauss ) {
         /* Gauss model: C = (C0/(4*PI*beta**2))*exp(-x**2/(4*beta**2)) */
-        int i;
-        double sum_exp = 0., sum_exp2 = 0., x2, B;
+        int i, k, n;
+        double sum_exp = 0., sum_exp2 = 0., B;
+        double x[SHAPE_CHUNK], y[SHAPE_CHUNK];
         pk->beta = (beta1 + beta2)/2.;        
         pk->orig_width = 0.0;
         B = 1./4./pk->beta/pk->beta;
@@ -2662,13 +3172,17 @@ fit_single_peak(Peak *pk, double stderr_w1, double stderr_w2,
                 update_ipos(B, pos, height, lpos, lheight, rpos, rheight);
         }
         /* Set iheight */
-        for (i=pk->beg; i<=pk->end; i++)
+        for (i=pk->beg; i<=pk->end; i+=n)
         {
-            x2 = (double)((i-pk->ipos)*(i-pk->ipos));  
-            sum_exp  += (double)(cd->data[i])
-                       *Shape(1., 0.0, pk->beta, (double)(i-pk->ipos), options);
-            sum_exp2 += Shape(1., 0.0, pk->beta, (double)(i-pk->ipos), options)
-                       *Shape(1., 0.0, pk->beta, (double)(i-pk->ipos), options);
+            n = QVMIN(SHAPE_CHUNK, pk->end - i + 1);
+            for (k=0; k<n; k++) {
+                x[k] = (double)(i+k-pk->ipos);
+            }
+            ShapeArray(1., 0.0, pk->beta, x, n, y, options);
+            for (k=0; k<n; k++) {
+                sum_exp  += (double)(cd->data[i+k])*y[k];
+                sum_exp2 += y[k]*y[k];
+            }
         }
         pk->C0 = pk->iheight = (sum_exp2) > 0 ? sum_exp / sum_exp2 : pk->height;
 //      fprintf(stderr, "single ipos= %f beg=%d end=%d\n", pk->ipos, pk->beg, pk->end);
@@ -2698,8 +3212,34 @@ fit_single_peak(Peak *pk, double stderr_w1, double stderr_w2,
  *  
  *******************************************************************************
  */ 
+
+/*******************************************************************************
+ * Function: subtract_peak_shape
+ * Purpose: subtract the model of a peak from dev[m1-first] for all 
+ *          scans m1 from beg to end
+ *******************************************************************************
+ */
+static void
+subtract_peak_shape( const Peak *pk, int beg, int end, int first, 
+                     const Options* options, double dev[] )
+{
+    int    k, m1, n;
+    double x[SHAPE_CHUNK], y[SHAPE_CHUNK];
+
+    for (m1 = beg; m1 <= end; m1 += n) {
+        n = QVMIN(SHAPE_CHUNK, end - m1 + 1);
+        for (k = 0; k < n; k++) {
+            x[k] = m1 + k - pk->ipos;
+        }
+        ShapeArray(pk->C0, pk->orig_width/TWO, pk->beta, x, n, y, options);
+        for (k = 0; k < n; k++) {
+            dev[m1 + k - first] -= y[k];
+        }
+    }
+}
+
 static void
-compute_deviation( const Peak peak_list[], const int data_array[], int j, int n,
+compute_deviation( const Peak peak_list[], const TT_Sample data_array[], int j, int n,
                    const Options* options, double dev[] )
 {
     int beg, end, m, m1;
@@ -2717,29 +3257,28 @@ compute_deviation( const Peak peak_list[], const int data_array[], int j, int n,
     } 
     
     for (m1=beg; m1<=end; m1++) { 
-        const Peak *pk;
         m = m1 - peak_list[0].beg; 
         dev[m] = (double)data_array[m1];  // initializing dev array 
-        if (j > 0) {
-            pk = &peak_list[j-1];
-            dev[m] -= Shape(pk->C0, pk->orig_width/TWO, pk->beta, 
-                            m1-pk->ipos, options );
-        } 
-        if (j > 1) { 
-            pk = &peak_list[j-2];
-            dev[m] -= Shape(pk->C0, pk->orig_width/TWO, pk->beta, 
-                            m1-pk->ipos, options );
-        } 
-        if (j < n-1) { 
-            pk = &peak_list[j+1];
-            dev[m] -= Shape(pk->C0, pk->orig_width/TWO, pk->beta, 
-                            m1-pk->ipos, options );
-        } 
-        if (j < n-2) {
-            pk = &peak_list[j+2];
-            dev[m] -= Shape(pk->C0, pk->orig_width/TWO, pk->beta, 
-                            m1-pk->ipos, options );
-        } 
+    }
+    /* Each point is reduced by the neighbors in the same order as before */
+    if (j > 0) {
+        subtract_peak_shape(&peak_list[j-1], beg, end, peak_list[0].beg,
+                            options, dev);
+    } 
+    if (j > 1) { 
+        subtract_peak_shape(&peak_list[j-2], beg, end, peak_list[0].beg,
+                            options, dev);
+    } 
+    if (j < n-1) { 
+        subtract_peak_shape(&peak_list[j+1], beg, end, peak_list[0].beg,
+                            options, dev);
+    } 
+    if (j < n-2) {
+        subtract_peak_shape(&peak_list[j+2], beg, end, peak_list[0].beg,
+                            options, dev);
+    } 
+    for (m1=beg; m1<=end; m1++) { 
+        m = m1 - peak_list[0].beg; 
         if (dev[m] < 0) { 
             dev[m] = 0.; 
         } 
@@ -2756,16 +3295,21 @@ static double
 compute_peak_resolution( const Peak* pk, int begin, 
                          const double dev[], const Options* options )
 {
-    int m, m1;
-    double dev_area;
+    int k, m, m1, n;
+    double dev_area, x[SHAPE_CHUNK], y[SHAPE_CHUNK];
 
     dev_area = 0.; 
-    for (m1 = pk->beg; m1 < pk->end; m1++)
+    for (m1 = pk->beg; m1 < pk->end; m1 += n)
     { 
-        m = m1 - begin; 
-        dev_area += fabs((double)(dev[m]+dev[m+1])/TWO
-                  - Shape(pk->C0, pk->orig_width/TWO, pk->beta,
-                         (double)(2*m1 + 1 - 2*pk->ipos)/TWO, options));
+        n = QVMIN(SHAPE_CHUNK, pk->end - m1);
+        for (k = 0; k < n; k++) {
+            x[k] = (double)(2*(m1+k) + 1 - 2*pk->ipos)/TWO;
+        }
+        ShapeArray(pk->C0, pk->orig_width/TWO, pk->beta, x, n, y, options);
+        for (k = 0; k < n; k++) {
+            m = m1 + k - begin; 
+            dev_area += fabs((double)(dev[m]+dev[m+1])/TWO - y[k]);
+        }
     }
     if (pk->area > 0.) {  dev_area /= pk->area;  } 
     return dev_area;
@@ -2971,7 +3515,7 @@ set_peak_lattice( Peak pk[], int b_indx, int e_indx, double spacing_in )
  *******************************************************************************
  */
 static void
-fix_peak_positions( Peak pk[], int peak_list_len, const int data_array[], 
+fix_peak_positions( Peak pk[], int peak_list_len, const TT_Sample data_array[], 
                     int nn, double ave_spacing, BtkMessage* message )
 {
     int indx, state = END_STATE, b_indx=0;
@@ -3071,11 +3615,11 @@ print_peak_info( Peak pk[], int peak_list_len, int data_array[], int nn,
  */
 static void
 get_intrinsic_position_and_height( double array[], int beg, int end, 
-    double beta, double *ipos, double *iheight, int debug, Options *options )
+    double beta, double *ipos, double *iheight, int debug, const Options *options )
 {
-    int ctr, i;         // ctr = counter of points with positive signal 
+    int ctr, i, k, n;   // ctr = counter of points with positive signal 
     int width = end - beg;
-    double sum_exp = 0., sum_exp2 = 0., x;
+    double sum_exp = 0., sum_exp2 = 0., x[SHAPE_CHUNK], y[SHAPE_CHUNK];
     double B = 1./4./beta/beta;
 
     if( debug ) fprintf( stderr, "pmax:" );
@@ -3108,11 +3652,16 @@ get_intrinsic_position_and_height( double array[], int beg, int end,
         if (*ipos >= width-1) *ipos = width - 1.;
 
         // Determine intrinsic height
-        for( i=0; i<width; i++ ) {
-            x = *ipos - (double)i;
-            sum_exp  += (double)(array[i])*Shape(1., 0.0, beta, x, options);
-            sum_exp2 += Shape(1., 0.0, beta, x, options)
-                       *Shape(1., 0.0, beta, x, options);
+        for( i=0; i<width; i+=n ) {
+            n = QVMIN(SHAPE_CHUNK, width - i);
+            for( k=0; k<n; k++ ) {
+                x[k] = *ipos - (double)(i+k);
+            }
+            ShapeArray(1., 0.0, beta, x, n, y, options);
+            for( k=0; k<n; k++ ) {
+                sum_exp  += (double)(array[i+k])*y[k];
+                sum_exp2 += y[k]*y[k];
+            }
 //          if (beg==65)
 //              fprintf(stderr, "beg=%d width=%d ipos=%f beta=%f x= %f shape=%f sum_exp=%f sum_exp2=%f\n", beg, width, *ipos, beta, x, Shape(1., 0.0, beta, x, options), sum_exp, sum_exp2);
         }
@@ -3185,10 +3734,10 @@ compute_max_resolution( Peak *peak_list, int n )
  */ 
 static int
 resolve_sub( Peak* peak_list, int n, int peak_list_len, int color, 
-             int* data_array, int length, 
+             TT_Sample* data_array, int length, 
              double rep_width2, 
              double rep_w02beta, double rep_spacing, 
-             double* max_resolution, Options *options, BtkMessage *message )
+             double* max_resolution, const Options *options, BtkMessage *message )
 {
     int        j, k=0;  
     double     *dev=NULL;
@@ -3455,11 +4004,11 @@ resolve_sub( Peak* peak_list, int n, int peak_list_len, int color,
  */ 
 int 
 resolve_multiple_peaks(Data *data, int color, int i, int n,  
-    double *max_resolution, Options *options, BtkMessage *message) 
+    double *max_resolution, const Options *options, BtkMessage *message) 
 { 
     ColorData *cd;
     Peak* short_peak_list;
-    int*  data_array;
+    TT_Sample* data_array;
     int   length=0;
     double rep_w02beta, rep_spacing, rep_width1, rep_width2, rep_width_ratio;
 #if SHOW_MULTIPLE_RESOLUTION 
@@ -3499,28 +4048,40 @@ resolve_multiple_peaks(Data *data, int color, int i, int n,
  *******************************************************************************
  */ 
 static int 
-data_resolve_single_peaks( Data *data, Options *options, BtkMessage *message) 
+data_resolve_single_peaks( Data *data, const Options *options, BtkMessage *message) 
 { 
     int        i;
     double     stderr_w1, stderr_w2;
+    PeakWidths *pw;
+
+    /* The windows of neighboring peaks overlap, so each peak's widths 
+     * are computed once and shared. Fitting a peak does not change its 
+     * bounds, position or height, which the widths depend on 
+     */
+    if ((pw = peak_widths_create(data, message)) == NULL)
+        return ERROR;
 
     for (i=0; i < data->peak_list_len; i++) {
         Peak* peak = data->peak_list[i];
-        peak->ave_width1 = get_average_width(1, peak->data_peak_ind,
+        peak->ave_width1 = average_width(1, peak->data_peak_ind,
             NUM_PEAK_UPSTREAM, NUM_PEAK_DOWNSTREAM,
-            &stderr_w1, data, message);
-        peak->ave_width2 = get_average_width(2, peak->data_peak_ind,
+            &stderr_w1, pw, data, message);
+        peak->ave_width2 = average_width(2, peak->data_peak_ind,
             NUM_PEAK_UPSTREAM, NUM_PEAK_DOWNSTREAM,
-           &stderr_w2, data, message);
+           &stderr_w2, pw, data, message);
         if ((peak->type   ==11        ) || 
             (peak->type%10==1  && i==0) || 
             (peak->type<20     && i==data->peak_list_len-1)) 
         {
             if (fit_single_peak(peak, stderr_w1, stderr_w2,
                 data, options, message) != SUCCESS)
+            {
+                FREE(pw);
                 return ERROR;
+            }
         }
     }             /* loop in i */ 
+    FREE(pw);
     return SUCCESS; 
 } 
 
@@ -3529,7 +4090,7 @@ data_resolve_single_peaks( Data *data, Options *options, BtkMessage *message)
  *******************************************************************************
  */ 
 int 
-data_resolve_peaks( Data *data, Options *options, BtkMessage *message) 
+data_resolve_peaks( Data *data, const Options *options, BtkMessage *message) 
 { 
     int        i, j, k, n, color; 
     int        shift[NUM_COLORS] = {0, 0, 0, 0};
@@ -3629,7 +4190,7 @@ data_resolve_peaks( Data *data, Options *options, BtkMessage *message)
  *******************************************************************************
  */ 
 int 
-Btk_process_peaks(Data *data, Options *options, BtkMessage *message)  
+Btk_process_peaks(Data *data, const Options *options, BtkMessage *message)  
 { 
     clock_t start_clock = clock(), curr_clock;
 
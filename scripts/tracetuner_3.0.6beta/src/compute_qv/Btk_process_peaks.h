@@ -34,25 +34,33 @@
 #define AREA_FACTOR2 (0.02*ONE_PLUS)
 #define ROUNDPOS(X)  ( INT_DBL((X)+0.5) )
 #define ROUND(X)     ( ((X)>0.0) ? ROUNDPOS(X) : -ROUNDPOS(-(X)) )
+#define SIGNAL_MAX_LEVELS 6  /* rows of the sparse table of range maxima */
 
 extern int is_dp(Peak *, int *, Data *); 
-extern int Btk_process_peaks(Data *, Options *, BtkMessage *); 
+extern int Btk_process_peaks(Data *, const Options *, BtkMessage *); 
 extern int data_create_single_ordered_peak_list(Data *, BtkMessage *); 
 extern int data_recall_bases(Data *, char *, char *, BtkMessage *); 
 extern double get_average_width1(Data *, int, int, int, BtkMessage *); 
 extern double get_average_width2(Data *, int, int, int, double *, BtkMessage *); 
 extern double get_average_ratio(Data *, int, int, int, BtkMessage *); 
-extern double get_peak_area(int *, int, int, BtkMessage *); 
+extern double get_peak_area(TT_Sample *, int, int, BtkMessage *); 
 extern double get_average_abi_spacing(int , Data *, BtkMessage *);
-extern int get_peak_position(int *, int, int, double, BtkMessage *); 
+extern int get_peak_position(TT_Sample *, int, int, double, BtkMessage *); 
 extern int is_true_peak(Peak); 
-extern int get_peak_max(int *, int, int, BtkMessage *);
+extern int get_peak_max(TT_Sample *, int, int, BtkMessage *);
+extern int colordata_build_signal_index(ColorData *, BtkMessage *);
+extern void colordata_release_signal_index(ColorData *);
+extern void data_release_signal_index(Data *);
+extern double colordata_peak_area(ColorData *, int, int, BtkMessage *);
+extern int colordata_peak_position(ColorData *, int, int, double, 
+    BtkMessage *);
+extern int colordata_peak_max(ColorData *, int, int, BtkMessage *);
 extern int resolve_multiple_peaks(Data *, int, int, int, double *,  
-    Options *, BtkMessage *); 
+    const Options *, BtkMessage *); 
 extern void data_release(Data *); 
 extern int is_maximum(int n, int *data, int length);
-extern int data_detect_peaks(Data *, Options *, BtkMessage *);
-extern int data_expand_peaks(Data *, Options *, BtkMessage *);
-extern int data_resolve_peaks(Data *, Options *, BtkMessage *);
+extern int data_detect_peaks(Data *, const Options *, BtkMessage *);
+extern int data_expand_peaks(Data *, const Options *, BtkMessage *);
+extern int data_resolve_peaks(Data *, const Options *, BtkMessage *);
 extern double get_average_width(int, int, int, int, double *,
     Data *, BtkMessage *);
@@ -66,7 +66,6 @@
 #define DEBUG  0
 #define DEBUG0 0
 #define DEBUG_CURTIS 0
-#define DEFAULT_NUM_WINDOWS 40
 #define DEFAULT_SPACING 12
 #define DPRINT(x) fprintf(stderr, #x " = %g\n", (float)(x)) // for debugging
 #define ERROR -1
@@ -96,16 +95,6 @@
 #define SQRT_ENVELOPE_ASYMPTOTE 0.5
 #define SWAP(a,b) tempr=(a);(a)=(b);(b)=tempr
 
-/* Crude estimate of peak spacing */
-static int    num_windows = DEFAULT_NUM_WINDOWS;
-static int    isweet;
-static double crude_spacing_estimate = 8.0;
-static float  mobs_model_coeff[POLYFIT_DEGREE + 1];
-static float  spac_model_coeff[POLYFIT_DEGREE + 1];
-static float  spac_mod_val[DEFAULT_NUM_WINDOWS];
-static float  spac_mod_pos[DEFAULT_NUM_WINDOWS];
-static float  norm_mod_val[NUM_COLORS][DEFAULT_NUM_WINDOWS];
-static float  norm_mod_pos[DEFAULT_NUM_WINDOWS];
 
 static void 
 bubble(int *data, int num_data)
@@ -848,14 +837,14 @@ xgr_output_curve(FILE *fp, int *data, int shift, int beg, int end, int color)
  */
 int
 explore_filtering_noise(int num_datapoints, int *data, char base,
-    Options options, BtkMessage *message)
+    const Options *options, BtkMessage *message)
 {
     FILE *fp=NULL;
     int i;
     int *new_data;
     char filename[MAXPATHLEN];
 
-    if (options.xgr) {
+    if (options->xgr) {
         sprintf(filename, "chromat_%c.xgr", base);
         fp = fopen(filename, "w");
         fprintf(fp, "Title = Chromatogram for base =%c\n", base);
@@ -873,7 +862,7 @@ explore_filtering_noise(int num_datapoints, int *data, char base,
     }
     fgauss(new_data, num_datapoints);
     
-    if (options.xgr) 
+    if (options->xgr) 
         xgr_output_curve(fp, new_data, 0, 0, num_datapoints, 2);           /* red */
 
     /* Data after fir_filter1 */
@@ -881,7 +870,7 @@ explore_filtering_noise(int num_datapoints, int *data, char base,
         new_data[i] = data[i];
     }
     lowpass(new_data, num_datapoints);
-    if (options.xgr)
+    if (options->xgr)
         xgr_output_curve(fp, new_data, 0, 0, num_datapoints, 7);           /* yellow */
 
     /* Data after fir_filter2 */
@@ -889,7 +878,7 @@ explore_filtering_noise(int num_datapoints, int *data, char base,
         new_data[i] = data[i];
     }
     bandpass(new_data, num_datapoints);
-    if (options.xgr)
+    if (options->xgr)
         xgr_output_curve(fp, new_data, 0, 0, num_datapoints, 4);          /* green */
 
     /* Data after savgol255 filter */
@@ -897,7 +886,7 @@ explore_filtering_noise(int num_datapoints, int *data, char base,
         new_data[i] = data[i];
     }
     savgol255_filter(  new_data, num_datapoints, 1);
-    if (options.xgr)
+    if (options->xgr)
         xgr_output_curve(fp, new_data, 0, 0, num_datapoints, 9);          /* cyan */
 
     /* Data after savgol41616 filter */
@@ -905,7 +894,7 @@ explore_filtering_noise(int num_datapoints, int *data, char base,
         new_data[i] = data[i];
     }
     savgol41616_filter(new_data, num_datapoints, 1);
-    if (options.xgr)
+    if (options->xgr)
         xgr_output_curve(fp, new_data, 0, 0, num_datapoints, 3);          /* blue */
 
     /* Data after iir filter */
@@ -914,11 +903,11 @@ explore_filtering_noise(int num_datapoints, int *data, char base,
     }
     median_filter_n5(new_data, num_datapoints);
     savgol255_filter(  new_data, num_datapoints, 1);
-    if (options.xgr)
+    if (options->xgr)
         xgr_output_curve(fp, new_data, 0, 0, num_datapoints, 5);          /* violet */
 
     FREE(new_data);
-    if (options.xgr)
+    if (options->xgr)
         fclose(fp);
 
     return SUCCESS;
@@ -930,7 +919,7 @@ explore_filtering_noise(int num_datapoints, int *data, char base,
  *****************************************************************************/
 static int
 create_DP_list(Data *data, int beg_pos, int end_pos, int *shift, 
-    Peak ***dp, int *num_DPs, Options *options, BtkMessage *message)
+    Peak ***dp, int *num_DPs, const Options *options, BtkMessage *message)
 {
     int    i; 
     int    max_shift=NINF;
@@ -1104,10 +1093,11 @@ estimate_spacing_variation_of_shifted_peaks(Peak *dp[], int num_DPs,
     int win_beg, int win_end, int shift[NUM_COLORS], float ignoreSmallest,
     float *mean_spacing, float *spacing_var, float *std_dev, int ind_win,
     int *min_spacing, int   *max_spacing, int *min_pos, int *max_pos,
-    int   *min_color0,  int *min_color1, Data * data, Options *options,
+    int   *min_color0,  int *min_color1, Data * data, const Options *options,
     BtkMessage *message)
 {
-    int    hist_spacings_len = INT_DBL(5.0 * crude_spacing_estimate);
+    SpacingModel *sm = &data->spacing;
+    int    hist_spacings_len = INT_DBL(5.0 * sm->crude_spacing_estimate);
 
     /* Tolerance for ratio of maximum weight to total weight */
     int      i, spacing, color;
@@ -1469,6 +1459,7 @@ sliding_window5_average(float *y, int num_data)
  *           model specified by spac_model_coeff[]
  *
  * Inputs:
+ *   data        trace data holding the spacing model
  *   scan        integer data scan
  *
  * Outputs:      none
@@ -1476,8 +1467,9 @@ sliding_window5_average(float *y, int num_data)
  * Comments:
  */
 double
-spacing_curve(int scan)
+spacing_curve(const Data *data, int scan)
 {
+    const SpacingModel *sm = &data->spacing;
     int   i;
     float powers[POLYFIT_DEGREE + 1];
     double r = -1;
@@ -1485,30 +1477,33 @@ spacing_curve(int scan)
     if (POLY_SPAC_MODEL_APPROX > 0) {
         fpoly(scan, powers-1, POLYFIT_DEGREE + 1);    /* offset for NR */
         for ( i=0; i < POLYFIT_DEGREE + 1; i++)
-            r += spac_model_coeff[i] * powers[i];
+            r += sm->spac_model_coeff[i] * powers[i];
     }
     else
     {
 #if 0
         fprintf(stderr, 
-            "In spacing_curve: scan=%d num_windows=%d spac_mod_pos0=%f spac_mod_pos_last=%f\n",
-            scan, num_windows, spac_mod_pos[0], spac_mod_pos[num_windows - 1]);
+            "In spacing_curve: scan=%d sm->num_windows=%d spac_mod_pos0=%f spac_mod_pos_last=%f\n",
+            scan, sm->num_windows, sm->spac_mod_pos[0], sm->spac_mod_pos[sm->num_windows - 1]);
 #endif
-        if (scan <= spac_mod_pos[0])
-            r = spac_mod_val[0];
-        else if (scan >= spac_mod_pos[num_windows - 1])
-            r = spac_mod_val[num_windows - 1];
+        if ((scan >= sm->spac_curve_beg) && 
+            (scan <  sm->spac_curve_beg + sm->spac_curve_len))
+            r = sm->spac_curve[scan - sm->spac_curve_beg];
+        else if (scan <= sm->spac_mod_pos[0])
+            r = sm->spac_mod_val[0];
+        else if (scan >= sm->spac_mod_pos[sm->num_windows - 1])
+            r = sm->spac_mod_val[sm->num_windows - 1];
         else 
         {
-            for (i=0; i< num_windows - 1; i++)
+            for (i=0; i< sm->num_windows - 1; i++)
             {
-                if (((float)scan >= spac_mod_pos[i  ]) &&
-                   ((float)scan <  spac_mod_pos[i+1]))
+                if (((float)scan >= sm->spac_mod_pos[i  ]) &&
+                   ((float)scan <  sm->spac_mod_pos[i+1]))
                 {
-                   r = spac_mod_val[i] +
-                      (spac_mod_val[i+1] - spac_mod_val[i]) *
-                      ((float)scan       - spac_mod_pos[i]) /
-                      (spac_mod_pos[i+1] - spac_mod_pos[i]);
+                   r = sm->spac_mod_val[i] +
+                      (sm->spac_mod_val[i+1] - sm->spac_mod_val[i]) *
+                      ((float)scan       - sm->spac_mod_pos[i]) /
+                      (sm->spac_mod_pos[i+1] - sm->spac_mod_pos[i]);
                 }
             }
         }
@@ -1524,6 +1519,7 @@ static void
 output_spacing_curve(float *x, float *y, int num_points, int degree, 
     int win_size, Data *data)
 {
+    SpacingModel *sm = &data->spacing;
     int   i, j;
     char filename[MAXPATHLEN];
     float *powers, *z;
@@ -1550,9 +1546,9 @@ output_spacing_curve(float *x, float *y, int num_points, int degree,
     for (i=0; i<num_points; i++) {
         z[i] = 0.;
         for (j=0; j<degree; j++) {
-            z[i] += spac_model_coeff[j] * pow(x[i], j);
+            z[i] += sm->spac_model_coeff[j] * pow(x[i], j);
         }
-        z[i] = spacing_curve(x[i]);
+        z[i] = spacing_curve(data, x[i]);
         if (z[i] >0) 
             fprintf(fp, "%d %f\n", i, z[i]);
     }
@@ -1561,7 +1557,7 @@ output_spacing_curve(float *x, float *y, int num_points, int degree,
     /* Output sliding window avarage approximation of spacing curve */
     fprintf(fp, "\ncolor = %d\n", 5);      /* violet */
     for (i=0; i<num_points; i++) {
-        z[i] = spacing_curve(x[i]);
+        z[i] = spacing_curve(data, x[i]);
     }
     (void)sliding_window5_average(z, num_points);
     for (i=0; i<num_points; i++) {
@@ -1631,45 +1627,102 @@ output_new_spacing_curve(float *x, float *y, int num_points)
     fclose(fp);
 }
 
-/****************************************************************************e
- * Function: normalization_curve
- * Purpose:  Returns the spacing at specified scan according to piecewise
- *           model specified by spac_model_coeff[]
+/****************************************************************************
+ * Function: interpolate_windows
+ * Purpose:  Evaluate a piecewise linear model, given by its values at the 
+ *           centers of the windows, at each of a range of scans
  *
  * Inputs:
- *   scan        integer data scan
+ *   pos         window centers (nondecreasing)
+ *   val         model values at the window centers
+ *   num_wins    number of windows
+ *   beg, len    first scan and number of scans to evaluate
  *
- * Outputs:      none
- * Return:       spacing estimate
- * Comments:
+ * Outputs:      out[k] = model value at scan beg+k
+ * Return:       none
+ * Comments:     The model is constant before the first and after the last
+ *               window center. The window is advanced along with the scan,
+ *               so this costs O(len + num_wins) instead of a search over
+ *               the windows for every scan.
  */
-double
-normalization_curve(int scan, int color)
+static void
+interpolate_windows(const float *pos, const float *val, int num_wins, 
+    int beg, int len, float *out)
 {
-    int   i;
-    double r = -1;
+    int i = 0, k;
 
-    if (scan <= norm_mod_pos[0])
-        r = norm_mod_val[color][0];
-    else if (scan >= norm_mod_pos[num_windows - 1])
-        r = norm_mod_val[color][num_windows - 1];
-    else
+    for (k=0; k<len; k++)
     {
-        for (i=0; i< num_windows - 1; i++)
+        int scan = beg + k;
+
+        if (scan <= pos[0])
+            out[k] = val[0];
+        else if (scan >= pos[num_wins - 1])
+            out[k] = val[num_wins - 1];
+        else
         {
-            if (((float)scan >= norm_mod_pos[i  ]) &&
-               ((float)scan <  norm_mod_pos[i+1]))
-            {
-               r = norm_mod_val[color][i] +
-                  (norm_mod_val[color][i+1] - norm_mod_val[color][i]) *
-                  ((float)scan       - norm_mod_pos[i]) /
-                  (norm_mod_pos[i+1] - norm_mod_pos[i]);
-            }
+            while ((i < num_wins - 2) && ((float)scan >= pos[i+1]))
+                i++;
+            out[k] = val[i] +
+                (val[i+1] - val[i]) *
+                ((float)scan - pos[i]) /
+                (pos[i+1]    - pos[i]);
         }
     }
-    return(r);
 }
 
+/****************************************************************************
+ * Function: tabulate_spacing_curve
+ * Purpose:  Store the values of the piecewise spacing model for every scan
+ *           between the first and the last window centers, so that 
+ *           spacing_curve() does not need to search the windows.
+ *           Must be called whenever spac_mod_pos[] or spac_mod_val[] change
+ */
+static void
+tabulate_spacing_curve(SpacingModel *sm)
+{
+    int beg = (int)sm->spac_mod_pos[0];
+    int end = (int)sm->spac_mod_pos[sm->num_windows - 1] + 1;
+
+    FREE(sm->spac_curve);
+    sm->spac_curve_len = 0;
+    if ((POLY_SPAC_MODEL_APPROX > 0) || (beg < 0) || (end < beg))
+        return;
+
+    /* If this fails spacing_curve() just searches the windows */
+    sm->spac_curve = CALLOC(float, end - beg + 1);
+    if (sm->spac_curve == NULL)
+        return;
+    interpolate_windows(sm->spac_mod_pos, sm->spac_mod_val, sm->num_windows, beg, 
+        end - beg + 1, sm->spac_curve);
+    sm->spac_curve_beg = beg;
+    sm->spac_curve_len = end - beg + 1;
+}
+
+/****************************************************************************
+ * Function: spacing_model_init
+ * Purpose:  Set the spacing model of a trace to its defaults, before the
+ *           spacing has been estimated from the data
+ */
+void
+spacing_model_init(SpacingModel *sm)
+{
+    (void)memset(sm, 0, sizeof(*sm));
+    sm->num_windows            = DEFAULT_NUM_WINDOWS;
+    sm->crude_spacing_estimate = 8.0;
+    sm->spac_curve             = NULL;
+}
+
+/****************************************************************************
+ * Function: spacing_model_release
+ * Purpose:  Free the memory allocated for the tabulated spacing curve
+ */
+void
+spacing_model_release(SpacingModel *sm)
+{
+    FREE(sm->spac_curve);
+    sm->spac_curve_len = 0;
+}
 
 /*****************************************************************************
  * Function: find_optimal_shift_in_a_window
@@ -1702,13 +1755,14 @@ find_optimal_shift_in_a_window(Data *data, int ind_win, int win_beg, int win_end
     int shift_flag[NUM_COLORS], float *best_mean_spacing, 
     float *best_spacing_var, int *best_min_spa, int *best_max_spa,
     int *best_min_pos, int *best_max_pos, float *shift_err, 
-    int *best_min_color0, int *best_min_color1, Options *options, BtkMessage *message)
+    int *best_min_color0, int *best_min_color1, const Options *options, BtkMessage *message)
 {
+    SpacingModel *sm = &data->spacing;
     const double shiftIncDefault		= 0.5;
     const double shiftMaxDefault		= 1.5;
     const double minRelatChannelWgt     = MIN_RELATIVE_CHANNEL_WEIGHT;
                  /* minimum total color height as fraction of total height */
-    const int	 hist_spacings_len = INT_DBL(2.5*crude_spacing_estimate);
+    const int	 hist_spacings_len = INT_DBL(2.5*sm->crude_spacing_estimate);
 		 /* length of hist_spacings; maximum spacing in histogram + 1 */
     const double minErr = 0.2;
 
@@ -1731,10 +1785,10 @@ find_optimal_shift_in_a_window(Data *data, int ind_win, int win_beg, int win_end
         shiftMax = shiftMaxDefault;
 
     /* Set absolute parameters */
-    shift_inc = qv_round(shiftInc * crude_spacing_estimate);
+    shift_inc = qv_round(shiftInc * sm->crude_spacing_estimate);
     if ( shift_inc < 1 ) 
         shift_inc = 1;
-    shift_max = qv_round(shiftMax * crude_spacing_estimate);
+    shift_max = qv_round(shiftMax * sm->crude_spacing_estimate);
 
     /* Check for a good signal in each channel */
     tot_wgt = 0;
@@ -1834,8 +1888,8 @@ find_optimal_shift_in_a_window(Data *data, int ind_win, int win_beg, int win_end
               "        std_dev=%f best_std_dev=%f \n",  std_dev, best_std_dev);
 #endif 
                         if ((mean_spacing > DBL_EPSILON) &&
-                            (mean_spacing > crude_spacing_estimate-1.) &&
-                            (mean_spacing < crude_spacing_estimate+1.) &&
+                            (mean_spacing > sm->crude_spacing_estimate-1.) &&
+                            (mean_spacing < sm->crude_spacing_estimate+1.) &&
                             ( (spacing_var  < *best_spacing_var) 
                               ||
                              ((spacing_var == *best_spacing_var) &&
@@ -1964,8 +2018,9 @@ void prune_called_peaks( Data *data )
  */
 static int 
 make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS], 
-    Options *options, BtkMessage *message)
+    const Options *options, BtkMessage *message)
 {
+    SpacingModel *sm = &data->spacing;
     Peak	**peaks = data->peak_list; /* shortcut to peak_list */
     const int	  num_peaks = data->peak_list_len;
     const double  maxShiftMax        = MAX_SHIFT_MAX;
@@ -2063,9 +2118,7 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
             fprintf(stderr, "Before output anal data for win %d shift_buf=%d %d %d %d \n",
                 i, shift_buf[0], shift_buf[1], shift_buf[2], shift_buf[3]);
 #endif 
-            output_analyzed_data(filename, "Analyzed data for window", 
-                data->color_data[0].data, data->color_data[1].data,
-                data->color_data[2].data, data->color_data[3].data,
+            output_colordata(filename, "Analyzed data for window", 
                 win_beg, win_end, shift_buf, i, data);
         }
 
@@ -2092,14 +2145,14 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
         if (min_var * ONE_MINUS > spac_var[i]) {
             min_var = spac_var[i];
             i0 = i;
-            crude_spacing_estimate = spacing[i0];
+            sm->crude_spacing_estimate = spacing[i0];
         }
         if (max_var < spac_var[i] * ONE_MINUS ) {
             max_var = spac_var[i];
             j = i;
         }
     }
-    isweet = i0;
+    sm->isweet = i0;
 
     if (MONITOR > 1) {
         if ( (fp = fopen("tt_rel_spac_var", "w")) != NULL ) {
@@ -2176,9 +2229,7 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
             fprintf(stderr, "Before output shifted anal data for win i0 shift_buf=%d %d %d %d \n",
                 shift_buf[0], shift_buf[1], shift_buf[2], shift_buf[3]);
 #endif
-            output_analyzed_data(filename, "Shifted analyzed data for window", 
-                data->color_data[0].data, data->color_data[1].data,
-                data->color_data[2].data, data->color_data[3].data,
+            output_colordata(filename, "Shifted analyzed data for window", 
                 win_beg, win_end, shift_buf, i0, data);
         }
 
@@ -2260,9 +2311,7 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
             fprintf(stderr, "Before output shifted anal data for win %d shift_buf=%d %d %d %d \n",
                 i, shift_buf[0], shift_buf[1], shift_buf[2], shift_buf[3]);
 #endif
-                output_analyzed_data(filename, "Shifted analyzed data for window",
-                    data->color_data[0].data, data->color_data[1].data,
-                    data->color_data[2].data, data->color_data[3].data,
+                output_colordata(filename, "Shifted analyzed data for window",
                     win_beg, win_end, shift_buf, i, data);
             }
 
@@ -2361,9 +2410,7 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
             fprintf(stderr, "Before output shifted anal data for win %d shift_buf=%d %d %d %d \n",
                 i, shift_buf[0], shift_buf[1], shift_buf[2], shift_buf[3]);
 #endif
-                output_analyzed_data(filename,"Shifted analyzed data for window",
-                    data->color_data[0].data, data->color_data[1].data,
-                    data->color_data[2].data, data->color_data[3].data,
+                output_colordata(filename,"Shifted analyzed data for window",
                     win_beg, win_end, shift_buf, i, data);
             }
 
@@ -2438,10 +2485,10 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
         if (options->Verbose > 1)
             fprintf(stderr, "Warning: Poor mobility shift estimates.\n"
 	    "    No shift corrections applied.\n"
-	    "    Using constant default spacing of %f\n", crude_spacing_estimate);
-        spac_model_coeff[0] = crude_spacing_estimate;
+	    "    Using constant default spacing of %f\n", sm->crude_spacing_estimate);
+        sm->spac_model_coeff[0] = sm->crude_spacing_estimate;
         for ( i=1; i < POLYFIT_DEGREE + 1; i++ ) 
-            spac_model_coeff[i] = 0;
+            sm->spac_model_coeff[i] = 0;
     }
     else {
 	/* Fit mob. shifts with polynomial models */
@@ -2471,13 +2518,13 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
 
 #if POLY_MOB_SHIFT_APPROX
             /* Approximate mobility shift curve with polynomial */
-            polyfit(x, y[color], var, ngood+1, mobs_model_coeff, 
+            polyfit(x, y[color], var, ngood+1, sm->mobs_model_coeff, 
                 POLYFIT_DEGREE + 1);
             for (i=0; i < POLYFIT_DEGREE + 1; i++) 
-                a[color][i] = mobs_model_coeff[i];
+                a[color][i] = sm->mobs_model_coeff[i];
 #endif
             if (options->xgr) {
-                output_mobility_curve(x, y[color], ngood+1, mobs_model_coeff, 
+                output_mobility_curve(x, y[color], ngood+1, sm->mobs_model_coeff, 
                     POLYFIT_DEGREE + 1, color);
             }
 
@@ -2488,8 +2535,8 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
             if ( options->Verbose > 2 )
 	        printf("fitted polynomial coeff's for color %d: "
 	           "%10.3g %10.3g %10.3g\n",
-	           color, mobs_model_coeff[0], 
-                   mobs_model_coeff[1], mobs_model_coeff[2]);
+	           color, sm->mobs_model_coeff[0], 
+                   sm->mobs_model_coeff[1], sm->mobs_model_coeff[2]);
 #endif
         }
 
@@ -2553,8 +2600,10 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
                        }
                    }
                }
-               memcpy(data->color_data[color].data, new_trace, 
-                   length*sizeof(int));
+               for (j=0; j<length; j++) {
+                   data->color_data[color].data[j] = TT_SAMPLE(new_trace[j]);
+               }
+               colordata_release_signal_index(&data->color_data[color]);
             }
             FREE(new_trace);
         }
@@ -2576,50 +2625,52 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
         }
 
  	/* Calculate the spoacing curve 
-         * num_wins is local variable, and num_windows = global
+         * num_wins is local variable, and sm->num_windows is kept
+         * in the spacing model of the trace
          */
-        num_windows = num_wins; 
-        spac_mod_pos[i0] = data_beg + win_size* i0/2 + win_size/2;
-        spac_mod_val[i0] = spacing[i0];
-        for ( i=i0+1; i < num_windows; i++ )
+        sm->num_windows = num_wins; 
+        sm->spac_mod_pos[i0] = data_beg + win_size* i0/2 + win_size/2;
+        sm->spac_mod_val[i0] = spacing[i0];
+        for ( i=i0+1; i < sm->num_windows; i++ )
         {
-            spac_mod_pos[i] = data_beg + win_size* i/2 + win_size/2;
-            spac_mod_val[i] = spacing[i];
-            if (spac_mod_val[i] < spac_mod_val[i-1])
-                spac_mod_val[i] = spac_mod_val[i-1];
+            sm->spac_mod_pos[i] = data_beg + win_size* i/2 + win_size/2;
+            sm->spac_mod_val[i] = spacing[i];
+            if (sm->spac_mod_val[i] < sm->spac_mod_val[i-1])
+                sm->spac_mod_val[i] = sm->spac_mod_val[i-1];
 
             if ((spacing[i] <= 0) || isnan(spacing[i])) {
-                spac_mod_val[i] = spac_mod_val[i-1];
+                sm->spac_mod_val[i] = sm->spac_mod_val[i-1];
             }
             var[i] = spac_var[i];
         }
         for ( i=i0-1; i >=0; i--)
         {
-            spac_mod_pos[i] = data_beg + win_size* i/2 + win_size/2; 
-            spac_mod_val[i] = spacing[i];
+            sm->spac_mod_pos[i] = data_beg + win_size* i/2 + win_size/2; 
+            sm->spac_mod_val[i] = spacing[i];
             if ((spacing[i] <= 0) || isnan(spacing[i])) {
-                spac_mod_val[i] = spac_mod_val[i+1];
+                sm->spac_mod_val[i] = sm->spac_mod_val[i+1];
             } 
             var[i] = spac_var[i];
         }
 #if 0
-        fprintf(stderr, "i0=%d data_beg=%d data_end=%d num_windows=%d\n", 
-            i0, data_beg, data_end, num_windows);
-        fprintf(stderr, "spac_mod_pos=\n");
-        for ( i=0; i < num_windows; i++ )
-            fprintf(stderr, "%f ", spac_mod_pos[i]);
+        fprintf(stderr, "i0=%d data_beg=%d data_end=%d sm->num_windows=%d\n", 
+            i0, data_beg, data_end, sm->num_windows);
+        fprintf(stderr, "sm->spac_mod_pos=\n");
+        for ( i=0; i < sm->num_windows; i++ )
+            fprintf(stderr, "%f ", sm->spac_mod_pos[i]);
         fprintf(stderr, "\n");
         fprintf(stderr, "spacing=\n");
-        for ( i=0; i < num_windows; i++ )
+        for ( i=0; i < sm->num_windows; i++ )
             fprintf(stderr, "%f ", spacing[i]);
-        fprintf(stderr, "spac_mod_val=\n");
+        fprintf(stderr, "sm->spac_mod_val=\n");
         fprintf(stderr, "\n");
-        for ( i=0; i < num_windows; i++ )
-            fprintf(stderr, "%f ", spac_mod_val[i]);
+        for ( i=0; i < sm->num_windows; i++ )
+            fprintf(stderr, "%f ", sm->spac_mod_val[i]);
         fprintf(stderr, "\n");
 #endif
 
-        sliding_window5_average(spac_mod_val, num_windows);
+        sliding_window5_average(sm->spac_mod_val, sm->num_windows);
+        tabulate_spacing_curve(sm);
 
 //      polyfit(spac_mod_pos, spac_mod_val, var, num_windows, spac_model_coeff, 
 //          POLYFIT_DEGREE + 1);
@@ -2627,13 +2678,13 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
         if (options->Verbose > 2) {
             fprintf(stderr, "Spacing model coeff:\n");
             for ( i=0; i < POLYFIT_DEGREE; i++ ) {
-                fprintf(stderr, "c[%d]=%f ", i, spac_model_coeff[i]);
+                fprintf(stderr, "c[%d]=%f ", i, sm->spac_model_coeff[i]);
             }
             fprintf(stderr, "\n");
         }
 
         if (options->xgr) {
-            output_spacing_curve(spac_mod_pos, spac_mod_val, num_windows, 
+            output_spacing_curve(sm->spac_mod_pos, sm->spac_mod_val, sm->num_windows, 
                 POLYFIT_DEGREE + 1, win_size, data);
         }
 
@@ -2675,7 +2726,7 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
             for ( i=0; i < num_wins; i++ )
 	        fprintf(fp, "%7d %6.2f %6.2f %6.2f\n", 
                     win_size*(i-1)/2+win_size/2, spacing[i],
-		    spac_var[i], spacing_curve(INT_FLT(win_size*(i-1)/2+win_size/2)));
+		    spac_var[i], spacing_curve(data, INT_FLT(win_size*(i-1)/2+win_size/2)));
             fclose(fp);
         }
     }
@@ -2711,7 +2762,7 @@ make_DP_mobility_shifts(Data *data, int shift_flag[NUM_COLORS],
  *******************************************************************************
  */
 int
-get_peak_spacing(Data *data, Options *options, BtkMessage *message)
+get_peak_spacing(Data *data, const Options *options, BtkMessage *message)
 {
 
     int     i, num_peaks = data->peak_list_len;
@@ -2797,7 +2848,8 @@ last_base_pos(int *num_datapoints, int *data_end, int **chromatogram)
  *****************************************************************************
  */
 static void
-output_normalization_curves()
+output_normalization_curves(float norm_mod_val[NUM_COLORS][DEFAULT_NUM_WINDOWS],
+    int num_wins)
 {
     int   i;
     FILE *fp;
@@ -2809,28 +2861,28 @@ output_normalization_curves()
 
     /* Output computed normalization factor for 0th color */
     fprintf(fp, "\ncolor = %d\n", 4);       /* green  */
-    for (i=0; i<num_windows; i++) {
+    for (i=0; i<num_wins; i++) {
         fprintf(fp, "%d %f\n", i, norm_mod_val[0][i]);
     }
     fprintf(fp, "next\n");
 
     /* Output computed normalization factor for 1st  color */
     fprintf(fp, "\ncolor = %d\n", 9);       /* cyan   */
-    for (i=0; i<num_windows; i++) {
+    for (i=0; i<num_wins; i++) {
         fprintf(fp, "%d %f\n", i, norm_mod_val[1][i]);
     }
     fprintf(fp, "next\n");
 
     /* Output computed normalization factor for 2nd  color */
     fprintf(fp, "\ncolor = %d\n", 7);       /* yellow */
-    for (i=0; i<num_windows; i++) {
+    for (i=0; i<num_wins; i++) {
         fprintf(fp, "%d %f\n", i, norm_mod_val[2][i]);
     }
     fprintf(fp, "next\n");
 
     /* Output computed normalization factor for 3rd  color */
     fprintf(fp, "\ncolor = %d\n", 2);       /* red    */
-    for (i=0; i<num_windows; i++) {
+    for (i=0; i<num_wins; i++) {
         fprintf(fp, "%d %f\n", i, norm_mod_val[3][i]);
     }
     fprintf(fp, "next\n");
@@ -2891,12 +2943,17 @@ output_log_norm_curve(float *ave_int[NUM_COLORS], float *sum_ints[NUM_COLORS],
  *******************************************************************************
  */
 static int
-normalize_signals(Data *data, Options *options, BtkMessage *message)
+normalize_signals(Data *data, const Options *options, BtkMessage *message)
 {
+    SpacingModel *sm = &data->spacing;
     int    i, j, m, num_wins, win_size, win_beg, win_end, num_factors;
+    int    max_length;
     int    shift[NUM_COLORS]       = {0, 0, 0, 0};
     float  norm_factor[NUM_COLORS] = {0., 0., 0., 0.};
     float  average_peak_height;
+    float  norm_mod_val[NUM_COLORS][DEFAULT_NUM_WINDOWS];
+    float  norm_mod_pos[DEFAULT_NUM_WINDOWS];
+    float *gain = NULL;
     float *sum_ints[NUM_COLORS]  = {NULL, NULL, NULL, NULL}; 
     float *ave_int[NUM_COLORS]   = {NULL, NULL, NULL, NULL};
     int   *num_peaks[NUM_COLORS] = {NULL, NULL, NULL, NULL};
@@ -2907,11 +2964,14 @@ normalize_signals(Data *data, Options *options, BtkMessage *message)
         win_size = MIN_WIN_SIZE;
         num_wins = 2 * (data->pos_data_end - data->pos_data_beg) / win_size;
     }
-    num_windows = num_wins;
+    sm->num_windows = num_wins;
     for (i=0; i< NUM_COLORS; i++) {
         sum_ints[i]  = CALLOC(float, num_wins);
+        MEM_ERROR(sum_ints[i]);
         ave_int[i]   = CALLOC(float, num_wins);
+        MEM_ERROR(ave_int[i]);
         num_peaks[i] = CALLOC(int,   num_wins);
+        MEM_ERROR(num_peaks[i]);
     }
 
     /* Calculate the coefficients of normalization model */
@@ -2979,17 +3039,32 @@ normalize_signals(Data *data, Options *options, BtkMessage *message)
 
     /* Output normalization curves */
     for (i=0; i< NUM_COLORS; i++) {
-        sliding_window5_average(norm_mod_val[i], num_windows);
+        sliding_window5_average(norm_mod_val[i], num_wins);
     }
 
     if (options->xgr)
-        output_normalization_curves();
+        output_normalization_curves(norm_mod_val, num_wins);
 
-    /* Apply normalization model to data */
+    /* Apply normalization model to data: evaluate the model at every scan 
+     * once, then scale the signal by it 
+     */
+    max_length = 1;
     for (i=0; i< NUM_COLORS; i++) {
+        if (max_length < data->color_data[i].length)
+            max_length = data->color_data[i].length;
+    }
+    gain = CALLOC(float, max_length);
+    MEM_ERROR(gain);
+    for (i=0; i< NUM_COLORS; i++) {
+        TT_Sample *signal = data->color_data[i].data;
+
+        interpolate_windows(norm_mod_pos, norm_mod_val[i], num_wins, 0,
+            data->color_data[i].length, gain);
         for (j=0; j<data->color_data[i].length; j++) {
-            data->color_data[i].data[j] *= normalization_curve(j, i);
+            double value = signal[j] * (double)gain[j];
+            signal[j] = TT_SAMPLE(value);
         }
+        colordata_release_signal_index(&data->color_data[i]);
 
         /* Update peak heights upon normalization of data */
         for (j=0; j<data->color_data[i].peak_list_len; j++) {
@@ -3000,12 +3075,22 @@ normalize_signals(Data *data, Options *options, BtkMessage *message)
         }
     }
 
+    FREE(gain);
     for (i=0; i< NUM_COLORS; i++) {
         FREE(sum_ints[i]);
         FREE(ave_int[i]);
         FREE(num_peaks[i]);
     }
     return SUCCESS;
+
+error:
+    FREE(gain);
+    for (i=0; i< NUM_COLORS; i++) {
+        FREE(sum_ints[i]);
+        FREE(ave_int[i]);
+        FREE(num_peaks[i]);
+    }
+    return ERROR;
 }
 
 /*********************************************************************
@@ -3023,6 +3108,39 @@ output_chromatogram(char *filename, char *title, int *chromatogram0,
         0, num_datapoints, shift, -1, data);
 }
 
+/*********************************************************************
+ * Function: output_colordata
+ * Purpose:  output_analyzed_data() for the traces stored in data, 
+ *           which are widened to int first
+ *********************************************************************
+ */
+void
+output_colordata(char *filename, char *title, int data_beg, int data_end,
+    int *shift, int ind_win, Data *data)
+{
+    int  i, j;
+    int *chromatogram[NUM_COLORS] = {NULL, NULL, NULL, NULL};
+
+    for (i=0; i<NUM_COLORS; i++) {
+        chromatogram[i] = CALLOC(int, data->color_data[i].length);
+        if (chromatogram[i] == NULL) {
+            fprintf(stderr, "Out of memory writing %s\n", filename);
+            goto cleanup;
+        }
+        for (j=0; j<data->color_data[i].length; j++)
+            chromatogram[i][j] = data->color_data[i].data[j];
+    }
+
+    output_analyzed_data(filename, title,
+        chromatogram[0], chromatogram[1],
+        chromatogram[2], chromatogram[3],
+        data_beg, data_end, shift, ind_win, data);
+
+cleanup:
+    for (i=0; i<NUM_COLORS; i++)
+        FREE(chromatogram[i]);
+}
+
 /*********************************************************************
  * Function: get_baseline
  * Purpose:  return the min value of signal in the selected window
@@ -3191,7 +3309,7 @@ get_minor_matrix4(float **mcmatrix, float **mcminmat)
  ******************************************************************************
  */
 int
-prebaseline(int num_datapoints, int **chromatogram, Options *options,
+prebaseline(int num_datapoints, int **chromatogram, const Options *options,
     BtkMessage *message)
 {
     int win_size;
@@ -3239,7 +3357,7 @@ prebaseline(int num_datapoints, int **chromatogram, Options *options,
  ******************************************************************************
  */
 int
-make_multicomponent_iteration(int **chromatogram, int num_datapoints, Options *options,
+make_multicomponent_iteration(int **chromatogram, int num_datapoints, const Options *options,
     BtkMessage *message)
 {
     int       win_size;
@@ -3454,7 +3572,7 @@ error:
  */
 static void 
 prefilter_and_prebaseline(int *num_datapoints, int **chromatogram, int sample_rate, 
-    Options *options, BtkMessage *message)
+    const Options *options, BtkMessage *message)
 {
     int i;
     long new_num_datapoints = (long)(*num_datapoints);
@@ -3484,7 +3602,7 @@ prefilter_and_prebaseline(int *num_datapoints, int **chromatogram, int sample_ra
 
 static void
 multicomponent_data(int num_datapoints, int **chromatogram, 
-    Options *options, BtkMessage *message, Data *data)
+    const Options *options, BtkMessage *message, Data *data)
 {
     int i;
 
@@ -3550,29 +3668,47 @@ determine_beg_of_data(int *data_beg, int start_tol,
     return SUCCESS;
 }
 
+typedef struct {
+    int  **chromatogram;
+    long   num_datapoints;
+} BaselineTask;
+
+static int
+baseline_color(int color, void *arg)
+{
+    BaselineTask *bt = (BaselineTask *)arg;
+
+    if (DEBUG > 2)
+        fprintf(stderr, "color %d...\n", color);
+
+//  fprintf(stderr, "baselining... ");
+    zero_baseline(bt->chromatogram[color], bt->num_datapoints);
+//  fprintf(stderr, " done\n");
+    clip(bt->chromatogram[color], bt->num_datapoints, 0, SHRT_MAX);
+    return SUCCESS;
+}
+
 /*********************************************************************
  * Function: baseline_data    
  *********************************************************************
  */
 static void
-baseline_data(int *num_datapoints, int **chromatogram, Data *data)
+baseline_data(int *num_datapoints, int **chromatogram, Data *data,
+    const Options *options)
 {
     int i;
-    for ( i=0; i < NUM_COLORS; i++) {
-        if (DEBUG > 2)
-            fprintf(stderr, "color %d...\n", i);
+    BaselineTask bt;
 
-//      fprintf(stderr, "baselining... ");
-        zero_baseline(chromatogram[i], (long)(*num_datapoints));
-//      fprintf(stderr, " done\n");
-        clip(chromatogram[i], (long)(*num_datapoints), 0, SHRT_MAX);
-    }
+    bt.chromatogram = chromatogram;
+    bt.num_datapoints = (long)(*num_datapoints);
+    (void)run_tasks(baseline_color, NUM_COLORS, &bt, options->color_threads);
 
     for (i=0; i<NUM_COLORS; i++) {
         int j;
+        colordata_release_signal_index(&data->color_data[i]);
         data->color_data[i].length = *num_datapoints;
         for (j=0; j<data->color_data[i].length; j++)
-            data->color_data[i].data[j] = chromatogram[i][j];
+            data->color_data[i].data[j] = TT_SAMPLE(chromatogram[i][j]);
     }
     return;
 }
@@ -3583,7 +3719,7 @@ baseline_data(int *num_datapoints, int **chromatogram, Data *data)
  */
 static int 
 determine_end_of_data(int *num_datapoints, int **chromatogram,
-    int *data_end, Data *data, Options options)   
+    int *data_end, Data *data, const Options *options)   
 {
     int i, init_num_datapoints = *num_datapoints;
 
@@ -3591,7 +3727,7 @@ determine_end_of_data(int *num_datapoints, int **chromatogram,
         fprintf(stderr, "data_end=%d *num_datapoints=%d \n",
             *data_end, *num_datapoints);
 #endif
-    if (options.Verbose > 2)
+    if (options->Verbose > 2)
         fprintf(stderr, "determining last base pos ... ");
    *data_end = *num_datapoints;
     if (last_base_pos(num_datapoints, data_end, chromatogram)
@@ -3600,7 +3736,7 @@ determine_end_of_data(int *num_datapoints, int **chromatogram,
         return ERROR;
     }
     data->pos_data_end = *data_end;
-    if (options.Verbose > 2)
+    if (options->Verbose > 2)
         fprintf(stderr, " done...\n");
 
     if (CLIP_DATA_END) {
@@ -3616,7 +3752,7 @@ determine_end_of_data(int *num_datapoints, int **chromatogram,
                 chromatogram[i][j] = data->color_data[i].data[j];
 //          memcpy(data->color_data[i].data, chromatogram[i],
 //              data->color_data[i].length*sizeof(int));
-            if (options.Verbose > 2) {
+            if (options->Verbose > 2) {
                 fprintf(stderr, "Number of datapoints reduced from %d to %d\n",
                     init_num_datapoints, *num_datapoints);
             }
@@ -3634,7 +3770,7 @@ determine_end_of_data(int *num_datapoints, int **chromatogram,
  *******************************************************************************
  */
 static int
-process_peaks(int **chromatogram, Data *data, Options *options,
+process_peaks(int **chromatogram, Data *data, const Options *options,
     BtkMessage *message)
 {
     int i;
@@ -3682,7 +3818,7 @@ process_peaks(int **chromatogram, Data *data, Options *options,
  *******************************************************************************
  */
 static int 
-data_normalize(int **chromatogram, Data *data, Options *options, 
+data_normalize(int **chromatogram, Data *data, const Options *options, 
     BtkMessage *message)
 {
     int i;
@@ -3717,9 +3853,10 @@ data_normalize(int **chromatogram, Data *data, Options *options,
  */
 static int
 respace_chromatograms(int **chromatogram, int *num_data,
-    int alloc_chromat_len, Data *data, Options *options,
+    int alloc_chromat_len, Data *data, const Options *options,
     BtkMessage *message)
 {
+    SpacingModel *sm = &data->spacing;
     int     i, j, k, init_num_data = *num_data;
     int     scan=0, new_scan=0, new_last_scan=0;
     int    *new_chromatogram[NUM_COLORS];
@@ -3749,7 +3886,7 @@ respace_chromatograms(int **chromatogram, int *num_data,
 #endif
 
     /* Initialize */
-    spacing  = spacing_curve(scan);
+    spacing  = spacing_curve(data, scan);
     new_spacing = DEFAULT_SPACING;
     last_pos = 0.;
    *num_data = 0;
@@ -3762,7 +3899,7 @@ respace_chromatograms(int **chromatogram, int *num_data,
            (*num_data + new_spacing < alloc_chromat_len))
     {
 
-        spacing  = spacing_curve(scan);
+        spacing  = spacing_curve(data, scan);
 
 
 //      if (scan + spacing > init_num_data) {
@@ -3775,7 +3912,7 @@ respace_chromatograms(int **chromatogram, int *num_data,
 
 #if 0
         fprintf(stderr, "scan = %d spacing=%f new_spacing=%f last_pos=%f\n",
-            scan, spacing_curve(scan), new_spacing, last_pos);
+            scan, spacing_curve(data, scan), new_spacing, last_pos);
 #endif
         for (j=new_scan; j<new_scan+new_spacing; j++)
         {
@@ -3866,17 +4003,18 @@ respace_chromatograms(int **chromatogram, int *num_data,
     }
     for (i=0; i<NUM_COLORS; i++)
     {
+        colordata_release_signal_index(&data->color_data[i]);
         data->color_data[i].length = *num_data;
 #if 0
         fprintf(stderr, "alloc_chromat_len=%d num_data=%d\n",
             alloc_chromat_len, *num_data);
 #endif
-        data->color_data[i].data = REALLOC(data->color_data[i].data, int,
+        data->color_data[i].data = REALLOC(data->color_data[i].data, TT_Sample,
            *num_data);
         for (j=0; j < *num_data; j++)
         {
             chromatogram[i][j] = new_chromatogram[i][j];
-            data->color_data[i].data[j] = new_chromatogram[i][j];
+            data->color_data[i].data[j] = TT_SAMPLE(new_chromatogram[i][j]);
         }
     }
 
@@ -3965,31 +4103,32 @@ respace_chromatograms(int **chromatogram, int *num_data,
             FREE(dp);
         }
 
-        num_windows = num_wins;
+        sm->num_windows = num_wins;
 #if 0
-        fprintf(stderr, "num_windows=%d spacing=\n", num_windows);
+        fprintf(stderr, "sm->num_windows=%d spacing=\n", sm->num_windows);
 #endif
-        i0 = isweet;
-        spac_mod_val[i0] = mean_spacing[i0];
-        for ( i=i0+1; i < num_windows; i++ )
+        i0 = sm->isweet;
+        sm->spac_mod_val[i0] = mean_spacing[i0];
+        for ( i=i0+1; i < sm->num_windows; i++ )
         {
-            spac_mod_val[i] = mean_spacing[i];
+            sm->spac_mod_val[i] = mean_spacing[i];
             if ((mean_spacing[i] <= 0) || isnan(mean_spacing[i])) {
-                spac_mod_val[i] = spac_mod_val[i-1];
+                sm->spac_mod_val[i] = sm->spac_mod_val[i-1];
             }
         }
         for ( i=i0-1; i >=0; i--)
         {
-            spac_mod_val[i] = mean_spacing[i];
+            sm->spac_mod_val[i] = mean_spacing[i];
             if ((mean_spacing[i] <= 0) || isnan(mean_spacing[i])) {
-                spac_mod_val[i] = spac_mod_val[i+1];
+                sm->spac_mod_val[i] = sm->spac_mod_val[i+1];
             }
         }
 
-        sliding_window5_average(spac_mod_val, num_windows);
+        sliding_window5_average(sm->spac_mod_val, sm->num_windows);
+        tabulate_spacing_curve(sm);
 
         if (options->xgr) {
-            output_new_spacing_curve(spac_mod_pos, spac_mod_val, num_windows);   
+            output_new_spacing_curve(sm->spac_mod_pos, sm->spac_mod_val, sm->num_windows);   
         }
 
         FREE(mean_spacing);
@@ -4031,54 +4170,54 @@ error:
  */
 int
 Btk_process_raw_data(int *num_datapoints, int **chromatogram, 
-    char *color2base, Data *data, Options options, BtkMessage *message)
+    char *color2base, Data *data, const Options *options, BtkMessage *message)
 {
     int        i, sample_rate = 2, alloc_chromat_len = *num_datapoints * 3;
     int        init_num_datapoints = *num_datapoints;
     int        data_beg=0, data_end=*num_datapoints;
     const long start_tol = 500;  // if *data_beg > start_tol, throw away lead data
 
-    if (options.xgr) 
+    if (options->xgr) 
         output_chromatogram("0_Raw_data.xgr", "Raw data", 
         chromatogram[0], chromatogram[1], chromatogram[2], chromatogram[3],
        *num_datapoints, data);
 
     /* STEP1: filter out noise */
     prefilter_and_prebaseline(num_datapoints, chromatogram, sample_rate,
-        &options, message);
+        options, message);
 
-    if (options.xgr)
+    if (options->xgr)
         output_chromatogram("1_Prefilt_prebaselined_data.xgr",
         "Prefiltered and prebaselined data", 
         chromatogram[0], chromatogram[1], chromatogram[2], chromatogram[3],
         *num_datapoints, data);
 
     /* STEP2: (optionally) multicomponent */
-    if (options.multicomp) {
+    if (options->multicomp) {
         multicomponent_data(*num_datapoints, chromatogram,
-            &options, message, data);
+            options, message, data);
     }
 
     /* STEP3: determine first base position and optionally clip leading data*/
     determine_beg_of_data(&data_beg, start_tol, num_datapoints, 
         chromatogram, data);
 
-    if (options.xgr)
+    if (options->xgr)
         output_chromatogram("3_Filt_mult_lead-pruned_data.xgr",
             "Prefiltered, multicomponented and leader-pruned data", 
             chromatogram[0], chromatogram[1], chromatogram[2], chromatogram[3],
            *num_datapoints, data);
 
     /* STEP4: baseline */
-    baseline_data(num_datapoints, chromatogram, data);
+    baseline_data(num_datapoints, chromatogram, data, options);
         
-    if (options.xgr) 
+    if (options->xgr) 
         output_chromatogram("4_Filt_mult_lead-pruned_basel_data.xgr",
         "Prefiltered, multicomponented, leader-pruned and baselined data", 
         chromatogram[0], chromatogram[1], chromatogram[2], chromatogram[3],
        *num_datapoints, data);
 
-    if (options.Verbose  > 1)
+    if (options->Verbose  > 1)
         fprintf(stderr, "Number of datapoints reduced from %d to %d\n",
             init_num_datapoints, *num_datapoints);
    
@@ -4087,15 +4226,15 @@ Btk_process_raw_data(int *num_datapoints, int **chromatogram,
        &data_end, data, options);
 
     /* STEP6: process peaks and normalize data */
-    if (process_peaks(chromatogram, data, &options, message) != SUCCESS)
+    if (process_peaks(chromatogram, data, options, message) != SUCCESS)
         return ERROR;
 
 #if 1
-    if (data_normalize(chromatogram, data, &options, message) != SUCCESS)
+    if (data_normalize(chromatogram, data, options, message) != SUCCESS)
         return ERROR;
 #endif
 
-    if (options.xgr)
+    if (options->xgr)
          output_chromatogram("5_Analyzed_data.xgr", "Analyzed_data",
             chromatogram[0], chromatogram[1], chromatogram[2], chromatogram[3],
            *num_datapoints, data);
@@ -4105,24 +4244,24 @@ Btk_process_raw_data(int *num_datapoints, int **chromatogram,
         data_end);
  
     /* STEP7: correct mobility shifts */
-    get_peak_spacing(data, &options, message);
+    get_peak_spacing(data, options, message);
     for (i=0; i<NUM_COLORS; i++) {
         int j;
         for (j=0; j < *num_datapoints; j++)
             chromatogram[i][j] = data->color_data[i].data[j];
     }
   
-    if (options.xgr) 
+    if (options->xgr) 
          output_chromatogram("6_Analyzed_data_shifted.xgr",
             "Analyzed data_shifted", 
              chromatogram[0], chromatogram[1], chromatogram[2], chromatogram[3],
             *num_datapoints, data);
 
     if (respace_chromatograms(chromatogram, num_datapoints, alloc_chromat_len,
-        data, &options, message) != SUCCESS)
+        data, options, message) != SUCCESS)
         return ERROR;
 
-    if (options.xgr)
+    if (options->xgr)
          output_chromatogram("7_Analyzed_data_respaced.xgr",
             "Analyzed data_shifted_and_respaced", 
             chromatogram[0], chromatogram[1], chromatogram[2], chromatogram[3],
@@ -20,16 +20,18 @@
  *************************************************************************/
 
 #define DEFAULT_PEAK_SPACING 12
-#define POLYFIT_DEGREE 5
 #define NUM_MULTICOMP_ITER 16
 
-extern int get_peak_spacing(Data *, Options *, BtkMessage *);
+extern int get_peak_spacing(Data *, const Options *, BtkMessage *);
 extern int Btk_process_raw_data(int *, int **, char *, Data *, 
-    Options, BtkMessage *);
+    const Options *, BtkMessage *);
 extern void output_analyzed_data(char *, char *, int *, int *, int *, int *,
     int, int, int *, int, Data *);
 extern void output_chromatogram(char *, char *, int *, int *, int *, int *,
     int, Data *);
-extern int multicomponent(int **, int, Options *, BtkMessage *);
-extern int prebaseline(int, int **, Options *, BtkMessage *);
-extern double spacing_curve(int);
+extern void output_colordata(char *, char *, int, int, int *, int, Data *);
+extern int multicomponent(int **, int, const Options *, BtkMessage *);
+extern int prebaseline(int, int **, const Options *, BtkMessage *);
+extern double spacing_curve(const Data *, int);
+extern void spacing_model_init(SpacingModel *);
+extern void spacing_model_release(SpacingModel *);
@@ -47,6 +47,8 @@
 /*#define RESOLUTION_FACTOR 0.00001*/
 #define MERGE_PEAKS 0
 #define MAX_NAME_LENGTH 256
+#define DEFAULT_NUM_WINDOWS 40 /* max # of windows of the spacing model */
+#define POLYFIT_DEGREE 5
 
 extern double Erf(double);
 extern double F(double);
@@ -118,12 +120,29 @@ typedef struct {
     int    orig_length;
 } TT_Bases;
 
+/*
+ * Storage type of the chromatogram samples held in ColorData. Building
+ * with -DTT_SAMPLE16 (make SAMPLE16=1) stores unsigned 16-bit samples,
+ * halving the footprint and memory traffic of the most traversed arrays;
+ * kernels widen samples to int for arithmetic, and every store into
+ * ColorData.data goes through TT_SAMPLE(), which saturates to the range.
+ */
+#ifdef TT_SAMPLE16
+typedef unsigned short TT_Sample;
+#define TT_SAMPLE_MAX  65535
+#define TT_SAMPLE(v)   ((v) <= 0 ? 0 : \
+                        ((v) >= TT_SAMPLE_MAX ? TT_SAMPLE_MAX : (TT_Sample)(v)))
+#else
+typedef int TT_Sample;
+#define TT_SAMPLE(v)   (v)
+#endif
+
 typedef struct {
     char  base;			/* the base, 'A', 'C', 'G' or 'T', is linked
 				 * to the color_number depending on the sample
 				 * file 
                                  */
-    int  *data;			/* data points for a particular color_number */
+    TT_Sample *data;		/* data points for a particular color_number */
     int   dye_number;		/* 1, 2, ..., NUM_COLORS  */
     int   length;		/* length of the data array */       
     int   max_value;		/* maximum value of signal for the trace */
@@ -135,6 +154,27 @@ typedef struct {
     int   peak_list_max_len;	/* default peak list length, MAX_NUM_OF_PEAK, which
 				 * is used when initializing the structure 
                                  */
+    int  *scan_peak_index;      /* index of the peak covering each scan, or -1;
+                                 * NULL unless built by 
+                                 * colordata_build_scan_index 
+                                 */
+    int   scan_peak_index_len;  /* length of the array scan_peak_index */
+    int   scan_peak_index_stale;/* set if the peak list has been edited 
+                                 * since the scan index was built; the 
+                                 * next lookup by scan then rebuilds it
+                                 */
+    double *signal_sum;         /* signal_sum[i] is the sum of data[0 .. i-1];
+                                 * NULL unless built by 
+                                 * colordata_build_signal_index 
+                                 */
+    int  *signal_max;           /* sparse table of the positions of range 
+                                 * maxima of data, signal_max_levels rows
+                                 * of length signal_index_len
+                                 */
+    int   signal_max_levels;
+    int   signal_index_len;     /* length of data indexed, or -1 if the data
+                                 * can't be indexed 
+                                 */
 } ColorData;
 
 typedef struct {
@@ -145,6 +185,22 @@ typedef struct {
     double *psr7;		/* peak distance (or spacing) ratio */
 } TraceParameters;
 
+/* Peak spacing and mobility model of a trace, estimated from its raw data
+ * by get_peak_spacing() and refined when the data are respaced
+ */
+typedef struct {
+    int     num_windows;           /* number of windows in use */
+    int     isweet;                /* window with the most reliable spacing */
+    double  crude_spacing_estimate;
+    float   mobs_model_coeff[POLYFIT_DEGREE + 1];
+    float   spac_model_coeff[POLYFIT_DEGREE + 1];
+    float   spac_mod_val[DEFAULT_NUM_WINDOWS];
+    float   spac_mod_pos[DEFAULT_NUM_WINDOWS];
+    float  *spac_curve;            /* spacing model tabulated per scan */
+    int     spac_curve_beg;
+    int     spac_curve_len;
+} SpacingModel;
+
 typedef struct {
     TT_Bases      bases;
     ColorData  color_data[NUM_COLORS];	/* chromatograms */
@@ -156,11 +212,13 @@ typedef struct {
     int        pos_data_beg;            /* used when processing raw data */
     int        pos_data_end;            /* used when processing raw data */
     TraceParameters trace_parameters;
+    SpacingModel spacing;
     char       chemistry[MAX_NAME_LENGTH];
 } Data;
 
 typedef struct {
     char  *chemistry;                       
+    int    color_threads;     /* run the per-color stages of a trace on threads */
     int    edited_bases;      /* use edited, rather than called, bases */
     char   file_name[MAX_NAME_LENGTH]; /* sample file name        */
     int    gauss;             /* use gaussian peak shape model */
@@ -218,5 +276,5 @@ typedef enum {
 } TABLETYPE;
 
 extern void
-exit_message(Options *, int);
+exit_message(const Options *, int);
 #endif
@@ -26,8 +26,25 @@
 #ifndef __BTK_QV_FUNS__
 #define __BTK_QV_FUNS__
 
+/* The grids of the tables of Btk_qv_tables.h, which mkqvtables generates */
+#define EXP2_TABLE_SIZE 4000
+#define EXP2_MAX_X      4.0
+#define PEAK_TABLE_SIZE 401             /* of tPhi and tW1 */
+#define XMIN_PHI        0.9404511322
+#define DX_PHI          0.0001486222
+#define XMIN_W1         0.0001
+#define DX_W1           0.0249997500
+
+/* Coefficients of the approximation of the error function */
+#define ERF_P           0.47047
+#define ERF_A1          0.3480242
+#define ERF_A2         -0.0958798
+#define ERF_A3          0.7478556
+
 extern double Erf(double);
 extern double Shape(double, double, double, double, const Options *);
+extern void   ShapeArray(double, double, double, const double *, int, double *,
+                  const Options *);
 extern double W1(double);
 extern double Phi(double);
 
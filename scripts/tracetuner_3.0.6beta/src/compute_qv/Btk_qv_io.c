@@ -69,10 +69,8 @@
 #define SHOW_SUBSTITUTIONS           0
 #define USE_DEFAULT_CHEMISTRY        0
 
-unsigned int max_colordata_value;
-
 void
-exit_message(Options *op, int errlevel)
+exit_message(const Options *op, int errlevel)
 {
     fprintf(stderr,
         "TraceTuner exiting abruptly with errorlevel %d while processing trace %s\n",
@@ -214,7 +212,7 @@ read_fasta(char* file_name, Contig* contig, BtkMessage *message)
  */
 static int
 read_abi_nums(int *num_called_bases, int use_edited_bases, int *num_datapoints,
-Options *options)
+const Options *options)
 {
     ABIError   r;
     int        j;
@@ -277,7 +275,7 @@ Options *options)
  ********************************************************************************
  */
 static int
-read_scf_nums(int *num_called_bases, int *num_datapoints, Options *options)
+read_scf_nums(int *num_called_bases, int *num_datapoints, const Options *options)
 {
      long num_bases;
      long num_points;
@@ -518,80 +516,54 @@ read_scf_color_data(int num_values,
                     char *color2base,
                     BtkMessage *message)
 {
-     int  *analyzed_data;
-     short dye_number;
-     int   i;
-
-     analyzed_data = CALLOC(int, num_values);
-     MEM_ERROR(analyzed_data);
-
      color2base[0] = 'A';
      color2base[1] = 'C';
      color2base[2] = 'G';
      color2base[3] = 'T';
 
-     for (dye_number = 0; dye_number < NUM_COLORS; dye_number++)
-     {
-          SCF_AnalyzedData(dye_number, analyzed_data);
+     /* All four channels are decoded in one pass, straight into place */
+     SCF_AllAnalyzedData(chromatogram);
 
-          for (i = 0; i < num_values; i++)
-               chromatogram[dye_number][i] = analyzed_data[i];
-     }
+     return SUCCESS;
+}
 
-     FREE(analyzed_data);
 
-     return SUCCESS;
+#ifndef __WIN32
+/*******************************************************************************
+ * Function: make_temp_file
+ * Purpose:  create an empty file with a unique name to uncompress a sample
+ *           file into, so that concurrent runs never share it
+ *******************************************************************************
+ */
+static int
+make_temp_file(char *temp_file_name, BtkMessage *message)
+{
+    int fd;
 
- error:
-     return kMemoryFull;
-}
+    strcpy(temp_file_name, "/tmp/ttunerXXXXXX");
+    if ((fd = mkstemp(temp_file_name)) < 0) {
+        sprintf(message->text, 
+            "could not create a temporary file, errno = %d", errno);
+        temp_file_name[0] = '\0';
+        return ERROR;
+    }
+    close(fd);
 
+    return SUCCESS;
+}
+#endif
 
-/*
- * This function extracts base calls and chromatogram traces from a single
- * sample file.  Its synopsis is:
- *
- * result = Btk_read_sample_file(file_name, num_bases, called_bases,
- *	called_locs, num_values, avals, cvals,
- *	gvals, tvals, call_method, chemistry,
- *	options, message, verbose)
- *
- * where
- *	file_name	is the name (path) of the sample file
- *	num_bases	is the address where the number of bases will be put
- *	called_bases	is the address where a pointer to the array of called
- *			bases will be put
- *      edited_bases      integer which indicates whether to use the array of
- *                      called (0) or edited bases (1) from sample file
- *	called_locs	is the address where a pointer to the array of called
- *			base locations will be put
- *	num_values	is the address where the number of trace points will
- *			be put
- *	avals		is the address where a pointer to the array of A trace
- *			points will be put
- *	cvals		is the address where a pointer to the array of C trace
- *			points will be put
- *	gvals		is the address where a pointer to the array of G trace
- *			points will be put
- *	tvals		is the address where a pointer to the array of T trace
- *			points will be put
- *	call_method	is an optional address where a string that describes
- *			the method used to call the bases will be put
- *	chemistry	is an optional address where a string that describes
- *			the chemistry used (primer or terminator) will be put
- *	message		is the address of a BtkMessage where information about
- *			an error will be put, if any
- *	verbose		is whether to write status messages to stderr, and
- *			how verbosely
- *
- *	result		is 0 on success, !0 if an error occurs
- *
- * The caller is responsible for free()ing the arrays returned; the convenience
- * function Btk_release_file_data() can be used for this purpose.
+/*******************************************************************************
+ * Function: read_sample_data
+ * Purpose:  extract base calls and chromatogram traces from a sample file 
+ *           opened by F_Open() or F_OpenBuffer(); the arguments are as for
+ *           Btk_read_sample_file(). The caller closes the file.
+ *******************************************************************************
  */
-int
-Btk_read_sample_file(
-    char       *file_name,
+static int
+read_sample_data(
+    int         fileType,
+    const char *seq_name,
     int        *num_bases,
     char      **called_bases,
     int         use_edited_bases,
@@ -605,145 +577,24 @@ Btk_read_sample_file(
     char      **call_method,
     char      **chemistry,
     char       *status_code,
-    Options     options,
+    const Options *options,
     BtkMessage *message)
 {
-    char *seq_name;
     int   i, r=0;
     int  *chromatogram[NUM_COLORS] = {NULL, NULL, NULL, NULL};
-    void *p;
-    long  fileSize, n;
+    long  n;
     char  color2base[5];
-    int   fileType = -1;
-    unsigned char magic[2];
-    FILE *fp;
     char  tempFileName[MAX_FILE_NAME_LENGTH] = "";
-    char  command[2048];
     char  phd_file_name[1000];
 
     for (i = 0; i < NUM_COLORS; i++) {
         chromatogram[i] = NULL;
     }
-   *called_bases = NULL;
-   *called_locs  = NULL;
-
-    /* Set seq_name to just the name of the file, no leading path. */
-
-#ifdef __WIN32
-    if ((seq_name = strrchr(file_name, '\\')) != NULL) {
-#else
-    if ((seq_name = strrchr(file_name, '/')) != NULL) {
-#endif
-        seq_name++;
-    }
-    else {
-        seq_name = file_name;
-    }
-
-    if ((fp = fopen(file_name, "r")) == NULL)
-    {
-        sprintf(message->text,
-                "could not open file for reading, errno = %d", errno);
-        return ERROR;
-    }
-    fread(magic, 1, 2, fp);
-    fclose(fp);
-
-#ifdef __WIN32
-    if (magic[0] == 0x1f && magic[1] == 0x8b)   /* gzipped file */
-    {
-        sprintf(tempFileName, "TTUNERQQ.TMP");
-
-        sprintf(command, "gzip -d -f -c %s > TTUNERQQ.TMP", file_name);
-
-        if (system(command) != 0)
-        {
-            sprintf(message->text,
-                    "gunzip command failed on file %s, errno = %d", file_name,
-                    errno);
-            return ERROR;
-        }
-    }
-    else if (magic[0] == 0x1f && magic[1] == 0x9d)   /* UNIX compressed file */
-    {
-        if (seq_name[strlen(seq_name) - 2] != '.' ||
-            seq_name[strlen(seq_name) - 1] != 'Z')
-        {
-            sprintf(message->text,
-                    "cannot uncompress file %s, name must end in .Z",
-                    file_name);
-            return ERROR;
-        }
-
-        sprintf(tempFileName, "TTUNERQQ.TMP");
-
-        sprintf(command, "gzip -d -f -c %s > TTUNERQQ.TMP", file_name);
-
-        if (system(command) != 0)
-        {
-            sprintf(message->text,
-                    "gunzip command failed on file %s, errno = %d", file_name,
-                    errno);
-            return ERROR;
-        }
-    }
-#else
-    if (magic[0] == 0x1f && magic[1] == 0x8b)   /* gzipped file */
-    {
-        sprintf(tempFileName, "/tmp/%s", seq_name);
-        if (seq_name[strlen(seq_name) - 3] == '.' &&
-            seq_name[strlen(seq_name) - 2] == 'g' &&
-            seq_name[strlen(seq_name) - 1] == 'z')
-            tempFileName[strlen(tempFileName) - 3] = '\0';
-
-        sprintf(command, "gunzip -f -c %s > %s", file_name, tempFileName);
-        if (system(command) != 0)
-        {
-            sprintf(message->text,
-                    "gunzip command failed on file %s, errno = %d", file_name,
-                    errno);
-            return ERROR;
-        }
-    }
-    else if (magic[0] == 0x1f && magic[1] == 0x9d)   /* UNIX compressed file */
-    {
-        if (seq_name[strlen(seq_name) - 2] != '.' ||
-            seq_name[strlen(seq_name) - 1] != 'Z')
-        {
-            sprintf(message->text,
-                    "cannot uncompress file %s, name must end in .Z",
-                    file_name);
-            return ERROR;
-        }
-
-        sprintf(tempFileName, "/tmp/%s", seq_name);
-                tempFileName[strlen(tempFileName) - 2] = '\0';
-
-        sprintf(command, "uncompress -f -c %s > %s", file_name, tempFileName);
-        if (system(command) != 0)
-        {
-            sprintf(message->text,
-                    "gunzip command failed on file %s, errno = %d", file_name,
-                    errno);
-            return ERROR;
-        }
-    }
-#endif
-
-    if ((r = F_Open(tempFileName[0] != '\0' ? tempFileName : file_name,
-                    &p, &fileSize, &fileType)) != kNoError) {
-        sprintf(message->text, "Error opening file: %s", 
-                  ABI_ErrorString((ABIError)r));
-        goto error;
-    }
-
-    if (tempFileName[0] != '\0')
-        unlink(tempFileName);
 
     if (fileType == ABI)
     {
          if ((r = read_abi_nums(num_bases, use_edited_bases, num_values,
-             &options)) != kNoError) {
+             options)) != kNoError) {
               strcpy(status_code, "ABIFILE_FAILURE");
               sprintf(message->text, "Error reading file: %s",
                       ABI_ErrorString((ABIError)r));
@@ -752,7 +603,7 @@ Btk_read_sample_file(
     }
     else if (fileType == SCF)
     {
-         if ((r = read_scf_nums(num_bases, num_values, &options))
+         if ((r = read_scf_nums(num_bases, num_values, options))
              != kNoError) {
              strcpy(status_code, "ABIFILE_FAILURE");
              sprintf(message->text, "Error reading file: %s",
@@ -761,13 +612,13 @@ Btk_read_sample_file(
          }
     }
 
-    if ((options.Verbose > 1) &&
+    if ((options->Verbose > 1) &&
         (fileType == ABI && use_edited_bases) &&
-        (options.inp_phd == 0)) {
+        (options->inp_phd == 0)) {
         fprintf(stderr, "Starting from edited bases\n");
     }
 
-    if ((options.inp_phd == 0) && (num_bases > 0)) {
+    if ((options->inp_phd == 0) && (num_bases > 0)) {
         /* Allocate memory for data arrays */
        *called_bases = CALLOC(char, *num_bases);
         MEM_ERROR(*called_bases);
@@ -782,7 +633,7 @@ Btk_read_sample_file(
          MEM_ERROR(chromatogram);
     }
 
-    if ((fileType == ABI) && (options.inp_phd == 0))
+    if ((fileType == ABI) && (options->inp_phd == 0))
     {
          if ((r = read_abi_bases_locs_and_quality_values(*num_bases,
                 *called_bases, use_edited_bases, *called_locs,
@@ -795,7 +646,7 @@ Btk_read_sample_file(
               goto error;
          }
     }
-    else if ((fileType == SCF) && (options.inp_phd == 0))
+    else if ((fileType == SCF) && (options->inp_phd == 0))
     {
          if ((r = read_scf_bases_and_locs(*num_bases, *called_bases,
             *called_locs, message))
@@ -839,7 +690,7 @@ Btk_read_sample_file(
          }
     }
 
-    if (options.Verbose > 2) {
+    if (options->Verbose > 2) {
          (void)fprintf(stderr, "Base order: %c%c%c%c\n", color2base[0],
             color2base[1], color2base[2], color2base[3]);
     }
@@ -866,7 +717,7 @@ Btk_read_sample_file(
          }
     }
 
-    if (*chemistry != NULL) {
+    if ((chemistry != NULL) && (*chemistry != NULL)) {
         *chemistry = CALLOC(char, BTKMESSAGE_LENGTH);
          MEM_ERROR(*chemistry);
 
@@ -886,13 +737,16 @@ Btk_read_sample_file(
          }
     }
 
-    F_Close(p, fileType);
-    p = NULL;
-
     /* If -ipd <dir> option is used, read original bases and
      * locations from phd file, rather than from sample file
      */
-    if (options.inp_phd) {
+    if (options->inp_phd) {
+        if (seq_name == NULL) {
+            sprintf(message->text, 
+                "the name of the sample is needed to find its phd file");
+            r = ERROR;
+            goto error;
+        }
         strcpy(tempFileName, seq_name);
         if (seq_name[strlen(seq_name) - 3] == '.' &&
             seq_name[strlen(seq_name) - 2] == 'g' &&
@@ -905,10 +759,10 @@ Btk_read_sample_file(
         }
 #ifdef __WIN32
         sprintf(phd_file_name, "%s\\%s.phd.1",
-            options.inp_phd_dir, tempFileName);
+            options->inp_phd_dir, tempFileName);
 #else
         sprintf(phd_file_name, "%s/%s.phd.1",
-            options.inp_phd_dir, tempFileName);
+            options->inp_phd_dir, tempFileName);
 #endif
        *num_bases = -1;
         if ((*num_bases = get_phd_num_bases(phd_file_name, message)) < 0)
@@ -948,96 +802,295 @@ Btk_read_sample_file(
             }
 #if 0
             fprintf(stderr, "options.Verbose=%d options.inp_phd =%d\n",
-               options.Verbose, options.inp_phd);
+               options->Verbose, options->inp_phd);
 #endif
-            if ((options.Verbose > 1) && (options.inp_phd > 0))
+            if ((options->Verbose > 1) && (options->inp_phd > 0))
             fprintf(stderr,
                "Reading original bases and locations from phd file: %s\n",
                phd_file_name);
         }
     }
 
-    /* Set the correct input vars to the correct colors */
-    switch(color2base[0]) {
-    case 'A':
-         *avals = chromatogram[0];
-         break;
-    case 'C':
-         *cvals = chromatogram[0];
-         break;
-    case 'G':
-         *gvals = chromatogram[0];
-         break;
-    case 'T':
-         *tvals = chromatogram[0];
-         break;
-    default:
-         (void)sprintf(message->text, "unknown color '%c'", color2base[0]);
-         r = ERROR;
-         goto error;
-    }
-    switch(color2base[1]) {
-    case 'A':
-         *avals = chromatogram[1];
-         break;
-    case 'C':
-         *cvals = chromatogram[1];
-         break;
-    case 'G':
-         *gvals = chromatogram[1];
-         break;
-    case 'T':
-         *tvals = chromatogram[1];
-         break;
-    default:
-         (void)sprintf(message->text, "unknown color '%c'", color2base[1]);
-         r = ERROR;
-         goto error;
-    }
-    switch(color2base[2]) {
-    case 'A':
-         *avals = chromatogram[2];
-         break;
-    case 'C':
-         *cvals = chromatogram[2];
-         break;
-    case 'G':
-         *gvals = chromatogram[2];
-         break;
-    case 'T':
-         *tvals = chromatogram[2];
-         break;
-    default:
-         (void)sprintf(message->text, "unknown color '%c'", color2base[2]);
-         r = ERROR;
-         goto error;
-    }
-    switch(color2base[3]) {
-    case 'A':
-         *avals = chromatogram[3];
-         break;
-    case 'C':
-         *cvals = chromatogram[3];
-         break;
-    case 'G':
-         *gvals = chromatogram[3];
-         break;
-    case 'T':
-         *tvals = chromatogram[3];
-         break;
-    default:
-         (void)sprintf(message->text, "unknown color '%c'", color2base[3]);
-         r = ERROR;
-         goto error;
+    /* Set the correct input vars to the correct colors */
+    switch(color2base[0]) {
+    case 'A':
+         *avals = chromatogram[0];
+         break;
+    case 'C':
+         *cvals = chromatogram[0];
+         break;
+    case 'G':
+         *gvals = chromatogram[0];
+         break;
+    case 'T':
+         *tvals = chromatogram[0];
+         break;
+    default:
+         (void)sprintf(message->text, "unknown color '%c'", color2base[0]);
+         r = ERROR;
+         goto error;
+    }
+    switch(color2base[1]) {
+    case 'A':
+         *avals = chromatogram[1];
+         break;
+    case 'C':
+         *cvals = chromatogram[1];
+         break;
+    case 'G':
+         *gvals = chromatogram[1];
+         break;
+    case 'T':
+         *tvals = chromatogram[1];
+         break;
+    default:
+         (void)sprintf(message->text, "unknown color '%c'", color2base[1]);
+         r = ERROR;
+         goto error;
+    }
+    switch(color2base[2]) {
+    case 'A':
+         *avals = chromatogram[2];
+         break;
+    case 'C':
+         *cvals = chromatogram[2];
+         break;
+    case 'G':
+         *gvals = chromatogram[2];
+         break;
+    case 'T':
+         *tvals = chromatogram[2];
+         break;
+    default:
+         (void)sprintf(message->text, "unknown color '%c'", color2base[2]);
+         r = ERROR;
+         goto error;
+    }
+    switch(color2base[3]) {
+    case 'A':
+         *avals = chromatogram[3];
+         break;
+    case 'C':
+         *cvals = chromatogram[3];
+         break;
+    case 'G':
+         *gvals = chromatogram[3];
+         break;
+    case 'T':
+         *tvals = chromatogram[3];
+         break;
+    default:
+         (void)sprintf(message->text, "unknown color '%c'", color2base[3]);
+         r = ERROR;
+         goto error;
+    }
+
+    return SUCCESS;
+
+    error:
+    if (chromatogram[0] != NULL) {
+         Btk_release_file_data(*called_bases, *called_locs, *quality_values,
+             chromatogram, call_method, (chemistry != NULL) ? chemistry : NULL);
+    }
+    return r;
+}
+
+
+/*
+ * This function extracts base calls and chromatogram traces from a single
+ * sample file.  Its synopsis is:
+ *
+ * result = Btk_read_sample_file(file_name, num_bases, called_bases,
+ *	called_locs, num_values, avals, cvals,
+ *	gvals, tvals, call_method, chemistry,
+ *	options, message, verbose)
+ *
+ * where
+ *	file_name	is the name (path) of the sample file
+ *	num_bases	is the address where the number of bases will be put
+ *	called_bases	is the address where a pointer to the array of called
+ *			bases will be put
+ *      edited_bases      integer which indicates whether to use the array of
+ *                      called (0) or edited bases (1) from sample file
+ *	called_locs	is the address where a pointer to the array of called
+ *			base locations will be put
+ *	num_values	is the address where the number of trace points will
+ *			be put
+ *	avals		is the address where a pointer to the array of A trace
+ *			points will be put
+ *	cvals		is the address where a pointer to the array of C trace
+ *			points will be put
+ *	gvals		is the address where a pointer to the array of G trace
+ *			points will be put
+ *	tvals		is the address where a pointer to the array of T trace
+ *			points will be put
+ *	call_method	is an optional address where a string that describes
+ *			the method used to call the bases will be put
+ *	chemistry	is an optional address where a string that describes
+ *			the chemistry used (primer or terminator) will be put
+ *	message		is the address of a BtkMessage where information about
+ *			an error will be put, if any
+ *	verbose		is whether to write status messages to stderr, and
+ *			how verbosely
+ *
+ *	result		is 0 on success, !0 if an error occurs
+ *
+ * The caller is responsible for free()ing the arrays returned; the convenience
+ * function Btk_release_file_data() can be used for this purpose.
+ */
+int
+Btk_read_sample_file(
+    char       *file_name,
+    int        *num_bases,
+    char      **called_bases,
+    int         use_edited_bases,
+    int       **called_locs,
+    int       **quality_values,
+    int        *num_values,
+    int       **avals,
+    int       **cvals,
+    int       **gvals,
+    int       **tvals,
+    char      **call_method,
+    char      **chemistry,
+    char       *status_code,
+    const Options *options,
+    BtkMessage *message)
+{
+    char *seq_name;
+    int   r=0;
+    void *p = NULL;
+    long  fileSize;
+    int   fileType = -1;
+    unsigned char magic[2];
+    FILE *fp;
+    char  tempFileName[MAX_FILE_NAME_LENGTH] = "";
+    char  command[2048];
+
+   *called_bases = NULL;
+   *called_locs  = NULL;
+
+    /* Set seq_name to just the name of the file, no leading path. */
+
+#ifdef __WIN32
+    if ((seq_name = strrchr(file_name, '\\')) != NULL) {
+#else
+    if ((seq_name = strrchr(file_name, '/')) != NULL) {
+#endif
+        seq_name++;
+    }
+    else {
+        seq_name = file_name;
+    }
+
+    if ((fp = fopen(file_name, "r")) == NULL)
+    {
+        sprintf(message->text,
+                "could not open file for reading, errno = %d", errno);
+        return ERROR;
+    }
+    fread(magic, 1, 2, fp);
+    fclose(fp);
+
+#ifdef __WIN32
+    if (magic[0] == 0x1f && magic[1] == 0x8b)   /* gzipped file */
+    {
+        sprintf(tempFileName, "TTUNERQQ.TMP");
+
+        sprintf(command, "gzip -d -f -c %s > TTUNERQQ.TMP", file_name);
+
+        if (system(command) != 0)
+        {
+            sprintf(message->text,
+                    "gunzip command failed on file %s, errno = %d", file_name,
+                    errno);
+            return ERROR;
+        }
+    }
+    else if (magic[0] == 0x1f && magic[1] == 0x9d)   /* UNIX compressed file */
+    {
+        if (seq_name[strlen(seq_name) - 2] != '.' ||
+            seq_name[strlen(seq_name) - 1] != 'Z')
+        {
+            sprintf(message->text,
+                    "cannot uncompress file %s, name must end in .Z",
+                    file_name);
+            return ERROR;
+        }
+
+        sprintf(tempFileName, "TTUNERQQ.TMP");
+
+        sprintf(command, "gzip -d -f -c %s > TTUNERQQ.TMP", file_name);
+
+        if (system(command) != 0)
+        {
+            sprintf(message->text,
+                    "gunzip command failed on file %s, errno = %d", file_name,
+                    errno);
+            return ERROR;
+        }
+    }
+#else
+    if (magic[0] == 0x1f && magic[1] == 0x8b)   /* gzipped file */
+    {
+        if (make_temp_file(tempFileName, message) != SUCCESS)
+            return ERROR;
+
+        sprintf(command, "gunzip -f -c %s > %s", file_name, tempFileName);
+        if (system(command) != 0)
+        {
+            sprintf(message->text,
+                    "gunzip command failed on file %s, errno = %d", file_name,
+                    errno);
+            return ERROR;
+        }
+    }
+    else if (magic[0] == 0x1f && magic[1] == 0x9d)   /* UNIX compressed file */
+    {
+        if (seq_name[strlen(seq_name) - 2] != '.' ||
+            seq_name[strlen(seq_name) - 1] != 'Z')
+        {
+            sprintf(message->text,
+                    "cannot uncompress file %s, name must end in .Z",
+                    file_name);
+            return ERROR;
+        }
+
+        if (make_temp_file(tempFileName, message) != SUCCESS)
+            return ERROR;
+
+        sprintf(command, "uncompress -f -c %s > %s", file_name, tempFileName);
+        if (system(command) != 0)
+        {
+            sprintf(message->text,
+                    "gunzip command failed on file %s, errno = %d", file_name,
+                    errno);
+            return ERROR;
+        }
+    }
+#endif
+
+    if ((r = F_Open(tempFileName[0] != '\0' ? tempFileName : file_name,
+                    &p, &fileSize, &fileType)) != kNoError) {
+        sprintf(message->text, "Error opening file: %s", 
+                  ABI_ErrorString((ABIError)r));
+        goto error;
     }
 
-    return SUCCESS;
+    if (tempFileName[0] != '\0')
+        unlink(tempFileName);
+
+    r = read_sample_data(fileType, seq_name, num_bases, called_bases, 
+        use_edited_bases, called_locs, quality_values, num_values, 
+        avals, cvals, gvals, tvals, call_method, chemistry, status_code, 
+        options, message);
+
+    F_Close(p, fileType);
+    return r;
 
     error:
-    if (chromatogram[0] != NULL) {
-         Btk_release_file_data(*called_bases, *called_locs, *quality_values,
-             chromatogram, call_method, (chemistry != NULL) ? chemistry : NULL);
-    }
+    if (tempFileName[0] != '\0')
+        unlink(tempFileName);
     if (p != NULL) {
          F_Close(p, fileType);
          p = NULL;
@@ -1045,6 +1098,74 @@ Btk_read_sample_file(
     return r;
 }
 
+/*
+ * This function is the in-memory counterpart of Btk_read_sample_file(): 
+ * it extracts base calls and chromatogram traces from the contents of an 
+ * ABI or SCF sample file held in a buffer. Its synopsis is:
+ *
+ * result = Btk_read_sample_buffer(buffer, size, seq_name, num_bases, ...)
+ *
+ * where
+ *	buffer		is the address of the file contents; it is only read
+ *	size		is the number of bytes in the buffer
+ *	seq_name	is the name of the sample, used to find its phd file
+ *			when options->inp_phd is set; may be NULL otherwise
+ *
+ * and the other arguments are as for Btk_read_sample_file(). Compressed
+ * contents are not accepted. No file is created and no state is kept 
+ * between calls, so threads may read different buffers concurrently.
+ */
+int
+Btk_read_sample_buffer(
+    const void *buffer,
+    long        size,
+    const char *seq_name,
+    int        *num_bases,
+    char      **called_bases,
+    int         use_edited_bases,
+    int       **called_locs,
+    int       **quality_values,
+    int        *num_values,
+    int       **avals,
+    int       **cvals,
+    int       **gvals,
+    int       **tvals,
+    char      **call_method,
+    char      **chemistry,
+    char       *status_code,
+    const Options *options,
+    BtkMessage *message)
+{
+    int   r;
+    int   fileType = -1;
+    /* The parsers only read the buffer while it is open */
+    void *p = (void *)buffer;
+
+   *called_bases = NULL;
+   *called_locs  = NULL;
+
+    if ((size >= 2) && (((const unsigned char *)buffer)[0] == 0x1f)) {
+        sprintf(message->text, "compressed sample data are not supported");
+        return ERROR;
+    }
+
+    if ((r = F_OpenBuffer(p, size, &fileType)) != kNoError) {
+        sprintf(message->text, "Error opening sample data: %s", 
+                  ABI_ErrorString((ABIError)r));
+        if (fileType == ABI || fileType == SCF)
+            F_CloseBuffer(p, fileType);
+        return r;
+    }
+
+    r = read_sample_data(fileType, seq_name, num_bases, called_bases, 
+        use_edited_bases, called_locs, quality_values, num_values, 
+        avals, cvals, gvals, tvals, call_method, chemistry, status_code, 
+        options, message);
+
+    F_CloseBuffer(p, fileType);
+    return r;
+}
+
 /*
  * This function frees up all the arrays allocated by Btk_read_sample_file().
  * Its synopsis is:
@@ -1081,8 +1202,10 @@ Btk_release_file_data(
     for (i = 0; i < NUM_COLORS; i++) {
 	FREE(chromatogram[i]);
     }
-    FREE(*call_method);
-    FREE(*chemistry);
+    if (call_method != NULL)
+        FREE(*call_method);
+    if (chemistry != NULL)
+        FREE(*chemistry);
 }
 
 /*******************************************************************************
@@ -1839,10 +1962,11 @@ int
 output_four_multi_fasta_files(char *multiseqsFileName,
     char *multiqualFileName, char *multilocsFileName, char *multistatFileName,
     int num_bases, char *called_bases, int *quality_values, int *called_locs, 
-    double frac_QV20_with_shoulders, char *status_code, Options options)
+    double frac_QV20_with_shoulders, char *status_code, const Options *options)
 {
     int i, j;
-    char *seq_name, ttuner_name[BUFLEN];
+    const char *seq_name;
+    char ttuner_name[BUFLEN];
     FILE *seqs_out = NULL, *qual_out = NULL, 
          *locs_out = NULL, *stat_out = NULL;
 
@@ -1868,14 +1992,14 @@ output_four_multi_fasta_files(char *multiseqsFileName,
 
     /* Use the name of the sample file, sans path, as the sequence name */
 #ifdef __WIN32
-    if ((seq_name = strrchr(options.file_name, '\\')) != NULL) {
+    if ((seq_name = strrchr(options->file_name, '\\')) != NULL) {
 #else
-    if ((seq_name = strrchr(options.file_name, '/')) != NULL) {
+    if ((seq_name = strrchr(options->file_name, '/')) != NULL) {
 #endif
         seq_name++;
     }
     else {
-        seq_name = options.file_name;
+        seq_name = options->file_name;
     }
 
     fprintf(seqs_out, ">%s \n", seq_name);
@@ -2084,22 +2208,23 @@ Btk_output_fasta_file(
  */
 
 int
-Btk_output_tip_file( Data *data, char *color2base, Options options)
+Btk_output_tip_file( Data *data, char *color2base, const Options *options)
 {
-    char *seq_name, tip_file_name[MAXPATHLEN];
+    const char *seq_name;
+    char tip_file_name[MAXPATHLEN];
     int i, j, halfwidth, ipos, color, ibeg, iend, *y, num_points;
     FILE *tip_out;
 
     /* Use the name of the sample file, sans path, as the sequence name */
 #ifdef __WIN32
-    if ((seq_name = strrchr(options.file_name, '\\')) != NULL) {
+    if ((seq_name = strrchr(options->file_name, '\\')) != NULL) {
 #else
-    if ((seq_name = strrchr(options.file_name, '/')) != NULL) {
+    if ((seq_name = strrchr(options->file_name, '/')) != NULL) {
 #endif
         seq_name++;
     }
     else {
-        seq_name = options.file_name;
+        seq_name = options->file_name;
     }
 
     /*
@@ -2107,14 +2232,14 @@ Btk_output_tip_file( Data *data, char *color2base, Options options)
      * file name.
      */
 #ifdef __WIN32
-    if (options.tip_dir[0] != '.')
-        (void)sprintf(tip_file_name, "%s\\%s.tip", options.tip_dir, 
+    if (options->tip_dir[0] != '.')
+        (void)sprintf(tip_file_name, "%s\\%s.tip", options->tip_dir, 
             seq_name);
     else
         (void)sprintf(tip_file_name, "%s.tip", seq_name);           
 #else
-    if (options.tip_dir[0] != '.')
-        (void)sprintf(tip_file_name, "%s/%s.tip", options.tip_dir, 
+    if (options->tip_dir[0] != '.')
+        (void)sprintf(tip_file_name, "%s/%s.tip", options->tip_dir, 
             seq_name);
     else
         (void)sprintf(tip_file_name, "%s.tip", seq_name);           
@@ -2125,7 +2250,7 @@ Btk_output_tip_file( Data *data, char *color2base, Options options)
         error(tip_file_name, "couldn't open", errno);
         return ERROR;
     }
-    if (options.Verbose > 2) {
+    if (options->Verbose > 2) {
         (void)fprintf(stderr, "Writing TIP output to %s\n", tip_file_name);
     }
     (void)fprintf(tip_out, ">%s\n", seq_name);
@@ -2157,7 +2282,7 @@ Btk_output_tip_file( Data *data, char *color2base, Options options)
             y[num_points] = INT_DBL(Shape(data->peak_list[i]->C0, 
                                        data->peak_list[i]->orig_width/2.,
                                        data->peak_list[i]->beta, 
-                                       j-ipos, &options));
+                                       j-ipos, options));
             num_points++;
             if (y[num_points-1] == 0) break;
         }
@@ -2194,24 +2319,29 @@ Btk_output_tip_file( Data *data, char *color2base, Options options)
 
 int
 Btk_output_tab_file(int num2, AltBase *altbases,
-    Options options)
+    const Options *options)
 {
-    char *seq_name, tab_file_name[MAXPATHLEN];
+    const char *base_name;
+    char seq_name[MAX_NAME_LENGTH], tab_file_name[MAXPATHLEN];
     int i, num_sub, num_del;
     FILE *tab_out;
 
     /* Use the name of the sample file, sans path, as the sequence name */
 #ifdef __WIN32
-    if ((seq_name = strrchr(options.file_name, '\\')) != NULL) {
+    if ((base_name = strrchr(options->file_name, '\\')) != NULL) {
 #else
-    if ((seq_name = strrchr(options.file_name, '/')) != NULL) {
+    if ((base_name = strrchr(options->file_name, '/')) != NULL) {
 #endif
-        seq_name++;
+        base_name++;
     }
     else {
-        seq_name = options.file_name;
+        base_name = options->file_name;
     }
 
+    /* Work on a copy, since the suffix may be stripped below */
+    (void)strncpy(seq_name, base_name, sizeof(seq_name) - 1);
+    seq_name[sizeof(seq_name) - 1] = '\0';
+
     /* Removing the suffix ".Z" or ".gz" from the name of compressed sample */
     if (seq_name[strlen(seq_name) - 3] == '.' &&
         seq_name[strlen(seq_name) - 2] == 'g' &&
@@ -2227,14 +2357,14 @@ Btk_output_tab_file(int num2, AltBase *altbases,
      * file name.
      */
 #ifdef __WIN32
-    if (options.tab_dir[0] != '.')
-        (void)sprintf(tab_file_name, "%s\\%s.tab", options.tab_dir,
+    if (options->tab_dir[0] != '.')
+        (void)sprintf(tab_file_name, "%s\\%s.tab", options->tab_dir,
             seq_name);
     else
         (void)sprintf(tab_file_name, "%s.tab", seq_name);
 #else
-    if (options.tab_dir[0] != '.')
-        (void)sprintf(tab_file_name, "%s/%s.tab", options.tab_dir,
+    if (options->tab_dir[0] != '.')
+        (void)sprintf(tab_file_name, "%s/%s.tab", options->tab_dir,
             seq_name);
     else
         (void)sprintf(tab_file_name, "%s.tab", seq_name);
@@ -2245,7 +2375,7 @@ Btk_output_tab_file(int num2, AltBase *altbases,
         error(tab_file_name, "couldn't open", errno);
         return ERROR;
     }
-    if (options.Verbose > 2) {
+    if (options->Verbose > 2) {
         (void)fprintf(stderr, "Writing ABC output to %s\n", tab_file_name);
     }
 
@@ -2282,177 +2412,100 @@ Btk_output_tab_file(int num2, AltBase *altbases,
 
 
 /********************************************************************************
- * Function: delta_out_samples1
+ * Function: write_scf_samples
+ * Purpose:  write the samples section of an SCF file for all four channels.
+ *           Version 2 interleaves A, C, G and T at every scan; version 3
+ *           stores each channel contiguously, delta coded twice (the two
+ *           delta passes are fused into a single second difference). The
+ *           whole section is encoded big-endian into one buffer and written
+ *           with a single fwrite.
  ********************************************************************************
  */
-void
-delta_out_samples1(unsigned char samples[], int num_samples)
+static int
+write_scf_samples(FILE *fp, int **chromatogram, int num_samples,
+    int sample_size, int scf_version)
 {
-    int i;
-    unsigned char p_delta = 0, p_sample;
+    int i, dye;
+    unsigned int d, prev1, prev2;
+    size_t size = (size_t)num_samples * NUM_COLORS * sample_size;
+    unsigned char *buf, *out;
 
-    for (i = 0; i < num_samples; i++)
-    {
-        p_sample = samples[i];
-        samples[i] = samples[i] - p_delta;
-        p_delta = p_sample;
-    }
+    buf = (unsigned char *) malloc(size > 0 ? size : 1);
+    if (buf == NULL) return ERROR;
 
-    for (p_delta = 0, i = 0; i < num_samples; i++)
+    out = buf;
+    if (scf_version == 2)
     {
-        p_sample = samples[i];
-        samples[i] = samples[i] - p_delta;
-        p_delta = p_sample;
+        if (sample_size == 1)
+            for (i = 0; i < num_samples; i++)
+                for (dye = 0; dye < NUM_COLORS; dye++)
+                    *out++ = (unsigned char) chromatogram[dye][i];
+        else
+            for (i = 0; i < num_samples; i++)
+                for (dye = 0; dye < NUM_COLORS; dye++)
+                {
+                    *out++ = (unsigned char) (chromatogram[dye][i] >> 8);
+                    *out++ = (unsigned char)  chromatogram[dye][i];
+                }
     }
-}
-
-/********************************************************************************
- * Function: delta_out_samples2
- ********************************************************************************
- */
-void
-delta_out_samples2(unsigned short samples[], int num_samples)
-{
-    int i;
-    unsigned short p_delta = 0, p_sample;
-
-    for (i = 0; i < num_samples; i++)
+    else
     {
-        p_sample = samples[i];
-        samples[i] = samples[i] - p_delta;
-        p_delta = p_sample;
-    }
-
-    for (p_delta = 0, i = 0; i < num_samples; i++)
+        for (dye = 0; dye < NUM_COLORS; dye++)
+        {
+            prev1 = prev2 = 0;
+            if (sample_size == 1)
+                for (i = 0; i < num_samples; i++)
+                {
+                    d = (unsigned int)chromatogram[dye][i] - 2 * prev1 + prev2;
+                    prev2 = prev1;
+                    prev1 = (unsigned int)chromatogram[dye][i];
+                    *out++ = (unsigned char) d;
+                }
+            else
+                for (i = 0; i < num_samples; i++)
+                {
+                    d = (unsigned int)chromatogram[dye][i] - 2 * prev1 + prev2;
+                    prev2 = prev1;
+                    prev1 = (unsigned int)chromatogram[dye][i];
+                    *out++ = (unsigned char) (d >> 8);
+                    *out++ = (unsigned char)  d;
+                }
+        }
+    }
+
+    if (fwrite(buf, 1, size, fp) != size)
     {
-        p_sample = samples[i];
-        samples[i] = samples[i] - p_delta;
-        p_delta = p_sample;
-    }
-}
-
-/********************************************************************************
- * Function: write_sample1
- ********************************************************************************
- */
-static int
-write_sample1(FILE *fp, TT_Samples1 *sample)
-{
-    if (writeuchar(fp, sample->sample_A) != SUCCESS) return ERROR;
-    if (writeuchar(fp, sample->sample_C) != SUCCESS) return ERROR;
-    if (writeuchar(fp, sample->sample_G) != SUCCESS) return ERROR;
-    if (writeuchar(fp, sample->sample_T) != SUCCESS) return ERROR;
+        FREE(buf);
 
-    return SUCCESS;
-}
+        return ERROR;
+    }
 
-/********************************************************************************
- * Function: write_sample2
- ********************************************************************************
- */
-static int
-write_sample2(FILE *fp, TT_Samples2 *sample)
-{
-    if (writeushort(fp, sample->sample_A) != SUCCESS) return ERROR;
-    if (writeushort(fp, sample->sample_C) != SUCCESS) return ERROR;
-    if (writeushort(fp, sample->sample_G) != SUCCESS) return ERROR;
-    if (writeushort(fp, sample->sample_T) != SUCCESS) return ERROR;
+    FREE(buf);
 
     return SUCCESS;
 }
 
 /********************************************************************************
- * Function: write_samples31
+ * Function: max_sample_value
+ * Purpose:  find the largest magnitude of the samples to be written, which
+ *           decides whether they fit in one byte
  ********************************************************************************
  */
 static int
-write_samples31(FILE *fp, TT_Samples1 *samples, int num_samples)
+max_sample_value(int **chromatogram, int num_samples)
 {
-    int i, base;
-    unsigned char *samples_out;
+    int i, dye, v, max_value = 0;
 
-    samples_out = (unsigned char *) malloc(num_samples * sizeof(unsigned char));
-    if (samples_out == NULL) return ERROR;
-
-    for (base = 0; base < 4; base++)
-    {
+    for (dye = 0; dye < NUM_COLORS; dye++)
         for (i = 0; i < num_samples; i++)
-            switch (base)
-            {
-                case 0:
-                    samples_out[i] = samples[i].sample_A;
-                    break;
-                case 1:
-                    samples_out[i] = samples[i].sample_C;
-                    break;
-                case 2:
-                    samples_out[i] = samples[i].sample_G;
-                    break;
-                case 3:
-                    samples_out[i] = samples[i].sample_T;
-                    break;
-            }
-
-        delta_out_samples1(samples_out, num_samples);
-        if (num_samples != (int)fwrite(samples_out, 1, num_samples, fp))
         {
-            FREE(samples_out);
-
-            return ERROR;
+            v = (chromatogram[dye][i] >= 0) ? chromatogram[dye][i] : 
+                                             -chromatogram[dye][i];
+            if (v > max_value)
+                max_value = v;
         }
-    }
-
-    FREE(samples_out);
-
-    return SUCCESS;
-}
-
-/********************************************************************************
- * Function: write_samples32
- ********************************************************************************
- */
-static int
-write_samples32(FILE *fp, TT_Samples2 *samples, int num_samples)
-{
-    int i, base;
-    unsigned short *samples_out;
-
-    samples_out = (unsigned short *) malloc(num_samples * sizeof(unsigned short));
-    if (samples_out == NULL) return ERROR;
-
-    for (base = 0; base < 4; base++)
-    {
-        for (i = 0; i < num_samples; i++)
-            switch (base)
-            {
-                case 0:
-                    samples_out[i] = (&samples[i])->sample_A;
-                    break;
-                case 1:
-                    samples_out[i] = (&samples[i])->sample_C;
-                    break;
-                case 2:
-                    samples_out[i] = (&samples[i])->sample_G;
-                    break;
-                case 3:
-                    samples_out[i] = (&samples[i])->sample_T;
-                    break;
-            }
-
-        delta_out_samples2(samples_out, num_samples);
-
-        for (i = 0; i < num_samples; i++)
-            if (writeushort(fp, samples_out[i]) != SUCCESS)
-            {
-                FREE(samples_out);
-
-                return ERROR;
-            }
-    }
 
-    FREE(samples_out);
-
-    return SUCCESS;
+    return max_value;
 }
 
 /********************************************************************************
@@ -2567,7 +2620,7 @@ write_scf_header(FILE *fp, SCF_Header *header)
 int
 output_scf_file(
     char *path,
-    char *scf_dir,
+    const char *scf_dir,
     char *called_bases,
     int  *called_peak_locs,
     int  *quality_values,
@@ -2586,6 +2639,7 @@ output_scf_file(
     SCF_Header header;
     SCF_Bases_Rec base;
     int i, scf_version = 2;
+    int *chromatogram[NUM_COLORS];
 
 #ifdef __WIN32
     if ((seq_name = strrchr(path, '\\')) != NULL)
@@ -2621,13 +2675,19 @@ output_scf_file(
 
     sprintf(comments, "DYEP=%s\nCONV=%s", chemistry, TT_VERSION);
 
+    chromatogram[0] = chromatogram0;
+    chromatogram[1] = chromatogram1;
+    chromatogram[2] = chromatogram2;
+    chromatogram[3] = chromatogram3;
+
     header.magic_number      = TT_SCF_MAGIC;
     header.samples           = num_datapoints;
     header.samples_offset    = (unsigned int) sizeof(SCF_Header);
     header.bases             = num_called_bases;
     header.bases_left_clip   = 0;
     header.bases_right_clip  = 0;
-    header.sample_size       = (max_colordata_value < 256) ? 1 : 2;
+    header.sample_size       = (max_sample_value(chromatogram, 
+                               num_datapoints) < 256) ? 1 : 2;
     header.bases_offset      = (unsigned int) (header.samples_offset + header.samples
                                * ((header.sample_size == 2) ? 8 : 4));
     header.comments_size     = (unsigned int) strlen(comments) + 1;
@@ -2643,75 +2703,9 @@ output_scf_file(
 
     if (write_scf_header(scf_out, &header) != SUCCESS) return ERROR;
 
-    if (max_colordata_value < 256)
-    {
-        TT_Samples1 sample, *samples;
-
-        if (scf_version == 2)
-        {
-            for (i = 0; i < (int)header.samples; i++)
-            {
-                sample.sample_A = (unsigned char) chromatogram0[i];
-                sample.sample_C = (unsigned char) chromatogram1[i];
-                sample.sample_G = (unsigned char) chromatogram2[i];
-                sample.sample_T = (unsigned char) chromatogram3[i];
-
-                if (write_sample1(scf_out, &sample) != SUCCESS) return ERROR;
-            }
-        }
-        else
-        {
-            samples = (TT_Samples1 *) malloc(header.samples * sizeof(TT_Samples1));
-            if (samples == NULL) return ERROR;
-
-            for (i = 0; i < (int)header.samples; i++)
-            {
-                samples[i].sample_A = (unsigned char) chromatogram0[i];
-                samples[i].sample_C = (unsigned char) chromatogram1[i];
-                samples[i].sample_G = (unsigned char) chromatogram2[i];
-                samples[i].sample_T = (unsigned char) chromatogram3[i];
-            }
-
-            if (write_samples31(scf_out, samples, header.samples) != SUCCESS)
-                return ERROR;
-
-            FREE(samples);
-        }
-    }
-    else
-    {
-        TT_Samples2 sample, *samples;
-
-        if (scf_version == 2)
-        {
-            for (i = 0; i < (int)header.samples; i++)
-            {
-                sample.sample_A = (unsigned short) chromatogram0[i];
-                sample.sample_C = (unsigned short) chromatogram1[i];
-                sample.sample_G = (unsigned short) chromatogram2[i];
-                sample.sample_T = (unsigned short) chromatogram3[i];
-
-                if (write_sample2(scf_out, &sample) != SUCCESS) return ERROR;
-            }
-        }
-        else
-        {
-            samples = (TT_Samples2 *) malloc(header.samples * sizeof(TT_Samples2));
-            if (samples == NULL) return ERROR;
-
-            for (i = 0; i < (int)header.samples; i++)
-            {
-                samples[i].sample_A = (unsigned short) chromatogram0[i];
-                samples[i].sample_C = (unsigned short) chromatogram1[i];
-                samples[i].sample_G = (unsigned short) chromatogram2[i];
-                samples[i].sample_T = (unsigned short) chromatogram3[i];
-            }
-
-            if (write_samples32(scf_out, samples, header.samples) != SUCCESS) return ERROR;
-
-            FREE(samples);
-        }
-    }
+    if (write_scf_samples(scf_out, chromatogram, (int)header.samples,
+        (int)header.sample_size, scf_version) != SUCCESS)
+        return ERROR;
 
     if (scf_version == 2)
     {
@@ -2923,12 +2917,13 @@ Btk_read_tab_file(char *tab_file_name, char *bases2, int *qvs2,
  *******************************************************************************/
 
 int
-Btk_output_poly_file(Data *data, Options *options, BtkMessage *message)
+Btk_output_poly_file(Data *data, const Options *options, BtkMessage *message)
 {
     int    i, j, jc, peak_index, num_peaks; 
     double max_height, ave_area = 0.;      
     double ampA, ampC, ampG, ampT;
-    char  *seq_name, poly_name[MAX_FILE_NAME_LENGTH];
+    const char *seq_name;
+    char  poly_name[MAX_FILE_NAME_LENGTH];
     Peak   peak;
     FILE  *poly_out;
 
@@ -3067,10 +3062,11 @@ Btk_output_poly_file(Data *data, Options *options, BtkMessage *message)
 
 int
 Btk_output_poly_file_old(Data *data, int *data_peak_ind1, int *data_peak_ind2,
-    int *qv, Options *options, BtkMessage *message)
+    int *qv, const Options *options, BtkMessage *message)
 {
     int    i, ind1, ind2, ipos;
-    char  *seq_name, poly_name[MAX_FILE_NAME_LENGTH];
+    const char *seq_name;
+    char  poly_name[MAX_FILE_NAME_LENGTH];
     FILE  *poly_out; 
     Peak **dpl = data->peak_list; 
 
@@ -31,6 +31,7 @@
 #define NAME_DIR 2           /* input will come from all files in a directory */
 #define NAME_FILEOFFILES 4   /* input will come from a file with one filename per line */
 #define NAME_MULTI 8
+#define NAME_SOCKET 16       /* input will come from clients of a server socket */
 
 extern int 
 read_consensus_from_sample_file(char **, int);
@@ -57,7 +58,28 @@ Btk_read_sample_file(
     char  **call_method,
     char  **chemistry,
     char   *status_code,
-    Options options,
+    const Options *options,
+    BtkMessage *message);
+
+extern int
+Btk_read_sample_buffer(
+    const void *buffer,
+    long    size,
+    const char *seq_name,
+    int    *num_bases,
+    char  **called_bases,
+    int     use_edited,
+    int   **called_locs,
+    int   **quality_values, 
+    int    *num_values,
+    int   **avals,
+    int   **cvals,
+    int   **gvals,
+    int   **tvals,
+    char  **call_method,
+    char  **chemistry,
+    char   *status_code,
+    const Options *options,
     BtkMessage *message);
 
 
@@ -144,19 +166,19 @@ extern int
 Btk_output_tip_file(
     Data *data,
     char *color2base,
-    Options options);
+    const Options *options);
 
 extern int
 Btk_output_tab_file(
     int num2,
     AltBase *altbases,
-    Options options);
+    const Options *options);
 
 
 extern int
 output_scf_file(
     char *path,
-    char *scf_dir,
+    const char *scf_dir,
     char *called_bases,
     int *called_locs,
     int *quality_values,
@@ -185,12 +207,12 @@ Btk_read_phd_file(char *full_name,
 extern int
 Btk_output_poly_file(
     Data *, 
-    Options *, 
+    const Options *, 
     BtkMessage *);
 
 extern int
 output_four_multi_fasta_files(char *, char *, char *, char *,
-    int , char *, int *, int *, double, char *, Options );
+    int , char *, int *, int *, double, char *, const Options *);
 
 extern int
 Btk_read_tab_file(char *, char *, int *, int *, int *, int *, 
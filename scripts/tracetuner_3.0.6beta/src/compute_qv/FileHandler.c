@@ -65,52 +65,66 @@ ABIError F_Open(char *file_name, void **ptr, long *file_size, int *file_type)
         error = size != fread(*ptr, 1, size, stream) ? kFileError : kNoError;
 
     if (error == kNoError)
+        error = F_OpenBuffer(*ptr, (long)size, file_type);
+
+    if (stream != NULL)
+        fclose(stream);
+
+     return error;
+}
+
+ABIError F_Close(void *ptr, int file_type)
+{
+     ABIError error;
+
+     error = F_CloseBuffer(ptr, file_type);
+
+     free(ptr);
+
+     return error;
+}
+
+/*
+ *  Open a sample file already held in memory, e.g. received from another
+ *  process, without going through the file system. The buffer stays owned
+ *  by the caller and is only read while it is open.
+ */
+ABIError F_OpenBuffer(void *ptr, long size, int *file_type)
+{
+    ABIError error = kNoError;
+
+    if (ptr == NULL || size < 4)
+        return kWrongFileType;
+
+    if (strncmp((char *) ptr, "ABIF", 4) == 0)
+        *file_type = ABI;
+    else if (strncmp((char *) ptr, ".scf", 4) == 0)
+        *file_type = SCF;
+    else if (strncmp((char *) ptr + 1, "ZTR", 3) == 0)
     {
-        if (strncmp((char *) *ptr, "ABIF", 4) == 0)
-            *file_type = ABI;
-        else if (strncmp((char *) *ptr, ".scf", 4) == 0)
-            *file_type = SCF;
-        else if (strncmp((char *) *ptr + 1, "ZTR", 3) == 0)
-        {
-            *file_type = ZTR;
-//           fprintf(stderr, "This is a ZTR file\n");
-        }
-        else
-            error = kWrongFileType;
+        *file_type = ZTR;
+//       fprintf(stderr, "This is a ZTR file\n");
     }
+    else
+        error = kWrongFileType;
 
     if (error == kNoError)
     {
         if (*file_type == ABI)
-            error = ABI_Open(*ptr, size);
+            error = ABI_Open(ptr, (size_t)size);
         else if (*file_type == SCF)
-            error = SCF_Open(*ptr, size);
+            error = SCF_Open(ptr, (size_t)size);
         else if (*file_type == ZTR)
             error = kNoError;                 
-        else 
-        {
-            fprintf(stderr, "Unknown file type\n");
-            error = kWrongFileType;
-            return error;
-        }
     }
 
-    if (stream != NULL)
-        fclose(stream);
-
-     return error;
+    return error;
 }
 
-ABIError F_Close(void *ptr, int file_type)
+ABIError F_CloseBuffer(void *ptr, int file_type)
 {
-     ABIError error;
-
      if (file_type == ABI)
-	  error = ABI_Close(ptr);
-     else
-	  error = SCF_Close(ptr);
-
-     free(ptr);
+	  return ABI_Close(ptr);
 
-     return error;
+     return SCF_Close(ptr);
 }
@@ -26,3 +26,5 @@
 
 ABIError F_Open(char *, void **, long *, int *);
 ABIError F_Close(void *, int);
+ABIError F_OpenBuffer(void *, long, int *);
+ABIError F_CloseBuffer(void *, int);
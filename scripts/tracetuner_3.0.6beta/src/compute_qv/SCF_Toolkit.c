@@ -33,178 +33,184 @@
 
 extern unsigned long get_offset(unsigned char *);
 
-static char *gFile = NULL;
+static TT_THREAD_LOCAL char *gFile = NULL;
+
+/*
+ * Header fields, decoded once by SCF_Open() so that the accessors below
+ * do not re-read the version string and offsets on every call.
+ */
+static TT_THREAD_LOCAL double        gVersion = 0.0;
+static TT_THREAD_LOCAL long          gNumSamples = 0;
+static TT_THREAD_LOCAL unsigned long gSamplesOffset = 0;
+static TT_THREAD_LOCAL unsigned long gSampleSize = 0;
+static TT_THREAD_LOCAL long          gNumBases = 0;
+static TT_THREAD_LOCAL unsigned long gBasesOffset = 0;
+
+static void parse_header(void)
+{
+     char scf_version_string[5];
+
+     SCF_SCFVersion(scf_version_string);
+     gVersion = atof(scf_version_string);
+
+     gNumSamples    = get_offset((unsigned char *) (gFile + 4));
+     gSamplesOffset = get_offset((unsigned char *) (gFile + 8));
+     gNumBases      = get_offset((unsigned char *) (gFile + 12));
+     gBasesOffset   = get_offset((unsigned char *) (gFile + 24));
+     gSampleSize    = get_offset((unsigned char *) (gFile + 40));
+}
 
 void SCF_NumBases(long *num_bases)
 {
-     *num_bases = get_offset((unsigned char *) (gFile + 12));
+     *num_bases = gNumBases;
 }
 
 void SCF_Bases(char *edited_bases)
 {
-     long num_bases, i;
-     unsigned long bases_offset;
-     char scf_version_string[5];
-     double scf_version_number;
-
-     SCF_SCFVersion(scf_version_string);
-     scf_version_number = atof(scf_version_string);
-
-     SCF_NumBases(&num_bases);
-     bases_offset = get_offset((unsigned char *) (gFile + 24));
+     long i;
+     unsigned long bases_offset = gBasesOffset;
 
-     if (scf_version_number < 2.9)
-	  for (i = 0; i < num_bases; i++)
+     if (gVersion < 2.9)
+	  for (i = 0; i < gNumBases; i++)
 	       edited_bases[i] = *(gFile + bases_offset + (i * 12) + 8);
      else
      {
-	  bases_offset += (num_bases * 8);
+	  bases_offset += (gNumBases * 8);
 
-	  for (i = 0; i < num_bases; i++)
+	  for (i = 0; i < gNumBases; i++)
 	       edited_bases[i] = *(gFile + bases_offset + i);
      }
 }
 
 void SCF_PeakLocations(short *edited_locs)
 {
-     long num_bases, i;
-     unsigned long bases_offset;
-     char scf_version_string[5];
-     double scf_version_number;
-
-     SCF_SCFVersion(scf_version_string);
-     scf_version_number = atof(scf_version_string);
-
-     SCF_NumBases(&num_bases);
-     bases_offset = get_offset((unsigned char *) (gFile + 24));
+     long i;
 
-     if (scf_version_number < 2.9)
-	  for (i = 0; i < num_bases; i++)
+     if (gVersion < 2.9)
+	  for (i = 0; i < gNumBases; i++)
 	       edited_locs[i] = (short) get_offset((unsigned char *) 
-					(gFile + bases_offset + (i * 12)));
+					(gFile + gBasesOffset + (i * 12)));
      else
-	  for (i = 0; i < num_bases; i++)
+	  for (i = 0; i < gNumBases; i++)
 	       edited_locs[i] = (short) get_offset((unsigned char *) 
-					(gFile + bases_offset + (i * 4)));
+					(gFile + gBasesOffset + (i * 4)));
 }
 
 void SCF_NumAnalyzedData(long *num_data_points)
 {
-     *num_data_points = get_offset((unsigned char *) (gFile + 4));
+     *num_data_points = gNumSamples;
 }
 
-void SCF_AnalyzedData(short dye, int *analyzed_array)
+/*
+ * Decodes one dye of a version 3 sample block. The samples of each dye
+ * are stored contiguously and delta coded twice; both prefix sums are
+ * undone in a single pass, wrapping at the sample size exactly as the
+ * two separate passes of delta_samples1/2 would.
+ */
+static void decode_delta_channel(const unsigned char *src, int *analyzed_array)
 {
-     long num_data_points, i;
-     unsigned long samples_offset;
-     unsigned long sample_size;
-     char scf_version_string[5];
-     double scf_version_number;
-     unsigned char *buf1;
-     unsigned short *buf2;
-
-     SCF_SCFVersion(scf_version_string);
-     scf_version_number = atof(scf_version_string);
-
-     SCF_NumAnalyzedData(&num_data_points);
-
-     samples_offset = get_offset((unsigned char *) (gFile + 8));
-     sample_size = get_offset((unsigned char *) (gFile + 40));
+     long i;
 
-     if (scf_version_number < 2.9) {
-	  for (i = 0; i < num_data_points; i++)
-	       if (sample_size == 1)
-		    analyzed_array[i] = *((unsigned char *) gFile + 
-					  samples_offset + (i * 4) + dye);
-	       else 
-	       {
-		    analyzed_array[i] = *((unsigned char *) gFile + 
-					  samples_offset +
-					  (i * 8) + (dye * 2)) * 256;
-		    analyzed_array[i] += *((unsigned char *) gFile + 
-					   samples_offset +
-					   (i * 8) + (dye * 2) + 1);
-	       }
-     } else
+     if (gSampleSize == 1)
      {
-	  if (sample_size == 1)
+	  unsigned char sum1 = 0, sum2 = 0;
+
+	  for (i = 0; i < gNumSamples; i++)
 	  {
-	       buf1 = (unsigned char *) malloc(num_data_points * 
-					       sizeof(unsigned char));
+	       sum1 = (unsigned char) (sum1 + src[i]);
+	       sum2 = (unsigned char) (sum2 + sum1);
+	       analyzed_array[i] = sum2;
+	  }
+     }
+     else
+     {
+	  unsigned short sum1 = 0, sum2 = 0;
 
-	       memcpy(buf1, ((unsigned char *) gFile + 
-			     samples_offset + (dye * num_data_points)),
-		      num_data_points);
+	  for (i = 0; i < gNumSamples; i++)
+	  {
+	       sum1 = (unsigned short) (sum1 + 
+					((src[2 * i] << 8) | src[2 * i + 1]));
+	       sum2 = (unsigned short) (sum2 + sum1);
+	       analyzed_array[i] = sum2;
+	  }
+     }
+}
 
-	       delta_samples1(buf1, num_data_points);
+void SCF_AnalyzedData(short dye, int *analyzed_array)
+{
+     long i;
+     const unsigned char *samples = (unsigned char *) gFile + gSamplesOffset;
 
-	       for (i = 0; i < num_data_points; i++)
-		    analyzed_array[i] = buf1[i];
+     if (gVersion < 2.9) {
+	  for (i = 0; i < gNumSamples; i++)
+	       if (gSampleSize == 1)
+		    analyzed_array[i] = samples[(i * 4) + dye];
+	       else 
+		    analyzed_array[i] = (samples[(i * 8) + (dye * 2)] << 8) |
+			 samples[(i * 8) + (dye * 2) + 1];
+     } else
+	  decode_delta_channel(samples + dye * gNumSamples * gSampleSize,
+			       analyzed_array);
+}
 
-	       free(buf1);
-	  }
+/*
+ * Decodes the traces of all four dyes in one pass over the sample block,
+ * writing directly into analyzed_arrays[0..3] (A, C, G, T order).
+ */
+void SCF_AllAnalyzedData(int **analyzed_arrays)
+{
+     long i;
+     short dye;
+     const unsigned char *samples = (unsigned char *) gFile + gSamplesOffset;
+     int *a = analyzed_arrays[0], *c = analyzed_arrays[1],
+	 *g = analyzed_arrays[2], *t = analyzed_arrays[3];
+
+     if (gVersion < 2.9) {
+	  if (gSampleSize == 1)
+	       for (i = 0; i < gNumSamples; i++, samples += 4)
+	       {
+		    a[i] = samples[0];
+		    c[i] = samples[1];
+		    g[i] = samples[2];
+		    t[i] = samples[3];
+	       }
 	  else
-	  {
-	       buf2 = (unsigned short *) malloc(num_data_points * 
-						sizeof(unsigned short));
-
-	       for (i = 0; i < num_data_points; i++)
+	       for (i = 0; i < gNumSamples; i++, samples += 8)
 	       {
-		    buf2[i] = *((unsigned char *) gFile + 
-				samples_offset + (dye * num_data_points * 2)
-				+ (i * 2)) * 256;
-		    buf2[i] += *((unsigned char *) gFile + 
-				 samples_offset + (dye * num_data_points * 2)
-				 + (i * 2) + 1);
+		    a[i] = (samples[0] << 8) | samples[1];
+		    c[i] = (samples[2] << 8) | samples[3];
+		    g[i] = (samples[4] << 8) | samples[5];
+		    t[i] = (samples[6] << 8) | samples[7];
 	       }
-
-	       delta_samples2(buf2, num_data_points);
-
-	       for (i = 0; i < num_data_points; i++)
-		    analyzed_array[i] = buf2[i];
-
-	       free(buf2);
-	  }
-     }
+     } else
+	  for (dye = 0; dye < 4; dye++)
+	       decode_delta_channel(samples + dye * gNumSamples * gSampleSize,
+				    analyzed_arrays[dye]);
 }
 
 void delta_samples1(unsigned char samples[], long num_samples)
 {
      long i;
-     unsigned char p_sample = 0;
-
-     for (i = 0; i < num_samples; i++)
-     {
-	  samples[i] = samples[i] + p_sample;
-	  p_sample = samples[i];
-     }
-
-     p_sample = 0;
+     unsigned char sum1 = 0, sum2 = 0;
 
      for (i = 0; i < num_samples; i++)
      {
-	  samples[i] = samples[i] + p_sample;
-	  p_sample = samples[i];
+	  sum1 = (unsigned char) (sum1 + samples[i]);
+	  sum2 = (unsigned char) (sum2 + sum1);
+	  samples[i] = sum2;
      }
 }
 
 void delta_samples2(unsigned short samples[], long num_samples)
 {
      long i;
-     unsigned short p_sample = 0;
+     unsigned short sum1 = 0, sum2 = 0;
 
      for (i = 0; i < num_samples; i++)
      {
-	  samples[i] = samples[i] + p_sample;
-	  p_sample = samples[i];
-     }
-
-     p_sample = 0;
-
-     for (i = 0; i < num_samples; i++)
-     {
-	  samples[i] = samples[i] + p_sample;
-	  p_sample = samples[i];
+	  sum1 = (unsigned short) (sum1 + samples[i]);
+	  sum2 = (unsigned short) (sum2 + sum1);
+	  samples[i] = sum2;
      }
 }
 
@@ -225,7 +231,10 @@ ABIError SCF_Open(void *file, size_t size)
      if (gFile != NULL)
 	  error = kFileAlreadyOpen;
      else
+     {
 	  gFile = (char *) file;
+	  parse_header();
+     }
 
      return error;
 }
@@ -32,6 +32,7 @@ void SCF_NumBases(long *);
 void SCF_Bases(char *);
 void SCF_PeakLocations(short *);
 void SCF_AnalyzedData(short, int *);
+void SCF_AllAnalyzedData(int **);
 void SCF_SCFVersion(char *);
 
 void delta_samples1(unsigned char *, long);
@@ -24,6 +24,9 @@
 /**  $Id: example.c,v 1.6 2008/04/06 18:12:26 gdenisov Exp $       
  **  example.c - Sample application program to output .qual files from
  **              ABI sample file inputs using the Tracetuner library.
+ **              The sample files are read into memory and handed to the
+ **              library through a TTContext, as an application that 
+ **              receives traces from elsewhere would do.
  **/
 #include <stdio.h>
 #include <stdlib.h>
@@ -36,24 +39,45 @@
 #include "Btk_default_table.h"
 #include "util.h"
 #include "train.h"
-#include "Btk_compute_qv.h"
 #include "Btk_match_data.h"
 #include "Btk_qv_io.h"
+#include "Btk_context.h"
+
+/*
+ *  Read the whole file into a newly allocated buffer
+ */
+static char *
+read_whole_file(char *path, long *size)
+{
+    FILE *fp;
+    char *buf = NULL;
+
+    if ((fp = fopen(path, "rb")) == NULL) 
+        return NULL;
+
+    if ((fseek(fp, 0, SEEK_END) == 0) && ((*size = ftell(fp)) > 0) &&
+        (fseek(fp, 0, SEEK_SET) == 0) &&
+        ((buf = (char *)malloc(*size)) != NULL) &&
+        (fread(buf, 1, *size, fp) != (size_t)*size)) 
+    {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(fp);
+
+    return buf;
+}
 
 int
 main(int argc, char *argv[])
 {
-    int i, n;
-    char *lookup_table, *smp, *smptail;
+    int n;
+    long size;
+    char *lookup_table, *smp, *smptail, *buf;
     BtkLookupTable *table;
-    int nbases, nvals;
-    char *bases, *chemistry = "";
-    char status_code[100];
-    int *locations, *vals[4], *qv = NULL;
-
-    BtkMessage  msg;
     Options     options;
-    Results     results;
+    TTContext  *ctx;
+    TTResult    result;
 
     if(argc < 2) {
         fprintf(stderr, "usage: %s <samplefiles...>\n", argv[0]);
@@ -88,6 +112,21 @@ main(int argc, char *argv[])
         table = NULL;
     }
 
+    /* Setting default options 
+     */
+    (void)memset(&options, 0, sizeof(options));
+    options.gauss          = 1;
+    options.min_ratio      = (float)0.15;
+    options.Verbose        = 3;
+    options.process_bases  = 1;
+    options.lut_type       = ABI3730pop7;
+
+    /* One context per thread; this example has only one */
+    if ((ctx = tt_context_create(&options, table)) == NULL) {
+        fprintf(stderr, "Couldn't create the context.\n");
+        exit(1);
+    }
+
     for(n=1; n < argc; n++) {
         smp = argv[n];
         if ((smptail = strrchr(smp, '/')) != NULL)
@@ -95,91 +134,27 @@ main(int argc, char *argv[])
         else
             smptail = smp;
 
-        /* Setting default options 
-         */
-        options.nocall         = 0;
-        options.recalln        = 0;
-        options.edited_bases   = 0;
-        options.gauss          = 1;
-        options.tip_dir[0]     = '\0';
-        options.tal_dir[0]     = '\0';
-        options.tab_dir[0]     = '\0';
-        options.het            = 0;
-        options.time           = 0;
-        options.min_ratio      = (float)0.15;
-        options.Verbose        = 3;
-        options.inp_phd        = 0;
-        options.inp_phd_dir[0] = '\0';
-        options.file_name[0]   = '\0';
-        options.lut_type       = ABI3730pop7;
-       
-      
-        if (Btk_read_sample_file(smp, &nbases, &bases, 0, &locations, 
-            &qv, &nvals, &vals[0], &vals[1], &vals[2], &vals[3],
-            NULL, &chemistry, status_code, options, &msg) != 0) 
-        {
+        if ((buf = read_whole_file(smp, &size)) == NULL) {
             fprintf(stderr, "%s: couldn't read sample file\n", smptail);
             continue;
         }
 
-        strcpy(options.file_name, smptail);
-
-        if (table == NULL) {
-            if (strstr(chemistry, "3730")) {
-                table = Btk_get_3730pop7_table();
-            }
-            else if (strstr(chemistry, "POP5")) {
-                table = Btk_get_3700pop5_table();
-            }
-            else if (strstr(chemistry, "POP6") && 
-                     strstr(chemistry, "3700")) {
-                table = Btk_get_3700pop6_table();
-            }
-            else if (strstr(chemistry, "3100")) {
-                table = Btk_get_3100pop6_table();
-            }
-            else {
-            fprintf(stderr,
-                    "Can't select the lookup table automatically. \n"
-                    "Using built-in ABI 3730 Pop-7 table.\n");
-            table = Btk_get_3730pop7_table();
-            }
-        }
-
-        if ( Btk_compute_qv(&nbases, &bases, &locations, &nvals, vals, 
-                     "ACGT", table, &qv, options, &msg, &results) != 0) {
-            fprintf(stderr, "%s: %s\n", smptail, msg.text);
-            goto cleanup_a_file;
+        if (tt_process_buffer(ctx, buf, size, &result) != SUCCESS) {
+            fprintf(stderr, "%s: %s\n", smptail, tt_context_message(ctx));
+            free(buf);
+            continue;
         }
+        free(buf);
 
-        fprintf(stderr, "%s: %d bases. ", smp, nbases);
+        fprintf(stderr, "%s: %d bases. ", smp, result.num_bases);
         fprintf(stderr, "QVs are output to .qual file\n");
 
-        Btk_output_quality_values(NAME_FILES, smp, NULL, "", qv, nbases, 0, 
-                                  nbases - 1, 0);
-
-    cleanup_a_file:
-        if (qv != NULL) {
-            free(qv);
-            qv = NULL;
-        }
-        if (bases != NULL) {
-            free(bases);
-            bases = NULL;
-        }
-        if (locations != NULL) {
-            free(locations);
-            locations = NULL;
-        }
-        for (i=0; i<4; i++) {
-            if (vals[i] != NULL) {
-                free(vals[i]);
-                vals[i] = NULL;
-            }
-        }
-
+        Btk_output_quality_values(NAME_FILES, smp, NULL, "", 
+            result.quality_values, result.num_bases, 0, 
+            result.num_bases - 1, 0);
     }
 
+    tt_context_destroy(ctx);
     Btk_destroy_lookup_table(table);
 
     return(0);
@@ -28,6 +28,9 @@
 #include <stdlib.h>
 #ifndef __WIN32
 #include <unistd.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #endif
 #include <math.h>
 #ifdef __WIN32
@@ -89,6 +92,7 @@ static char status_code[BUFLEN];
 
 static int dev = 0;
 static int opts = 0;
+static int Serving = 0;		/* whether running as a server (-serve) */
 
 static int OutputSCF;		/* whether to write Staden SCF files */
 static char SCFDirName[BUFLEN];
@@ -147,7 +151,8 @@ usage(int argc, char *argv[])
     "    [ -q    | -qd  <dir>  ][ -c | -cd <dir> ] [ -tab | -tabd <dir> ]\n" 
     "    [ -d    | -dd  <dir>  ][ -qr     <file> ] [ -hpr | -hprd <dir> ]\n"
     "    [ -sa         <file>  ][ -qa     <file> ] [ -o           <dir> ]\n"
-    "    { <sample_file(s)>     | -id      <dir>   | -if  <fileoffiles> }\n"
+    "    { <sample_file(s)>     | -id      <dir>   | -if  <fileoffiles> |\n"
+    "      -serve <socket> }\n"
              , TT_VERSION, argv[0] );
 }
 
@@ -164,7 +169,7 @@ usage_dev(int argc, char *argv[])
     "    [ -t <lookup_table>    ][ -ct <context_table>  ]\n"
     "    [ -cv3   ] [ -time     ][ -C <consensus_file>  ]\n"
     "    [ -convolved ][ -shift ][ -renorm ][ -respace ]\n"
-    "    [ -raw ] [ -xgr ][ -mc ] \n"
+    "    [ -raw ] [ -xgr ][ -mc ] [ -color_threads ]\n"
     "    [ -indel_detect ][ -indel_resolve ][ -indloc <loc> ][ -indsize <size> ]\n"
     "    [ -3730][ -3700pop5][ -3700pop6][ -3100][ -mbace]\n"
     "    [ -p  | -pd  <dir> ] [ -s | -sd <dir> ] [ -tip | -tipd <dir> ]\n"
@@ -172,7 +177,8 @@ usage_dev(int argc, char *argv[])
     "    [ -d  | -dd  <dir> ] [ -qr     <file> ] [ -tab | -tabd <dir> ]\n"
     "    [ -ipd <dir> ]       [ -hpr  | -hprd <dir> ]                  \n"
     "    [ -sa       <file> ] [ -qa     <file> ] [ -o           <dir> ]\n"
-    "    { <sample_file(s)>   | -id     <dir>    | -if  <fileoffiles> }\n"
+    "    { <sample_file(s)>   | -id     <dir>    | -if  <fileoffiles> |\n"
+    "      -serve <socket> }\n"
              , TT_VERSION, argv[0] );
 }
 
@@ -200,7 +206,8 @@ help_message(int argc, char *argv[])
 "                         the default (automatic choice of the lookup table)\n"
 "                         as well as the options -3700pop5, -3700pop6, -3100,\n"
 "                         and -mbace. To get a message showing \n"
-"                         which table was used, specify -V option\n"
+"                         which table was used, specify -V option.\n"
+"                         The table may be in text or binary (lut -B) format\n"
 "    -3730                Use the built-in ABI 3730-pop7 lookup table\n"
 "    -3700pop5            Use the built-in ABI 3700-pop5 lookup table\n"
 "    -3700pop6            Use the built-in ABI 3700-pop6 lookup table\n"
@@ -232,6 +239,12 @@ help_message(int argc, char *argv[])
 "                         file\n"
 "    -id <dir>            Read the input sample files from specified directory"
 "\n"
+"    -serve <socket>      Run as a server on the Unix domain socket <socket>.\n"
+"                         Each line received names a sample file, which is\n"
+"                         processed with the output options of the command\n"
+"                         line; the reply is a line 'OK <file>' or\n"
+"                         'ERROR <file>: <reason>'. The line QUIT stops the\n"
+"                         server\n"
 "    -tab                 Call heterozygotes or mixed bases and output .tab\n"
 "                          file(s) in the  current directory\n"
 "    -tabd <dir>          Call mixed bases and output .tab file(s), in the\n"
@@ -249,44 +262,45 @@ help_message(int argc, char *argv[])
 
 
 static void
-output_options(Options options)
+output_options(const Options *options)
 {
     fprintf(stderr, "Options:\n");
-    fprintf(stderr, "\tchemistry = %s\n", options.chemistry);
-    fprintf(stderr, "\tedited_bases = %d\n", options.edited_bases);
-    fprintf(stderr, "\tfile_name = %s\n", options.file_name);                                        
-    fprintf(stderr, "\tgauss = %d\n", options.gauss); 
-    fprintf(stderr, "\thet = %d\n",options.het );  
-    fprintf(stderr, "\tindel_detect = %d\n", options.indel_detect);
-    fprintf(stderr, "\tindel_resolve = %d\n", options.indel_resolve);
-    fprintf(stderr, "\tindsize = %d\n", options.indsize);
-    fprintf(stderr, "\tindloc = %d\n", options.indloc);
-    fprintf(stderr, "\tinp_phd = %d\n", options.inp_phd);
-    fprintf(stderr, "\tinp_phd_dir = %s\n", options.inp_phd_dir);     
-    fprintf(stderr, "\tlut_type = %d\n", options.lut_type);
-    fprintf(stderr, "\tmin_ratio = %f\n", options.min_ratio);
-    fprintf(stderr, "\tmix = %d\n", options.mix );    
-    fprintf(stderr, "\tmulticomp = %d\n", options.multicomp); 
-    fprintf(stderr, "\tnocall = %d\n", options.nocall); 
-    fprintf(stderr, "\trespace = %d\n", options.respace);
-    fprintf(stderr, "\tscf_dir = %s\n", options.scf_dir); 
-    fprintf(stderr, "\tscf_version = %d\n", options.scf_version);
-    fprintf(stderr, "\tpath = %s\n", options.path);   
-    fprintf(stderr, "\tpoly_dir = %s\n", options.poly_dir);
-    fprintf(stderr, "\tprocess_bases = %d\n", options.process_bases);
-    fprintf(stderr, "\traw_data = %d\n", options.raw_data);
-    fprintf(stderr, "\trecalln = %d\n", options.recalln);
-    fprintf(stderr, "\trecallndb = %d\n", options.recallndb); 
-    fprintf(stderr, "\trecallndb = %d\n", options.ladder);         
-    fprintf(stderr, "\trenorm = %d\n", options.renorm); 
-    fprintf(stderr, "\tshift = %d\n", options.shift);  
-    fprintf(stderr, "\ttab_dir = %s\n", options.tab_dir);  
-    fprintf(stderr, "\ttal_dir = %s\n", options.tal_dir);
-    fprintf(stderr, "\thpr_dir = %s\n", options.hpr_dir);
-    fprintf(stderr, "\ttime = %d\n", options.time); 
-    fprintf(stderr, "\ttip_dir = %s\n", options.tip_dir);
-    fprintf(stderr, "\tVerbose = %d\n", options.Verbose);
-    fprintf(stderr, "\txgr = %d\n", options.xgr);   
+    fprintf(stderr, "\tchemistry = %s\n", options->chemistry);
+    fprintf(stderr, "\tcolor_threads = %d\n", options->color_threads);
+    fprintf(stderr, "\tedited_bases = %d\n", options->edited_bases);
+    fprintf(stderr, "\tfile_name = %s\n", options->file_name);                                        
+    fprintf(stderr, "\tgauss = %d\n", options->gauss); 
+    fprintf(stderr, "\thet = %d\n",options->het );  
+    fprintf(stderr, "\tindel_detect = %d\n", options->indel_detect);
+    fprintf(stderr, "\tindel_resolve = %d\n", options->indel_resolve);
+    fprintf(stderr, "\tindsize = %d\n", options->indsize);
+    fprintf(stderr, "\tindloc = %d\n", options->indloc);
+    fprintf(stderr, "\tinp_phd = %d\n", options->inp_phd);
+    fprintf(stderr, "\tinp_phd_dir = %s\n", options->inp_phd_dir);     
+    fprintf(stderr, "\tlut_type = %d\n", options->lut_type);
+    fprintf(stderr, "\tmin_ratio = %f\n", options->min_ratio);
+    fprintf(stderr, "\tmix = %d\n", options->mix );    
+    fprintf(stderr, "\tmulticomp = %d\n", options->multicomp); 
+    fprintf(stderr, "\tnocall = %d\n", options->nocall); 
+    fprintf(stderr, "\trespace = %d\n", options->respace);
+    fprintf(stderr, "\tscf_dir = %s\n", options->scf_dir); 
+    fprintf(stderr, "\tscf_version = %d\n", options->scf_version);
+    fprintf(stderr, "\tpath = %s\n", options->path);   
+    fprintf(stderr, "\tpoly_dir = %s\n", options->poly_dir);
+    fprintf(stderr, "\tprocess_bases = %d\n", options->process_bases);
+    fprintf(stderr, "\traw_data = %d\n", options->raw_data);
+    fprintf(stderr, "\trecalln = %d\n", options->recalln);
+    fprintf(stderr, "\trecallndb = %d\n", options->recallndb); 
+    fprintf(stderr, "\trecallndb = %d\n", options->ladder);         
+    fprintf(stderr, "\trenorm = %d\n", options->renorm); 
+    fprintf(stderr, "\tshift = %d\n", options->shift);  
+    fprintf(stderr, "\ttab_dir = %s\n", options->tab_dir);  
+    fprintf(stderr, "\ttal_dir = %s\n", options->tal_dir);
+    fprintf(stderr, "\thpr_dir = %s\n", options->hpr_dir);
+    fprintf(stderr, "\ttime = %d\n", options->time); 
+    fprintf(stderr, "\ttip_dir = %s\n", options->tip_dir);
+    fprintf(stderr, "\tVerbose = %d\n", options->Verbose);
+    fprintf(stderr, "\txgr = %d\n", options->xgr);   
 
     return;
 }
@@ -527,6 +541,57 @@ parse_mobility_file_name(char* query, Options* options, BtkMessage* message,
     return lookup_table;
 }
 
+/*
+ * This function checks that the options given do not conflict.  Its
+ * synopsis is:
+ *
+ * result = check_options(options, message)
+ *
+ * where
+ *	options		is the address of the Options of the run
+ *	message		is the address of a BtkMessage where the conflict
+ *			will be described, if any
+ *
+ *	result		is 0 if the options are consistent, !0 otherwise
+ */
+static int
+check_options(const Options *options, BtkMessage *message)
+{
+    if (SUP(options->het)+SUP(options->mix) > 1)
+    {
+        sprintf(message->text, "Please, specify no more than one of the "
+            "options -het and -mix");
+    }
+    else if (SUP(options->nocall)+SUP(options->recalln) > 1)
+    {
+        sprintf(message->text, "Please, specify no more than one of the "
+            "options -nocall and -recalln");
+    }
+    else if (
+        (SUP(options->nocall)+SUP(options->recalln)+SUP(options->recallndb)+
+         SUP(options->ladder) > 1))
+    {
+        sprintf(message->text, "Please, specify no more than one of the "
+            "options -nocall, -recalln, -recallndb and -ladder");
+    }
+    /* "Secret" option */
+    else if (SUP(options->het)+SUP(options->recalln)-SUP(options->poly) > 1)
+    {
+        sprintf(message->text, "Please, specify no more than one of the "
+            "options -het and -recalln");
+    }
+    else if ((SUP(options->het)+SUP(options->mix)==0) && 
+             (options->tab_dir[0] != '\0')) 
+    {
+        sprintf(message->text, "Option -tab or -tabd <dir> can only be "
+            "used with either -het or -mix");
+    }
+    else {
+        return SUCCESS;
+    }
+    return ERROR;
+}
+
 /*
  * This function processes a single sample file.  Its synopsis is:
  *
@@ -588,7 +653,7 @@ process_file(BtkLookupTable *table, ContextTable *ctable,
         options->edited_bases, &called_peak_locs, &quality_values, 
         &num_datapoints, &chromatogram[0], &chromatogram[1], 
         &chromatogram[2], &chromatogram[3], &call_method, &(options->chemistry), 
-        status_code, *options, message) != SUCCESS)
+        status_code, options, message) != SUCCESS)
     {
 	if (status_code[0] == '\0')
         {
@@ -602,14 +667,14 @@ process_file(BtkLookupTable *table, ContextTable *ctable,
         output_four_multi_fasta_files(multiseqsFileName, multiqualFileName,
             multilocsFileName, multistatFileName, num_called_bases,
             called_bases, quality_values, called_peak_locs, 
-            results.frac_QV20_with_shoulders, status_code, *options);
+            results.frac_QV20_with_shoulders, status_code, options);
         status_code[0] = '\0';
         goto error;
     }
     message->text[0] = '\0';  /* message may have been set with no error */
 
     if (opts)
-        output_options(*options);
+        output_options(options);
 #if 0
     fprintf(stderr, "After Btk_read_sample_file: options->file_name=%s\n", options->file_name);
 #endif
@@ -626,39 +691,13 @@ process_file(BtkLookupTable *table, ContextTable *ctable,
         goto error;
     }
    
-    if (SUP(options->het)+SUP(options->mix) > 1)
+    if (check_options(options, message) != SUCCESS)
     {
-        fprintf(stderr, "\nPlease, specify no more than one of the options");
-        fprintf(stderr, " -het and -mix\n");
-        exit_message(options, -1);
-    }
-    else if (SUP(options->nocall)+SUP(options->recalln) > 1)
-    {
-        fprintf(stderr, "\nPlease, specify no more than one of the options");
-        fprintf(stderr, " -nocall and -recalln\n");
-        exit_message(options, -1);
-    }
-    else if (
-        (SUP(options->nocall)+SUP(options->recalln)+SUP(options->recallndb)+
-         SUP(options->ladder) > 1))
-    {
-        fprintf(stderr, "\nPlease, specify no more than one of the options");
-        fprintf(stderr, " -nocall, -recalln, -recallndb and -ladder\n");
-        exit_message(options, -1);
-    }
-    /* "Secret" option */
-    else if (SUP(options->het)+SUP(options->recalln)-SUP(options->poly) > 1)
-    {
-        fprintf(stderr, "\nPlease, specify no more than one of the options");
-        fprintf(stderr, " -het and -recalln\n");
-        exit_message(options, -1);
-    }
-    else if ((SUP(options->het)+SUP(options->mix)==0) && 
-             (options->tab_dir[0] != '\0')) 
-    {
-        fprintf(stderr, 
-        "\nOption -tab or -tabd <dir> can only be used with ");
-        fprintf(stderr, "either -het or -mix\n");
+        /* A server reports the conflict to its client and goes on */
+        if (Serving) {
+            goto error;
+        }
+        fprintf(stderr, "\n%s\n", message->text);
         exit_message(options, -1);
     }
 
@@ -731,14 +770,14 @@ process_file(BtkLookupTable *table, ContextTable *ctable,
 #if USE_CONTEXT_TABLE
                         ctable,
 #endif
-                        &quality_values, *options, message, &results ) == ERROR) 
+                        &quality_values, options, message, &results ) == ERROR) 
         {
 	    sprintf(status_code, "%s", "TT_TRASH");
             if (OutputFourMultiFastaFiles)
                 output_four_multi_fasta_files(multiseqsFileName, multiqualFileName,
                 multilocsFileName, multistatFileName, num_called_bases,
                 called_bases, quality_values, called_peak_locs, 
-                results.frac_QV20_with_shoulders, status_code, *options);
+                results.frac_QV20_with_shoulders, status_code, options);
             if (Verbose > 1)
                 fprintf(stderr, "0 bases finally\n");
             status_code[0] = '\0';
@@ -844,7 +883,7 @@ process_file(BtkLookupTable *table, ContextTable *ctable,
         output_four_multi_fasta_files(multiseqsFileName, multiqualFileName,
             multilocsFileName, multistatFileName, num_called_bases,
             called_bases, quality_values, called_peak_locs, 
-            results.frac_QV20_with_shoulders, status_code, *options);
+            results.frac_QV20_with_shoulders, status_code, options);
         status_code[0] = '\0';
     }
 
@@ -1066,6 +1105,169 @@ process_dir(BtkLookupTable *table, ContextTable *ctable,
     return;
 }
 
+#ifndef __WIN32
+/*
+ * This function runs ttuner as a server on a Unix domain socket, so that
+ * the lookup and context tables are loaded once and each trace costs only
+ * its own processing. Its synopsis is:
+ *
+ * result = serve(table, ctable, socket_name, ...)
+ *
+ * where
+ *	table		is the address of a BtkLookupTable returned by
+ *			Btk_read_lookup_table(), or NULL
+ *      ctable          is the address of a ContextTable returned by
+ *                      read_context_table()
+ *	socket_name	is the path of the socket to create
+ *	message		is the address of a BtkMessage where information about
+ *			an error will be put, if any
+ *
+ *	result		is 0 when the server is stopped, !0 if the socket
+ *			can't be set up
+ *
+ * Clients connect one at a time and send one sample file path per line.
+ * Every file is processed as if it were named on the command line, and
+ * the server answers with one line per file, "OK <file>" or
+ * "ERROR <file>: <reason>", as soon as the file is done. The line QUIT
+ * stops the server and removes the socket. An existing socket_name is
+ * replaced only if it is a socket.
+ */
+static int
+serve(BtkLookupTable *table, ContextTable *ctable,
+    char *socket_name, char *ConsensusName, char *ConsensusSeq,
+    Options *options, BtkMessage *message)
+{
+    int    listen_fd, fd, c, quit = 0, too_long;
+    struct sockaddr_un addr;
+    struct stat statbuf;
+    FILE  *in, *out;
+    char   line[BUFLEN], path[BUFLEN], *s;
+
+    if (strlen(socket_name) >= sizeof(addr.sun_path)) {
+        sprintf(message->text, "socket name is too long");
+        return ERROR;
+    }
+    (void)memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_name);
+
+    /* Replace a socket left by an earlier server, but nothing else */
+    if (lstat(socket_name, &statbuf) == 0) {
+        if (!S_ISSOCK(statbuf.st_mode)) {
+            sprintf(message->text, "exists and is not a socket");
+            return ERROR;
+        }
+        (void)unlink(socket_name);
+    }
+
+    if ((listen_fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+        error(socket_name, "couldn't create socket", errno);
+        return ERROR;
+    }
+    if ((bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) ||
+        (listen(listen_fd, 8) != 0))
+    {
+        error(socket_name, "couldn't listen on socket", errno);
+        (void)close(listen_fd);
+        return ERROR;
+    }
+
+    /* A client that goes away must not take the server with it */
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    if (Verbose > 0) {
+        fprintf(stderr, "Serving on %s\n", socket_name);
+    }
+    Serving = 1;
+
+    while (!quit) {
+        if ((fd = accept(listen_fd, NULL, NULL)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            error(socket_name, "couldn't accept connection", errno);
+            break;
+        }
+        in  = fdopen(fd, "r");
+        out = fdopen(dup(fd), "w");
+        if ((in == NULL) || (out == NULL)) {
+            error(socket_name, "couldn't open connection", errno);
+            if (in != NULL) {
+                (void)fclose(in);
+            }
+            else {
+                (void)close(fd);
+            }
+            if (out != NULL) {
+                (void)fclose(out);
+            }
+            continue;
+        }
+
+        while (fgets(line, sizeof(line), in) != NULL) {
+            /* A line without a newline did not fit; skip the rest of it */
+            too_long = 0;
+            if ((strchr(line, '\n') == NULL) && !feof(in)) {
+                while (((c = getc(in)) != EOF) && (c != '\n'))
+                    ;
+                too_long = 1;
+            }
+            /* Trim the newline, if any */
+            if ((s = strpbrk(line, "\r\n")) != NULL) {
+                *s = '\0';
+            }
+            if (line[0] == '\0') {
+                continue;
+            }
+            if (strcmp(line, "QUIT") == 0) {
+                quit = 1;
+                break;
+            }
+
+            if (too_long || (strlen(line) >= MAX_NAME_LENGTH)) {
+                line[MAX_NAME_LENGTH - 1] = '\0';
+                fprintf(out, "ERROR %s...: file name is too long\n", line);
+            }
+            else if (stat(line, &statbuf) != 0) {
+                fprintf(out, "ERROR %s: %s\n", line, strerror(errno));
+            }
+            else if (statbuf.st_mode & S_IFDIR) {
+                fprintf(out, "ERROR %s: is a directory\n", line);
+            }
+            else {
+                /* process_file() may strip a compression suffix from path */
+                strcpy(path, line);
+                strcpy(options->path, line);
+                if (process_file(table, ctable, path, ConsensusName,
+                    ConsensusSeq, options, message) != SUCCESS)
+                {
+                    if (message->text[0] != '\0') {
+                        fprintf(stderr, "%s: %s\n", line, message->text);
+                    }
+                    fprintf(out, "ERROR %s: %s\n", line,
+                        (message->text[0] != '\0') ? message->text :
+                        "processing failed");
+                }
+                else {
+                    fprintf(out, "OK %s\n", line);
+                }
+                fprintf(stderr, "\n");
+            }
+            (void)fflush(out);
+        }
+        (void)fclose(in);
+        (void)fclose(out);
+    }
+
+    (void)close(listen_fd);
+    (void)unlink(socket_name);
+    if (Verbose > 1) {
+        fprintf(stderr, "%s: server stopped\n", socket_name);
+    }
+    return SUCCESS;
+}
+#endif
+
 /*******************************************************************************
  * Function: validateDirectory
  *******************************************************************************
@@ -1154,6 +1356,7 @@ main(int argc, char *argv[])
     InputType       = NAME_FILES;
     options.inp_phd = 0;
     options.inp_phd_dir[0]='\0';
+    options.file_name[0] = '\0';
     ConsensusSpecified = 0;
     ConsensusName[0]='\0';
     AlnType         = NAME_FILES;
@@ -1174,6 +1377,7 @@ main(int argc, char *argv[])
     lut_name        = NULL;
     context_table   = NULL;
     options.chemistry    = NULL;
+    options.color_threads= 0;
     options.indel_detect = 0;
     options.indel_resolve= 0;
     options.indloc       = -1;
@@ -1185,6 +1389,7 @@ main(int argc, char *argv[])
     options.ladder       = 0;
     options.edited_bases = 0;
     options.gauss        = 1;
+    options.sf           = NULL;
     options.shift        = 0;
     options.renorm       = 0;
     options.respace      = 0;
@@ -1246,6 +1451,7 @@ main(int argc, char *argv[])
              (strcmp(argv[optind], "-qr")             == 0) ||
              (strcmp(argv[optind], "-sd")             == 0) ||
              (strcmp(argv[optind], "-sa")             == 0) ||
+             (strcmp(argv[optind], "-serve")          == 0) ||
              (strcmp(argv[optind], "-t" )             == 0) ||
              (strcmp(argv[optind], "-tipd")           == 0) ||
              (strcmp(argv[optind], "-tabd")           == 0) ||
@@ -1281,6 +1487,7 @@ main(int argc, char *argv[])
              (strcmp(argv[optind], "-xgr")          != 0) &&
              (strcmp(argv[optind], "-shift")        != 0) &&
              (strcmp(argv[optind], "-convolved")    != 0) &&
+             (strcmp(argv[optind], "-color_threads")!= 0) &&
              (strcmp(argv[optind], "-het")          != 0) &&
              (strcmp(argv[optind], "-mix")          != 0) &&
              (strcmp(argv[optind], "-cv3")          != 0) &&
@@ -1630,6 +1837,13 @@ main(int argc, char *argv[])
                     j = strlen(args) - 1;   /* break out of inner loop */
                     break;
                 }
+                else if (strcmp(args, "-serve") == 0) {
+                    InputType = NAME_SOCKET;
+                    (void)strncpy(InputName, argv[++optind],
+                                  sizeof(InputName));
+                    j = strlen(args) - 1;   /* break out of inner loop */
+                    break;
+                }
                 else if (strcmp(args, "-sa") == 0) {
                     OutputFasta++;
                     FastaType |= NAME_MULTI;
@@ -1766,6 +1980,10 @@ main(int argc, char *argv[])
                     options.gauss = 0;
                     j = strlen(args) - 1;   /* break out of inner loop */
                 }
+                else if (strcmp(args, "-color_threads") == 0) {
+                    options.color_threads = 1;
+                    j = strlen(args) - 1;   /* break out of inner loop */
+                }
                 else {
                     listtype = i;
                     OutputSCF++;
@@ -2017,7 +2235,7 @@ main(int argc, char *argv[])
         unlink(multistatFileName);
     }
 
-    if (optind == argc)
+    if ((optind == argc) && (InputType != NAME_SOCKET))
         fprintf(stderr, "No input data is specified\n");
 
     switch (InputType) {
@@ -2070,6 +2288,23 @@ main(int argc, char *argv[])
         ConsensusSeq, &options, &message);
 	break;
 
+    case NAME_SOCKET:
+#ifdef __WIN32
+        fprintf(stderr, "%s: -serve is not supported on this platform\n",
+            argv[0]);
+        exit_message(&options, 2);
+#else
+        if (serve(table, ctable, InputName, ConsensusName,
+            ConsensusSeq, &options, &message) != SUCCESS)
+        {
+            if (message.text[0] != '\0') {
+                fprintf(stderr, "%s: %s\n", InputName, message.text);
+            }
+            exit_message(&options, 1);
+        }
+#endif
+        break;
+
     default:
 	fprintf(stderr, "%s: internal error: name type %d\n", argv[0],
 			InputType);
@@ -0,0 +1,224 @@
+/**************************************************************************
+ * This file is part of TraceTuner, the DNA sequencing quality value,
+ * base calling and trace processing software.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received (LICENSE.txt) a copy of the GNU General Public
+ * License along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Btk_qv.h"
+#include "Btk_qv_data.h"
+#include "Btk_qv_funs.h"
+
+/*
+ * mkqvtables: generate Btk_qv_tables.h, the read-only tables of the peak 
+ * model functions of Btk_qv_funs.c. The Makefile runs it when it changes.
+ * The grids and the approximation of Erf() are those of Btk_qv_funs.h.
+ */
+
+#define MAX_ITER        200
+#define MAX_ERROR       1.0e-12   /* of the roots of the W1 equation */
+#define MAX_PHI_ERROR   2.0e-6    /* of the shipped tPhi in its equation */
+#define VALUE_FORMAT    "%.6f"    /* of the values of tW1 and tPhi */
+
+/* Solution y(x) of Erf(y)*W1(y)/y = x, as shipped. It was computed with 
+ * a root finder that is not known; bisection gives values that differ 
+ * by up to 1.4e-4, which would change the output of the convolved model, 
+ * so the values are kept and only checked against the equation.
+ */
+static const double shipped_phi[PEAK_TABLE_SIZE] = {
+0.425476, 0.436098, 0.453291, 0.464074, 0.478590, 0.488036, 0.501804, 0.509573,
+0.520660, 0.529877, 0.537627, 0.548622, 0.555505, 0.562574, 0.571793, 0.579019,
+0.585124, 0.592445, 0.601000, 0.606200, 0.612088, 0.619031, 0.626394, 0.631236,
+0.636616, 0.642759, 0.650096, 0.654479, 0.659247, 0.664520, 0.670500, 0.676406,
+0.680592, 0.685107, 0.690042, 0.695536, 0.701073, 0.704976, 0.709139, 0.713622,
+0.718511, 0.723934, 0.727977, 0.731757, 0.735770, 0.740065, 0.744708, 0.749799,
+0.753301, 0.756882, 0.760657, 0.764663, 0.768945, 0.773567, 0.777303, 0.780649,
+0.784150, 0.787832, 0.791723, 0.795864, 0.800233, 0.803337, 0.806564, 0.809929,
+0.813451, 0.817154, 0.821067, 0.825186, 0.828154, 0.831229, 0.834422, 0.837747,
+0.841221, 0.844866, 0.848708, 0.851952, 0.854863, 0.857873, 0.860991, 0.864231,
+0.867607, 0.871137, 0.874842, 0.877660, 0.880488, 0.883406, 0.886421, 0.889544,
+0.892787, 0.896163, 0.899692, 0.902442, 0.905170, 0.907978, 0.910872, 0.913860,
+0.916951, 0.920156, 0.923488, 0.926479, 0.929104, 0.931799, 0.934568, 0.937419,
+0.940358, 0.943393, 0.946534, 0.949793, 0.952390, 0.954973, 0.957621, 0.960339,
+0.963133, 0.966008, 0.968972, 0.972033, 0.975165, 0.977642, 0.980177, 0.982771,
+0.985430, 0.988158, 0.990961, 0.993845, 0.996816, 0.999884, 1.002362, 1.004846,
+1.007386, 1.009986, 1.012649, 1.015380, 1.018185, 1.021068, 1.024038, 1.026667,
+1.029103, 1.031590, 1.034132, 1.036733, 1.039396, 1.042126, 1.044927, 1.047806,
+1.050612, 1.053002, 1.055441, 1.057931, 1.060474, 1.063075, 1.065736, 1.068463,
+1.071260, 1.074132, 1.076667, 1.079062, 1.081505, 1.083998, 1.086544, 1.089146,
+1.091807, 1.094533, 1.097326, 1.100173, 1.102534, 1.104939, 1.107391, 1.109893,
+1.112447, 1.115056, 1.117724, 1.120455, 1.123252, 1.125927, 1.128304, 1.130725,
+1.133193, 1.135710, 1.138279, 1.140902, 1.143584, 1.146328, 1.149139, 1.151654,
+1.154054, 1.156498, 1.158989, 1.161529, 1.164121, 1.166767, 1.169472, 1.172239,
+1.175071, 1.177454, 1.179886, 1.182362, 1.184886, 1.187459, 1.190085, 1.192766,
+1.195506, 1.198309, 1.200994, 1.203425, 1.205901, 1.208422, 1.210992, 1.213612,
+1.216286, 1.219018, 1.221809, 1.224664, 1.227189, 1.229677, 1.232210, 1.234791,
+1.237422, 1.240105, 1.242845, 1.245644, 1.248505, 1.251221, 1.253734, 1.256293,
+1.258900, 1.261557, 1.264266, 1.267032, 1.269857, 1.272744, 1.275607, 1.278162,
+1.280763, 1.283413, 1.286115, 1.288869, 1.291681, 1.294553, 1.297488, 1.300419,
+1.303032, 1.305692, 1.308403, 1.311167, 1.313986, 1.316865, 1.319805, 1.322811,
+1.325773, 1.328462, 1.331201, 1.333993, 1.336841, 1.339748, 1.342716, 1.345750,
+1.348854, 1.351749, 1.354537, 1.357379, 1.360278, 1.363236, 1.366258, 1.369346,
+1.372505, 1.375665, 1.378524, 1.381440, 1.384414, 1.387450, 1.390553, 1.393725,
+1.396970, 1.400254, 1.403208, 1.406221, 1.409297, 1.412439, 1.415650, 1.418936,
+1.422301, 1.425665, 1.428741, 1.431882, 1.435090, 1.438370, 1.441726, 1.445163,
+1.448686, 1.452024, 1.455256, 1.458560, 1.461939, 1.465398, 1.468942, 1.472577,
+1.476147, 1.479503, 1.482936, 1.486449, 1.490048, 1.493739, 1.497527, 1.501262,
+1.504778, 1.508377, 1.512065, 1.515848, 1.519731, 1.523723, 1.527512, 1.531235,
+1.535051, 1.538967, 1.542991, 1.547130, 1.551245, 1.555128, 1.559113, 1.563206,
+1.567417, 1.571752, 1.576083, 1.580175, 1.584380, 1.588707, 1.593164, 1.597762,
+1.602230, 1.606587, 1.611073, 1.615698, 1.620473, 1.625396, 1.629960, 1.634664,
+1.639521, 1.644542, 1.649744, 1.654589, 1.659575, 1.664732, 1.670076, 1.675551,
+1.680716, 1.686063, 1.691607, 1.697370, 1.703041, 1.708644, 1.714463, 1.720521,
+1.726670, 1.732607, 1.738786, 1.745234, 1.751801, 1.758169, 1.764819, 1.771783,
+1.778715, 1.785643, 1.792909, 1.800513, 1.807811, 1.815481, 1.823576, 1.831492,
+1.839697, 1.848389, 1.856934, 1.865825, 1.875245, 1.884449, 1.894264, 1.904372,
+1.914642, 1.925641, 1.936527, 1.948290, 1.960132, 1.972842, 1.985717, 1.999670,
+2.013806, 2.029078, 2.045050, 2.062009, 2.080161, 2.099720, 2.120503, 2.143186,
+2.168127, 2.195664, 2.226701, 2.261991, 2.303734, 2.354351, 2.419369, 2.511913,
+2.682565};
+
+/*******************************************************************************
+ * Function: erf_approx
+ * Purpose: the approximation of the error function used by Erf()
+ *******************************************************************************
+ */
+static double
+erf_approx(double x)
+{
+    double t, sign;
+
+    sign = (x==0)?0:(x/fabs(x));
+    t = 1./(1.+ERF_P*x*sign);
+
+    return sign*(1. - (ERF_A1*t + ERF_A2*t*t + ERF_A3*t*t*t) * exp(-x*x));
+}
+
+/*******************************************************************************
+ * Function: solve_w1
+ * Purpose: solve Erf(y-x) + Erf(y+x) = Erf(y) for x by bisection
+ *******************************************************************************
+ */
+static double
+solve_w1(double y, double *err)
+{
+    int    i;
+    double lo = 0., hi = y + 5., mid = 0.;
+
+    for (i = 0; i < MAX_ITER && hi - lo > 0.; i++) {
+        mid = (lo + hi)/2.;
+        if (erf_approx(y-mid) + erf_approx(y+mid) - erf_approx(y) > 0.)
+            lo = mid;
+        else
+            hi = mid;
+    }
+   *err = hi - lo;
+    return lo;
+}
+
+/*******************************************************************************
+ * Function: round_value
+ * Purpose: return x as it reads back when printed with VALUE_FORMAT, 
+ *          rounding halves up as the shipped tables did
+ *******************************************************************************
+ */
+static double
+round_value(double x)
+{
+    char buf[64];
+
+    sprintf(buf, VALUE_FORMAT, x + 1.0e-10);
+    return atof(buf);
+}
+
+/*******************************************************************************
+ * Function: w1_interp
+ * Purpose: return W1(x) as Btk_qv_funs.c computes it from the table w1
+ *******************************************************************************
+ */
+static double
+w1_interp(const double *w1, double x)
+{
+    int i = (int)((x - XMIN_W1)/DX_W1);
+
+    if (i < 0)
+        return w1[0];
+    if (i >= PEAK_TABLE_SIZE-1)
+        return x;
+    return w1[i] + (w1[i+1]-w1[i])/DX_W1 * (x-XMIN_W1 - DX_W1*(double)i);
+}
+
+static void
+print_table(const char *name, const double *t, int n, const char *format)
+{
+    int i;
+
+    printf("static const double %s[%d] = {\n", name, n);
+    for (i = 0; i < n; i++) {
+        printf(format, t[i]);
+        printf("%s", (i == n-1) ? "};\n\n" : 
+            ((i % 4 == 3) ? ",\n" : ", "));
+    }
+}
+
+int
+main(void)
+{
+    int    i;
+    double factor = EXP2_TABLE_SIZE/EXP2_MAX_X, del = 1.0/factor;
+    double exp2[EXP2_TABLE_SIZE], w1[PEAK_TABLE_SIZE];
+    double y, err, max_err = 0., max_phi_err = 0.;
+
+    for (i = 0; i < EXP2_TABLE_SIZE; i++) {
+        double x2 = (i+0.5)*del;
+        x2 *= x2;
+        exp2[i] = exp(-x2);
+    }
+    for (i = 0; i < PEAK_TABLE_SIZE; i++) {
+        w1[i] = round_value(solve_w1(XMIN_W1 + DX_W1*(double)i, &err));
+        if (err > max_err) max_err = err;
+    }
+    for (i = 0; i < PEAK_TABLE_SIZE; i++) {
+        y = shipped_phi[i];
+        err = fabs(erf_approx(y)*w1_interp(w1, y)/y 
+            - (XMIN_PHI + DX_PHI*(double)i));
+        if (err > max_phi_err) max_phi_err = err;
+    }
+    if (max_err > MAX_ERROR || max_phi_err > MAX_PHI_ERROR) {
+        fprintf(stderr, "mkqvtables: max errors %g and %g exceed %g and %g\n",
+            max_err, max_phi_err, MAX_ERROR, MAX_PHI_ERROR);
+        return 1;
+    }
+
+    printf("/* Generated by mkqvtables; do not edit. Max errors %.3g, %.3g */"
+        "\n\n", max_err, max_phi_err);
+    printf("#ifndef __BTK_QV_TABLES__\n#define __BTK_QV_TABLES__\n\n");
+    printf("/* exp(-x*x) at the midpoints of %d bins of [0,%g) */\n", 
+        EXP2_TABLE_SIZE, EXP2_MAX_X);
+    print_table("exp2_values", exp2, EXP2_TABLE_SIZE, "%.17g");
+    printf("/* Solution y(x) of Erf(y)*W1(y)/y = x, x = %.10f + %.10f*i */\n",
+        XMIN_PHI, DX_PHI);
+    print_table("tPhi", shipped_phi, PEAK_TABLE_SIZE, VALUE_FORMAT);
+    printf("/* Solution x(y) of Erf(y-x) + Erf(y+x) = Erf(y), "
+        "y = %.4f + %.10f*i */\n", XMIN_W1, DX_W1);
+    print_table("tW1", w1, PEAK_TABLE_SIZE, VALUE_FORMAT);
+    printf("#endif\n");
+
+    return 0;
+}
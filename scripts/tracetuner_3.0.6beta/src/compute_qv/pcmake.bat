@@ -36,6 +36,8 @@ gcc -D__WIN32 -O3 -c Btk_compute_match.c -o    ..\..\obj\x86-win32\Btk_compute_m
 gcc -D__WIN32 -O3 -c Btk_sw.c -o               ..\..\obj\x86-win32\Btk_sw.o 
 gcc -D__WIN32 -O3 -c context_table.c -o        ..\..\obj\x86-win32\context_table.o
 gcc -D__WIN32 -O3 -c tracepoly.c -o            ..\..\obj\x86-win32\tracepoly.o
+gcc -D__WIN32 -O3 -c Btk_context.c -o          ..\..\obj\x86-win32\Btk_context.o
+gcc -D__WIN32 -O3 -c train_bin.c -o            ..\..\obj\x86-win32\train_bin.o
 gcc -D__WIN32 -O3 -c Btk_process_indels.c -o   ..\..\obj\x86-win32\Btk_process_indels.o
 gcc -D__WIN32 -O3 -c main.c -o                 ..\..\obj\x86-win32\main.o
 gcc -D__WIN32 -O3 -o ..\..\rel\x86-win32\ttuner ..\..\obj\x86-win32\*.o 
@@ -35,6 +35,7 @@
 
 #include "Btk_qv.h"
 #include "tracepoly.h"
+#include "util.h"
 
 
 
@@ -59,10 +60,12 @@ const double
  ******************************************************************************/
 #define POLY_DBG 0       /* debug for fitting code */
 
-/* Global variables to get useful debug info to the routines below */
+/* Variables to get useful debug info to the routines below; they are
+ * per thread, as readGetCoefficients sets BaseIndx for every trace.
+ */
 #if TELL_ME_IF_I_EXCEED_THE_LIMITS      /* tracepoly.h */
-char* Filename;
-int ReadNum, BadReadNum, BaseIndx, ReportNum;
+TT_THREAD_LOCAL char* Filename;
+TT_THREAD_LOCAL int ReadNum, BadReadNum, BaseIndx, ReportNum;
 #define IFR if(0) /* if( BaseIndx==2 ) */
 #else
 #define IFR if(0) /* if( ReadNum==BadReadNum && BaseIndx == 1 ) */
@@ -87,7 +90,7 @@ typedef void MyFunc( FuncArgs*, double, double[], int );
 #define MYMIN(A,B)      ( (A)<(B) ? (A) : (B) )
 #define MYMAX(A,B)      ( (A)>(B) ? (A) : (B) )
 
-static double sqrarg;
+static TT_THREAD_LOCAL double sqrarg;
 #define SQR(a) ((sqrarg=(a)) == 0.0 ? 0.0 : sqrarg*sqrarg)
 
 
@@ -253,11 +256,11 @@ free_matrix(double **m, long nrl, long nrh, long ncl, long nch)
  * using the SVD.
  ******************************************************************************/
 
-static double maxarg1,maxarg2;
+static TT_THREAD_LOCAL double maxarg1,maxarg2;
 #define FMAX(a,b) (maxarg1=(a),maxarg2=(b),(maxarg1) > (maxarg2) ?\
         (maxarg1) : (maxarg2))
 
-static int iminarg1,iminarg2;
+static TT_THREAD_LOCAL int iminarg1,iminarg2;
 #define IMIN(a,b) (iminarg1=(a),iminarg2=(b),(iminarg1) < (iminarg2) ?\
         (iminarg1) : (iminarg2))
 
@@ -0,0 +1,573 @@
+/**************************************************************************
+ * This file is part of TraceTuner, the DNA sequencing quality value,
+ * base calling and trace processing software.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received (LICENSE.txt) a copy of the GNU General Public
+ * License along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *************************************************************************/
+
+/*
+ *  train_bin.c
+ *
+ *  Writer and reader of the binary columnar training data format
+ *  (see train_bin.h).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef __WIN32
+#include <sys/mman.h>
+#endif
+
+#include "Btk_qv.h"
+#include "util.h"
+#include "Btk_atod.h"
+#include "train_bin.h"
+
+#define TRAIN_BIN_MAGIC             "TTTRNBIN"
+#define TRAIN_BIN_MAGIC_LEN         (8)
+#define TRAIN_BIN_FORMAT            (1)
+#define TRAIN_BIN_BYTE_ORDER        (0x01020304)
+#define TRAIN_BIN_HEADER_SIZE       (64)
+#define TRAIN_BIN_BLOCK_HEADER_SIZE (16)
+
+typedef struct {
+    char magic[TRAIN_BIN_MAGIC_LEN];  /* TRAIN_BIN_MAGIC, not terminated */
+    int  format;                      /* TRAIN_BIN_FORMAT */
+    int  byte_order;                  /* TRAIN_BIN_BYTE_ORDER as written */
+    char tt_version[16];              /* TT_VERSION of the writer */
+    int  num_params;                  /* TRAIN_BIN_NUM_PARAMS */
+    int  block_size;                  /* max number of records per block */
+} TrainBinHeader;
+
+struct TrainBinFile {
+    char *image;                      /* contents of the file */
+    long  size;
+    long  offset;                     /* of the next block; 0 before the
+                                       * header has been checked */
+    int   block_size;
+};
+
+struct TrainBinWriter {
+    FILE   *fp;                       /* NULL if records are kept in memory */
+    int     num_records;              /* in the current block */
+    int     capacity;                 /* records the columns can hold */
+    char    new_file;                 /* file boundary before next record */
+    double *param[TRAIN_BIN_NUM_PARAMS];
+    int    *dpos;
+    int    *qpos;
+    char   *dchar;
+    char   *qchar;
+    char   *is_match;
+    char   *flags;
+};
+
+/*******************************************************************************
+ * Function: block_bytes
+ * Purpose:  return the size of a block of n records in the file: a header,
+ *           the double columns, the int columns and the char columns,
+ *           padded so that the next block is aligned for doubles
+ *******************************************************************************
+ */
+static long
+block_bytes(int n)
+{
+    long size = TRAIN_BIN_BLOCK_HEADER_SIZE + (long)n *
+        (TRAIN_BIN_NUM_PARAMS * sizeof(double) + 2 * sizeof(int) + 4);
+
+    return (size + 7) & ~7L;
+}
+
+/*******************************************************************************
+ * Function: train_bin_open_stream
+ * Purpose:  prepare to read binary training data from an open stream
+ * Return:   NULL if the stream is not a regular file holding binary
+ *           training data, so that the caller can read it as text
+ * Comments: The file is mapped, not read, on systems that support it.
+ *******************************************************************************
+ */
+TrainBinFile *
+train_bin_open_stream(FILE *fp)
+{
+    TrainBinFile *tf;
+    struct stat   statbuf;
+    char         *image;
+    long          size;
+
+    if ((fstat(fileno(fp), &statbuf) != 0) ||
+        !(statbuf.st_mode & S_IFREG) ||
+        (statbuf.st_size < TRAIN_BIN_HEADER_SIZE))
+    {
+        return NULL;
+    }
+    size = (long)statbuf.st_size;
+
+#ifdef __WIN32
+    {
+        char magic[TRAIN_BIN_MAGIC_LEN];
+
+        if ((fread(magic, 1, TRAIN_BIN_MAGIC_LEN, fp) != TRAIN_BIN_MAGIC_LEN)
+            || (memcmp(magic, TRAIN_BIN_MAGIC, TRAIN_BIN_MAGIC_LEN) != 0))
+        {
+            rewind(fp);
+            return NULL;
+        }
+        rewind(fp);
+        if ((image = (char *)malloc(size)) == NULL) {
+            return NULL;
+        }
+        if (fread(image, 1, size, fp) != (size_t)size) {
+            FREE(image);
+            return NULL;
+        }
+    }
+#else
+    image = (char *)mmap(NULL, (size_t)size, PROT_READ, MAP_SHARED,
+        fileno(fp), 0);
+    if (image == (char *)MAP_FAILED) {
+        return NULL;
+    }
+    if (memcmp(image, TRAIN_BIN_MAGIC, TRAIN_BIN_MAGIC_LEN) != 0) {
+        (void)munmap(image, (size_t)size);
+        return NULL;
+    }
+#endif
+
+    if ((tf = CALLOC(TrainBinFile, 1)) == NULL) {
+#ifdef __WIN32
+        FREE(image);
+#else
+        (void)munmap(image, (size_t)size);
+#endif
+        return NULL;
+    }
+    tf->image = image;
+    tf->size  = size;
+    return tf;
+}
+
+/*******************************************************************************
+ * Function: train_bin_open
+ * Purpose:  prepare to read binary training data from the named file
+ * Return:   NULL if the file can't be opened or does not hold binary
+ *           training data
+ *******************************************************************************
+ */
+TrainBinFile *
+train_bin_open(const char *path)
+{
+    TrainBinFile *tf;
+    FILE         *fp;
+
+    if ((fp = fopen(path, "rb")) == NULL) {
+        return NULL;
+    }
+    tf = train_bin_open_stream(fp);
+    (void)fclose(fp);
+    return tf;
+}
+
+/*******************************************************************************
+ * Function: train_bin_next_block
+ * Purpose:  point the columns of block to the next block of records
+ * Return:   1 if a block was found, 0 at the end of data, ERROR if the
+ *           file is corrupt or in a format that can't be read here
+ *******************************************************************************
+ */
+int
+train_bin_next_block(TrainBinFile *tf, TrainBinBlock *block)
+{
+    TrainBinHeader  header;
+    const char     *p;
+    int             i, n;
+
+    if (tf->offset == 0) {
+        (void)memcpy(&header, tf->image, sizeof(header));
+        if ((header.format != TRAIN_BIN_FORMAT) ||
+            (header.byte_order != TRAIN_BIN_BYTE_ORDER) ||
+            (header.num_params != TRAIN_BIN_NUM_PARAMS) ||
+            (header.block_size < 1))
+        {
+            fprintf(stderr,
+                "Training data has an unknown format or byte order\n");
+            return ERROR;
+        }
+        tf->block_size = header.block_size;
+        tf->offset     = TRAIN_BIN_HEADER_SIZE;
+    }
+
+    if (tf->offset == tf->size) {
+        return 0;
+    }
+    if (tf->offset + TRAIN_BIN_BLOCK_HEADER_SIZE > tf->size) {
+        goto corrupt;
+    }
+    (void)memcpy(&n, tf->image + tf->offset, sizeof(n));
+    if ((n < 1) || (n > tf->block_size) ||
+        (tf->offset + block_bytes(n) > tf->size))
+    {
+        goto corrupt;
+    }
+
+    p = tf->image + tf->offset + TRAIN_BIN_BLOCK_HEADER_SIZE;
+    block->num_records = n;
+    for (i = 0; i < TRAIN_BIN_NUM_PARAMS; i++) {
+        block->param[i] = (const double *)p;
+        p += n * sizeof(double);
+    }
+    block->dpos     = (const int *)p;   p += n * sizeof(int);
+    block->qpos     = (const int *)p;   p += n * sizeof(int);
+    block->dchar    = p;                p += n;
+    block->qchar    = p;                p += n;
+    block->is_match = p;                p += n;
+    block->flags    = p;
+
+    tf->offset += block_bytes(n);
+    return 1;
+
+corrupt:
+    fprintf(stderr, "Training data is truncated or corrupt\n");
+    return ERROR;
+}
+
+/*******************************************************************************
+ * Function: train_bin_close
+ *******************************************************************************
+ */
+void
+train_bin_close(TrainBinFile *tf)
+{
+    if (tf == NULL) {
+        return;
+    }
+#ifdef __WIN32
+    FREE(tf->image);
+#else
+    (void)munmap(tf->image, (size_t)tf->size);
+#endif
+    FREE(tf);
+}
+
+/*******************************************************************************
+ * Function: release_writer
+ *******************************************************************************
+ */
+static void
+release_writer(TrainBinWriter *w)
+{
+    int i;
+
+    for (i = 0; i < TRAIN_BIN_NUM_PARAMS; i++) {
+        FREE(w->param[i]);
+    }
+    FREE(w->dpos);
+    FREE(w->qpos);
+    FREE(w->dchar);
+    FREE(w->qchar);
+    FREE(w->is_match);
+    FREE(w->flags);
+    FREE(w);
+}
+
+/*******************************************************************************
+ * Function: resize_writer
+ * Purpose:  let the columns of the writer hold capacity records
+ *******************************************************************************
+ */
+static int
+resize_writer(TrainBinWriter *w, int capacity)
+{
+    int i;
+
+    for (i = 0; i < TRAIN_BIN_NUM_PARAMS; i++) {
+        if ((w->param[i] = REALLOC(w->param[i], double, capacity)) == NULL) {
+            return ERROR;
+        }
+    }
+    if (((w->dpos     = REALLOC(w->dpos,     int,  capacity)) == NULL) ||
+        ((w->qpos     = REALLOC(w->qpos,     int,  capacity)) == NULL) ||
+        ((w->dchar    = REALLOC(w->dchar,    char, capacity)) == NULL) ||
+        ((w->qchar    = REALLOC(w->qchar,    char, capacity)) == NULL) ||
+        ((w->is_match = REALLOC(w->is_match, char, capacity)) == NULL) ||
+        ((w->flags    = REALLOC(w->flags,    char, capacity)) == NULL))
+    {
+        return ERROR;
+    }
+    w->capacity = capacity;
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Function: train_bin_create
+ * Purpose:  create the named file and write the header of binary
+ *           training data to it
+ * Return:   the writer, or NULL if the file can't be created
+ * Comments: If path is NULL, the records are kept in memory, to be copied
+ *           to another writer with train_bin_copy().
+ *******************************************************************************
+ */
+TrainBinWriter *
+train_bin_create(const char *path)
+{
+    TrainBinWriter *w;
+    TrainBinHeader  header;
+    char            pad[TRAIN_BIN_HEADER_SIZE];
+
+    if ((w = CALLOC(TrainBinWriter, 1)) == NULL) {
+        return NULL;
+    }
+    if (resize_writer(w, (path == NULL) ? 1024 : TRAIN_BIN_BLOCK_SIZE)
+        != SUCCESS)
+    {
+        release_writer(w);
+        return NULL;
+    }
+    if (path == NULL) {
+        return w;
+    }
+
+    (void)memset(&header, 0, sizeof(header));
+    (void)memcpy(header.magic, TRAIN_BIN_MAGIC, TRAIN_BIN_MAGIC_LEN);
+    header.format     = TRAIN_BIN_FORMAT;
+    header.byte_order = TRAIN_BIN_BYTE_ORDER;
+    (void)strncpy(header.tt_version, TT_VERSION, sizeof(header.tt_version));
+    header.num_params = TRAIN_BIN_NUM_PARAMS;
+    header.block_size = TRAIN_BIN_BLOCK_SIZE;
+    (void)memset(pad, 0, sizeof(pad));
+
+    if ((w->fp = fopen(path, "wb")) == NULL) {
+        release_writer(w);
+        return NULL;
+    }
+    if ((fwrite(&header, sizeof(header), 1, w->fp) != 1) ||
+        (fwrite(pad, TRAIN_BIN_HEADER_SIZE - sizeof(header), 1, w->fp) != 1))
+    {
+        (void)fclose(w->fp);
+        release_writer(w);
+        return NULL;
+    }
+    return w;
+}
+
+/*******************************************************************************
+ * Function: write_block
+ * Purpose:  write the records collected by the writer as one block
+ *******************************************************************************
+ */
+static int
+write_block(TrainBinWriter *w)
+{
+    int   i, n = w->num_records, block_header[4];
+    long  data_bytes;
+    char  pad[8];
+
+    (void)memset(block_header, 0, sizeof(block_header));
+    (void)memset(pad, 0, sizeof(pad));
+    block_header[0] = n;
+    data_bytes = TRAIN_BIN_BLOCK_HEADER_SIZE + (long)n *
+        (TRAIN_BIN_NUM_PARAMS * sizeof(double) + 2 * sizeof(int) + 4);
+
+    if (fwrite(block_header, sizeof(block_header), 1, w->fp) != 1) {
+        return ERROR;
+    }
+    for (i = 0; i < TRAIN_BIN_NUM_PARAMS; i++) {
+        if (fwrite(w->param[i], sizeof(double), n, w->fp) != (size_t)n) {
+            return ERROR;
+        }
+    }
+    if ((fwrite(w->dpos,     sizeof(int), n, w->fp) != (size_t)n) ||
+        (fwrite(w->qpos,     sizeof(int), n, w->fp) != (size_t)n) ||
+        (fwrite(w->dchar,    1, n, w->fp) != (size_t)n) ||
+        (fwrite(w->qchar,    1, n, w->fp) != (size_t)n) ||
+        (fwrite(w->is_match, 1, n, w->fp) != (size_t)n) ||
+        (fwrite(w->flags,    1, n, w->fp) != (size_t)n))
+    {
+        return ERROR;
+    }
+    if ((block_bytes(n) > data_bytes) &&
+        (fwrite(pad, block_bytes(n) - data_bytes, 1, w->fp) != 1))
+    {
+        return ERROR;
+    }
+
+    w->num_records = 0;
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Function: train_bin_new_file
+ * Purpose:  mark the start of the data of the next sample file
+ *******************************************************************************
+ */
+void
+train_bin_new_file(TrainBinWriter *w)
+{
+    w->new_file = 1;
+}
+
+/*******************************************************************************
+ * Function: put_record
+ * Purpose:  store one record in the writer, writing out a full block or
+ *           making room in memory as needed
+ *******************************************************************************
+ */
+static int
+put_record(TrainBinWriter *w, int dpos, char dchar, char is_match, int qpos,
+    char qchar, char flags, const double *params)
+{
+    int i, k;
+
+    if (w->num_records == w->capacity) {
+        if (w->fp != NULL) {
+            if (write_block(w) != SUCCESS) {
+                return ERROR;
+            }
+        }
+        else if (resize_writer(w, 2 * w->capacity) != SUCCESS) {
+            return ERROR;
+        }
+    }
+
+    k = w->num_records++;
+    w->dpos[k]     = dpos;
+    w->dchar[k]    = dchar;
+    w->is_match[k] = is_match;
+    w->qpos[k]     = qpos;
+    w->qchar[k]    = qchar;
+    w->flags[k]    = flags;
+    for (i = 0; i < TRAIN_BIN_NUM_PARAMS; i++) {
+        w->param[i][k] = params[i];
+    }
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Function: train_bin_append
+ * Purpose:  append one record: reference position and base, match flag,
+ *           sample position and base, and the trace parameters, or NULL
+ *           if the sample has no base here
+ * Comments: The parameters are stored as the values a reader of the text
+ *           format gets from their 6-decimal text, so that lookup tables
+ *           and reports made from either format are the same. A record
+ *           whose predictors would not parse as text (NaN or infinity)
+ *           has no parameters; such an intensity is stored as 0.
+ *******************************************************************************
+ */
+int
+train_bin_append(TrainBinWriter *w, int dpos, char dchar, int is_match,
+    int qpos, char qchar, const double *params)
+{
+    int     i;
+    char    buf[64], *s, flags;
+    double  p[TRAIN_BIN_NUM_PARAMS];
+
+    flags       = w->new_file ? TRAIN_BIN_NEW_FILE : 0;
+    w->new_file = 0;
+
+    if (params != NULL) {
+        flags |= TRAIN_BIN_HAS_PARAMS;
+        for (i = 0; i < TRAIN_BIN_NUM_PARAMS; i++) {
+            sprintf(buf, "%.6f", params[i]);
+            s = buf;
+            if (Btk_atod(&s, &p[i]) != 1) {
+                if (i < TRAIN_BIN_NUM_PREDICTORS) {
+                    flags &= ~TRAIN_BIN_HAS_PARAMS;
+                    break;
+                }
+                p[i] = 0.;
+            }
+        }
+    }
+    if (!(flags & TRAIN_BIN_HAS_PARAMS)) {
+        for (i = 0; i < TRAIN_BIN_NUM_PARAMS; i++) {
+            p[i] = 0.;
+        }
+    }
+
+    return put_record(w, dpos, dchar, (char)is_match, qpos, qchar, flags, p);
+}
+
+/*******************************************************************************
+ * Function: train_bin_num_records
+ * Purpose:  return the number of records held by a writer kept in memory
+ *******************************************************************************
+ */
+int
+train_bin_num_records(const TrainBinWriter *w)
+{
+    return w->num_records;
+}
+
+/*******************************************************************************
+ * Function: train_bin_copy
+ * Purpose:  append count records of the memory writer src, starting with
+ *           record first, to the writer dst, flags included
+ *******************************************************************************
+ */
+int
+train_bin_copy(TrainBinWriter *dst, const TrainBinWriter *src, int first,
+    int count)
+{
+    int     i, k;
+    double  p[TRAIN_BIN_NUM_PARAMS];
+
+    for (k = first; k < first + count; k++) {
+        for (i = 0; i < TRAIN_BIN_NUM_PARAMS; i++) {
+            p[i] = src->param[i][k];
+        }
+        if (put_record(dst, src->dpos[k], src->dchar[k], src->is_match[k],
+            src->qpos[k], src->qchar[k], src->flags[k], p) != SUCCESS)
+        {
+            return ERROR;
+        }
+    }
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Function: train_bin_clear
+ * Purpose:  drop the records held by a writer kept in memory
+ *******************************************************************************
+ */
+void
+train_bin_clear(TrainBinWriter *w)
+{
+    w->num_records = 0;
+    w->new_file    = 0;
+}
+
+/*******************************************************************************
+ * Function: train_bin_finish
+ * Purpose:  write the last block, close the file and free the writer
+ *******************************************************************************
+ */
+int
+train_bin_finish(TrainBinWriter *w)
+{
+    int r = SUCCESS;
+
+    if (w->fp != NULL) {
+        if ((w->num_records > 0) && (write_block(w) != SUCCESS)) {
+            r = ERROR;
+        }
+        if (fclose(w->fp) != 0) {
+            r = ERROR;
+        }
+    }
+    release_writer(w);
+    return r;
+}
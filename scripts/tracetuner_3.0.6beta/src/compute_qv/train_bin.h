@@ -0,0 +1,75 @@
+/**************************************************************************
+ * This file is part of TraceTuner, the DNA sequencing quality value,
+ * base calling and trace processing software.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received (LICENSE.txt) a copy of the GNU General Public
+ * License along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *************************************************************************/
+
+/*
+ *  train_bin.h
+ *
+ *  Binary columnar format of the training data written by train and read
+ *  by lut and checkqv/checkbc. The file is a header followed by blocks of
+ *  up to TRAIN_BIN_BLOCK_SIZE records; each block stores one array per
+ *  column, so that readers use the data in place after mapping the file.
+ *
+ *  Needs stdio.h.
+ */
+
+#ifndef TRAIN_BIN_H__
+#define TRAIN_BIN_H__
+
+#define TRAIN_BIN_NUM_PARAMS   (7)      /* 4 predictors and 3 iheights */
+#define TRAIN_BIN_NUM_PREDICTORS (4)
+#define TRAIN_BIN_BLOCK_SIZE   (65536)
+
+/* Record flags */
+#define TRAIN_BIN_NEW_FILE     (1)      /* first record after a file boundary */
+#define TRAIN_BIN_HAS_PARAMS   (2)      /* param columns are set */
+
+/* One block of records, as seen by a reader. Positions are 1-based, as
+ * in the text format.
+ */
+typedef struct {
+    int           num_records;
+    const double *param[TRAIN_BIN_NUM_PARAMS];
+    const int    *dpos;                 /* reference (consensus) position */
+    const int    *qpos;                 /* sample position */
+    const char   *dchar;                /* reference base */
+    const char   *qchar;                /* sample base */
+    const char   *is_match;
+    const char   *flags;
+} TrainBinBlock;
+
+typedef struct TrainBinFile   TrainBinFile;
+typedef struct TrainBinWriter TrainBinWriter;
+
+extern TrainBinFile   *train_bin_open(const char *);
+extern TrainBinFile   *train_bin_open_stream(FILE *);
+extern int             train_bin_next_block(TrainBinFile *, TrainBinBlock *);
+extern void            train_bin_close(TrainBinFile *);
+
+extern TrainBinWriter *train_bin_create(const char *);
+extern void            train_bin_new_file(TrainBinWriter *);
+extern int             train_bin_append(TrainBinWriter *, int, char, int, int,
+                           char, const double *);
+extern int             train_bin_finish(TrainBinWriter *);
+
+extern int             train_bin_num_records(const TrainBinWriter *);
+extern int             train_bin_copy(TrainBinWriter *, const TrainBinWriter *,
+                           int, int);
+extern void            train_bin_clear(TrainBinWriter *);
+
+#endif          /* TRAIN_BIN_H__ */
@@ -24,6 +24,9 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#ifdef TT_THREADS
+#include <pthread.h>
+#endif
 
 #include "util.h"
 
@@ -237,6 +240,83 @@ int qv_round(double x)
   else return INT_DBL(x);
 }
 
+#ifdef TT_THREADS
+#define MAX_TASKS 16
+
+typedef struct {
+    UtilTask  fn;
+    int       task;
+    void     *arg;
+    int       result;
+} TaskSlot;
+
+static void *
+run_task_slot(void *p)
+{
+    TaskSlot *slot = (TaskSlot *)p;
+
+    slot->result = slot->fn(slot->task, slot->arg);
+    return NULL;
+}
+#endif
+
+/**********************************************************************
+ * Run fn(0, arg) ... fn(num_tasks-1, arg).
+ *
+ * Inputs:	fn	task to run; it must only touch state owned by
+ *			its own task index
+ *		num_tasks	number of tasks
+ *		arg	argument passed to every task
+ *		concurrent	if nonzero (and built with TT_THREADS), run
+ *			the tasks on separate threads
+ * Outputs:
+ * Return:	SUCCESS if every task succeeded, ERROR otherwise.
+ * Comments:	All tasks have finished when this returns, so the
+ *		caller may go on to steps that combine their results.
+ *		Without TT_THREADS, or if a thread cannot be created,
+ *		the tasks run one after another in index order.
+ */
+int run_tasks(UtilTask fn, int num_tasks, void *arg, int concurrent)
+{
+    int i, status = SUCCESS;
+
+#ifdef TT_THREADS
+    if ( concurrent && num_tasks > 1 && num_tasks <= MAX_TASKS ) {
+        TaskSlot  slot[MAX_TASKS];
+        pthread_t thread[MAX_TASKS];
+        int       started[MAX_TASKS];
+
+        for ( i=0; i < num_tasks; i++ ) {
+            slot[i].fn = fn;
+            slot[i].task = i;
+            slot[i].arg = arg;
+            slot[i].result = SUCCESS;
+            started[i] = (pthread_create(&thread[i], NULL, run_task_slot,
+                &slot[i]) == 0);
+            if ( !started[i] )
+                run_task_slot(&slot[i]);
+        }
+        for ( i=0; i < num_tasks; i++ ) {
+            if ( started[i] )
+                pthread_join(thread[i], NULL);
+            if ( slot[i].result != SUCCESS )
+                status = ERROR;
+        }
+        return status;
+    }
+#else
+    (void)concurrent;
+#endif
+
+    for ( i=0; i < num_tasks; i++ ) {
+        if ( fn(i, arg) != SUCCESS ) {
+            status = ERROR;
+            break;
+        }
+    }
+    return status;
+}
+
 
 /*******************************************************************************
  * Implementation of class Stats (as close to a class as I can get in "C")
@@ -1082,7 +1162,7 @@ mobShiftQuality(Peak * const peak[], int n_peaks)
  *******************************************************************************
  */
 int
-collect_some_stats( Data *data, Options *options, BtkMessage *message,
+collect_some_stats( Data *data, const Options *options, BtkMessage *message,
                     Results *results )
 {
     int i, chunk_num = 0;
@@ -42,12 +42,28 @@
 #define MIN2(a,b)	((a) < (b) ? (a) : (b))
 #define MAX2(a,b)	((a) > (b) ? (a) : (b))
 
+/* Module state that is only meaningful within one trace (the sample file
+ * being parsed, scratch values of the NR macros) is kept per thread, so
+ * that several threads can each process their own traces
+ */
+#if defined(__GNUC__)
+#define TT_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define TT_THREAD_LOCAL __declspec(thread)
+#else
+#define TT_THREAD_LOCAL
+#endif
+
 void cg_stat(int *data, int *weight, int n, float *mean, float *std);
 void polyfit(float x[], float y[], float yerr[], int n_data,
 	     float a[], int na);
 
 void fpoly(float x, float p[], int np);
 int qv_round(double x);
+
+/* A unit of work run by run_tasks(); returns SUCCESS or ERROR */
+typedef int (*UtilTask)(int task, void *arg);
+int run_tasks(UtilTask fn, int num_tasks, void *arg, int concurrent);
 int qv_isnan(double x);
 
 
@@ -169,6 +169,18 @@ DYNAMIC		=
 LD_FLAGS_SHARED =  -S -shared #Maybe -S isn't necessary
 endif
 
+# make SAMPLE16=1 stores the processed chromatograms as 16-bit samples
+ifdef SAMPLE16
+CFLAGS         += -DTT_SAMPLE16
+endif
+
+# make THREADS=1 lets the per-color stages of a trace, the -threads (-T)
+# option of train (trainphd) and the -T option of lut run on POSIX threads
+ifdef THREADS
+CFLAGS         += -DTT_THREADS -pthread
+THREADLIBS      = -lpthread
+endif
+
 LIBDIR := ../../lib/$(BASEMACHINE)
 OBJDIR := ../../obj/$(BASEMACHINE)
 RELDIR := ../../rel/$(BASEMACHINE)
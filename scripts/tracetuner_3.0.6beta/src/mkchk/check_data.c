@@ -14,83 +14,242 @@
 #include "Btk_atod.h"
 #include "Btk_qv.h"
 #include "util.h"
+#include "train_bin.h"
 
 #define MAXLINE		(1000)
 #define CHUNK		(100)
 #define MAXQVALUE	(60)
 #define MAXNUMBINS      (5000)
 
+/* Binary training data being read */
+typedef struct {
+    TrainBinFile  *file;
+    TrainBinBlock  block;
+    int            next;        /* index of the next record in block */
+} BinaryInput;
+
 /***************************************************************************
- * get_bases
- * purpose: read bases from stdin to populate the pre-malloced array
- * <base> of length <base_count>. stdin should have the following format:
- * returns: the number of vali
- * id is_match parameter1 parameter2 parameter3 parameter4 is_valid
- *
- * called by: main
- * calls: none
- *
- * ASSUMES: 4 parameters
- *          input lines consist of
- *             sample_pos sample_char consensus_pos cons_char training_params
+ * next_field
  *
+ * purpose: return the next field of a line separated by blanks, tabs or
+ *          newlines, as strtok does, but keeping the position in <*pos>
+ *          so that several readers can parse lines at the same time.
  ***************************************************************************/
-BASE *
-get_bases(unsigned long initial_base_room, unsigned long *base_count,
-    char phred)
+static char *
+next_field(char **pos)
 {
-    unsigned long base_room, bases_used = 0;
-    BASE         *bases;
-    int           linenum = 0, prev_good_base = 0;
-    char          linebuf[1024], *s, new_frag_beg = 0;
-    double        is_match, qv;
-    int           spos, cpos;   /* Sample and consensus positions. */
-    char          schar, cchar, prev_schar='X'; /* Sample and consensus characters. */
-    BtkMessage    msg, *message = &msg;;
+    char *s = *pos + strspn(*pos, " \t\n");
+
+    if (*s == '\0')
+        return NULL;
+    *pos = s + strcspn(s, " \t\n");
+    if (**pos != '\0')
+        *(*pos)++ = '\0';
+    return s;
+}
 
-    base_room = initial_base_room;
-    bases = (BASE *) malloc(base_room * sizeof(bases[0]));
+/***************************************************************************
+ * get_text_record
+ * purpose: read the next record of text training data from fp, skipping
+ * blank lines and comments. Sets *new_frag_beg when a "# File" comment is
+ * passed and leaves *params pointing to the training parameters, if any.
+ * returns: 1 if a record was read, 0 at the end of input
+ ***************************************************************************/
+static int
+get_text_record(FILE *fp, char *linebuf, int size, int *linenum,
+    char *new_frag_beg, int *cpos, char *cchar, int *is_match, int *spos,
+    char *schar, char **params)
+{
+    char *s, *pos;
 
-    while (fgets(linebuf, sizeof(linebuf), stdin) != NULL)
+    while (fgets(linebuf, size, fp) != NULL)
     {
-        linenum++;
+        (*linenum)++;
 
 /* Ignore all white space lines and comments */
         if (strspn(linebuf, " \t\r\n") == strlen(linebuf))
             continue;
 
         if (linebuf[0] == '#' && linebuf[2] == 'F')
-            new_frag_beg = 1;
+            *new_frag_beg = 1;
 
         if (linebuf[0] == '#' || linebuf[0] == ';' ||
            (linebuf[0] == '/' && linebuf[1] == '*'))
             continue;
 
-/* Get rid of 1) sample position, 2) sample base,
- * 3) consensus position and 4) consensus base. */
+/* Get rid of 1) consensus position, 2) consensus base,
+ * 3) match flag, 4) sample position and 5) sample base. */
 
-        s = strtok(linebuf, " \t\n");
+        pos = linebuf;
+        s = next_field(&pos);
         if (s == NULL) continue;
-        cpos = atoi(s);
+        *cpos = atoi(s);
 
-        s = strtok(NULL, " \t\n");
+        s = next_field(&pos);
         if (s == NULL) continue;
-        cchar = s[0];
+        *cchar = s[0];
 
-        s=strtok(NULL, " \t\n");
-        if ( s==NULL ) { continue; }
-        is_match=atoi(s);
+        s = next_field(&pos);
+        if (s == NULL) continue;
+        *is_match = atoi(s);
 
-        s = strtok(NULL, " \t\n");
+        s = next_field(&pos);
         if (s == NULL) continue;
-        spos = atoi(s);
+        *spos = atoi(s);
 
-        s = strtok(NULL, " \t\n");
+        s = next_field(&pos);
         if (s == NULL) continue;
-        schar = s[0];
+        *schar = s[0];
 
-        s += strlen(s) + 1;
+        *params = pos;
+        return 1;
+    }
+    return 0;
+}
 
+/***************************************************************************
+ * get_binary_record
+ * purpose: same as get_text_record, for binary training data. The
+ * parameters of the record are then got with get_binary_params.
+ * returns: 1 if a record was read, 0 at the end of input
+ ***************************************************************************/
+static int
+get_binary_record(BinaryInput *in, int *linenum, char *new_frag_beg,
+    int *cpos, char *cchar, int *is_match, int *spos, char *schar)
+{
+    int k, r;
+
+    if (in->next == in->block.num_records)
+    {
+        if ((r = train_bin_next_block(in->file, &in->block)) == 0)
+            return 0;
+        if (r == ERROR)
+            exit(-1);
+        in->next = 0;
+    }
+    k = in->next++;
+    (*linenum)++;
+
+    if (in->block.flags[k] & TRAIN_BIN_NEW_FILE)
+        *new_frag_beg = 1;
+    *cpos     = in->block.dpos[k];
+    *cchar    = in->block.dchar[k];
+    *is_match = in->block.is_match[k];
+    *spos     = in->block.qpos[k];
+    *schar    = in->block.qchar[k];
+    return 1;
+}
+
+/***************************************************************************
+ * get_binary_params
+ * purpose: copy the 4 training parameters of the last record read with
+ * get_binary_record
+ * returns: 1 if the record has parameters, 0 otherwise
+ ***************************************************************************/
+static int
+get_binary_params(BinaryInput *in, double *phr3, double *phr7, double *psr7,
+    double *pres)
+{
+    int k = in->next - 1;
+
+    if (!(in->block.flags[k] & TRAIN_BIN_HAS_PARAMS))
+        return 0;
+    *phr3 = in->block.param[0][k];
+    *phr7 = in->block.param[1][k];
+    *psr7 = in->block.param[2][k];
+    *pres = in->block.param[3][k];
+    return 1;
+}
+
+/* Reader of the bases of a file of training data, text or binary */
+typedef struct BaseReader {
+    FILE          *fp;
+    char           phred;       /* read quality values, not parameters */
+    BinaryInput    bin;
+    char           linebuf[1024];
+    int            linenum;
+    int            eof;
+    char           new_frag_beg;
+    char           prev_schar;
+    BASE           prev_good;   /* last undeleted base, as read */
+    unsigned long  num_bases;   /* number of bases read so far */
+    BASE          *pending;     /* bases not yet returned */
+    int            num_pending;
+    int            num_ready;   /* the first num_ready are final */
+    int            next;        /* index of the next base to return */
+    int            room;
+} BaseReader;
+
+/***************************************************************************
+ * base_reader_open
+ * purpose: start reading bases from <fp>, which holds text training data
+ * or binary training data written by train -b. If <phred> is set, each
+ * base has a quality value instead of the 4 training parameters.
+ * returns: the reader, or NULL if there is not enough memory
+ ***************************************************************************/
+BaseReader *
+base_reader_open(FILE *fp, char phred)
+{
+    BaseReader *r;
+
+    if ((r = (BaseReader *)calloc(1, sizeof(BaseReader))) == NULL)
+        return NULL;
+    r->fp = fp;
+    r->phred = phred;
+    r->prev_schar = 'X';
+    r->room = CHUNK;
+    if ((r->pending = (BASE *)malloc(r->room * sizeof(BASE))) == NULL) {
+        free(r);
+        return NULL;
+    }
+
+    r->bin.file = train_bin_open_stream(fp);
+    if ((r->bin.file != NULL) && phred) {
+        fprintf(stderr, "Binary training data has no quality values\n");
+        exit(-1);
+    }
+    return r;
+}
+
+/***************************************************************************
+ * base_reader_close
+ * purpose: free the reader; the file itself is left open
+ ***************************************************************************/
+void
+base_reader_close(BaseReader *r)
+{
+    if (r == NULL)
+        return;
+    train_bin_close(r->bin.file);
+    free(r->pending);
+    free(r);
+}
+
+/***************************************************************************
+ * read_base
+ * purpose: read the next valid base into the pending bases of <r>.
+ * A deleted base gets, like the incorrect bases before it, the larger of
+ * the values of the undeleted bases around it, so it and they become
+ * final only when a correct base is read.
+ * returns: 1 if a base was read, 0 at the end of input
+ ***************************************************************************/
+static int
+read_base(BaseReader *r)
+{
+    int     i, j, garbled, match;
+    int     spos, cpos;   /* Sample and consensus positions. */
+    char    schar, cchar; /* Sample and consensus characters. */
+    char   *s = NULL;
+    double  qv;
+    BASE    base;
+
+    while ((r->bin.file != NULL)
+        ? get_binary_record(&r->bin, &r->linenum, &r->new_frag_beg, &cpos,
+              &cchar, &match, &spos, &schar)
+        : get_text_record(r->fp, r->linebuf, sizeof(r->linebuf),
+              &r->linenum, &r->new_frag_beg, &cpos, &cchar, &match, &spos,
+              &schar, &s))
+    {
         if ((cchar == 'X') || (cchar == 'N') || (schar == 'N')) {
             /* Consensus originally had '-', as a result of a polymorphism */
             continue;
@@ -98,100 +257,163 @@ get_bases(unsigned long initial_base_room, unsigned long *base_count,
         if (schar == '-')  /* deleted base */
         {
             /* Consensus may have 'N' at this position!
-             * We define fictitious values of * pres and phr3,
-             * and use real phr7 and psr7 of previous base
+             * Its values are set from the next undeleted base
              */
-            if ((bases_used < 1) || new_frag_beg) {
+            if ((r->num_bases < 1) || r->new_frag_beg)
                 continue;
+            base = r->prev_good;
+            base.is_match = 0;
+        }
+        else if (!r->phred)
+        {
+            if (r->bin.file != NULL) {
+                garbled = !get_binary_params(&r->bin, &base.parameter[0],
+                    &base.parameter[1], &base.parameter[2],
+                    &base.parameter[3]);
             }
             else {
-                is_match = 0; 
-                bases[bases_used].schar = schar;
-                bases[bases_used].new_frag_beg = new_frag_beg;
-                bases[bases_used].is_match = is_match;
-                bases_used++;
-                prev_schar = schar;
-                if ((bases_used % 100000) == 0) {
-                    fprintf(stderr, "\r%lu bases have been read", bases_used);
-                }
-                if (bases_used == base_room)
-                {
-                    base_room += BASE_COUNT_SCALE;
-                    bases = (BASE*)realloc(bases, base_room * sizeof(bases[0]));
-                }
-                new_frag_beg = 0;
-                continue;
+                garbled = (Btk_atod(&s, &base.parameter[0]) != 1)
+                      ||  (Btk_atod(&s, &base.parameter[1]) != 1)
+                      ||  (Btk_atod(&s, &base.parameter[2]) != 1)
+                      ||  (Btk_atod(&s, &base.parameter[3]) != 1);
             }
-        }
-        else  /* undeleted base */
-        {
-            if (!phred)
+            if (garbled)
             {
-                if ((Btk_atod(&s, &bases[bases_used].parameter[0]) != 1)
-                ||  (Btk_atod(&s, &bases[bases_used].parameter[1]) != 1)
-                ||  (Btk_atod(&s, &bases[bases_used].parameter[2]) != 1)
-                ||  (Btk_atod(&s, &bases[bases_used].parameter[3]) != 1))
-                {
+                if (r->bin.file != NULL)
+                    fprintf(stderr,
+                        "record %d: missing/garbled parameter; skipping\n",
+                        r->linenum);
+                else
                     fprintf(stderr,
                         "line %d:\n%s\nmissing/garbled parameter; skipping\n",
-                        linenum, linebuf);
-                    continue;
-                }
-                if ((prev_schar == '-') && (bases_used > 0))
-                {
-                    int i = bases_used-1;
-                    while ((i>=0) && (bases[i].is_match == (char)0))
-                    {
-                        bases[i].parameter[0] = 
-                            QVMAX(bases[prev_good_base].parameter[0],
-                                  bases[bases_used    ].parameter[0]);
-                        bases[i].parameter[1] = 
-                            QVMAX(bases[prev_good_base].parameter[1],
-                                  bases[bases_used    ].parameter[1]);
-                        bases[i].parameter[2] = 
-                            QVMAX(bases[prev_good_base].parameter[2],
-                                  bases[bases_used    ].parameter[2]);
-                        bases[i].parameter[3] = 
-                            QVMAX(bases[prev_good_base].parameter[3],
-                                  bases[bases_used    ].parameter[3]);
-                        i--;
-                    }
-                }
+                        r->linenum, r->linebuf);
+                continue;
             }
-            else
+            if ((r->prev_schar == '-') && (r->num_bases > 0))
             {
-                if (Btk_atod(&s, &qv) != 1) 
-                {
-                    fprintf(stderr,
-                        "line %d:\n%s\nmissing/garbled parameter; skipping\n",
-                        linenum, linebuf);
-                    continue;    
-                }
-                if (phred)
+                for (i = r->num_pending - 1;
+                     (i >= 0) && (r->pending[i].is_match == (char)0); i--)
                 {
-                    bases[bases_used].qv = (int)(qv + 0.0001);
+                    for (j = 0; j < PARAMETER_COUNT; j++)
+                        r->pending[i].parameter[j] =
+                            QVMAX(r->prev_good.parameter[j],
+                                  base.parameter[j]);
                 }
+            }
+            base.is_match = (char)match;
+        }
+        else
+        {
+            if (Btk_atod(&s, &qv) != 1) 
+            {
+                fprintf(stderr,
+                    "line %d:\n%s\nmissing/garbled parameter; skipping\n",
+                    r->linenum, r->linebuf);
+                continue;    
+            }
+            base.qv = (int)(qv + 0.0001);
 
-                if ((prev_schar == '-') && (bases_used > 0))
+            if ((r->prev_schar == '-') && (r->num_bases > 0))
+            {
+                for (i = r->num_pending - 1;
+                     (i >= 0) && (r->pending[i].is_match == (char)0); i--)
                 {
-                    int i = bases_used-1;
-                    while ((i>=0) && (bases[i].is_match == (char)0))
-                    {
-                        bases[i].qv = QVMAX(bases[prev_good_base].qv,
-                                            bases[bases_used    ].qv);
-                        i--;
-                    }
+                    r->pending[i].qv = QVMAX(r->prev_good.qv, base.qv);
                 }
             }
+            base.is_match = (char)match;
+        }
+
+        base.schar = schar;
+        base.new_frag_beg = r->new_frag_beg;
+        if (schar != '-')
+            r->prev_good = base;
+        r->prev_schar = schar;
+        r->new_frag_beg = 0;
+
+        if (r->num_pending == r->room) {
+            r->room += CHUNK;
+            r->pending = (BASE *)realloc(r->pending, r->room * sizeof(BASE));
+            if (r->pending == NULL) {
+                fprintf(stderr, "Cannot allocate memory for bases\n");
+                exit(-1);
+            }
         }
+        r->pending[r->num_pending++] = base;
+        r->num_bases++;
+
+        /* Nothing before a correct base can change any more */
+        if (base.is_match != (char)0)
+            r->num_ready = r->num_pending;
+        return 1;
+    }
+    return 0;
+}
+
+/***************************************************************************
+ * base_reader_next
+ * purpose: get the next base, in input order, with its final values.
+ * The memory used does not depend on the size of the input.
+ * returns: 1 if a base was got, 0 at the end of input
+ ***************************************************************************/
+int
+base_reader_next(BaseReader *r, BASE *base)
+{
+    while (r->next == r->num_ready)
+    {
+        if (r->next > 0) {
+            r->num_pending -= r->next;
+            (void)memmove(r->pending, r->pending + r->next,
+                r->num_pending * sizeof(BASE));
+            r->num_ready = r->next = 0;
+        }
+        if (r->eof || !read_base(r)) {
+            /* Bases after the last correct one keep the values they have */
+            r->eof = 1;
+            if (r->num_pending == 0)
+                return 0;
+            r->num_ready = r->num_pending;
+        }
+    }
+    *base = r->pending[r->next++];
+    return 1;
+}
+
+/***************************************************************************
+ * get_bases
+ * purpose: read bases from stdin to populate the pre-malloced array
+ * <base> of length <base_count>. stdin should have the following format:
+ * returns: the number of vali
+ * id is_match parameter1 parameter2 parameter3 parameter4 is_valid
+ *
+ * called by: main
+ * calls: base_reader_next
+ *
+ * ASSUMES: 4 parameters
+ *          input lines consist of
+ *             sample_pos sample_char consensus_pos cons_char training_params
+ *          or stdin is a file of binary training data written by train -b
+ *
+ ***************************************************************************/
+BASE *
+get_bases(unsigned long initial_base_room, unsigned long *base_count,
+    char phred)
+{
+    unsigned long base_room, bases_used = 0;
+    BASE         *bases;
+    BaseReader   *reader;
+    BtkMessage    msg, *message = &msg;;
 
-        prev_schar     = schar;
-        prev_good_base = bases_used;
-        bases[bases_used].is_match = (char)is_match;
-        bases[bases_used].schar = schar;
-        bases[bases_used].new_frag_beg = new_frag_beg;
+    base_room = initial_base_room;
+    bases = (BASE *) malloc(base_room * sizeof(bases[0]));
+    MEM_ERROR(bases);
+
+    reader = base_reader_open(stdin, phred);
+    MEM_ERROR(reader);
+
+    while (base_reader_next(reader, &bases[bases_used]))
+    {
         bases_used++;
-        new_frag_beg = 0;
 
         if ((bases_used % 100000) == 0) {
             fprintf(stderr, "\r%lu bases have been read", bases_used);
@@ -207,6 +429,7 @@ get_bases(unsigned long initial_base_room, unsigned long *base_count,
 
     if (bases_used != base_room)
         bases = (BASE*)realloc(bases, bases_used * sizeof(bases[0]));
+    base_reader_close(reader);
 
    *base_count = bases_used;
 
@@ -237,6 +460,7 @@ error:
  *
  * ASSUMES: input lines consist of
  *             sample_pos sample_char consensus_pos cons_char training_params
+ *          or stdin is a file of binary training data written by train -b
  *
  * NOTE: if schar == '-', the training parameters are not set.
  *******************************************************************************
@@ -246,52 +470,31 @@ getbase(int *cpos, char* cchar, int *is_match, int* spos, char* schar,
         double *phr3, double *phr7, double *psr7, double *pres, 
         double *iheight, double *iheight1, double *iheight2)
 {
-    char linebuf[MAXLINE], *s;
-    static int line = 0;
+    char linebuf[MAXLINE], *s, new_frag_beg;
+    static int line = 0, opened = 0;
+    static BinaryInput bin;
+
+    if (!opened) {
+        bin.file = train_bin_open_stream(stdin);
+        opened = 1;
+    }
 
     for (;;) 
     {
-	if (fgets(linebuf, MAXLINE, stdin) == NULL) {
-	    return 0;
-	}
-        
-        line++;
-
-	/* Ignore all white space lines and comments */
-	if (strspn(linebuf, " \t\r\n") == strlen(linebuf)) {
-	    continue;
-	}
-	if ((linebuf[0] == '#')
-	|| ((linebuf[0] == '/') && (linebuf[1] == '*'))
-	|| (linebuf[0] == ';'))
-	{
-	    continue;
-	}
-
-	/* Get rid of 1) sample position, 2) sample base,
-	 * 3) consensus position and 4) consensus base.
-	 */
-	s=strtok(linebuf, " \t\n");
-	if ( s==NULL ) { continue; }
-       *cpos=atoi(s);
-
-	s=strtok(NULL, " \t\n");
-	if ( s==NULL ) { continue; }
-       *cchar=s[0];
-
-        s=strtok(NULL, " \t\n");
-        if ( s==NULL ) { continue; }
-       *is_match = atoi(s);  
-
-	s=strtok(NULL, " \t\n");
-	if ( s==NULL ) { continue; }
-       *spos=atoi(s);
-
-	s=strtok(NULL, " \t\n");
-	if ( s==NULL ) { continue; }
-       *schar=s[0];
-
-	s+=strlen(s)+1;
+        if (bin.file != NULL) {
+            if (!get_binary_record(&bin, &line, &new_frag_beg, cpos, cchar,
+                is_match, spos, schar))
+            {
+                train_bin_close(bin.file);
+                bin.file = NULL;
+                return 0;
+            }
+        }
+        else if (!get_text_record(stdin, linebuf, MAXLINE, &line,
+            &new_frag_beg, cpos, cchar, is_match, spos, schar, &s))
+        {
+            return 0;
+        }
         
         /* Ignore base positions where consensus base is 'N' or 'X' */
         if (((*cchar) == 'N') || ((*cchar) == 'X')) 
@@ -305,10 +508,12 @@ getbase(int *cpos, char* cchar, int *is_match, int* spos, char* schar,
             return 1; 
         }
 
-        if ((Btk_atod(&s, phr3)     != 1) ||
-            (Btk_atod(&s, phr7)     != 1) ||
-            (Btk_atod(&s, psr7)     != 1) ||
-            (Btk_atod(&s, pres)     != 1))
+        if ((bin.file != NULL)
+            ? !get_binary_params(&bin, phr3, phr7, psr7, pres)
+            : ((Btk_atod(&s, phr3)     != 1) ||
+               (Btk_atod(&s, phr7)     != 1) ||
+               (Btk_atod(&s, psr7)     != 1) ||
+               (Btk_atod(&s, pres)     != 1)))
         { 
             fprintf(stderr,
                 "line %d: missing/garbled parameter; skipping\n", line);
@@ -14,6 +14,11 @@
 #define MAXQVALUE       (100)
 #define MAXNUMBINS      (5000)
 
+typedef struct BaseReader BaseReader;
+
+extern BaseReader *base_reader_open(FILE *, char);
+extern int   base_reader_next(BaseReader *, BASE *);
+extern void  base_reader_close(BaseReader *);
 extern BASE *get_bases(unsigned long , unsigned long *, char);
 extern int   getbase(int *, char* , int *, int* , char* , 
     double *, double *, double *, double *, 
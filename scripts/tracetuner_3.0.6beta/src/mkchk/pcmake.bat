@@ -13,6 +13,7 @@ copy ..\compute_qv\Btk_qv.h Btk_qv.h
 copy ..\compute_qv\Btk_qv_data.h Btk_qv_data.h
 copy ..\compute_qv\Btk_compute_qv.h Btk_compute_qv.h
 copy ..\compute_qv\util.h util.h
+copy ..\compute_qv\train_bin.h train_bin.h
 copy ..\mktrain\train.h train.h
 copy ..\mklut\lut.h lut.h
 copy ..\mklut\params.h params.h
@@ -35,6 +36,7 @@ del Btk_qv_data.h
 del Btk_lookup_table.h
 del Btk_compute_qv.h
 del util.h
+del train_bin.h
 del train.h
 del lut.h
 del params.h
@@ -46,6 +46,133 @@
 extern int Verbose;     /* How much status info to print, if any */
 extern int Compress;    /* Whether to compress thresholds */
 
+/***************************************************************************
+ * Function: set_thresholds
+ *
+ * Purpose: determine a set of thresholds for parameter #<i> such that an
+ *          even number of bases fall between each threshold, given the
+ *          <num_val> sorted unique values of the parameter and the number
+ *          of bases having each one of them.
+ *
+ * Called by: get_thresholds, get_thresholds_from_sketches
+ *
+ ***************************************************************************/
+static void
+set_thresholds(PARAMETER parameter[], int i, double *parameter_value,
+    long *weight_value, int num_val, long base_count)
+{
+    int j, jj, k, kk, compressed, unique_count = num_val - 1;
+    long m, remain_weight;
+    long params_per_threshold, thresholds_per_value, unique_sum;
+
+    parameter[i].max = parameter_value[unique_count];
+
+    for (m = base_count, k = -1, j = 0; 
+         (j < parameter[i].threshold_count) && (k < unique_count-1); 
+         j++)
+    {
+        /* Calculate number per bin with current parameters left 
+         * and bins left 
+         */
+        params_per_threshold = (long)rint(((double) m) / 
+                                     (parameter[i].threshold_count - j));
+        unique_sum = weight_value[++k];
+
+        if (unique_sum < params_per_threshold)
+        {
+            while (unique_sum < params_per_threshold)
+                unique_sum += weight_value[++k];
+
+            if ((params_per_threshold - unique_sum + weight_value[k] >
+                unique_sum - params_per_threshold)
+            ||
+                params_per_threshold - unique_sum + weight_value[k - 1] <
+                (rint) (((double) params_per_threshold) * MIN_BIN_FRACTION))
+            {
+                parameter[i].threshold[j] = (parameter_value[k] 
+                    + parameter_value[k + 1]) / 2;
+                m -= unique_sum;
+            }
+            else
+            {
+                parameter[i].threshold[j] = (parameter_value[k - 1] 
+                    + parameter_value[k]) / 2;
+                m -= unique_sum - weight_value[k--];
+            }
+        }
+        else
+        {
+            thresholds_per_value = (long)floor(((double) weight_value[k]) / 
+                                              params_per_threshold);
+            remain_weight = weight_value[k] 
+                - thresholds_per_value * params_per_threshold;
+
+            for (jj = j; jj < j + thresholds_per_value; jj++)
+            {
+                parameter[i].threshold[j] = (parameter_value[k] 
+                    + parameter_value[k + 1]) / 2;
+                m -= params_per_threshold;
+            }
+
+            if (remain_weight > 0)
+            {
+                parameter[i].threshold[j] = (parameter_value[k] 
+                    + parameter_value[k + 1]) / 2;
+                m -= remain_weight;
+            }
+        }
+    }
+    parameter[i].threshold_count = j;
+
+    parameter[i].threshold[parameter[i].threshold_count - 1] 
+        = parameter[i].max;
+
+    if (Compress)
+    {
+        /*
+         * Compress the thresholds if any are duplicated.  Compress instead
+         * of redistributing across the remaining values to limit the
+         * skewness of the resulting bins.  For example, if we're picking
+         * three thresholds from the data (0 0 0 0 0 0 1 2 3), we'd get 0,
+         * 0, and 3.  Since the first two are 0, we want two buckets
+         * instead, one with a value of 0 (6 bases), and the other with a
+         * value of 3 (3 bases).  These buckets are somewhat skewed, but
+         * they're the best we can do with this data.  If, instead, we
+         * chose to redistribute, we'd get three buckets all right, one
+         * with a value of 0 (6 bases), another with a value of 2 (2
+         * bases), and the last one with a value of 3 (1 base), which is
+         * even more skewed.
+         */
+
+        for (kk = 1, compressed = j = 0; 
+             j < parameter[i].threshold_count - 1; 
+             j++)
+        {
+            while ((j + kk < parameter[i].threshold_count-1) &&
+                (parameter[i].threshold[j] == 
+                 parameter[i].threshold[j + kk])) {
+                kk++;
+            }
+
+            if (kk > 1)   /* got some dups; shift down and continue */
+            {
+                assert(parameter[i].threshold_count - (j + kk) >= 0);
+                memmove(&parameter[i].threshold[j + 1], 
+                    &parameter[i].threshold[j + kk],
+                    (parameter[i].threshold_count - (j + kk)) *
+                    sizeof(parameter[i].threshold[0]));
+                parameter[i].threshold_count -= kk - 1;
+                compressed += kk - 1;
+            }
+        }
+
+        if (Verbose > 1 && compressed > 0)
+            fprintf(stderr, 
+                "compressed down to %d thresholds for parm #%d\n",
+                parameter[i].threshold_count, i);
+    }
+}
+
 /***************************************************************************
  * Function: get_thresholds
  *
@@ -53,15 +180,14 @@ extern int Compress;    /* Whether to compress thresholds */
  *          even number of bases fall between each threshold.
  *
  * Called by: main in file lut.c
- * Calls:     randomized_select
+ * Calls:     quicksort, set_thresholds
  *
  ***************************************************************************/
 void
 get_thresholds(BASE *base, unsigned long base_count, PARAMETER parameter[])
 {
-    int i, j, jj, k, kk, m, compressed, remain_weight;
-    int *weight_value;
-    int params_per_threshold, thresholds_per_value, unique_count, unique_sum;
+    int i, j, unique_count;
+    long *weight_value;
     double *parameter_value;
 
     parameter_value = (double *) malloc(sizeof(double) * base_count);
@@ -74,7 +200,7 @@ get_thresholds(BASE *base, unsigned long base_count, PARAMETER parameter[])
 
     for (i = 0; i < PARAMETER_COUNT; i++)
     {
-        weight_value = (int *) malloc(sizeof(*weight_value) * BLOCKSIZE);
+        weight_value = (long *) malloc(sizeof(*weight_value) * BLOCKSIZE);
         if (weight_value == NULL)
         {
             puts("couldn't malloc weight_value");
@@ -116,7 +242,7 @@ get_thresholds(BASE *base, unsigned long base_count, PARAMETER parameter[])
             if (parameter_value[j] != parameter_value[j - 1])
             {
                 if (++unique_count % BLOCKSIZE == 0)
-                    weight_value = (int*)realloc(weight_value, 
+                    weight_value = (long*)realloc(weight_value, 
                           sizeof(*weight_value) * (unique_count + BLOCKSIZE));
 
                 parameter_value[unique_count] = parameter_value[j];
@@ -141,227 +267,226 @@ get_thresholds(BASE *base, unsigned long base_count, PARAMETER parameter[])
             fprintf(stderr, "parameter #%d: %lu values, %d unique\n",
                                          i,  base_count, unique_count + 1);
 
-        parameter[i].max = parameter_value[unique_count];
+        set_thresholds(parameter, i, parameter_value, weight_value,
+            unique_count + 1, (long)base_count);
+        free(weight_value);
+    }
 
-        for (m = base_count, k = -1, j = 0; 
-             (j < parameter[i].threshold_count) && (k < unique_count-1); 
-             j++)
+    free(parameter_value);
+}
+
+/***************************************************************************
+ * Function: compare_values
+ * Purpose:  order doubles for qsort
+ ***************************************************************************/
+static int
+compare_values(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/***************************************************************************
+ * Function: merge_into_sketch
+ *
+ * Purpose: add <num_val> sorted unique values, with their weights, to
+ *          the sketch. If it then holds more than SKETCH_SIZE values,
+ *          runs of neighbouring values whose total weight is at most
+ *          2*count/SKETCH_SIZE are merged into their largest value, which
+ *          keeps it within about SKETCH_SIZE values. The rank of any value
+ *          read from the sketch is then off by at most that weight, and
+ *          the largest value is kept exactly.
+ *
+ ***************************************************************************/
+static void
+merge_into_sketch(SKETCH *sketch, double *value, long *weight, int num_val)
+{
+    int     i = 0, j = 0, n = 0;
+    long    limit;
+    double *v;
+    long   *w;
+
+    v = (double *) malloc(sizeof(double) * (sketch->num_val + num_val + 1));
+    w = (long *) malloc(sizeof(long) * (sketch->num_val + num_val + 1));
+    if (v == NULL || w == NULL)
+    {
+        puts("couldn't malloc sketch");
+        exit(1);
+    }
+
+    while (i < sketch->num_val || j < num_val)
+    {
+        if (j == num_val ||
+            (i < sketch->num_val && sketch->value[i] < value[j]))
+        {
+            v[n] = sketch->value[i];
+            w[n++] = sketch->weight[i++];
+        }
+        else if (i == sketch->num_val || value[j] < sketch->value[i])
+        {
+            v[n] = value[j];
+            w[n++] = weight[j++];
+        }
+        else
         {
-            /* Calculate number per bin with current parameters left 
-             * and bins left 
-             */
-            params_per_threshold = (int)rint(((double) m) / 
-                                         (parameter[i].threshold_count - j));
-            unique_sum = weight_value[++k];
-
-            if (unique_sum < params_per_threshold)
+            v[n] = value[j];
+            w[n++] = sketch->weight[i++] + weight[j++];
+        }
+    }
+    free(sketch->value);
+    free(sketch->weight);
+    sketch->value = v;
+    sketch->weight = w;
+    sketch->num_val = n;
+
+    if (sketch->num_val > SKETCH_SIZE)
+    {
+        limit = 2 * (sketch->count / SKETCH_SIZE);
+        for (i = 1, n = 0; i < sketch->num_val; i++)
+        {
+            if (w[n] + w[i] <= limit)
             {
-                while (unique_sum < params_per_threshold)
-                    unique_sum += weight_value[++k];
-
-                if ((params_per_threshold - unique_sum + weight_value[k] >
-                    unique_sum - params_per_threshold)
-                ||
-                    params_per_threshold - unique_sum + weight_value[k - 1] <
-                    (rint) (((double) params_per_threshold) * MIN_BIN_FRACTION))
-                {
-                    parameter[i].threshold[j] = (parameter_value[k] 
-                        + parameter_value[k + 1]) / 2;
-                    m -= unique_sum;
-                }
-                else
-                {
-                    parameter[i].threshold[j] = (parameter_value[k - 1] 
-                        + parameter_value[k]) / 2;
-                    m -= unique_sum - weight_value[k--];
-                }
+                v[n] = v[i];
+                w[n] += w[i];
             }
             else
             {
-                thresholds_per_value = (int)floor(((double) weight_value[k]) / 
-                                                  params_per_threshold);
-                remain_weight = weight_value[k] 
-                    - thresholds_per_value * params_per_threshold;
-
-                for (jj = j; jj < j + thresholds_per_value; jj++)
-                {
-                    parameter[i].threshold[j] = (parameter_value[k] 
-                        + parameter_value[k + 1]) / 2;
-                    m -= params_per_threshold;
-                }
-
-                if (remain_weight > 0)
-                {
-                    parameter[i].threshold[j] = (parameter_value[k] 
-                        + parameter_value[k + 1]) / 2;
-                    m -= remain_weight;
-                }
+                v[++n] = v[i];
+                w[n] = w[i];
             }
         }
-        parameter[i].threshold_count = j;
+        sketch->num_val = n + 1;
+    }
+}
+
+/***************************************************************************
+ * Function: sketch_flush
+ * Purpose:  move the values added since the last flush into the sorted
+ *           part of the sketch
+ ***************************************************************************/
+static void
+sketch_flush(SKETCH *sketch)
+{
+    int   j, unique_count;
+    long *weight;
 
-        parameter[i].threshold[parameter[i].threshold_count - 1] 
-            = parameter[i].max;
+    if (sketch->num_new == 0)
+        return;
 
-        if (Compress)
-        {
-            /*
-             * Compress the thresholds if any are duplicated.  Compress instead
-             * of redistributing across the remaining values to limit the
-             * skewness of the resulting bins.  For example, if we're picking
-             * three thresholds from the data (0 0 0 0 0 0 1 2 3), we'd get 0,
-             * 0, and 3.  Since the first two are 0, we want two buckets
-             * instead, one with a value of 0 (6 bases), and the other with a
-             * value of 3 (3 bases).  These buckets are somewhat skewed, but
-             * they're the best we can do with this data.  If, instead, we
-             * chose to redistribute, we'd get three buckets all right, one
-             * with a value of 0 (6 bases), another with a value of 2 (2
-             * bases), and the last one with a value of 3 (1 base), which is
-             * even more skewed.
-             */
-
-            for (kk = 1, compressed = j = 0; 
-                 j < parameter[i].threshold_count - 1; 
-                 j++)
-            {
-                while ((j + kk < parameter[i].threshold_count-1) &&
-                    (parameter[i].threshold[j] == 
-                     parameter[i].threshold[j + kk])) {
-                    kk++;
-                }
-
-                if (kk > 1)   /* got some dups; shift down and continue */
-                {
-                    assert(parameter[i].threshold_count - (j + kk) >= 0);
-                    memmove(&parameter[i].threshold[j + 1], 
-                        &parameter[i].threshold[j + kk],
-                        (parameter[i].threshold_count - (j + kk)) *
-                        sizeof(parameter[i].threshold[0]));
-                    parameter[i].threshold_count -= kk - 1;
-                    compressed += kk - 1;
-                }
-            }
+    /* qsort rather than quicksort, which shares rand() between threads */
+    qsort(sketch->new_value, sketch->num_new, sizeof(double), compare_values);
 
-            if (Verbose > 1 && compressed > 0)
-                fprintf(stderr, 
-                    "compressed down to %d thresholds for parm #%d\n",
-                    parameter[i].threshold_count, i);
+    weight = (long *) malloc(sizeof(long) * sketch->num_new);
+    if (weight == NULL)
+    {
+        puts("couldn't malloc sketch");
+        exit(1);
+    }
+    weight[0] = 1;
+    for (j = 1, unique_count = 0; j < sketch->num_new; j++)
+    {
+        if (sketch->new_value[j] != sketch->new_value[unique_count])
+        {
+            sketch->new_value[++unique_count] = sketch->new_value[j];
+            weight[unique_count] = 1;
         }
+        else
+            weight[unique_count]++;
     }
 
-    free(parameter_value);
-    free(weight_value);
+    merge_into_sketch(sketch, sketch->new_value, weight, unique_count + 1);
+    sketch->num_new = 0;
+    free(weight);
 }
 
 /***************************************************************************
- * Function: get_thresholds2
- * 
- * Purpose: determine a set of thresholds for each parameter such that an 
- *          even number of bases fall between each threshold.
+ * Function: sketch_init
+ * Purpose:  make an empty sketch
+ ***************************************************************************/
+void
+sketch_init(SKETCH *sketch)
+{
+    sketch->num_val = 0;
+    sketch->value = NULL;
+    sketch->weight = NULL;
+    sketch->count = 0;
+    sketch->num_new = 0;
+    sketch->new_value = (double *) malloc(sizeof(double) * BASE_COUNT_SCALE);
+    if (sketch->new_value == NULL)
+    {
+        puts("couldn't malloc sketch");
+        exit(1);
+    }
+}
+
+/***************************************************************************
+ * Function: sketch_add
+ * Purpose:  count one more base having the given parameter value
+ ***************************************************************************/
+void
+sketch_add(SKETCH *sketch, double value)
+{
+    if (sketch->num_new == BASE_COUNT_SCALE)
+        sketch_flush(sketch);
+    sketch->new_value[sketch->num_new++] = value;
+    sketch->count++;
+}
+
+/***************************************************************************
+ * Function: sketch_merge
+ * Purpose:  add the values counted by sketch <from> to sketch <to>
+ ***************************************************************************/
+void
+sketch_merge(SKETCH *to, SKETCH *from)
+{
+    sketch_flush(from);
+    sketch_flush(to);
+    to->count += from->count;
+    if (from->num_val > 0)
+        merge_into_sketch(to, from->value, from->weight, from->num_val);
+}
+
+/***************************************************************************
+ * Function: sketch_release
+ ***************************************************************************/
+void
+sketch_release(SKETCH *sketch)
+{
+    free(sketch->value);
+    free(sketch->weight);
+    free(sketch->new_value);
+    sketch->value = NULL;
+    sketch->weight = NULL;
+    sketch->new_value = NULL;
+    sketch->num_val = 0;
+}
+
+/***************************************************************************
+ * Function: get_thresholds_from_sketches
+ *
+ * Purpose: determine a set of thresholds for each parameter such that an
+ *          even number of bases fall between each threshold, as
+ *          get_thresholds does, from a sketch of the values of each
+ *          parameter rather than from the bases themselves.
  *
  * Called by: main in file lut.c
  *
- ***************************************************************************
- */
+ ***************************************************************************/
 void
-get_thresholds2(PARAMETER parameter[])
+get_thresholds_from_sketches(SKETCH sketch[], PARAMETER parameter[])
 {
-    int i, j=0, k=0;
-    int expected_bin_size, sum, sum1, num_thresholds;     
+    int i;
 
     for (i = 0; i < PARAMETER_COUNT; i++)
     {
+        sketch_flush(&sketch[i]);
 
-        fprintf(stderr, 
-            "   parameter %d, num_val=%d ", 
-            i, parameter[i].num_val);
-        sum = 0;
-        for (j = 0; j < parameter[i].num_val; j++) {
-            sum += parameter[i].weight[j];
-            if (j < parameter[i].num_val-1 &&
-                    parameter[i].value[j] >= parameter[i].value[j+1]) {
-                fprintf(stderr, "In get_thresholds2: parameters disordered!!!\n");
-            }
-        }
+        if (Verbose > 1)
+            fprintf(stderr, "parameter #%d: %lu values, %d in sketch\n",
+                i, (unsigned long)sketch[i].count, sketch[i].num_val);
 
-        /* Set the last threshold */
-        num_thresholds = parameter[i].threshold_count;
-        parameter[i].threshold[num_thresholds-1] = 
-            parameter[i].value[parameter[i].num_val-1];
-        parameter[i].max = parameter[i].threshold[num_thresholds-1];
-        fprintf(stderr,
-            " last threshold=%f\n", parameter[i].threshold[num_thresholds-1]);
-        /* Compute the rest of the thresholds */
-        j = 0;
-        k = 0;
-        while (k < parameter[i].threshold_count-1) {
-            expected_bin_size = sum / num_thresholds;
-
-            /* Case 1: one unique value per bin 
-             **********************************
-             */
-            if (j < parameter[i].num_val-1 &&
-                parameter[i].weight[j] >= expected_bin_size) 
-            {
-//              fprintf(stderr, "Case 1\n");
-                parameter[i].threshold[k] = 
-                    (parameter[i].value[j] + parameter[i].value[j+1])/2.; 
-                k++;
-                j++;
-                num_thresholds--;
-                sum -= parameter[i].weight[j];
-#if DISPLAY_THRESHOLD_DETAILS
-                fprintf(stderr, "Threshold=%d, param=%d, tot_weight=%d exp_size=%d...\n",
-                    k, j, parameter[i].weight[j], expected_bin_size);
-#endif
-            }
-            
-            /* Case 2: one or more unique values per bin 
-             *******************************************
-             */
-            else if (j < parameter[i].num_val-1 &&
-                parameter[i].weight[j] < expected_bin_size) 
-            {
-//              fprintf(stderr, "Case 2\n");
-                sum1 = parameter[i].weight[j];
-                while (sum1 < expected_bin_size &&
-                    j < parameter[i].num_val-1) 
-                {
-                    j++;
-                    sum1 += parameter[i].weight[j];
-                }
-//              fprintf(stderr, "   j=%d sum1=%d\n", j, sum1);
-                sum -= sum1;
-                if (j < parameter[i].num_val-1 && sum1 >=expected_bin_size) {
-                    parameter[i].threshold[k] =
-                        (parameter[i].value[j] + parameter[i].value[j+1])/2.;
-#if DISPLAY_THRESHOLD_DETAILS
-                    fprintf(stderr, 
-                        "Threshold=%d, param=%d, tot_weight=%d exp_size=%d...\n",
-                        k, j, sum1, expected_bin_size);
-#endif
-                    k++;
-                    num_thresholds--;
-                }
-                else if (j == parameter[i].num_val-1) {
-                    parameter[i].threshold_count = k;
-                    parameter[i].threshold[k-1] = parameter[i].value[j];
-                    parameter[i].threshold = 
-                        (double*)realloc(parameter[i].threshold, k*sizeof(double)); 
-#if DISPLAY_THRESHOLD_DETAILS
-                    fprintf(stderr, 
-                        "Threshold=%d, param=%d, tot_weight=%d exp_size=%d...\n",
-                        k, j, sum1, expected_bin_size);
-#endif
-                }        
-            }
-            /* No parameters left */
-            else if (j == parameter[i].num_val-1) {
-                parameter[i].threshold_count = k;
-                parameter[i].threshold[k] = parameter[i].value[j];
-                parameter[i].threshold =
-                    (double*)realloc(parameter[i].threshold, k*sizeof(double));
-            }
-        } /* end loop in k */
-    }     /* end loop in i */
+        set_thresholds(parameter, i, sketch[i].value, sketch[i].weight,
+            sketch[i].num_val, sketch[i].count);
+    }
 }
@@ -23,5 +23,10 @@
  *************************************************************************/
 
 void get_thresholds(BASE *base, unsigned long base_count, PARAMETER parameter[]);
-void get_thresholds2(PARAMETER parameter[]);
+void get_thresholds_from_sketches(SKETCH sketch[], PARAMETER parameter[]);
+
+void sketch_init(SKETCH *sketch);
+void sketch_add(SKETCH *sketch, double value);
+void sketch_merge(SKETCH *to, SKETCH *from);
+void sketch_release(SKETCH *sketch);
 
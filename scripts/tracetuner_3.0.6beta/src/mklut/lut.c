@@ -65,9 +65,12 @@ int          Compress;         /* Whether to compress thresholds */
 #define DISPLAY_BASES 0
 #define DISPLAY_THRESHOLDS 0
 #define MIN_INCORRECT_COUNT 3
+#define MAX_LUT_THREADS 16  /* most tasks run_tasks will start */
 
 static char OutputName[BUFLEN];    /* Name of the Output lookup table file. */
 static int  OutputSpecified;       /* Whether the user has specified a name. */
+static char BinaryName[BUFLEN];    /* Name of the binary lookup table file. */
+static char TextTableName[BUFLEN]; /* Text lookup table to convert, if any. */
 
 static void 
 show_usage(int argc, char *argv[])
@@ -76,9 +79,13 @@ show_usage(int argc, char *argv[])
     "\nVersion: %s\n"
     "usage: %s\n"
     "     [ -Q ] [ -V ]\n"
-    "     [ -o <output_file> ]\n"
+    "     [ -o <output_file> [ -B <binary_file> ]]\n"
     "     <num_thresholds>  <  <alignment_file>\n"
-      , TT_VERSION, argv[0]);
+    "or:  %s [ -Q ] [ -V ]\n"
+    "     [ -o <output_file> [ -B <binary_file> ]]\n"
+    "     -f <file_of_train_files> [ -T <num_threads> ] <num_thresholds>\n"
+    "or:  %s -t <lookup_table_file> -B <binary_file>\n"
+      , TT_VERSION, argv[0], argv[0], argv[0]);
 }
 
 static void
@@ -90,10 +97,11 @@ show_usage_dev(int argc, char *argv[])
     "     [ -Q ] [ -V ]\n"
     "     [ -c ] [ -C ] \n"
     "     [ -b <initialbaseroom>]\n"
-    "     [ -f <fileoffiles>]\n"
-    "     [ -o <lookup_table_file> ]\n"
+    "     [ -f <fileoffiles> [ -T <num_threads> ]]\n"
+    "     [ -o <lookup_table_file> [ -B <binary_file> ]]\n"
     "     <num_thresholds>  <  <alignment_file>\n"
-      , TT_VERSION, argv[0]);
+    "or:  %s -t <lookup_table_file> -B <binary_file>\n"
+      , TT_VERSION, argv[0], argv[0]);
 }
 
 
@@ -419,142 +427,6 @@ number_in_cut(int i, int j, int k, int l, INFO *info,
     return c_1111;
 }
 
-/**************************************************************************
- * Function: read_bases_and_populate_bins
- **************************************************************************
- */
-int 
-read_bases_and_populate_bins(char *InputName, 
-    unsigned long *base_count, PARAMETER parameter[], BIN *bin)
-{
-    int           i, read_count=0;
-#if DISPLAY_THRESHOLDS
-    int           j;
-#endif
-    int           linenum = 0, index[PARAMETER_COUNT];
-    char          train_name[BUFLEN], *s, *current;
-    double        is_match;
-    int           spos, cpos;   /* Sample and consensus positions. */
-    char          schar, cchar; /* Sample and consensus characters. */
-    char          buffer[BUFLEN];
-    FILE         *fileoffiles, *trainfile;
-    BASE          base;
-    BIN          *current_bin;
-
-    if ((fileoffiles=fopen(InputName,"r"))== NULL) {
-        fprintf(stderr, "Unable to open file_of_files '%s'\n",
-            InputName);
-        return ERROR;
-    }
-
-   *base_count = 0;
-    current = buffer;
-
-#if DISPLAY_THRESHOLDS
-    for (i = 0; i < PARAMETER_COUNT; i++) {
-        fprintf(stderr, "\nParameter=%d, thresholds: \n", i);
-        for (j=0; j<parameter[i].threshold_count; j++) {
-            fprintf(stderr, "%f\n", parameter[i].threshold[j]);
-        }
-    }
-#endif
-    while (fgets(current, BUFLEN, fileoffiles) != NULL)
-    {
-        /* Ignore all white space lines and comments */
-        if (strspn(current, " \t\r\n") == strlen(current)) {
-            continue;
-        }
-        if ((current[0] == '#')
-            || ((current[0] == '/') && (current[1] == '*'))
-            || (current[0] == ';'))
-        {
-            continue;
-        }
-
-        /* Open an individual train file */
-        sscanf(current, "%s", train_name);
-        if ((trainfile=fopen(train_name,"r"))== NULL) {
-            fprintf(stderr, "Unable to open train file '%s'\n",
-                InputName);
-            return ERROR;
-        }
-
-        linenum = 0;
-        while (fgets(train_name, sizeof(train_name), trainfile) != NULL)
-        {
-            linenum++;
-
-/* Ignore all white space lines and comments */
-            if (strspn(train_name, " \t\r\n") == strlen(train_name))
-                continue;
-
-            if (train_name[0] == '#' || train_name[0] == ';' ||
-               (train_name[0] == '/' && train_name[1] == '*'))
-                continue;
-
-/* Get rid of 1) sample position, 2) sample base,
- * 3) consensus position and 4) consensus base. */
-
-            s = strtok(train_name, " \t\n");
-            if (s == NULL) continue;
-            spos = atoi(s);
-
-            s = strtok(NULL, " \t\n");
-            if (s == NULL) continue;
-            schar = s[0];
-
-            s = strtok(NULL, " \t\n");
-            if (s == NULL) continue;
-            cpos = atoi(s);
-
-            s = strtok(NULL, " \t\n");
-            if (s == NULL) continue;
-            cchar = s[0];
-
-            s += strlen(s) + 1;
-
-/* If sample == '-', there are no training parameters. */
-
-            if (schar == '-') continue;
-
-            if (Btk_atod(&s, &is_match) != 1
-            ||  Btk_atod(&s, &base.parameter[0]) != 1
-            ||  Btk_atod(&s, &base.parameter[1]) != 1
-            ||  Btk_atod(&s, &base.parameter[2]) != 1
-            ||  Btk_atod(&s, &base.parameter[3]) != 1)
-            {
-                fprintf(stderr, 
-                "train file %s, line %d:\n%s\nmissing/garbled base; skipping\n",
-                        train_name, linenum, current);
-                continue;
-            }
-
-           (*base_count)++;
-            read_count++;
-            if ((read_count % 100000) == 0) {
-                fprintf(stderr, "\r   %d bases populated", read_count);
-            }
-
-            /* Populate bins with current base */
-            for (i = 0; i < PARAMETER_COUNT; i++) {
-                index[i] = get_threshold_index(base.parameter[i],
-                    parameter[i].threshold, parameter[i].threshold_count);
-            }
-            current_bin = get_bin(bin, parameter, index);
-            if (is_match)
-                current_bin->correct++;
-            else
-                current_bin->incorrect++;  
-
-        }   /* loop in lines of a particular trainfile */
-        fclose(trainfile);
-    }       /* loop in lines of fileoffiles */
-    fprintf(stderr, "\n   %d bases populated\n", read_count);
-    fclose(fileoffiles);
-
-    return SUCCESS;
-}
-
 /**************************************************************************
  * count_number_of_correct_bases_in_each_bin
  * 
@@ -998,120 +870,31 @@ display_number_of_correct_bases_in_each_bin(PARAMETER *parameter, BIN *bin)
 }
 #endif
 
+/* The train files given with -f, and the state of each task of the passes
+ * over them. Task t reads files t, t+num_tasks, t+2*num_tasks, ...
+ */
+typedef struct {
+    char          **file;           /* names of the train files */
+    int             num_files;
+    int             num_tasks;
+    PARAMETER      *parameter;
+    SKETCH          sketch[MAX_LUT_THREADS][PARAMETER_COUNT];
+    BIN            *bin[MAX_LUT_THREADS];
+    unsigned long   base_count[MAX_LUT_THREADS];
+} TRAIN_FILES;
+
 /**************************************************************************
- * Function: compress_params_array          
- * Purpose:  compress all duplicated parameter values into unique values 
- *           and set its weight to the original number of the 
- *           duplicates
+ * Function: read_file_of_files
+ * Purpose:  get the names of the train files listed in <InputName>, one
+ *           per line; blank lines and comments are ignored
  **************************************************************************
  */
-int
-compress_params_array(double **A, int **w, int *len)
-{
-    int     i, j;
-    int     max_weight=0, *wn;
-    double  A_min=(*A)[0];
-
-#if 0
-    for (i=0; i<*len; i++) {
-        if (max_weight<(*w)[i]) {
-            max_weight = (*w)[i];
-        }
-    }
-    fprintf(stderr, "Begin compress_params_array: max_weight=%d\n",max_weight);
-#endif
-    wn = (int*)calloc(*len, sizeof(int));
-
-    j=0;
-    max_weight=0;
-    for (i=0; i<*len; i++) {
-        if ((*w)[i] <=0) {
-            fprintf(stderr, "ERROR: weight[%d]=%d<0!!!\n", i, (*w)[i]);
-        }
-        wn[j] += (*w)[i];
-#if 0  
-        if (max_weight < wn[j]) {
-            max_weight = wn[j];
-        }
-#endif
-        /* Compress into one all the values that are distanced 
-         * one from anotherby no more than MIN_DIST
-         */
-        if (i < *len-1 && (*A)[i] < (*A)[i+1]-MIN_DIST) {
-            (*A)[j]  = (A_min + (*A)[i])/2.;
-            j++;
-            A_min = (*A)[i+1];
-        }
-        else if (i == *len-1) {
-            (*A)[j]  = (A_min + (*A)[i])/2.;
-            j++;
-        }
-    }        
-#if 0
-    fprintf(stderr, "In compress_params_array: max_weight=%d\n", 
-        max_weight);
-#endif
-    /* Give back unused memory */                     
-   *len = j;         
-
-    max_weight=0;
-    for (i=0; i<*len; i++) {
-        (*w)[i]=wn[i];
-#if 0
-        if (max_weight<(*w)[i]) {
-            max_weight = (*w)[i];
-        }
-#endif
-    }
-#if 0
-    fprintf(stderr, "End of compress_params_array: max_weight=%d\n",
-        max_weight);
-#endif
-    free(wn);
-    wn=NULL;
-
-    return SUCCESS;
-}
-
-
-/***************************************************************************
- * Function: read_and_sort_trace_parameters
- * Purpose: read 4 arrays of trace parameters from stdin and sort each the 
- *          array. If identical parameter values are found after the 
- *          sorting, compress them them into one unique value and increment
- *          the corresponding "weight" number for this parameter value 
- * Returns: 4 parameter arrays, each having (generally) different length,
- *          4 arrays of weights for each the parameter and the integer array
- *          of length 4 which indicates the length of each the parameter
- *          array
- *
- * called by: main
- * calls: sort_parameters
- *
- * ASSUMES: 4 parameters
- *          input lines consist of
- *             sample_pos sample_char consensus_pos cons_char training_params
- *
- ***************************************************************************/
-int   
-read_and_sort_trace_parameters(char *InputName,
-    unsigned long *base_count, PARAMETER parameter[])
+static int
+read_file_of_files(char *InputName, TRAIN_FILES *tf)
 {
-    /* ind[j] is the current value for the index of j-th parameter
-     * array in which the value from the train file will be read in
-     */
-#if 0
-    int      max_weight, min_weight;
-#endif
-    int      i;
-    int      len[4]={0,0,0,0}, j;    
-    int      linenum = 0;
-    char     train_name[BUFLEN], *s, *current;
-    double   is_match;
-    int      spos, cpos;   /* Sample and consensus positions. */
-    char     schar, cchar; /* Sample and consensus characters. */
-    char     buffer[BUFLEN];
-    FILE    *fileoffiles=NULL, *trainfile=NULL;
+    int    room = 0;
+    char   buffer[BUFLEN], train_name[BUFLEN];
+    FILE  *fileoffiles;
 
     if ((fileoffiles=fopen(InputName,"r"))== NULL) {
         fprintf(stderr, "Unable to open file_of_files '%s'\n",
@@ -1119,267 +902,241 @@ read_and_sort_trace_parameters(char *InputName,
         return ERROR;
     }
 
-    for (j=0; j<PARAMETER_COUNT; j++) {
-        parameter[j].num_val = BASE_COUNT_SCALE;
-        parameter[j].value = (double*)malloc(BASE_COUNT_SCALE *
-            sizeof(double));
-        parameter[j].weight = (int*)calloc(BASE_COUNT_SCALE,
-            sizeof(int));
-        for (i=0; i<BASE_COUNT_SCALE; i++) {
-            parameter[j].weight[i]=1;
-        }
-    }
-
-   *base_count = 0;
-    current = buffer;
-
-    /* Scan the list of all train files */
-    while (fgets(current, BUFLEN, fileoffiles) != NULL)
+    tf->file = NULL;
+    tf->num_files = 0;
+    while (fgets(buffer, BUFLEN, fileoffiles) != NULL)
     {
         /* Ignore all white space lines and comments */
-        if (strspn(current, " \t\r\n") == strlen(current)) {
+        if (strspn(buffer, " \t\r\n") == strlen(buffer)) {
             continue;
         }
-        if ((current[0] == '#')
-            || ((current[0] == '/') && (current[1] == '*'))
-            || (current[0] == ';'))
+        if ((buffer[0] == '#')
+            || ((buffer[0] == '/') && (buffer[1] == '*'))
+            || (buffer[0] == ';'))
         {
             continue;
         }
 
         /* Ignore white space in the train file name */
-        sscanf(current, "%s", train_name);
+        sscanf(buffer, "%s", train_name);
 
-        /* Open an individual train file */
-        if ((trainfile=fopen(train_name,"r"))== NULL) {
-            fprintf(stderr, "Unable to open train file '%s'\n",
-                InputName);
+        if (tf->num_files == room) {
+            room += BUFLEN;
+            tf->file = (char **)realloc(tf->file, room * sizeof(char *));
+        }
+        if ((tf->file == NULL) ||
+            ((tf->file[tf->num_files] = strdup(train_name)) == NULL))
+        {
+            fputs("couldn't malloc train file names\n", stderr);
+            fclose(fileoffiles);
             return ERROR;
         }
+        tf->num_files++;
+    }
+    fclose(fileoffiles);
 
-        /* Read bases from the individual train file */
-        linenum = 0;
-        while (fgets(train_name, sizeof(train_name), trainfile) != NULL)
-        {
-            linenum++;
+    return SUCCESS;
+}
 
-/* Ignore all white space lines and comments */
-            if (strspn(train_name, " \t\r\n") == strlen(train_name))
-                continue;
+/**************************************************************************
+ * Function: for_each_base
+ * Purpose:  call fn for every base of the train files of the task
+ **************************************************************************
+ */
+static int
+for_each_base(TRAIN_FILES *tf, int task,
+    void (*fn)(TRAIN_FILES *, int, BASE *))
+{
+    int         f;
+    BASE        base;
+    BaseReader *reader;
+    FILE       *trainfile;
 
-            if (train_name[0] == '#' || train_name[0] == ';' ||
-               (train_name[0] == '/' && train_name[1] == '*'))
-                continue;
+    for (f = task; f < tf->num_files; f += tf->num_tasks)
+    {
+        if ((trainfile=fopen(tf->file[f],"r"))== NULL) {
+            fprintf(stderr, "Unable to open train file '%s'\n",
+                tf->file[f]);
+            return ERROR;
+        }
+        if ((reader = base_reader_open(trainfile, 0)) == NULL) {
+            fputs("couldn't malloc base reader\n", stderr);
+            fclose(trainfile);
+            return ERROR;
+        }
 
-/* Get rid of 1) sample position, 2) sample base,
- * 3) consensus position and 4) consensus base. */
+        while (base_reader_next(reader, &base)) {
+            fn(tf, task, &base);
+            tf->base_count[task]++;
+        }
 
-            s = strtok(train_name, " \t\n");
-            if (s == NULL) continue;
-            spos = atoi(s);
+        base_reader_close(reader);
+        fclose(trainfile);
+    }
 
-            s = strtok(NULL, " \t\n");
-            if (s == NULL) continue;
-            schar = s[0];
+    return SUCCESS;
+}
 
-            s = strtok(NULL, " \t\n");
-            if (s == NULL) continue;
-            cpos = atoi(s);
+static void
+sketch_base(TRAIN_FILES *tf, int task, BASE *base)
+{
+    int i;
 
-            s = strtok(NULL, " \t\n");
-            if (s == NULL) continue;
-            cchar = s[0];
+    for (i = 0; i < PARAMETER_COUNT; i++)
+        sketch_add(&tf->sketch[task][i], base->parameter[i]);
+}
 
-            s += strlen(s) + 1;
-    
-/* If sample == '-', there are no training parameters. */
+static int
+sketch_task(int task, void *arg)
+{
+    return for_each_base((TRAIN_FILES *)arg, task, sketch_base);
+}
 
-            if (schar == '-') continue;
+static void
+bin_base(TRAIN_FILES *tf, int task, BASE *base)
+{
+    int  i, index[PARAMETER_COUNT];
+    BIN *current_bin;
 
-            if (Btk_atod(&s, &is_match) != SUCCESS
-            ||  Btk_atod(&s, &parameter[0].value[len[0]]) != SUCCESS
-            ||  Btk_atod(&s, &parameter[1].value[len[1]]) != SUCCESS
-            ||  Btk_atod(&s, &parameter[2].value[len[2]]) != SUCCESS
-            ||  Btk_atod(&s, &parameter[3].value[len[3]]) != SUCCESS)
-            {
-                fprintf(stderr, "line %d:\n%s\nmissing/garbled parameter; skipping\n",
-                linenum, current);
-                continue;
-            }
-      
-           (*base_count)++; 
-            if ((*base_count > 1 && *base_count % BASE_COUNT_SCALE) == 0) {
-                fprintf(stderr, "\r   %lu parameters have been read       ", 
-               *base_count);
-            }
+    for (i = 0; i < PARAMETER_COUNT; i++) {
+        index[i] = get_threshold_index(base->parameter[i],
+            tf->parameter[i].threshold, tf->parameter[i].threshold_count);
+    }
+    current_bin = get_bin(tf->bin[task], tf->parameter, index);
+    if (base->is_match)
+        current_bin->correct++;
+    else
+        current_bin->incorrect++;
+}
 
-            for (j=0; j<PARAMETER_COUNT; j++) {
-                parameter[j].weight[len[j]] = 1;
-    
-                /* Currently allocated room for j-th parameter exhausted;
-                 * allocate more room
-                 */
-                if (len[j] == parameter[j].num_val-1) {
-                    parameter[j].value = (double*)realloc(parameter[j].value, 
-                        (parameter[j].num_val+BASE_COUNT_SCALE)*sizeof(double));
-                    parameter[j].weight = (int*)realloc(parameter[j].weight, 
-                        (parameter[j].num_val+BASE_COUNT_SCALE)*sizeof(int));
-                    parameter[j].num_val += BASE_COUNT_SCALE;
-                }
-            }
+static int
+bin_task(int task, void *arg)
+{
+    return for_each_base((TRAIN_FILES *)arg, task, bin_base);
+}
 
-            /* data portion data of size BASE_COUNT_SCALE has been read;
-             * Re-sort all the parameters that have been already read;
-             * then compress the parameter array
-             */
-            if (*base_count > 1 &&
-                *base_count % BASE_COUNT_SCALE == 0)
-            {
-//              fprintf(stderr, "\nBase count=%lu\n", *base_count);
-                for (j=0; j<PARAMETER_COUNT; j++) {
-#if 0
-                    fprintf(stderr, "\nParameter[%d]:\n", j);
-                    max_weight=0;
-                    min_weight=0;
-                    for (i=0; i<len[j]+1; i++) {
-                        if (max_weight<parameter[j].weight[i])
-                            max_weight = parameter[j].weight[i];
-                        if (min_weight>parameter[j].weight[i])
-                            min_weight = parameter[j].weight[i];
-                    }
-                    fprintf(stderr, "    before quicksort2 num_val=%d, max_weight=%d, min_weight=%d\n", 
-                        len[j], max_weight, min_weight);
-#endif
-                    
-                    quicksort2(parameter[j].value, parameter[j].weight, 0, len[j]-1); 
-#if 0
-                    max_weight=0;
-                    min_weight=0;
-                    for (i=0; i<len[j]+1; i++) {
-                        if (max_weight<parameter[j].weight[i])
-                            max_weight = parameter[j].weight[i];
-                        if (min_weight>parameter[j].weight[i])
-                            min_weight = parameter[j].weight[i];
-                    }
-                    fprintf(stderr, "    after  quicksort2 num_val=%d, max_weight=%d, min_weight=%d\n", 
-                        len[j], max_weight, min_weight);
-#endif
-                    compress_params_array(&parameter[j].value,
-                                          &parameter[j].weight,
-                                          &len[j]);    
-#if 0
-                    max_weight=0;
-                    min_weight=0;
-                    for (i=0; i<len[j]+1; i++) {
-                        if (max_weight<parameter[j].weight[i])
-                            max_weight = parameter[j].weight[i];
-                        if (min_weight>parameter[j].weight[i])
-                            min_weight = parameter[j].weight[i];
-                    }          
-                    fprintf(stderr, "    after  compress   num_val=%d, max_weight=%d, min_weight=%d\n", 
-                        len[j], max_weight, min_weight);
-#endif
-                    parameter[j].num_val = len[j]+1 + BASE_COUNT_SCALE;
-                    parameter[j].value = (double*)realloc(parameter[j].value,
-                        sizeof(double)*(len[j] +1+ BASE_COUNT_SCALE));
-                    parameter[j].weight = (int*)realloc(parameter[j].weight,
-                        sizeof(int)*(len[j] +1+ BASE_COUNT_SCALE));
-                }
-            } 
-            for (j=0; j<PARAMETER_COUNT; j++) {
-                len[j]++;
-            }
-        }     /* loop in lines of a particular trainfile */
-        fclose(trainfile);
-    }         /* loop in lines of fileoffiles */
-    fclose(fileoffiles);
-    fprintf(stderr, "\n");
+/***************************************************************************
+ * Function: sketch_trace_parameters
+ * Purpose: first pass over the train files: make a sketch of the values
+ *          of each trace parameter, from which the thresholds are got.
+ *          Each task sketches its own files, and the sketches are merged
+ *          at the end, so memory does not grow with the number of bases.
+ *
+ * called by: main
+ * calls: sketch_task, sketch_merge
+ *
+ ***************************************************************************/
+static int
+sketch_trace_parameters(TRAIN_FILES *tf, unsigned long *base_count,
+    SKETCH sketch[])
+{
+    int i, t, r;
 
-/* Give back any unused space */
-#if 0
-    fprintf(stderr, "Base count=%lu\n", *base_count);
-#endif
-    for (j=0; j<PARAMETER_COUNT; j++) {
-#if 0
-        fprintf(stderr, "\nParameter[%d]:\n", j);
-#endif
-#if 0
-        max_weight=0;
-        min_weight=0;
-        for (i=0; i<len[j]; i++) {
-            if (max_weight<parameter[j].weight[i])
-                max_weight = parameter[j].weight[i];
-            if (min_weight>parameter[j].weight[i])
-                min_weight = parameter[j].weight[i];
-        }
-        fprintf(stderr, "    before last quicksort2 num_val=%d, max_weight=%d, min_weight=%d\n",
-            len[j], max_weight, min_weight);
-#endif
-#if 0
-        fprintf(stderr, "\nFirst 20 values and weights:\n");
-        for (i=0; i<20; i++) {
-            fprintf(stderr, "%6d  %3.15f %d\n", i, parameter[j].value[i],
-            parameter[j].weight[i]);
-        }
-#endif
+    for (t = 0; t < tf->num_tasks; t++) {
+        for (i = 0; i < PARAMETER_COUNT; i++)
+            sketch_init(&tf->sketch[t][i]);
+        tf->base_count[t] = 0;
+    }
 
-        parameter[j].num_val = len[j];
-        quicksort2(parameter[j].value, parameter[j].weight, 0, len[j]-1);
-#if 0
-        fprintf(stderr, "\nFirst 50 values and weights:\n");
-        for (i=0; i<50; i++) {
-            fprintf(stderr, "%6d  %3.15f %d\n", i, parameter[j].value[i],
-            parameter[j].weight[i]);
-        }
-#endif
-#if 0
-        max_weight=0;
-        min_weight=0;
-        for (i=0; i<len[j]; i++) {
-            if (max_weight<parameter[j].weight[i])
-                max_weight = parameter[j].weight[i];
-            if (min_weight>parameter[j].weight[i])
-                min_weight = parameter[j].weight[i];
-        }
-        fprintf(stderr, "    after  last quicksort2 num_val=%d, max_weight=%d, min_weight=%d\n",
-            len[j], max_weight, min_weight);
-#endif
-        compress_params_array(&parameter[j].value, &parameter[j].weight,
-                              &len[j]);
-#if 0
-        fprintf(stderr, "\nFirst 50 values and weights:\n");
-        for (i=0; i<50; i++) {
-            fprintf(stderr, "%6d  %3.15f %d\n", i, parameter[j].value[i],
-            parameter[j].weight[i]);
+    r = run_tasks(sketch_task, tf->num_tasks, tf, tf->num_tasks > 1);
+
+    for (i = 0; i < PARAMETER_COUNT; i++)
+        sketch_init(&sketch[i]);
+   *base_count = 0;
+    for (t = 0; t < tf->num_tasks; t++) {
+       *base_count += tf->base_count[t];
+        for (i = 0; i < PARAMETER_COUNT; i++) {
+            sketch_merge(&sketch[i], &tf->sketch[t][i]);
+            sketch_release(&tf->sketch[t][i]);
         }
-#endif
-#if 0
-        max_weight=0;
-        min_weight=0;
-        for (i=0; i<len[j]; i++) {
-            if (max_weight<parameter[j].weight[i])
-                max_weight = parameter[j].weight[i];
-            if (min_weight>parameter[j].weight[i])
-                min_weight = parameter[j].weight[i];
+    }
+
+    return r;
+}
+
+/**************************************************************************
+ * Function: read_bases_and_populate_bins
+ * Purpose: second pass over the train files: count the correct and
+ *          incorrect bases in each of the <bin_count> bins. Each task
+ *          but the first fills a bin array of its own, which is added
+ *          to <bin> at the end.
+ *
+ * called by: main
+ * calls: bin_task
+ *
+ **************************************************************************
+ */
+static int 
+read_bases_and_populate_bins(TRAIN_FILES *tf, unsigned long *base_count,
+    PARAMETER parameter[], BIN *bin, unsigned long bin_count)
+{
+    int           t, r;
+    unsigned long n;
+
+    tf->parameter = parameter;
+    tf->bin[0] = bin;
+    for (t = 0; t < tf->num_tasks; t++) {
+        tf->base_count[t] = 0;
+        if ((t > 0) &&
+            ((tf->bin[t] = (BIN *)calloc(bin_count, sizeof(BIN))) == NULL))
+        {
+            /* Not enough memory for one more copy of the bins */
+            tf->num_tasks = t;
+            break;
         }
-        fprintf(stderr, "    after  last compress   num_val=%d, max_weight=%d, min_weight=%d\n",
-            len[j], max_weight, min_weight);
-#endif
-        parameter[j].num_val = len[j];
-#if 0 
-        /* Do not realloc here!!! For some reason, it does not work !!! */
-        parameter[j].value = realloc(parameter[j].value, len[j]);
-        parameter[j].weight = realloc(parameter[j].weight, len[j]);
-#endif  
-#if 0
-        fprintf(stderr, "\nFirst 50 values and weights:\n");
-        for (i=0; i<50; i++) {
-            fprintf(stderr, "%6d  %3.15f %d\n", i, parameter[j].value[i],
-            parameter[j].weight[i]);
+    }
+
+    r = run_tasks(bin_task, tf->num_tasks, tf, tf->num_tasks > 1);
+
+   *base_count = tf->base_count[0];
+    for (t = 1; t < tf->num_tasks; t++) {
+       *base_count += tf->base_count[t];
+        for (n = 0; n < bin_count; n++) {
+            bin[n].correct   += tf->bin[t][n].correct;
+            bin[n].incorrect += tf->bin[t][n].incorrect;
         }
-#endif
+        free(tf->bin[t]);
+        tf->bin[t] = NULL;
     }
 
+    return r;
+}
+
+/***************************************************************************
+ * write_binary_table
+ *
+ * purpose: read the text lookup table <text_name> and write it in the
+ * binary format, which ttuner and train load by mapping the file, to
+ * <binary_name>
+ *
+ * called by: main
+ * calls: Btk_read_lookup_table, Btk_write_binary_lookup_table
+ *
+ ***************************************************************************/
+static int
+write_binary_table(char *text_name, char *binary_name)
+{
+    BtkLookupTable *table;
+
+    if ((table = Btk_read_lookup_table(text_name)) == NULL) {
+        fprintf(stderr, "Cannot read lookup table '%s'\n", text_name);
+        return ERROR;
+    }
+    if ((table->num_tpar_entries < 1) || (table->num_lut_entries < 1)) {
+        fprintf(stderr, "Lookup table '%s' has no entries\n", text_name);
+        Btk_destroy_lookup_table(table);
+        return ERROR;
+    }
+    if (Btk_write_binary_lookup_table(table, binary_name) != SUCCESS) {
+        fprintf(stderr, "Cannot write binary lookup table '%s'\n",
+            binary_name);
+        Btk_destroy_lookup_table(table);
+        return ERROR;
+    }
+    if (Verbose)
+        fprintf(stderr, "Binary lookup table written to %s\n", binary_name);
+
+    Btk_destroy_lookup_table(table);
     return SUCCESS;
 }
 
@@ -1392,9 +1149,12 @@ main(int argc, char *argv[])
     PARAMETER     parameter[PARAMETER_COUNT];
     FILE         *fout;
     unsigned int  threshold_count = 0;  /* Number of thresholds used */
-    unsigned long initial_base_room, base_count;
+    unsigned long initial_base_room, base_count, bin_count;
     time_t        t1, t2;
     int           development = 0;    
+    int           num_threads = 1;
+    SKETCH        sketch[PARAMETER_COUNT];
+    static TRAIN_FILES train_files;
 
     /* FileOfFiles = 0 if input from stdin; =1 if from inp_file_name */
     int           FileOfFiles = 0;
@@ -1406,6 +1166,8 @@ main(int argc, char *argv[])
     InputName[0]  = '\0';
     OutputName[0] = '\0';
     OutputSpecified     = 0;
+    BinaryName[0]    = '\0';
+    TextTableName[0] = '\0';
 
 /* Set defaults */
 
@@ -1415,9 +1177,12 @@ main(int argc, char *argv[])
     initial_base_room = BASE_COUNT_SCALE;
 
     opterr = 0;
-    while ((i = getopt(argc, argv, "b:f:n:o:cCdQV")) != EOF)
+    while ((i = getopt(argc, argv, "b:f:n:o:t:B:T:cCdQV")) != EOF)
         switch (i)
         {
+            case 'B':
+                (void)strncpy(BinaryName, optarg, sizeof(BinaryName) - 1);
+                break;
             case 'b':
                 if (sscanf(optarg, "%lu", &initial_base_room) != 1
                 ||  initial_base_room < 1)
@@ -1458,6 +1223,19 @@ main(int argc, char *argv[])
                 OutputSpecified++;
                 (void)strncpy(OutputName, optarg, sizeof(OutputName));
                 break;
+            case 't':
+                (void)strncpy(TextTableName, optarg, sizeof(TextTableName) - 1);
+                break;
+            case 'T':
+                if (sscanf(optarg, "%d", &num_threads) != 1
+                ||  num_threads < 1 || num_threads > MAX_LUT_THREADS)
+                {
+                    fprintf(stderr, "Number of threads must be 1 to %d\n",
+                        MAX_LUT_THREADS);
+                    show_usage(argc, argv);
+                    exit(2);
+                }
+                break;
             case 'Q':
                 Verbose = 0;
                 break;
@@ -1470,6 +1248,23 @@ main(int argc, char *argv[])
                 exit(2);
         }
 
+    /* Only convert an existing text table to the binary format */
+    if (TextTableName[0] != '\0') {
+        if ((BinaryName[0] == '\0') || (optind != argc)) {
+            show_usage(argc, argv);
+            exit(2);
+        }
+        return (write_binary_table(TextTableName, BinaryName) == SUCCESS)
+            ? 0 : 1;
+    }
+
+    /* The binary table is made from the text one, which must be a file */
+    if ((BinaryName[0] != '\0') && !OutputSpecified) {
+        show_usage(argc, argv);
+        fprintf(stderr, "\nOption -B requires option -o\n");
+        exit(2);
+    }
+
     if (optind + 1 != argc 
        ||  sscanf(argv[optind], "%u", &threshold_count) != 1
        || threshold_count < 2)
@@ -1508,9 +1303,18 @@ main(int argc, char *argv[])
     /* 1. Read bases from train file
      ****************************
      */
-    if (FileOfFiles && Verbose) {
-        fprintf(stderr, "\nReading trace parameters ... \n");
-        read_and_sort_trace_parameters(InputName, &base_count, parameter);
+    if (FileOfFiles) {
+        if (read_file_of_files(InputName, &train_files) != SUCCESS)
+            exit(1);
+        train_files.num_tasks = (num_threads < train_files.num_files)
+                              ? num_threads : train_files.num_files;
+        if (Verbose)
+            fprintf(stderr, "\nReading trace parameters ... \n");
+        if (sketch_trace_parameters(&train_files, &base_count, sketch)
+            != SUCCESS)
+        {
+            exit(1);
+        }
     }
     else {
         if (Verbose)
@@ -1520,7 +1324,7 @@ main(int argc, char *argv[])
     t2 = time((time_t) NULL);
 
     if (FileOfFiles && Verbose)
-        fprintf(stderr, "%lu parameters read in %f sec\n", base_count, 
+        fprintf(stderr, "%lu bases read in %f sec\n", base_count, 
             (double)(t2 - t1));
     else 
         if (Verbose)
@@ -1546,21 +1350,14 @@ main(int argc, char *argv[])
         }
     }
 
-#if 0
-    j=2;
-    fprintf(stderr, "PARAMETER%d %d values and weights:\n",
-        j, parameter[j].num_val);
-    for (i=0; i<parameter[j].num_val; i++) {
-        fprintf(stderr, "%6d  %3.15f %d\n", i, parameter[j].value[i],
-        parameter[j].weight[i]);
-    }
-#endif
     /* 2. Compute the trace parameter thresholds
      ****************************************
      */
     fprintf(stderr, "\nComputing trace parameter thresholds ... \n");
     if (FileOfFiles) {
-        get_thresholds2(parameter);
+        get_thresholds_from_sketches(sketch, parameter);
+        for (i = 0; i < PARAMETER_COUNT; i++)
+            sketch_release(&sketch[i]);
     }
     else {
         get_thresholds(base, base_count, parameter);
@@ -1577,11 +1374,11 @@ main(int argc, char *argv[])
 
     t1 = t2;
 
-    bin = (BIN *) calloc(parameter[0].threshold_count
-                       * parameter[1].threshold_count
-                       * parameter[2].threshold_count
-                       * parameter[3].threshold_count
-                       , sizeof(BIN));
+    bin_count = (unsigned long)parameter[0].threshold_count
+              * parameter[1].threshold_count
+              * parameter[2].threshold_count
+              * parameter[3].threshold_count;
+    bin = (BIN *) calloc(bin_count, sizeof(BIN));
 
     if (bin == NULL)
     {
@@ -1594,8 +1391,11 @@ main(int argc, char *argv[])
      */
     fprintf(stderr, "\nPopulating bins ... \n");
     if (FileOfFiles) {
-        read_bases_and_populate_bins(InputName, &base_count,
-            parameter, bin);
+        if (read_bases_and_populate_bins(&train_files, &base_count,
+            parameter, bin, bin_count) != SUCCESS)
+        {
+            exit(1);
+        }
     }
     else {
         count_number_of_correct_bases_in_each_bin(base, base_count,
@@ -1647,14 +1447,23 @@ main(int argc, char *argv[])
     if (Verbose)
         fprintf(stderr, "lookup table generated in %f sec\n", (double)(t2 - t1));
 
+    if (BinaryName[0] != '\0') {
+        if ((fclose(fout) != 0) ||
+            (write_binary_table(OutputName, BinaryName) != SUCCESS))
+        {
+            exit(1);
+        }
+    }
+
     free(bin);
     for (i = 0; i < PARAMETER_COUNT; i++) {
         free(parameter[i].threshold);
-        parameter[i].value = NULL;
-        parameter[i].weight = NULL;
         parameter[i].threshold = NULL;
     }
     if (FileOfFiles) {
+        for (i = 0; i < train_files.num_files; i++)
+            free(train_files.file[i]);
+        free(train_files.file);
         free(InputName);
         InputName = NULL;
     }
@@ -26,6 +26,7 @@
  */
 
 #define BASE_COUNT_SCALE   (100000)
+#define SKETCH_SIZE        (1048576) /* values kept exactly by a SKETCH */
 #define QVMAX(a,b)  (((a)>(b))?(a):(b))
 
 typedef enum {
@@ -42,17 +43,25 @@ typedef struct {
 } BASE;
 
 typedef struct {
-    int     num_val;     /* length of the array of unique values */
-    double *value;       /* array of unique parameter values */
-    int    *weight;      /* array of weights (numbers of duplicates of a given
-                          * unique value);
-                          */
     double *threshold;   /* all possible threshold values for a given parameter */
     int threshold_count; /* number of thresholds (e.g., 50) for a parameter */
     int dimension;       /* precomputed dimension() */
     double max;
 } PARAMETER;
 
+/* Summary of the values of one parameter over many bases: their sorted
+ * unique values and the number of bases having each one. It is bounded
+ * by SKETCH_SIZE values, and two of them can be merged.
+ */
+typedef struct {
+    int     num_val;     /* number of values */
+    double *value;       /* sorted values */
+    long   *weight;      /* number of bases having each value */
+    long    count;       /* total number of bases */
+    int     num_new;     /* number of values not yet sorted */
+    double *new_value;   /* values not yet sorted, room for BASE_COUNT_SCALE */
+} SKETCH;
+
 typedef struct {
     unsigned long correct_base_call_count;
     unsigned long incorrect_base_call_count;
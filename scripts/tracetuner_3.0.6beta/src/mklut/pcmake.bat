@@ -28,6 +28,7 @@ copy ..\compute_qv\Btk_compute_tpars.h Btk_compute_tpars.h
 copy ..\compute_qv\Btk_compute_tp.h Btk_compute_tp.h
 copy ..\compute_qv\Btk_call_bases.h Btk_call_bases.h
 copy ..\compute_qv\Btk_process_raw_data.h Btk_process_raw_data.h
+copy ..\compute_qv\train_bin.h train_bin.h
 copy ..\mkchk\check_data.h check_data.h
 copy ..\mkchk\check_data.c check_data.c
 copy ..\mktrain\train.h train.h
@@ -56,4 +57,5 @@ del Btk_process_peaks.h
 del Btk_compute_tpars.h
 del Btk_compute_tp.h
 del nr.h
+del train_bin.h
 del train.h
@@ -52,7 +52,7 @@ random_unsigned_long(unsigned long a, unsigned long b)
  * x is on the right side of the array
  *******************************************************************************
  */
-unsigned long
+static unsigned long
 partition(double *A, unsigned long p, unsigned long r)
 {
     double x, temp;
@@ -665,7 +665,9 @@ find_best_region(Region *best, int size, int *read_direction)
 
 
 /* This function aligns the ends of the fragment with the vector
- * and extracts the clear range.  Its synopsis is:
+ * and extracts the clear range.  The scores against the vector bases
+ * are taken from the profile built when the vector was read.
+ * Its synopsis is:
  *
  * result = strip_vector( align_pars, query, vector, clear_range, start,
 			  finish, message )
@@ -698,6 +700,7 @@ strip_vector ( Align_params* align_pars, Contig* query, Vector* vector,
 	       BtkMessage* message )
 {
     int r, i;
+    int query_end, data_end;
     Range tmp;
     SubContig shortContig;
 
@@ -724,7 +727,7 @@ strip_vector ( Align_params* align_pars, Contig* query, Vector* vector,
     tmp.end = QVMIN( query->length-1, MAX_PRE_CUT_POS );
 
     r=Btk_sw_alignment(align_pars, query, &(vector->preCut), NULL,
-	start, tmp, 0, message);
+	&(vector->profile), start, tmp, 0, message);
     if ( r==ERROR ) { return ERROR; }
 
     /* If the alignment is good, fix its coordinates, 
@@ -764,7 +767,8 @@ strip_vector ( Align_params* align_pars, Contig* query, Vector* vector,
 
 
     /* Align with finish.  Because the postCut part may be very large,
-     * we should be clever to speed things up.  
+     * we should be clever to speed things up.  The alignments are
+     * scored first, and traced back only up to where they end.
      */
     tmp.begin=0;
     tmp.end=100;
@@ -773,8 +777,8 @@ strip_vector ( Align_params* align_pars, Contig* query, Vector* vector,
 
     finish->num_gaps = QVMAX( query->length, shortContig.length );
 
-    r=Btk_sw_alignment(align_pars, query, &(shortContig), NULL,
-	finish, tmp, 0, message);
+    r=Btk_sw_end(align_pars, query, &(shortContig), NULL,
+	&(vector->profile), finish, tmp, &query_end, &data_end, message);
     if ( r==ERROR ) { return ERROR; }
 
     if ( finish->score <= 0 ) {
@@ -782,15 +786,26 @@ strip_vector ( Align_params* align_pars, Contig* query, Vector* vector,
 	return SUCCESS;
     }
 
+    r=Btk_sw_trace(align_pars, query, &(shortContig), NULL,
+	&(vector->profile), finish, tmp, 0, query_end, data_end, message);
+    if ( r==ERROR ) { return ERROR; }
+
     tmp.begin= QVMAX( (finish->trace_qpos[0]-10), MIN_POST_CUT_POS );
     /* tmp.end=query->length;    OLD: off by 1 (SLT) */
     tmp.end=query->length -1;
     finish->num_gaps = 0;    /* Force percentage of gaps, not whole number. */
 
-    r=Btk_sw_alignment(align_pars, query, &(vector->postCut), NULL,
-	finish, tmp, 0, message);
+    r=Btk_sw_end(align_pars, query, &(vector->postCut), NULL,
+	&(vector->profile), finish, tmp, &query_end, &data_end, message);
     if ( r==ERROR ) { return ERROR; }
 
+    finish->trace_len = 0;
+    if ( finish->score > 0 ) {
+        r=Btk_sw_trace(align_pars, query, &(vector->postCut), NULL,
+	    &(vector->profile), finish, tmp, 0, query_end, data_end, message);
+        if ( r==ERROR ) { return ERROR; }
+    }
+
     /* If the alignment is good, fix its coordinates, 
      * otherwise, set its score to 0.
      */
@@ -823,6 +838,52 @@ strip_vector ( Align_params* align_pars, Contig* query, Vector* vector,
     return SUCCESS;
 }
 
+/* This function aligns the query with the library, or its reverse
+ * complement, starting from a region found by the FastA preprocessing.
+ * Its synopsis is:
+ *
+ * result = trace_region( align_pars, lib_seq, lib_rev_comp, query_seq,
+ *                        region, is_reverse, align, clearRange,
+ *                        read_direction, query_end, data_end, message )
+ *
+ * where
+ *      region        is the address of the Region to align
+ *      is_reverse    is 1 if the region is on the reverse complement
+ *      align         is the address of the Align structure, which will
+ *                    be created and set
+ *      query_end     is the end of the alignment in the query, as
+ *                    returned by Btk_sw_score, or -1 if not known
+ *      data_end      likewise for the library
+ *      the other arguments are those of Btk_compute_match
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ */
+static int
+trace_region( Align_params* align_pars, Contig* lib_seq, Contig* lib_rev_comp,
+    Contig* query_seq, Region* region, int is_reverse, Align* align,
+    Range clearRange, int read_direction, int query_end, int data_end,
+    BtkMessage* message)
+{
+    int r;
+
+    r=align_create(align, query_seq->length, region->cbeg, is_reverse,
+                   message);
+    if ( r==ERROR ) {
+        fprintf(stderr, "Error: Cannot create alignment\n");
+        return ERROR;
+    }
+
+    r=Btk_sw_trace(align_pars, query_seq, lib_seq, lib_rev_comp, NULL,
+                   align, clearRange, read_direction, query_end, data_end,
+                   message);
+    if ( r==ERROR ) {
+        fprintf(stderr, "Error: Cannot produce SW alignment\n");
+        return ERROR;
+    }
+
+    return SUCCESS;
+}
+
 /* This function finds possible good alignments using the FastA
  * (heuristic) algorithm.  It then uses the Smith-Waterman (exact)
  * algorithm on the best several to get exact scores.  It returns
@@ -875,7 +936,8 @@ strip_vector ( Align_params* align_pars, Contig* query, Vector* vector,
  *     Use FastA to find regions with good alignments.
  *     Use Smith-Waterman on the best regions to find the exact scores.
  *     Discard repeats.
- *     If there is a unique best region, i.e., not repeats, return it.
+ *     If there is a unique best region, i.e., not repeats, trace back its
+ *     alignment and return it.
  */
 int
 Btk_compute_match( Align_params* align_pars, Align_params* align_parsIUB,
@@ -885,7 +947,8 @@ Btk_compute_match( Align_params* align_pars, Align_params* align_parsIUB,
     Range* clearRange, int read_direction, BtkMessage* message)
 {
     Region best[2*KEEP_BEST];
-    int r, i, final;
+    int r, i, final, num_candidates;
+    int query_end[2*KEEP_BEST], data_end[2*KEEP_BEST];
     Align best_aligns[2*KEEP_BEST];
     int maxscore=-1;
 
@@ -915,6 +978,7 @@ Btk_compute_match( Align_params* align_pars, Align_params* align_parsIUB,
     }
 
     for( i=0; i<2*KEEP_BEST; i++) {
+        (void)align_init(&best_aligns[i], message);
         best_aligns[i].score = -1;
     }
 
@@ -946,31 +1010,47 @@ Btk_compute_match( Align_params* align_pars, Align_params* align_parsIUB,
     final = find_best_region(best, 2*KEEP_BEST, &read_direction);
 
     /* Do Smith-Waterman alignment for those regions whose score is
-     * at least half of the highest score.
+     * at least half of the highest score.  First count them.
      */
+    num_candidates = 0;
     if ( best[final].score > 0 ) {
         for( i=0; i<2*KEEP_BEST; i++) {
             if ( best[i].score > best[final].score/2 ) {
-                r=align_create(&best_aligns[i], query_seq->length,
-                               //best[i].cbeg==0 ? -best[i].beg : best[i].cbeg,
-                               best[i].cbeg,
-                               i/KEEP_BEST, message);
-                if ( r==ERROR ) {
-                    fprintf(stderr, "Error: Cannot create alignment\n");
-                    return ERROR;
-                }
+                num_candidates++;
+            }
+        }
+    }
 
-                r=Btk_sw_alignment(align_pars, query_seq, lib_seq,
-                                   lib_rev_comp, &best_aligns[i], *clearRange,
-                                   read_direction, message);
+    /* A single candidate cannot be a repeat, so it is aligned right away.
+     * When several compete, only their scores, the lengths of their
+     * alignments and where these end are computed here, and the winner
+     * is traced back below, so no path matrix is built for reads rejected
+     * as repeats.
+     */
+    for( i=0; i<2*KEEP_BEST && num_candidates > 0; i++) {
+        if ( best[i].score > best[final].score/2 ) {
+            if ( num_candidates == 1 ) {
+                r=trace_region(align_pars, lib_seq, lib_rev_comp, query_seq,
+                               &best[i], i/KEEP_BEST, &best_aligns[i],
+                               *clearRange, read_direction, -1, -1, message);
+                if ( r==ERROR ) { return ERROR; }
+            } else {
+                best_aligns[i].contig_offset = best[i].cbeg;
+                best_aligns[i].base_is_reverse = i/KEEP_BEST;
+                best_aligns[i].num_gaps = 0;
+
+                r=Btk_sw_score(align_pars, query_seq, lib_seq,
+                               lib_rev_comp, NULL, &best_aligns[i],
+                               *clearRange, read_direction, &query_end[i],
+                               &data_end[i], message);
                 if ( r==ERROR ) {
-                    fprintf(stderr, "Error: Cannot produce SW alignment\n");
+                    fprintf(stderr, "Error: Cannot score SW alignment\n");
                     return ERROR;
                 }
+            }
 
-                if ( best_aligns[i].score > maxscore ) {
-		    maxscore = best_aligns[i].score;
-                }
+            if ( best_aligns[i].score > maxscore ) {
+                maxscore = best_aligns[i].score;
             }
         }
     }
@@ -1004,20 +1084,30 @@ Btk_compute_match( Align_params* align_pars, Align_params* align_parsIUB,
     if( *num_good_alignments == 1 )
     {
 	/* There is a unique best match, so this is valid. */
-        align_range->begin = best_aligns[final].trace_qpos[0];
+        if ( num_candidates > 1 ) {
+            r=trace_region(align_pars, lib_seq, lib_rev_comp, query_seq,
+                           &best[final], final/KEEP_BEST, best_alignment,
+                           *clearRange, read_direction, query_end[final],
+                           data_end[final], message);
+            if ( r==ERROR ) { return ERROR; }
+        } else {
+            *best_alignment = best_aligns[final];
+            best_aligns[final].score = -1;
+        }
+        align_range->begin = best_alignment->trace_qpos[0];
         align_range->end = 
-	    best_aligns[final].trace_qpos[ best_aligns[final].trace_len - 1];
-        *best_alignment = best_aligns[final];
-	best_aligns[final].score = -1;
+	    best_alignment->trace_qpos[ best_alignment->trace_len - 1];
     }
 
     /* Clean up. */
-    for( i=0; i<2*KEEP_BEST; i++) {
-        if ( best_aligns[i].score > -1 ) {
-            r=align_release( &best_aligns[i], message );
-            if ( r==ERROR ) {
-                fprintf(stderr, "Error: Cannot release alignment\n");
-                return ERROR;
+    if ( num_candidates == 1 ) {
+        for( i=0; i<2*KEEP_BEST; i++) {
+            if ( best_aligns[i].score > -1 ) {
+                r=align_release( &best_aligns[i], message );
+                if ( r==ERROR ) {
+                    fprintf(stderr, "Error: Cannot release alignment\n");
+                    return ERROR;
+                }
             }
         }
     }
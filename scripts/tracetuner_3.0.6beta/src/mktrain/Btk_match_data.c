@@ -145,7 +145,8 @@ cleanup:
  *      SiteName        is the name of a file containing the restriction site
  *      vector          is the address of the Vector to be created
  *      ap              is the address of an Align_params data structure,
- *                      correctly set for IUB matching
+ *                      correctly set for IUB matching, with which the
+ *                      profile of the vector is built
  *      message         is the address of a BtkMessage where information about
  *                      an error will be put, if any
  *
@@ -231,6 +232,14 @@ readVector( char* VectorName, char* PrimerName, char* SiteName, Vector* vector,
         quality_values,  message) != SUCCESS)
         return ERROR; 
 
+    /* Score the vector bases once for all the reads. */
+    profile_init( &(vector->profile), message );
+    if ((profile_populate( &(vector->profile), ap, &(vector->preCut), 
+            message) != SUCCESS) ||
+        (profile_populate( &(vector->profile), ap, &(vector->postCut), 
+            message) != SUCCESS))
+        return ERROR;
+
     /* Clean up. */
     r=contig_release( &vectorContig, message );
     if ( r==ERROR ) { return ERROR; }
@@ -248,10 +257,13 @@ readVector( char* VectorName, char* PrimerName, char* SiteName, Vector* vector,
  * This function reads in short vector information and creates a Vector
  * data structure.  Its synopsis is:
  *
- * result = readShortVector(vectorName, vector, message)
+ * result = readShortVector(vectorName, vector, ap, message)
  * where
  *      vectorName      is the name of a file containing the short vector
  *      vector          is the address of the Vector to be created
+ *      ap              is the address of an Align_params data structure,
+ *                      correctly set for IUB matching, with which the
+ *                      profile of the vector is built
  *      message          is the address of a BtkMessage where information about
  *                      an error will be put, if any
  *
@@ -259,7 +271,8 @@ readVector( char* VectorName, char* PrimerName, char* SiteName, Vector* vector,
  ******************************************************************************
  */
 int
-readShortVector(char *vectorName, Vector *vector, BtkMessage *message)
+readShortVector(char *vectorName, Vector *vector, Align_params *ap,
+    BtkMessage *message)
 {
     Contig shortVectorContig;
     int r;
@@ -289,6 +302,14 @@ readShortVector(char *vectorName, Vector *vector, BtkMessage *message)
     vector->primerStart = 0;
     vector->is_reverse = 0;
 
+    /* Score the vector bases once for all the reads. */
+    profile_init(&(vector->profile), message);
+    r = profile_populate(&(vector->profile), ap, &(vector->preCut), message);
+    if (r == ERROR) {
+        contig_release(&shortVectorContig, message);
+        return ERROR;
+    }
+
     /* Clean up. */
     contig_release(&shortVectorContig, message);
     return SUCCESS;
@@ -1070,6 +1091,132 @@ alignment_parameters_release(Align_params* ap, BtkMessage* message)
     return SUCCESS;
 }
 
+/**********************************************************************/
+/*                     Profile functions:                             */
+/**********************************************************************/
+
+/**
+ * This function initializes a Profile, with no rows built.
+ * Its synopsis is:
+ *
+ * result = profile_init(prof, message)
+ *
+ * where
+ *      prof            is the address of the Profile
+ *      message         is the address of a BtkMessage where information about
+ *                      an error will be put, if any
+ *
+ *      result          is 0 on success, !0 if an error occurs
+ */
+int
+profile_init(Profile *prof, BtkMessage *message)
+{
+    int i;
+
+    for (i=0; i<256; i++) {
+        prof->row[i] = NULL;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * This function returns the scores of all the query bases against a 
+ * library base, building them if needed.  Its synopsis is:
+ *
+ * row = profile_row(prof, ap, dbase)
+ *
+ * where
+ *      prof            is the address of the Profile
+ *      ap              is the address of the Align_params structure
+ *                      whose matrix gives the scores
+ *      dbase           is the library base
+ *
+ *      row             is the array of scores, indexed by the query base,
+ *                      or NULL if there is not enough memory
+ *
+ * Note: a Profile shared by several threads must have all the rows that
+ *     will be asked for built beforehand, by profile_populate.
+ */
+int *
+profile_row(Profile *prof, Align_params *ap, char dbase)
+{
+    int  i;
+    int  id = (unsigned char) dbase;
+    int *row;
+
+    if (prof->row[id] != NULL) {
+        return prof->row[id];
+    }
+
+    row = CALLOC(int, 256);
+    if (row == NULL) {
+        return NULL;
+    }
+    for (i=0; i<ap->matrix_row_len; i++) {
+        row[i] = ap->matrix[i][id];
+    }
+    prof->row[id] = row;
+
+    return row;
+}
+
+/**
+ * This function builds the rows of a Profile for all the bases of a
+ * Contig.  Its synopsis is:
+ *
+ * result = profile_populate(prof, ap, contig, message)
+ *
+ * where
+ *      prof            is the address of the Profile
+ *      ap              is the address of the Align_params structure
+ *                      whose matrix gives the scores
+ *      contig          is the address of the library Contig
+ *      message         is the address of a BtkMessage where information about
+ *                      an error will be put, if any
+ *
+ *      result          is 0 on success, !0 if an error occurs
+ */
+int
+profile_populate(Profile *prof, Align_params *ap, Contig *contig,
+    BtkMessage *message)
+{
+    int i;
+
+    for (i=0; i<contig->length; i++) {
+        if (profile_row(prof, ap, contig->sequence[i]) == NULL) {
+            sprintf(message->text, "Not enough memory for the profile\n");
+            return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/**
+ * This function frees the rows of a Profile.  Its synopsis is:
+ *
+ * result = profile_release(prof, message)
+ *
+ * where
+ *      prof            is the address of the Profile
+ *      message         is the address of a BtkMessage where information about
+ *                      an error will be put, if any
+ *
+ *      result          is 0 on success, !0 if an error occurs
+ */
+int
+profile_release(Profile *prof, BtkMessage *message)
+{
+    int i;
+
+    for (i=0; i<256; i++) {
+        FREE(prof->row[i]);
+    }
+
+    return SUCCESS;
+}
+
 /**********************************************************************/
 /*                     Align functions:                               */
 /**********************************************************************/
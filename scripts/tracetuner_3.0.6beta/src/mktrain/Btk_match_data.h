@@ -69,6 +69,20 @@
        int    gap_ext;
     } Align_params;
     
+/**********************************************************************/
+/*                       Profile definition.                          */
+/**********************************************************************/
+
+/* A Profile contains, for each library base, the scores of all the query
+ * bases against it, i.e., a column of the substitution matrix, so that
+ * filling the alignment matrix takes one lookup per cell.  A row is NULL
+ * until it is built.
+ */
+
+    typedef struct {
+       int*   row[256];
+    } Profile;
+
 /**********************************************************************/
 /*                 Align definition and functions.                    */
 /**********************************************************************/
@@ -126,6 +140,8 @@
  * 		1 if the reverse complement
  * primerStart	the index in the vector where the primer starts
  *		NOTE: always w.r.t. forward vector
+ * profile	the scores against the bases of preCut and postCut, built
+ *		once, when the vector is read, and shared by all the reads
  */
 
     typedef struct {
@@ -133,12 +149,14 @@
 	Contig postCut;
 	int is_reverse;
 	int primerStart;
+	Profile profile;
     } Vector;
 
     extern int local_read_fasta(char *, Contig *, BtkMessage *);
     extern int readVector( char *, char *, char *, Vector*, Align_params *,
         BtkMessage *);
-    extern int readShortVector(char *, Vector *, BtkMessage *);
+    extern int readShortVector(char *, Vector *, Align_params *, 
+        BtkMessage *);
     extern int contig_init(Contig *, BtkMessage*);
     extern int contig_create(Contig *, char*, int, int *, BtkMessage*);
     extern int contig_copy(Contig *, Contig *, BtkMessage*);
@@ -155,6 +173,11 @@
     extern int set_alignment_parameters_IUB(Align_params *, int ,
         int, int, int, BtkMessage*);
     extern int alignment_parameters_release(Align_params *, BtkMessage *);
+    extern int profile_init(Profile *, BtkMessage *);
+    extern int *profile_row(Profile *, Align_params *, char);
+    extern int profile_populate(Profile *, Align_params *, Contig *, 
+        BtkMessage *);
+    extern int profile_release(Profile *, BtkMessage *);
     extern int align_init( Align*, BtkMessage*);
     extern int align_create( Align*, int, int, int, BtkMessage*);
     extern int align_fprint( FILE*, Align*, int, BtkMessage*);
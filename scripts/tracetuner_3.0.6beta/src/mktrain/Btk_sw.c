@@ -42,6 +42,7 @@ typedef struct{
     int maxq,maxd;
     char * path;
     int nmax1;
+    Profile *prof; /* scores against the data bases, or NULL */
 } passed_vars;
 
 
@@ -214,11 +215,15 @@ align_pair_1(passed_vars *pv, Align* align, Align_params* align_pars,
     int i;
  
     int cur_cell, up_cell, left_cell, upleft_cell;
- 
-    int iq,id;
+
+    Profile own, *prof;
+    int *scores;
+    unsigned char *qbases = (unsigned char *) query->sequence;
 
     int r;
 
+    (void)profile_init(&own, message);
+    prof = (pv->prof != NULL) ? pv->prof : &own;
     align->score=0;
  
     pv->nmax1=0;
@@ -256,6 +261,8 @@ align_pair_1(passed_vars *pv, Align* align, Align_params* align_pars,
         sh_current[0] = 0;
         nstart = QVMAX( 0, (m - pv->width + 1) );
         nend = QVMIN( (m+pv->width-1) , query->length );
+        scores = profile_row(prof, align_pars, data->sequence[m]);
+        MEM_ERROR(scores);
 
         for(n=nstart;n<nend;n++){
  
@@ -274,11 +281,8 @@ align_pair_1(passed_vars *pv, Align* align, Align_params* align_pars,
             }
             upleft_cell = left_cell - 1;
 
-            iq = (int) query->sequence[n];
-            id = (int) data->sequence[m];
-
     	    sh_current[cur_cell] = align_max_4 (
-		sh_prev[upleft_cell]+align_pars->matrix[iq][id],
+		sh_prev[upleft_cell]+scores[qbases[n]],
 		sh_current[up_cell]+align_pars->gap_init,
 		sh_prev[left_cell]+align_pars->gap_ext,
 		0,
@@ -319,6 +323,316 @@ align_pair_1(passed_vars *pv, Align* align, Align_params* align_pars,
     cleanup:
         FREE(sh_current);
         FREE(sh_prev);
+        (void)profile_release(&own, message);
+
+    return r;
+}
+
+/* This function computes the score of the best local alignment of two
+ * sequences, and where it ends, without storing the path matrix.
+ * Its synopsis is:
+ *
+ * result = align_pair_end( passed, align, params, query, data, message )
+ *
+ * where
+ *      passed        is the address of a passed_vars structure, whose
+ *                    width is set; maxq and maxd will be set to the
+ *                    end of the best alignment
+ *      align         is the address of the Align structure.  The only
+ *                    change to it will be in the score field.
+ *      params        is the address of an Align_params structure,
+ *                    which contains a scoring matrix and ins/del penalties
+ *      query         is the address of a Contig containing the query
+ *                    sequence
+ *      data          is the address of a Contig containing the data
+ *                    sequence
+ *      message       is the address of a BtkMessage, where information
+ *                    about an error will be put, if any
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ *
+ * The algorithm:
+ * Fills in the same band as align_pair_1, and finds the same best cell,
+ * since neither depends on which of several equally good moves is taken.
+ * Only two columns of scores are kept and no moves are recorded, so it
+ * costs a fraction of align_pair_1.
+ */
+static int
+align_pair_end(passed_vars *pv, Align* align, Align_params* align_pars,
+               Contig* query, Contig* data, BtkMessage* message)
+{
+    int mmax, nmax;
+
+    /* High scores, for current column and previous column. */
+    int *sh_current=NULL, *sh_prev=NULL, *tmp=NULL;
+    int nstart,nend;
+    int m=0,n=0;
+    int i;
+
+    int cur_cell, left_cell, shift;
+    int score, gap;
+
+    Profile own, *prof;
+    int *scores;
+    unsigned char *qbases = (unsigned char *) query->sequence;
+
+    int r;
+
+    (void)profile_init(&own, message);
+    prof = (pv->prof != NULL) ? pv->prof : &own;
+    align->score=0;
+
+    pv->maxq=0;
+    pv->maxd=0;
+    pv->path= NULL;
+
+    mmax = QVMIN( (query->length+pv->width), data->length );
+    nmax = QVMIN( (mmax+pv->width) , query->length+1 );
+
+    if(nmax < 0 || mmax < 0)  {
+        message->code=1;
+        return ERROR;
+    }
+
+    sh_prev    = CALLOC(int,nmax+1);
+    MEM_ERROR(sh_prev);
+    sh_current = CALLOC(int,nmax+1);
+    MEM_ERROR(sh_current);
+
+    /* Enforce zero boundary condition */
+    for(i=0;i<(nmax+1);i++){
+        sh_prev[i] = 0;
+    }
+
+    for(m=0;m<mmax;m++){
+        sh_current[0] = 0;
+        nstart = QVMAX( 0, (m - pv->width + 1) );
+        nend = QVMIN( (m+pv->width-1) , query->length );
+        scores = profile_row(prof, align_pars, data->sequence[m]);
+        MEM_ERROR(scores);
+
+        /* Index of the left neighbor, relative to the current cell,
+         * as in align_pair_1.
+         */
+        shift = (nstart == 0) ? 0 : 1;
+
+        for(n=nstart;n<nend;n++){
+            cur_cell = n - nstart + 1;
+            left_cell = cur_cell + shift;
+
+            score = sh_prev[left_cell-1] + scores[qbases[n]];
+            gap = sh_current[cur_cell-1] + align_pars->gap_init;
+            if ( gap > score ) {
+                score = gap;
+            }
+            gap = sh_prev[left_cell] + align_pars->gap_ext;
+            if ( gap > score ) {
+                score = gap;
+            }
+            if ( score < 0 ) {
+                score = 0;
+            }
+            sh_current[cur_cell] = score;
+
+#ifdef ALIGN_GLOBAL
+            if((n==query->length-1) || (m == mmax-1)) {
+#endif
+               if(align->score < score){
+                    align->score = score;
+                    pv->maxq = n;
+                    pv->maxd = m;
+                }
+#ifdef ALIGN_GLOBAL
+            }
+#endif
+        } /* end inner loop */
+        sh_current[nend-nstart+1] = NINF;
+        tmp=sh_prev;
+        sh_prev=sh_current;
+        sh_current=tmp;
+    } /* end outer loop */
+
+    r=SUCCESS;
+    goto cleanup;
+
+    error:
+        r = ERROR;
+
+    cleanup:
+        FREE(sh_current);
+        FREE(sh_prev);
+        (void)profile_release(&own, message);
+
+    return r;
+}
+
+/* This function computes the score of the best local alignment of two
+ * sequences, and the length of that alignment, without storing the path
+ * matrix. Its synopsis is:
+ *
+ * result = align_pair_score( passed, align, params, query, data, dir,
+ *                            message )
+ *
+ * where
+ *      passed        is the address of a passed_vars structure, whose
+ *                    width is set; maxq and maxd will be set to the
+ *                    end of the best alignment
+ *      align         is the address of the Align structure.  Its score
+ *                    and trace_len fields will be set.
+ *      params        is the address of an Align_params structure,
+ *                    which contains a scoring matrix and ins/del penalties
+ *      query         is the address of a Contig containing the query
+ *                    sequence
+ *      data          is the address of a Contig containing the data
+ *                    sequence
+ *      dir           is the direction in which to break ties
+ *      message       is the address of a BtkMessage, where information
+ *                    about an error will be put, if any
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ *
+ * The algorithm:
+ * Fills in the same band as align_pair_1, breaking ties the same way.
+ * Instead of the path, it keeps for each cell of the current and previous
+ * columns the number of steps align_pair_2 would trace back from that
+ * cell, so trace_len is the length of the alignment align_pair_2 would
+ * produce from the best cell. Memory is linear in the query length.
+ */
+static int
+align_pair_score(passed_vars *pv, Align* align, Align_params* align_pars,
+                 Contig* query, Contig* data, int dir, BtkMessage* message)
+{
+    int np;
+    int mmax, nmax;
+
+    /* High scores and trace lengths, for current and previous column. */
+    int *sh_current=NULL, *sh_prev=NULL, *tmp=NULL;
+    int *len_current=NULL, *len_prev=NULL;
+    int nstart,nend;
+    int m=0,n=0;
+    int i;
+    char best_dir;
+
+    int cur_cell, up_cell, left_cell, upleft_cell;
+
+    Profile own, *prof;
+    int *scores;
+    unsigned char *qbases = (unsigned char *) query->sequence;
+
+    int r;
+
+    (void)profile_init(&own, message);
+    prof = (pv->prof != NULL) ? pv->prof : &own;
+    align->score=0;
+    align->trace_len=0;
+
+    pv->maxq=0;
+    pv->maxd=0;
+    pv->path= NULL;
+
+    mmax = QVMIN( (query->length+pv->width), data->length );
+    nmax = QVMIN( (mmax+pv->width) , query->length+1 );
+
+    if(nmax < 0 || mmax < 0)  {
+        message->code=1;
+        return ERROR;
+    }
+
+    sh_prev     = CALLOC(int,nmax+1);
+    MEM_ERROR(sh_prev);
+    sh_current  = CALLOC(int,nmax+1);
+    MEM_ERROR(sh_current);
+    len_prev    = CALLOC(int,nmax+1);
+    MEM_ERROR(len_prev);
+    len_current = CALLOC(int,nmax+1);
+    MEM_ERROR(len_current);
+
+    /* Enforce zero boundary condition */
+    for(i=0;i<(nmax+1);i++){
+        sh_prev[i] = 0;
+        len_prev[i] = 0;
+    }
+
+    for(m=0;m<mmax;m++){
+        sh_current[0] = 0;
+        len_current[0] = 0;
+        nstart = QVMAX( 0, (m - pv->width + 1) );
+        nend = QVMIN( (m+pv->width-1) , query->length );
+        scores = profile_row(prof, align_pars, data->sequence[m]);
+        MEM_ERROR(scores);
+
+        for(n=nstart;n<nend;n++){
+
+            np = n-nstart;
+
+            cur_cell = np + 1;
+            up_cell = cur_cell-1;
+            if(nstart == 0) {
+                left_cell = np + 1;
+            } else {
+                left_cell = np + 2;
+            }
+            upleft_cell = left_cell - 1;
+
+            sh_current[cur_cell] = align_max_4 (
+                sh_prev[upleft_cell]+scores[qbases[n]],
+                sh_current[up_cell]+align_pars->gap_init,
+                sh_prev[left_cell]+align_pars->gap_ext,
+                0,
+                &best_dir,
+                dir
+            );
+
+            switch (best_dir) {
+            case 0 :    /* Match or Mismatch. */
+                len_current[cur_cell] = len_prev[upleft_cell] + 1;
+                break;
+            case 1 :    /* Deletion. */
+                len_current[cur_cell] = len_current[up_cell] + 1;
+                break;
+            case 2 :    /* Insertion. */
+                len_current[cur_cell] = len_prev[left_cell] + 1;
+                break;
+            default :   /* End (for local alignment.) */
+                len_current[cur_cell] = 0;
+                break;
+            }
+
+#ifdef ALIGN_GLOBAL
+            if((n==query->length-1) || (m == mmax-1)) {
+#endif
+               if(align->score < sh_current[cur_cell]){
+                    align->score = sh_current[cur_cell];
+                    align->trace_len = len_current[cur_cell];
+                    pv->maxq = n;
+                    pv->maxd = m;
+                }
+#ifdef ALIGN_GLOBAL
+            }
+#endif
+        } /* end inner loop */
+        sh_current[nend-nstart+1] = NINF;
+        len_current[nend-nstart+1] = 0;
+        tmp=sh_prev;
+        sh_prev=sh_current;
+        sh_current=tmp;
+        tmp=len_prev;
+        len_prev=len_current;
+        len_current=tmp;
+    } /* end outer loop */
+
+    r=SUCCESS;
+    goto cleanup;
+
+    error:
+        r = ERROR;
+
+    cleanup:
+        FREE(sh_current);
+        FREE(sh_prev);
+        FREE(len_current);
+        FREE(len_prev);
+        (void)profile_release(&own, message);
 
     return r;
 }
@@ -541,29 +855,18 @@ align_pair_2(passed_vars *pv, Align* align, Contig* query,
         return ERROR;
 }
 
-/* This function performs the Smith-Waterman dynamic programming
- * algorithm on two sequences and sets the appropriate arrays in
- * an Align data structure. Its synopsis is:
+/* This function returns the half-width of the band of the dynamic
+ * programming matrix. Its synopsis is:
  *
- * result = align_pair( align, params, query, data, message )
+ * width = align_band_width( align, query, data )
  *
  * where
  *      align         is the address of the Align structure
- *      params        is the address of an Align_params structure,
- *                    which contains a scoring matrix and ins/del penalties
  *      query         is the address of a Contig containing the query
  *                    sequence
  *      data          is the address of a Contig containing the data
  *                    sequence
- *      message       is the address of a BtkMessage, where information
- *                    about an error will be put, if any
- *
- *      result        is 0 on success, !0 if an error occurs.
  *
- * Note: the function aligns the whole sequences, and returns the
- *     best local sub-alignment.  To align sub-sequences, create
- *     SubContigs and then call the function.
- * 
  * If align->num_gaps > 0, use that number of gaps,
  *    align->num_gaps == 0, use FRACTION_GAPS*min_length,
  *    align->num_gaps < 0, no preprocssing was used before Btk_sw_alignment()
@@ -573,15 +876,14 @@ align_pair_2(passed_vars *pv, Align* align, Contig* query,
  * Therefore if Btk_sw_alignment() needs to be called without pre-processing
  * (such as FastA preprocessing), one can assign a negative value to
  * align->num_gaps before calling Btk_sw_alignment() to flag the sw algorithm
- * implemented here to compute the entire matrix.  In this case the pv.width
+ * implemented here to compute the entire matrix.  In this case the width
  * is calculated as the max of data->length and query->length.
  */
 static int
-align_pair(Align* align, Align_params* align_pars,
-           Contig* query, Contig* data, int dir, BtkMessage* message)
-{   passed_vars pv;
+align_band_width(Align* align, Contig* query, Contig* data)
+{
+    int width;
     int min_length;
-    int r;
 
     min_length = QVMIN( query->length, data->length );
     /* Negative align->num_gaps value means that no pre-processing was used
@@ -590,17 +892,17 @@ align_pair(Align* align, Align_params* align_pars,
      * of query length and data length. -- LZ
      */
     if ( align->num_gaps < 0 ) {
-    	pv.width = QVMAX(query->length, data->length);
+    	width = QVMAX(query->length, data->length);
     } else {
     	if ( align->num_gaps == 0 ) {
-            pv.width = (int)(min_length*FRACTION_GAPS);
+            width = (int)(min_length*FRACTION_GAPS);
     	} else {
-	    pv.width = 2*align->num_gaps;
+	    width = 2*align->num_gaps;
     	}
 
     	/* added by SLT (May 28 2001) */
-    	if ( pv.width < DESIRED_WIDTH ) {
-            pv.width = QVMIN( min_length, DESIRED_WIDTH );
+    	if ( width < DESIRED_WIDTH ) {
+            width = QVMIN( min_length, DESIRED_WIDTH );
     	}
 
         /* The following is somewhat of a kludge to deal with the fact
@@ -610,71 +912,102 @@ align_pair(Align* align, Align_params* align_pars,
      	 * I realize this negates all the code above, but eventually
      	 * we may want to fix this the right way.
      	 */
-    	pv.width = min_length;   /* kludge added by SLT (May 29 2001) */
-    }
-
-    r = align_pair_1(&pv, align, align_pars, query, data, dir, message);
-    if (r == ERROR) {
-	return ERROR;
+    	width = min_length;   /* kludge added by SLT (May 29 2001) */
     }
 
-    align_pair_2(&pv, align, query, data, message);
-
-    FREE(pv.path);
-
-    return SUCCESS;
+    return width;
 }
 
-
 /* This function performs the Smith-Waterman dynamic programming
  * algorithm on two sequences and sets the appropriate arrays in
  * an Align data structure. Its synopsis is:
  *
- * result = Btk_sw_alignment( params, query, library, rev_comp,
- *                            align, range, message )
+ * result = align_pair( align, params, query, data, profile, dir,
+ *                      query_length, data_length, message )
  *
  * where
+ *      align         is the address of the Align structure
  *      params        is the address of an Align_params structure,
  *                    which contains a scoring matrix and ins/del penalties
  *      query         is the address of a Contig containing the query
  *                    sequence
- *      library       is the address of a Contig containing the library
+ *      data          is the address of a Contig containing the data
  *                    sequence
- *      rev_comp      is the address of a Contig containing the reverse
- *                    complement of the library sequence
- *      align         is the address of the Align structure.
- *                    Its contig_offset and base_is_reverse fields 
- *                    should be set when the function is called.
- *                    At the end, all of the relevant fields in align
- *                    will be set.
- *		      NOTE: a negative value of align->num_gaps means
- *                          the entire matrix for aligning sub-sequences
- *                          will be computed.  This is useful when one
- *                          needs to call this Btk_sw_alignment() function
- *                          directly (skipping any pre-processing procedures
- *                          that probe for best regions to run sw), eg.
- *                          when aligning two short sequences.
- *      range         is the range of query that should be aligned.
+ *      profile       is the address of a Profile built with params for
+ *                    all the data bases, or NULL to build one as needed
+ *      dir           is the direction in which to break ties
+ *      query_length  is the number of query positions for which the
+ *                    matrix is filled in, or 0 for all of them
+ *      data_length   likewise for the data positions
  *      message       is the address of a BtkMessage, where information
  *                    about an error will be put, if any
  *
  *      result        is 0 on success, !0 if an error occurs.
  *
- * Note: the function aligns sub-sequences, and returns the
- *     best local sub-alignment.  It sets trace_qpos and
- *     trace_dpos with respect to the original sequences, not the
- *     sub-sequences.  (Previous versions of training code set 
- *     trace_dpos with respect either the forward or reverse sequence,
- *     this version always sets it with respect to forward.)
+ * Note: the function aligns the whole sequences, and returns the
+ *     best local sub-alignment.  To align sub-sequences, create
+ *     SubContigs and then call the function.  The band is always that
+ *     of the whole sequences, so filling in only the part of the matrix
+ *     up to the end of the best alignment gives the same alignment.
  */
-int 
-Btk_sw_alignment(Align_params *ap, Contig *query, Contig *library,
-                 Contig *rev_comp_library, Align *align,
-                 Range align_range, int dir, BtkMessage* message)
+static int
+align_pair(Align* align, Align_params* align_pars,
+           Contig* query, Contig* data, Profile *profile, int dir,
+           int query_length, int data_length, BtkMessage* message)
+{   passed_vars pv;
+    SubContig query_part, data_part;
+    int r;
+
+    pv.width = align_band_width(align, query, data);
+    pv.prof = profile;
+
+    query_part = *query;
+    data_part  = *data;
+    if (query_length > 0 && query_length < query_part.length) {
+        query_part.length = query_length;
+    }
+    if (data_length > 0 && data_length < data_part.length) {
+        data_part.length = data_length;
+    }
+
+    r = align_pair_1(&pv, align, align_pars, &query_part, &data_part, dir,
+                     message);
+    if (r == ERROR) {
+	return ERROR;
+    }
+
+    align_pair_2(&pv, align, &query_part, &data_part, message);
+
+    FREE(pv.path);
+
+    return SUCCESS;
+}
+
+
+/* This function creates the sub-contigs of the query and the library,
+ * or its reverse complement, to be aligned by Btk_sw_alignment,
+ * Btk_sw_score and Btk_sw_trace. Its synopsis is:
+ *
+ * result = sw_sub_contigs( query, library, rev_comp, align, range,
+ *                          query_part, library_part, message )
+ *
+ * where
+ *      query_part    is the address of the SubContig to be set to
+ *                    the range of the query
+ *      library_part  is the address of the SubContig to be set to
+ *                    the library, or its reverse complement, starting
+ *                    at align->contig_offset
+ *      the other arguments are those of Btk_sw_alignment
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ */
+static int
+sw_sub_contigs(Contig *query, Contig *library, Contig *rev_comp_library,
+               Align *align, Range align_range, SubContig *query_ranges,
+               SubContig *lib_ranges, BtkMessage* message)
 {
-    int    r=0,i;
+    int    r=0;
     int    align_range_len, align_range_begin;
-    SubContig lib_ranges, query_ranges;
 
     /* Get the "align" part of the fragment sequence 
      * or its reverse compliment
@@ -709,7 +1042,7 @@ Btk_sw_alignment(Align_params *ap, Contig *query, Contig *library,
     align_range_begin = align_range.begin;
 
     /* Create sub-contig for query. */
-    r=contig_create_sub( &query_ranges, query, align_range_begin,
+    r=contig_create_sub( query_ranges, query, align_range_begin,
                          align_range_len, message );
     if(r==ERROR) {
         return ERROR;
@@ -720,12 +1053,12 @@ Btk_sw_alignment(Align_params *ap, Contig *query, Contig *library,
      * whichever is appropriate.
      */
     if(align->base_is_reverse) {
-        r=contig_create_sub( &lib_ranges, rev_comp_library, 
+        r=contig_create_sub( lib_ranges, rev_comp_library, 
                              align->contig_offset,
                              rev_comp_library->length - align->contig_offset,
                              message );
     } else {
-        r=contig_create_sub( &lib_ranges, library, 
+        r=contig_create_sub( lib_ranges, library, 
                              align->contig_offset,
                              library->length - align->contig_offset,
                              message );
@@ -734,8 +1067,50 @@ Btk_sw_alignment(Align_params *ap, Contig *query, Contig *library,
         return ERROR;
     }
 
+    return SUCCESS;
+}
+
+
+/* This function aligns the sub-contigs of the query and the library
+ * and converts the trace to global positions.  Its synopsis is:
+ *
+ * result = sw_align( params, query, library, rev_comp, profile, align,
+ *                    range, dir, query_end, data_end, message )
+ *
+ * where query_end and data_end are the global positions at which the
+ * best alignment ends, as returned by Btk_sw_score, or -1 if not known,
+ * and the other arguments are those of Btk_sw_alignment.
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ */
+static int
+sw_align(Align_params *ap, Contig *query, Contig *library,
+         Contig *rev_comp_library, Profile *library_profile, Align *align,
+         Range align_range, int dir, int query_end, int data_end,
+         BtkMessage* message)
+{
+    int    r=0,i;
+    int    query_length = 0, data_length = 0;
+    SubContig lib_ranges, query_ranges;
+
+    r = sw_sub_contigs( query, library, rev_comp_library, align, align_range,
+                        &query_ranges, &lib_ranges, message );
+    if(r==ERROR) {
+        return ERROR;
+    }
+
+    /* Convert the ends to lengths of the sub-contigs to be filled in. */
+    if(query_end >= 0 && data_end >= 0) {
+        if(align->base_is_reverse) {
+            data_end = library->length - data_end - 1;
+        }
+        query_length = query_end - align_range.begin + 1;
+        data_length  = data_end - align->contig_offset + 1;
+    }
+
     /* Align sub-range of library with sub-range of fragment sequence. */
-    r = align_pair( align, ap, &query_ranges, &lib_ranges, dir, message );
+    r = align_pair( align, ap, &query_ranges, &lib_ranges, library_profile,
+                    dir, query_length, data_length, message );
 
     if(r==ERROR) {
         goto error;
@@ -745,7 +1120,7 @@ Btk_sw_alignment(Align_params *ap, Contig *query, Contig *library,
      * i.e., position w.r.t. 0, not w.r.t. alignment range.
      */
     for(i=0; i<align->trace_len; i++) {
-        align->trace_qpos[i] += align_range_begin;
+        align->trace_qpos[i] += align_range.begin;
         align->trace_dpos[i] += align->contig_offset;
         if(align->base_is_reverse) {
             align->trace_dpos[i] = library->length - align->trace_dpos[i] - 1;
@@ -757,3 +1132,205 @@ Btk_sw_alignment(Align_params *ap, Contig *query, Contig *library,
     error:
         return ERROR;
 }
+
+
+/* This function performs the Smith-Waterman dynamic programming
+ * algorithm on two sequences and sets the appropriate arrays in
+ * an Align data structure. Its synopsis is:
+ *
+ * result = Btk_sw_alignment( params, query, library, rev_comp, profile,
+ *                            align, range, dir, message )
+ *
+ * where
+ *      params        is the address of an Align_params structure,
+ *                    which contains a scoring matrix and ins/del penalties
+ *      query         is the address of a Contig containing the query
+ *                    sequence
+ *      library       is the address of a Contig containing the library
+ *                    sequence
+ *      rev_comp      is the address of a Contig containing the reverse
+ *                    complement of the library sequence
+ *      profile       is the address of a Profile built with params for
+ *                    all the bases of library and rev_comp, or NULL to
+ *                    build one for this alignment.  Building it once for
+ *                    a library that is aligned with many queries, such
+ *                    as the vector, saves doing it for each of them.
+ *      align         is the address of the Align structure.
+ *                    Its contig_offset and base_is_reverse fields 
+ *                    should be set when the function is called.
+ *                    At the end, all of the relevant fields in align
+ *                    will be set.
+ *		      NOTE: a negative value of align->num_gaps means
+ *                          the entire matrix for aligning sub-sequences
+ *                          will be computed.  This is useful when one
+ *                          needs to call this Btk_sw_alignment() function
+ *                          directly (skipping any pre-processing procedures
+ *                          that probe for best regions to run sw), eg.
+ *                          when aligning two short sequences.
+ *      range         is the range of query that should be aligned.
+ *      dir           is the direction in which to break ties
+ *      message       is the address of a BtkMessage, where information
+ *                    about an error will be put, if any
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ *
+ * Note: the function aligns sub-sequences, and returns the
+ *     best local sub-alignment.  It sets trace_qpos and
+ *     trace_dpos with respect to the original sequences, not the
+ *     sub-sequences.  (Previous versions of training code set 
+ *     trace_dpos with respect either the forward or reverse sequence,
+ *     this version always sets it with respect to forward.)
+ */
+int 
+Btk_sw_alignment(Align_params *ap, Contig *query, Contig *library,
+                 Contig *rev_comp_library, Profile *library_profile,
+                 Align *align, Range align_range, int dir,
+                 BtkMessage* message)
+{
+    return sw_align( ap, query, library, rev_comp_library, library_profile,
+                     align, align_range, dir, -1, -1, message );
+}
+
+
+/* This function computes the score of the best alignment of the
+ * sub-contigs of the query and the library, and converts where it ends
+ * to global positions.  Its synopsis is:
+ *
+ * result = sw_score( params, query, library, rev_comp, profile, align,
+ *                    range, dir, need_len, query_end, data_end, message )
+ *
+ * where need_len is 1 if the length of the alignment is to be set in
+ * align->trace_len, 0 if only its score and end are needed, in which case
+ * dir is not used, and the other arguments are those of Btk_sw_score.
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ */
+static int
+sw_score(Align_params *ap, Contig *query, Contig *library,
+         Contig *rev_comp_library, Profile *library_profile, Align *align,
+         Range align_range, int dir, int need_len, int *query_end,
+         int *data_end, BtkMessage* message)
+{
+    int    r;
+    passed_vars pv;
+    SubContig lib_ranges, query_ranges;
+
+    r = sw_sub_contigs( query, library, rev_comp_library, align, align_range,
+                        &query_ranges, &lib_ranges, message );
+    if(r==ERROR) {
+        return ERROR;
+    }
+
+    pv.width = align_band_width(align, &query_ranges, &lib_ranges);
+    pv.prof = library_profile;
+
+    if(!need_len) {
+        r = align_pair_end(&pv, align, ap, &query_ranges, &lib_ranges,
+                           message);
+    } else {
+        r = align_pair_score(&pv, align, ap, &query_ranges, &lib_ranges,
+                             dir, message);
+    }
+    if(r==ERROR) {
+        return ERROR;
+    }
+
+    /* Convert to global positions, as Btk_sw_alignment does. */
+    *query_end = pv.maxq + align_range.begin;
+    *data_end  = pv.maxd + align->contig_offset;
+    if(align->base_is_reverse) {
+        *data_end = library->length - *data_end - 1;
+    }
+
+    return SUCCESS;
+}
+
+
+/* This function computes the score of the alignment Btk_sw_alignment
+ * would produce, its length, and where it ends, without tracing it back.
+ * Its synopsis is:
+ *
+ * result = Btk_sw_score( params, query, library, rev_comp, profile,
+ *                        align, range, dir, query_end, data_end, message )
+ *
+ * where the arguments are those of Btk_sw_alignment, except that only the
+ * score and trace_len fields of align are set, so its trace arrays need
+ * not be allocated, and
+ *      query_end     is the address of an int, which will be set to
+ *                    the last query position of the alignment,
+ *                    i.e., trace_qpos[trace_len-1]
+ *      data_end      likewise for trace_dpos
+ *                    Both are meaningful only if the score is > 0.
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ *
+ * Note: the memory used is linear in the length of the query, so this is
+ *     the cheap way to compare competing regions.  Btk_sw_trace then
+ *     gives the alignment of the one chosen.
+ */
+int
+Btk_sw_score(Align_params *ap, Contig *query, Contig *library,
+             Contig *rev_comp_library, Profile *library_profile,
+             Align *align, Range align_range, int dir, int *query_end,
+             int *data_end, BtkMessage* message)
+{
+    return sw_score( ap, query, library, rev_comp_library, library_profile,
+                     align, align_range, dir, 1, query_end, data_end,
+                     message );
+}
+
+
+/* This function computes the score of the alignment Btk_sw_alignment
+ * would produce, and where it ends, but not its length.
+ * Its synopsis is:
+ *
+ * result = Btk_sw_end( params, query, library, rev_comp, profile,
+ *                      align, range, query_end, data_end, message )
+ *
+ * where the arguments are those of Btk_sw_score, and only the score field
+ * of align is set.
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ *
+ * Note: no moves are considered beyond the score, so it costs less than
+ *     Btk_sw_score, and is the way to find out whether, and where, two
+ *     sequences align.
+ */
+int
+Btk_sw_end(Align_params *ap, Contig *query, Contig *library,
+           Contig *rev_comp_library, Profile *library_profile,
+           Align *align, Range align_range, int *query_end, int *data_end,
+           BtkMessage* message)
+{
+    return sw_score( ap, query, library, rev_comp_library, library_profile,
+                     align, align_range, 0, 0, query_end, data_end,
+                     message );
+}
+
+
+/* This function produces the alignment Btk_sw_alignment would, given
+ * where it ends. Its synopsis is:
+ *
+ * result = Btk_sw_trace( params, query, library, rev_comp, profile,
+ *                        align, range, dir, query_end, data_end, message )
+ *
+ * where query_end and data_end are the ends returned by Btk_sw_score
+ * or Btk_sw_end for the same arguments, or -1 to fill in the whole band,
+ * and the other arguments are those of Btk_sw_alignment.
+ *
+ *      result        is 0 on success, !0 if an error occurs.
+ *
+ * Note: the matrix is filled in only up to the end of the alignment,
+ *     which is all the traceback needs, so an alignment that ends near
+ *     the beginning of the sequences is found at little cost.
+ */
+int
+Btk_sw_trace(Align_params *ap, Contig *query, Contig *library,
+             Contig *rev_comp_library, Profile *library_profile,
+             Align *align, Range align_range, int dir, int query_end,
+             int data_end, BtkMessage* message)
+{
+    return sw_align( ap, query, library, rev_comp_library, library_profile,
+                     align, align_range, dir, query_end, data_end,
+                     message );
+}
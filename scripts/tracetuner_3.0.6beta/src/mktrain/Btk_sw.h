@@ -27,7 +27,25 @@
 #define BTK_SW_H
 
 extern int Btk_sw_alignment(Align_params *ap, Contig *query, Contig *library,
-               Contig *rev_comp_library, Align *align, Range align_range,
+               Contig *rev_comp_library, Profile *library_profile,
+               Align *align, Range align_range,
                int read_direction, BtkMessage* message);
 
+extern int Btk_sw_score(Align_params *ap, Contig *query, Contig *library,
+               Contig *rev_comp_library, Profile *library_profile,
+               Align *align, Range align_range,
+               int read_direction, int *query_end, int *data_end,
+               BtkMessage* message);
+
+extern int Btk_sw_end(Align_params *ap, Contig *query, Contig *library,
+               Contig *rev_comp_library, Profile *library_profile,
+               Align *align, Range align_range,
+               int *query_end, int *data_end, BtkMessage* message);
+
+extern int Btk_sw_trace(Align_params *ap, Contig *query, Contig *library,
+               Contig *rev_comp_library, Profile *library_profile,
+               Align *align, Range align_range,
+               int read_direction, int query_end, int data_end,
+               BtkMessage* message);
+
 #endif
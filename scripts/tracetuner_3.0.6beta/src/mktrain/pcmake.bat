@@ -20,6 +20,7 @@ copy ..\compute_qv\tracepoly.h tracepoly.h
 copy ..\compute_qv\Btk_default_table.h Btk_default_table.h
 copy ..\compute_qv\Btk_atod.h Btk_atod.h
 copy ..\compute_qv\Btk_compute_qv.h Btk_compute_qv.h
+copy ..\compute_qv\train_bin.h train_bin.h
 gcc -D__WIN32 -O3 -c train_data.c -o           ..\..\obj\x86-win32\train_data.o
 gcc -D__WIN32 -O3 -c Btk_compute_match.c -o    ..\..\obj\x86-win32\Btk_compute_match.o
 gcc -D__WIN32 -O3 -c Btk_match_data.c -o       ..\..\obj\x86-win32\Btk_match_data.o
@@ -41,3 +42,4 @@ del Btk_lookup_table.h
 del Btk_qv_io.h
 del tracepoly.h
 del context_table.h
+del train_bin.h
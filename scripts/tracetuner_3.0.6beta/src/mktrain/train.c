@@ -61,6 +61,7 @@ extern __const char *__const sys_errlist[];
 #include "Btk_default_table.h"
 #include "Btk_atod.h"
 #include "Btk_compute_qv.h"
+#include "train_bin.h"
 #include "train_data.h"
 
 #define BUFLEN            1000
@@ -90,6 +91,10 @@ static int  ConsensusSpecified;    /* Whether the user has specified a name. */
 static char OutputName[BUFLEN];    /* Name of the Output file. */
 static int  OutputSpecified;       /* Whether the user has specified a name. */
 
+static char BinaryName[BUFLEN];    /* Name of the binary output file. */
+static int  BinarySpecified;       /* Whether the user has specified a name. */
+static TrainBinWriter *BinaryOut;  /* Writer of the binary output, or NULL */
+
 static char PrimerName[BUFLEN];    /* Name of the Primer file. */
 static int  PrimerSpecified;       /* Whether the user has specified a name. */
 
@@ -107,7 +112,6 @@ static double MaxFractionOfErrors; /* If the fraction of errors within
                                     * rejected, that is, will not be used 
                                     * in the training process
                                     */
-static char status_code[BUFLEN];
 static int nocall;                 /* Whether to use ABI base calls */
 static int recalln;                /* Whether to only recall 'N's to the best guess*/
 static int recallndb;              /* Whether to only recall 'N's and dye blobs 
@@ -144,15 +148,22 @@ static int MisMatch;
 static int GapInit;  
 static int GapExt;
 
+static int Threads;                /* Number of fragments processed at once */
+static TrainJobs *Jobs;            /* Runner of the fragments if Threads > 1 */
+
 /* 
- *  Global variables to summarize number of input files.  These are set in
- *  process_fragment_file and output as comments at the end of the run.
+ *  Numbers of input files.  These are counted by process_fragment_file
+ *  and output as comments at the end of the run.
  */
-int Count_input_files = 0;  
-int Count_file_errors = 0;  
-int Count_processing_errors = 0;
-int Count_possible_repeats  = 0;
-int Count_no_alignments     = 0;
+typedef struct {
+    int input_files;
+    int file_errors;
+    int processing_errors;
+    int possible_repeats;
+    int no_alignments;
+} FileCounts;
+
+static FileCounts Counts;
 
 /* ------------------------------------------------------------------- */
 static void usage(char** argv)
@@ -167,6 +178,7 @@ static void usage(char** argv)
     (void)fprintf(stderr, "\t[ -fr <repeat_frac> ]    [ -fe <max_frac_of_errors> ]\n");
     (void)fprintf(stderr, "\t[ -a <min_portion_aligned> ] [ -l <min_read_length> ]\n");
     (void)fprintf(stderr, "\t[ -ipd <dir> ]         [ -o <output_file> ]\n");
+    (void)fprintf(stderr, "\t[ -b <binary_file> ]   [ -threads <num> ]\n");
     (void)fprintf(stderr,
         "        <sample_file(s)> || -d <input_dir> || -p <project_file>\n");
 }
@@ -190,6 +202,7 @@ static void usage_dev(char** argv)
     (void)fprintf(stderr,
         "\t[ -fr <repeat_fraction> ] [ -fe <max_fraction_of_errors> ]\n");
     (void)fprintf(stderr, "\t[ -ipd <dir> ]         [ -o <output_file> ]\n");
+    (void)fprintf(stderr, "\t[ -b <binary_file> ]   [ -threads <num> ]\n");
     (void)fprintf(stderr,
         "      <sample_file(s)> || -d <input_dir> || -p <project_file>\n");
 }
@@ -220,6 +233,12 @@ help_message(int argc, char *argv[])
     (void)fprintf(stderr, "\t                      will be rejected (=not used in training process) \n");
     (void)fprintf(stderr, "\t-o <output_file>      Specify the name of the output file. By default, \n");
     (void)fprintf(stderr, "\t                      the output will be made to stdout   \n");
+    (void)fprintf(stderr, "\t-b <binary_file>      Also write the training data in binary format, which \n");
+    (void)fprintf(stderr, "\t                      lut, checkqv and checkbc read much faster. Without \n");
+    (void)fprintf(stderr, "\t                      -o, no text output is made \n");
+    (void)fprintf(stderr, "\t-threads <num>        Process up to 16 sample files at once. The output \n");
+    (void)fprintf(stderr, "\t                      is the same as that of a single thread. Needs -C \n");
+    (void)fprintf(stderr, "\t                      or -p and a build with THREADS=1 \n");
     (void)fprintf(stderr, "\t-C <consensusfile>    Specify the name of the FASTA file which contains \n");
     (void)fprintf(stderr, "\t                      the consensus sequence \n");
     (void)fprintf(stderr, "\t-V <vector>           Specify the name of the FASTA file which contains the \n");
@@ -449,6 +468,7 @@ process_fragment_file(Align_params *alp,
 		      Align_params   *alpIUB,
 		      char           *frag_name, 
 		      FILE           *fout, 
+                      TrainBinWriter *bout,
 		      Contig         *consensus, 
 		      Contig         *consensusrc,
 		      Vector         *vector, 
@@ -456,7 +476,8 @@ process_fragment_file(Align_params *alp,
                       ContextTable   *ctable,
 		      BtkMessage     *message,
                       Options         options, 
-                      Results        *results)
+                      Results        *results,
+                      FileCounts     *counts)
 {
     int             r,i, count_sub, count_del, count_ins, 
                     count_hetero,    count_mm_hetero,
@@ -483,6 +504,7 @@ process_fragment_file(Align_params *alp,
     BtkLookupTable *lookup_tbl=NULL;
     ReadInfo        read_info;
     char	   *consensus_seq = NULL;
+    char            status_code[BUFLEN];
 
     if (!ConsensusSpecified) {
         contig_init(consensus, message);
@@ -494,7 +516,7 @@ process_fragment_file(Align_params *alp,
     align_init(&vector_end_align, message);
 
     if (frag_name[0] == 0) {
-    	Count_file_errors++;
+    	counts->file_errors++;
 	release2(&fragment, &best_alignment, 
 	         &vector_start_align, &vector_end_align, message);
         return ERROR;
@@ -505,8 +527,11 @@ process_fragment_file(Align_params *alp,
     }
     if (options.Verbose >= 0) {
         fprintf(fout, "\n# File: %s ", frag_name);
+        if (bout != NULL) {
+            train_bin_new_file(bout);
+        }
     }
-    Count_input_files++;
+    counts->input_files++;
 
     /* Setting members of Options structure */
     options.nocall = 0;     
@@ -517,6 +542,7 @@ process_fragment_file(Align_params *alp,
     options.xgr = 0; 
     options.edited_bases = edited_bases;
     options.gauss = gauss;
+    options.color_threads = 0;
     options.het = het;
     options.mix = mix;
     options.shift = shift;
@@ -530,10 +556,6 @@ process_fragment_file(Align_params *alp,
     options.tal_dir[0]   = '\0';
     options.raw_data = 0;
     options.xgr = 0;
-    options.sf[0] = p1;
-    options.sf[1] = p2;
-    options.sf[2] = p3;
-    options.sf[3] = p4;
     options.inp_phd = inp_phd;
     options.indel_detect = 0;
     options.indel_resolve = 0;
@@ -548,18 +570,18 @@ process_fragment_file(Align_params *alp,
         edited_bases, &peak_locs, &quality_values, &num_datapoints, 
         &chromatogram[0], &chromatogram[1], 
         &chromatogram[2], &chromatogram[3], 
-      	&call_method, &chemistry, status_code, options,              /* global */
+      	&call_method, &chemistry, status_code, &options,
         message)) != SUCCESS)
     {
         if (r == kWrongFileType)
         {
             fprintf(stderr, ": not a sample file\n");
             fprintf(fout, ": not a sample file\n");
-            Count_file_errors++;
+            counts->file_errors++;
             return SUCCESS;
         }
         message->text[0] = '\0';  /* message may have been set with no error */
-      	Count_file_errors++;
+      	counts->file_errors++;
 	release2(&fragment, &best_alignment, 
 	         &vector_start_align, &vector_end_align, message);
         return ERROR;
@@ -584,7 +606,7 @@ process_fragment_file(Align_params *alp,
 			  strlen(consensus_seq), quality_values, message);
 	FREE(consensus_seq);
     	if (r == ERROR) {
-    	    Count_file_errors++;
+    	    counts->file_errors++;
 	    release2(&fragment, &best_alignment,
 		     &vector_start_align, &vector_end_align, message);
     	    return ERROR;
@@ -594,7 +616,7 @@ process_fragment_file(Align_params *alp,
     	r = contig_get_reverse_comp(consensusrc, consensus, message);
 
     	if (r == ERROR) {
-    	    Count_file_errors++;
+    	    counts->file_errors++;
 	    release2(&fragment, &best_alignment,
 		     &vector_start_align, &vector_end_align, message);
     	    return ERROR;
@@ -607,7 +629,7 @@ process_fragment_file(Align_params *alp,
 	release2(&fragment, &best_alignment, 
 	         &vector_start_align, &vector_end_align, message);
     	sprintf(message->text,"No called base information in input file");
-    	Count_file_errors++;
+    	counts->file_errors++;
     	return ERROR;
     }
     if (num_datapoints <= 0) {
@@ -615,7 +637,7 @@ process_fragment_file(Align_params *alp,
 	release2(&fragment, &best_alignment, 
 	         &vector_start_align, &vector_end_align, message);
     	sprintf(message->text,"No peak information in input file");
-    	Count_file_errors++;
+    	counts->file_errors++;
     	return ERROR;
     }
 
@@ -706,10 +728,10 @@ process_fragment_file(Align_params *alp,
     {
         if (Btk_compute_tpars(&num_bases, &bases, &peak_locs, &num_datapoints, 
             chromatogram, "ACGT", &params[0], &params[1], &params[2], &params[3], 
-            &iheight, &iheight2, &ave_iheight, &read_info, table, ctable, options, 
+            &iheight, &iheight2, &ave_iheight, &read_info, table, ctable, &options, 
             message, results ) != SUCCESS)
         {
-            Count_processing_errors++;
+            counts->processing_errors++;
             release1(bases, peak_locs, chromatogram, quality_values, params, 
             iheight);
             FREE(iheight2);
@@ -722,7 +744,7 @@ process_fragment_file(Align_params *alp,
     
     r = contig_create(&fragment, bases, num_bases, quality_values, message);
     if (r == ERROR) {
-    	Count_processing_errors++;
+    	counts->processing_errors++;
     	release1(bases, peak_locs, chromatogram, quality_values, params, iheight);
         FREE(iheight2);
         FREE(ave_iheight);
@@ -736,7 +758,7 @@ process_fragment_file(Align_params *alp,
             &vector_start_align, &vector_end_align, &clear_range, 0,
             message) == ERROR) 
     {
-    	Count_processing_errors++;
+    	counts->processing_errors++;
         if (options.Verbose > 0) {
             fprintf(fout, "# Error calling Btk_compute_match: file %s\n",
                 frag_name);
@@ -754,10 +776,10 @@ process_fragment_file(Align_params *alp,
         extract_bases_from_alignment(num_bases, bases, &best_alignment);
         if (Btk_compute_tpars(&num_bases, &bases, &peak_locs, &num_datapoints,
             chromatogram, "ACGT", &params[0], &params[1], &params[2], &params[3],
-            &iheight, &iheight2, &ave_iheight, &read_info, table, ctable, options, 
+            &iheight, &iheight2, &ave_iheight, &read_info, table, ctable, &options, 
             message, results ) != SUCCESS)
         {
-            Count_processing_errors++;
+            counts->processing_errors++;
             release1(bases, peak_locs, chromatogram, quality_values, params,
                 iheight);
             FREE(iheight2);
@@ -776,7 +798,7 @@ process_fragment_file(Align_params *alp,
     	    fprintf(stderr, "No good alignments - ignore file %s\n",
 	        frag_name);
         }
-    	Count_no_alignments++;
+    	counts->no_alignments++;
     } else if ( (num_align != 1) || (best_alignment.score == -1) ) {
         if (options.Verbose > 0) { 
     	    fprintf(fout, "# Possible repeat !!! - ignore file %s\n",
@@ -784,7 +806,7 @@ process_fragment_file(Align_params *alp,
     	    fprintf(stderr, "Possible repeat !!! - ignore file %s\n",
 	        frag_name);
         }
-    	Count_possible_repeats++;
+    	counts->possible_repeats++;
     } 
     else 
     {
@@ -815,14 +837,15 @@ process_fragment_file(Align_params *alp,
                                                                 &&
                  (num_bases >= min_read_length))
         {
-       	    if (append_to_train_data(fout, num_bases, peak_locs, params, 
+       	    if (append_to_train_data(fout, bout, num_bases, peak_locs, 
+                params, 
                 iheight, iheight2, ave_iheight, clear_range, align_range, 
                 &vector_start_align, &best_alignment, &vector_end_align, 0, 
                 QVMAX(best_alignment.trace_dpos[0],
                 best_alignment.trace_dpos[best_alignment.trace_len-1]),
                 options.Verbose, message) == ERROR) 
             {
-                Count_processing_errors++;
+                counts->processing_errors++;
                 release2(&fragment, &best_alignment, &vector_start_align, 
                     &vector_end_align, message);
                 return ERROR;
@@ -852,7 +875,7 @@ process_fragment_file(Align_params *alp,
       	        fprintf(stderr, "BAD PROCESSING!!! - ignore file %s\n",
 	            frag_name);
             }
-            Count_processing_errors++;
+            counts->processing_errors++;
         }
         if (options.Verbose > 0)
     	    fprintf(stderr, "Align range length:%4d\n", alignment_size);
@@ -900,6 +923,231 @@ error:
 }
 
 
+/*******************************************************************************
+ * Function: initialize_results
+ *******************************************************************************
+ */
+void
+initialize_results(Results *results)
+{
+    int i;
+    results->align_length = 0;
+    results->count_ins = 0;
+    results->count_del = 0;
+    results->count_sub = 0;
+    results->count_err = 0;
+    results->count_hetero = 0;
+    results->count_tp_hetero    = 
+    results->count_fp_hetero    = results->count_fn_hetero    = 0;
+    results->count_tp_qv_hetero = results->count_fn_qv_hetero = 
+    results->count_fp_qv_hetero = 0;
+    results->min_qv_cor  = 100;
+    results->count_chunks = 0;
+    for ( i=0; i<MAX_CHUNKS; i++ ) {
+        statsReset( &results->stats[i] );
+        /* assumption: normalized spacing is mostly in [0,2] */
+        histoReset( &results->histo[i], 0.0, 2.0 );
+    }
+}
+
+/* A fragment file processed by Jobs. Everything it points to is only read
+ * while the batch of fragments runs
+ */
+typedef struct {
+    Align_params   *ap;
+    Align_params   *apIUB;
+    Contig         *consensus;
+    Contig         *consensusrc;
+    Vector         *vector;
+    BtkLookupTable *table;
+    ContextTable   *ctable;
+    Options         options;
+    Results        *total;          /* where the results are summed up */
+    char            name[MAXPATHLEN];
+    char            reference[BUFLEN]; /* reported before the file, if set */
+    int             report_name;    /* on error, report the name of the file
+                                     * rather than the error message
+                                     */
+    int             result;
+    BtkMessage      message;
+    FileCounts      counts;
+    Results         results;
+} FragmentJob;
+
+/*******************************************************************************
+ * Function: report_fragment_error
+ *******************************************************************************
+ */
+static void
+report_fragment_error(FILE *fout, char *what)
+{
+    fprintf(stderr,"Error processing input file: %s\n", what);
+    fprintf(fout,"# Error processing input file: %s\n", what);
+}
+
+/*******************************************************************************
+ * Function: add_results
+ * Purpose:  add the results of a fragment to the results of the run
+ *******************************************************************************
+ */
+static void
+add_results(Results *total, const Results *results)
+{
+    int i;
+
+    total->align_length       += results->align_length;
+    total->count_del          += results->count_del;
+    total->count_ins          += results->count_ins;
+    total->count_sub          += results->count_sub;
+    total->count_err          += results->count_err;
+    total->count_hetero       += results->count_hetero;
+    total->count_tp_hetero    += results->count_tp_hetero;
+    total->count_fn_hetero    += results->count_fn_hetero;
+    total->count_fp_hetero    += results->count_fp_hetero;
+    total->count_mm_hetero    += results->count_mm_hetero;
+    total->count_fn_qv_hetero += results->count_fn_qv_hetero;
+    total->count_fp_qv_hetero += results->count_fp_qv_hetero;
+    total->count_tp_qv_hetero += results->count_tp_qv_hetero;
+    total->min_qv_cor = QVMIN(total->min_qv_cor, results->min_qv_cor);
+
+    /* count_chunks is that of the last fragment which set it */
+    if (results->count_chunks >= 0) {
+        total->count_chunks = results->count_chunks;
+    }
+    for (i = 0; i < MAX_CHUNKS; i++) {
+        statsUpdateFromStats(&total->stats[i], &results->stats[i]);
+        histoUpdateFromHisto(&total->histo[i], &results->histo[i]);
+    }
+}
+
+/*******************************************************************************
+ * Function: run_fragment_job
+ * Purpose:  process the fragment file of a job; called by Jobs on any thread
+ *******************************************************************************
+ */
+static void
+run_fragment_job(void *p, FILE *fout, TrainBinWriter *bout)
+{
+    FragmentJob *job = (FragmentJob *)p;
+
+    if (job->reference[0] != '\0') {
+        fprintf(stderr, "Reference = %s\n", job->reference);
+        fprintf(fout, "# Reference = %s\n", job->reference);
+    }
+    initialize_results(&job->results);
+    job->results.count_chunks = -1;     /* not set */
+
+    job->result = process_fragment_file(job->ap, job->apIUB, job->name, fout,
+        bout, job->consensus, job->consensusrc, job->vector, job->table,
+        job->ctable, &job->message, job->options, &job->results, &job->counts);
+}
+
+/*******************************************************************************
+ * Function: fragment_job_done
+ * Purpose:  report the outcome of a job once its output has been written;
+ *           called by Jobs in the order the files were submitted
+ *******************************************************************************
+ */
+static int
+fragment_job_done(void *p, FILE *fout)
+{
+    FragmentJob *job = (FragmentJob *)p;
+
+    if (job->result != SUCCESS) {
+        report_fragment_error(fout,
+            job->report_name ? job->name : job->message.text);
+    }
+    add_results(job->total, &job->results);
+
+    Counts.input_files       += job->counts.input_files;
+    Counts.file_errors       += job->counts.file_errors;
+    Counts.processing_errors += job->counts.processing_errors;
+    Counts.possible_repeats  += job->counts.possible_repeats;
+    Counts.no_alignments     += job->counts.no_alignments;
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Function: submit_fragment_file
+ * Purpose:  process a fragment file and report an error, if any. If Threads
+ *           is > 1, the file is queued to Jobs instead, to be processed with
+ *           the rest of its batch. If reference is not NULL, it is reported
+ *           before the file. On error, the name of the file is reported if
+ *           report_name is set, the error message otherwise
+ * Return:   ERROR if a batch could not be run, SUCCESS otherwise
+ *******************************************************************************
+ */
+static int
+submit_fragment_file(Align_params *ap, Align_params *apIUB, char *frag_name,
+    FILE *fout, Contig *consensus, Contig *consensusrc, Vector *vector,
+    BtkLookupTable *table, ContextTable *ctable, BtkMessage *message,
+    Options options, Results *results, char *reference, int report_name)
+{
+    FragmentJob *job;
+
+    if (Jobs == NULL) {
+        if (reference != NULL) {
+            fprintf(stderr, "Reference = %s\n", reference);
+            fprintf(fout, "# Reference = %s\n", reference);
+        }
+        if (process_fragment_file(ap, apIUB, frag_name, fout, BinaryOut,
+            consensus, consensusrc, vector, table, ctable, message, options,
+            results, &Counts) != SUCCESS)
+        {
+            report_fragment_error(fout, report_name ? frag_name : message->text);
+        }
+        return SUCCESS;
+    }
+
+    /* The jobs share the FastA lookup tables of the consensus, which
+     * Btk_compute_match would otherwise create on first use
+     */
+    if (((consensus->lut.length == 0) &&
+         (contig_make_fasta_lookup_table(consensus, KTUP, message) != SUCCESS))
+        ||
+        ((consensusrc->lut.length == 0) &&
+         (contig_make_fasta_lookup_table(consensusrc, KTUP, message) != SUCCESS)))
+    {
+        return ERROR;
+    }
+
+    if ((job = (FragmentJob *)train_jobs_next(Jobs)) == NULL) {
+        sprintf(message->text, "Error writing the output of the input files");
+        return ERROR;
+    }
+    job->ap          = ap;
+    job->apIUB       = apIUB;
+    job->consensus   = consensus;
+    job->consensusrc = consensusrc;
+    job->vector      = vector;
+    job->table       = table;
+    job->ctable      = ctable;
+    job->options     = options;
+    job->total       = results;
+    job->report_name = report_name;
+    (void)strncpy(job->name, frag_name, sizeof(job->name) - 1);
+    if (reference != NULL) {
+        (void)strncpy(job->reference, reference, sizeof(job->reference) - 1);
+    }
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Function: flush_fragment_files
+ * Purpose:  finish processing the fragment files queued to Jobs, if any
+ *******************************************************************************
+ */
+static int
+flush_fragment_files(BtkMessage *message)
+{
+    if ((Jobs != NULL) && (train_jobs_flush(Jobs) != SUCCESS)) {
+        sprintf(message->text, "Error writing the output of the input files");
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+
 /*
  * This function prints as formatted an error message as it can, then exits
  * if the Force flag isn't set.  Its synopsis is:
@@ -967,7 +1215,6 @@ static int process_dir(
     struct dirent *de;
     char path[MAXPATHLEN];
     struct stat statbuf;
-    int r;
 
     message->text[0] = 0;
 
@@ -988,12 +1235,12 @@ static int process_dir(
             continue;
     	}
 
-        if ((r = process_fragment_file(ap, apIUB, path, fout, consensus,
+        if (submit_fragment_file(ap, apIUB, path, fout, consensus,
             consensusrc, vector, table, ctable, message, options,
-            results)) != SUCCESS) 
+            results, NULL, 0) != SUCCESS) 
         {
-      	    fprintf(stderr,"Error processing input file: %s\n",message->text);
-      	    fprintf(fout,"# Error processing input file: %s\n",message->text);
+      	    closedir(d);
+      	    return ERROR;
     	}
     }
 
@@ -1001,6 +1248,40 @@ static int process_dir(
     return SUCCESS;
 }
 
+/* Consensus sequences read by process_projectfile. With -threads, the
+ * fragments queued to Jobs use theirs until the batch has run, so up to
+ * MAX_REFERENCES are kept and released together
+ */
+#define MAX_REFERENCES 32
+
+typedef struct {
+    Contig  consensus;
+    Contig  consensusrc;
+} Reference;
+
+/*******************************************************************************
+ * Function: release_references
+ *******************************************************************************
+ */
+static int
+release_references(Reference *refs, int *num_refs, BtkMessage *message)
+{
+    int i;
+
+    if (flush_fragment_files(message) != SUCCESS) {
+        return ERROR;
+    }
+    for (i = 0; i < *num_refs; i++) {
+        if ((contig_release(&refs[i].consensus, message) == ERROR) ||
+            (contig_release(&refs[i].consensusrc, message) == ERROR))
+        {
+            return ERROR;
+        }
+    }
+    *num_refs = 0;
+    return SUCCESS;
+}
+
 /*
  * This function processes all files contained in the specified project file.
  * Its synopsis is:
@@ -1037,10 +1318,10 @@ process_projectfile(
     char    buffer1[BUFLEN];
     char    buffer2[BUFLEN];
     char    *current, *previous, *tmp;
-    Contig  consensus;
-    Contig  consensusrc;
+    Reference refs[MAX_REFERENCES];
+    Reference *ref = NULL;
     char    fragmentName[MAXPATHLEN];
-    int     r, have_consensus;
+    int     r, num_refs, max_refs;
     FILE    *infile;
 
     if ((infile=fopen(projectFile,"r"))== NULL) {
@@ -1049,7 +1330,8 @@ process_projectfile(
     	return ERROR;
     }
 
-    have_consensus=0;
+    num_refs=0;
+    max_refs=(Jobs != NULL) ? MAX_REFERENCES : 1;
     buffer2[0]='\0';
     previous = buffer2;
     current  = buffer1;
@@ -1069,80 +1351,40 @@ process_projectfile(
     	/* If consensus is different from previous, read it in. */
     	if ( strcmp(current, previous) != 0 ) {
       	    /* Release previous, if necessary. */
-            if ( have_consensus ) {
-	    	r=contig_release( &consensus, message );
+            if ( num_refs == max_refs ) {
+                r=release_references( refs, &num_refs, message );
 		if ( r==ERROR ) { return ERROR; }
-		r=contig_release( &consensusrc, message );
-		if ( r==ERROR ) { return ERROR; }
-		have_consensus=0;
       	    }
+            ref=&refs[num_refs];
 
             /* Read consensus file. */
-            r=local_read_fasta( ConsensusName, &consensus, message );
+            r=local_read_fasta( ConsensusName, &ref->consensus, message );
       	    if ( r==ERROR ) { return ERROR; }
 
       	    /* Create reverse complement of consensus. */
-      	    r=contig_get_reverse_comp( &consensusrc, &consensus, message );
+      	    r=contig_get_reverse_comp( &ref->consensusrc, &ref->consensus,
+                message );
       	    if ( r==ERROR ) { return ERROR; }
-      	    have_consensus=1;
+      	    num_refs++;
     	}
 
     	tmp=previous;
     	previous=current;
     	current=tmp;
 
-        if (options.Verbose >0) {
-      	    fprintf(stderr, "Reference = %s\n", ConsensusName );
-    	    fprintf(fout, "# Reference = %s\n", ConsensusName );
-        }
-
-    	if (process_fragment_file(ap, apIUB, fragmentName, fout, &consensus,
-	    &consensusrc, vector, table, ctable, message, options,
-            results) == ERROR) 
+    	if (submit_fragment_file(ap, apIUB, fragmentName, fout, &ref->consensus,
+	    &ref->consensusrc, vector, table, ctable, message, options, results,
+            (options.Verbose > 0) ? ConsensusName : NULL, 1) == ERROR) 
         {
-      	    fprintf(stderr,"Error processing input file: %s\n",fragmentName);
-            fprintf(fout,"# Error processing input file: %s\n",fragmentName);
+            fclose(infile);
+            return ERROR;
     	}
     }
 
     fclose(infile);
 
     /* Clean up. */
-    if ( have_consensus ) {
-    	r=contig_release( &consensus, message );
-    	if ( r==ERROR ) { return ERROR; }
-    	r=contig_release( &consensusrc, message );
-    	if ( r==ERROR ) { return ERROR; }
-    }
-
-    return SUCCESS;
-}
-
-/*******************************************************************************
- * Function: initialize_results
- *******************************************************************************
- */
-void
-initialize_results(Results *results)
-{
-    int i;
-    results->align_length = 0;
-    results->count_ins = 0;
-    results->count_del = 0;
-    results->count_sub = 0;
-    results->count_err = 0;
-    results->count_hetero = 0;
-    results->count_tp_hetero    = 
-    results->count_fp_hetero    = results->count_fn_hetero    = 0;
-    results->count_tp_qv_hetero = results->count_fn_qv_hetero = 
-    results->count_fp_qv_hetero = 0;
-    results->min_qv_cor  = 100;
-    results->count_chunks = 0;
-    for ( i=0; i<MAX_CHUNKS; i++ ) {
-        statsReset( &results->stats[i] );
-        /* assumption: normalized spacing is mostly in [0,2] */
-        histoReset( &results->histo[i], 0.0, 2.0 );
-    }
+    return release_references( refs, &num_refs, message );
 }
 
 static void
@@ -1189,6 +1431,9 @@ int main(int argc, char** argv)
     ConsensusSpecified  = 0;
     OutputName[0]       = '\0';
     OutputSpecified     = 0;
+    BinaryName[0]       = '\0';
+    BinarySpecified     = 0;
+    BinaryOut           = NULL;
     PrimerName[0]       = '\0';
     PrimerSpecified     = 0;
     VectorName[0]       = '\0';
@@ -1225,6 +1470,8 @@ int main(int argc, char** argv)
     inp_phd_dir[0]      ='\0';
     min_portion_aligned = 0.;
     min_read_length     = 0;
+    Threads             = 1;
+    Jobs                = NULL;
     initialize_results(&results);
     options.sf = CALLOC(double, 4);
 
@@ -1253,13 +1500,15 @@ int main(int argc, char** argv)
              (strcmp(argv[optind], "-E" )        == 0) ||
              (strcmp(argv[optind], "-f" )        == 0) ||
              (strcmp(argv[optind], "-o" )        == 0) ||
+             (strcmp(argv[optind], "-b" )        == 0) ||
              (strcmp(argv[optind], "-p" )        == 0) ||
              (strcmp(argv[optind], "-p1")        == 0) ||
              (strcmp(argv[optind], "-p2")        == 0) ||
              (strcmp(argv[optind], "-p3")        == 0) ||
              (strcmp(argv[optind], "-p4")        == 0) ||
              (strcmp(argv[optind], "-d" )        == 0) ||
-             (strcmp(argv[optind], "-ipd" )      == 0)
+             (strcmp(argv[optind], "-ipd" )      == 0) ||
+             (strcmp(argv[optind], "-threads")   == 0)
             )
             &&
             (optind==argc-1 || argv[optind+1][0]=='-'))
@@ -1400,6 +1649,15 @@ int main(int argc, char** argv)
                 (void)strncpy(OutputName, argv[++optind], sizeof(OutputName));
                 break;
 
+            case 'b':
+                if (strcmp(args, "-b") != 0) {
+                    usage(argv);
+                    exit(2);
+                }
+                BinarySpecified++;
+                (void)strncpy(BinaryName, argv[++optind], sizeof(BinaryName));
+                break;
+
             case 'p':
                 if ((strcmp(args, "-p1") != 0) &&
                     (strcmp(args, "-p2") != 0) &&
@@ -1500,7 +1758,13 @@ int main(int argc, char** argv)
                 SiteSpecified++; 
                 (void)strncpy(SiteName, argv[++optind], sizeof(SiteName)); break;
 
-	    case 't': if (strcmp(args, "-t") != 0) { usage(argv);
+	    case 't': 
+                if (strcmp(args, "-threads") == 0) {
+                    Threads = atoi(argv[++optind]);
+                    j = strlen(args) - 1;   /* break out of inner loop */
+                    break;
+                }
+                if (strcmp(args, "-t") != 0) { usage(argv);
                     exit(2);
                 }
                 lookup_table = argv[++optind];
@@ -1544,6 +1808,29 @@ int main(int argc, char** argv)
         "Error: MaxFractionOfErrors must be in the range [0,1.0]\n" );
         exit(2);
     }
+
+    if ((Threads < 1) || (Threads > MAX_TRAIN_THREADS)) {
+        fprintf(stderr,
+        "Error: the number of threads must be in the range [1,%d]\n",
+            MAX_TRAIN_THREADS);
+        exit(2);
+    }
+#ifndef TT_THREADS
+    if (Threads > 1) {
+        fprintf(stderr,
+        "train was built without thread support; ignoring -threads\n");
+        Threads = 1;
+    }
+#endif
+    /* Without -C, each fragment would have its own consensus */
+    if (!ConsensusSpecified) {
+        Threads = 1;
+    }
+
+    options.sf[0] = p1;
+    options.sf[1] = p2;
+    options.sf[2] = p3;
+    options.sf[3] = p4;
     
     /*
      * Set line buffering on the status output so that someone monitoring
@@ -1591,11 +1878,38 @@ int main(int argc, char** argv)
       	    exit(ERROR);
     	}
     	fprintf(stderr, "Software Version: %s\n", TT_VERSION);
+    } else if (BinarySpecified) {
+        /* Only the binary output is wanted */
+#ifdef __WIN32
+    	if ((fout=fopen("NUL", "w"))== NULL) {
+#else
+    	if ((fout=fopen("/dev/null", "w"))== NULL) {
+#endif
+      	    fprintf(stderr, "Cannot open the null device\n");
+      	    exit(ERROR);
+    	}
     } else {
     	if (options.Verbose >= 1) 
             fprintf(stderr, "No output file specified.  Using stdout.\n");
     	fout=stdout;
     }
+
+    if (BinarySpecified) {
+        if ((BinaryOut = train_bin_create(BinaryName)) == NULL) {
+            fprintf(stderr, "Cannot open output file '%s'\n", BinaryName);
+            exit(ERROR);
+        }
+    }
+
+    if (Threads > 1) {
+        if ((Jobs = train_jobs_create(Threads, sizeof(FragmentJob),
+            run_fragment_job, fragment_job_done, fout, BinaryOut)) == NULL)
+        {
+            fprintf(stderr, "Cannot create the temporary files of %d threads\n",
+                Threads);
+            exit(ERROR);
+        }
+    }
   
     /* Set parameters for alignment with consensus */
     if (set_alignment_parameters( &align_pars, Match, MisMatch, GapInit,
@@ -1643,7 +1957,8 @@ int main(int argc, char** argv)
     } else if ( VectorSpecified 
 	      && (! PrimerSpecified) && (!SiteSpecified) ) {
     	fprintf(fout, "# Short Vector = %s\n", VectorName);
-    	if (readShortVector( VectorName, &vector, &message) == ERROR ) {
+    	if (readShortVector( VectorName, &vector, &align_pars_IUB, 
+	    &message) == ERROR ) {
       	    fprintf(stderr, message.text);
      	    exit (ERROR);
     	}
@@ -1693,14 +2008,13 @@ int main(int argc, char** argv)
 #endif
     	/* Loop for each fragment: */
     	for (i = optind; i < argc; i++) {
-   	    r = process_fragment_file(&align_pars, &align_pars_IUB, argv[i],
+   	    r = submit_fragment_file(&align_pars, &align_pars_IUB, argv[i],
             fout, &consensus, &consensusrc, vecP, table, ctable, &message, 
-            options, &results);
+            options, &results, NULL, 0);
    	    if (r != SUCCESS) {
-		fprintf(stderr,"Error processing input file: %s\n",
-			message.text);
-		fprintf(fout,"# Error processing input file: %s\n",
+		fprintf(stderr,"Error processing input files: %s\n",
 			message.text);
+      	        exit (ERROR);
       	    }
     	}
     	break;
@@ -1755,6 +2069,11 @@ int main(int argc, char** argv)
 
     /* Clean up. */
  
+    if ((Jobs != NULL) && (train_jobs_finish(Jobs) != SUCCESS)) {
+        fprintf(stderr, "Error writing the output of the input files\n");
+        exit(ERROR);
+    }
+
     if (alignment_parameters_release( &align_pars, &message) == ERROR) {
     	fprintf(stderr, "Error releasing memory: %s\n",message.text);
     	exit(ERROR);
@@ -1782,19 +2101,23 @@ int main(int argc, char** argv)
      */
     fprintf(fout,"#\n");
     fprintf(fout,"# File count summary for this run: \n");
-    fprintf(fout,"#  %6d files input\n", Count_input_files);
-    fprintf(fout,"#  %6d files processed\n", Count_input_files -
-	    (Count_file_errors + Count_processing_errors + 
-	    Count_possible_repeats + Count_no_alignments));
+    fprintf(fout,"#  %6d files input\n", Counts.input_files);
+    fprintf(fout,"#  %6d files processed\n", Counts.input_files -
+	    (Counts.file_errors + Counts.processing_errors + 
+	    Counts.possible_repeats + Counts.no_alignments));
     fprintf(fout,"#  %6d files rejected with file errors\n", 
-	    Count_file_errors);
+	    Counts.file_errors);
     fprintf(fout,"#  %6d files rejected with processing errors\n",
-	    Count_processing_errors);
+	    Counts.processing_errors);
     fprintf(fout,"#  %6d files rejected with possible repeats\n",
-	    Count_possible_repeats);
+	    Counts.possible_repeats);
     fprintf(fout,"#  %6d files rejected with no alignments\n",
-	    Count_no_alignments);
+	    Counts.no_alignments);
     fclose(fout);
+    if ((BinaryOut != NULL) && (train_bin_finish(BinaryOut) != SUCCESS)) {
+        fprintf(stderr, "Error writing output file '%s'\n", BinaryName);
+        exit(ERROR);
+    }
 
     /*
      *   Print out Results summary
@@ -1852,9 +2175,9 @@ int main(int argc, char** argv)
                      results.count_mm_hetero));
         fprintf(stderr, "   AVE FN PER ONE PROCCESSED FILE: %4.2f\n",
             (double)results.count_fn_hetero/
-            (double)(Count_input_files -
-            (Count_file_errors + Count_processing_errors +
-            Count_possible_repeats + Count_no_alignments)));
+            (double)(Counts.input_files -
+            (Counts.file_errors + Counts.processing_errors +
+            Counts.possible_repeats + Counts.no_alignments)));
 
         fprintf(stderr,
             "FP HETEROZYGOTES: %3d FP_RATIO=%f",
@@ -1864,9 +2187,9 @@ int main(int argc, char** argv)
                      results.count_mm_hetero));
         fprintf(stderr, "   AVE FP PER ONE PROCCESSED FILE: %4.2f\n",
             (double)results.count_fp_hetero/
-            (double)(Count_input_files -
-            (Count_file_errors + Count_processing_errors +
-            Count_possible_repeats + Count_no_alignments)));    
+            (double)(Counts.input_files -
+            (Counts.file_errors + Counts.processing_errors +
+            Counts.possible_repeats + Counts.no_alignments)));    
         fprintf(stderr, "MM HETEROZYGOTES: %3d\n",
             results.count_mm_hetero);
         fprintf(stderr, 
@@ -1874,9 +2197,9 @@ int main(int argc, char** argv)
             results.count_fn_hetero+results.count_fp_hetero); 
         fprintf(stderr, "     AVE PER ONE PROCCESSED FILE: %4.2f\n",
             (double)(results.count_fp_hetero+results.count_fn_hetero)/
-            (double)(Count_input_files -
-            (Count_file_errors + Count_processing_errors +
-            Count_possible_repeats + Count_no_alignments)));
+            (double)(Counts.input_files -
+            (Counts.file_errors + Counts.processing_errors +
+            Counts.possible_repeats + Counts.no_alignments)));
 
         fprintf(stderr,
             "FRACTION OF FN HETEROZYGOTES: %f\n",
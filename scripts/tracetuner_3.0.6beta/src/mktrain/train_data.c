@@ -50,6 +50,7 @@
 #include "Btk_match_data.h"
 #include "Btk_compute_match.h"
 #include "Btk_qv_io.h"
+#include "train_bin.h"
 #include "train_data.h"
 
 /*********************************************************************************
@@ -146,10 +147,11 @@ get_num_errors(Align* align, int *ins, int *del, int *sub, int *tot)
 /* This function appends one Align data structure to the training output
  * file.  Its synopsis is:
  *
- * result = append_align_to_train_data(out, params, align, message)
+ * result = append_align_to_train_data(out, bout, params, align, message)
  *
  * where
  *      out             is the (already open) output stream
+ *      bout            is the writer of binary training data, or NULL
  *      params          is the matrix of trace parameters
  *      align           is the address of the Align
  *      message         is the address of a BtkMessage where information about
@@ -159,11 +161,12 @@ get_num_errors(Align* align, int *ins, int *del, int *sub, int *tot)
  *
  */
 int
-append_align_to_train_data(FILE* fout, double** params, double *iheight,
-    double *iheight2, double *ave_iheight, Align* align, int min_dpos, 
-    int max_dpos, BtkMessage* message)
+append_align_to_train_data(FILE* fout, TrainBinWriter *bout, double** params,
+    double *iheight, double *iheight2, double *ave_iheight, Align* align, 
+    int min_dpos, int max_dpos, BtkMessage* message)
 {
     int     i, j, ismatch;
+    double  p[TRAIN_BIN_NUM_PARAMS];
 
     for (j=0; j< align->trace_len; j++) {
         if ((align->trace_dpos[j] < min_dpos) ||
@@ -175,6 +178,27 @@ append_align_to_train_data(FILE* fout, double** params, double *iheight,
             ismatch = (align->trace_mchar[j]=='|')?1:0;
         }
 
+        if (bout != NULL) {
+            if (align->trace_dir[j] != '2') {
+                i = align->trace_qpos[j];
+                p[0] = params[0][i];
+                p[1] = params[1][i];
+                p[2] = params[2][i];
+                p[3] = params[3][i];
+                p[4] = iheight[i];
+                p[5] = iheight2[i];
+                p[6] = ave_iheight[i];
+            }
+            if (train_bin_append(bout, align->trace_dpos[j]+1,
+                align->trace_dchar[j], ismatch, align->trace_qpos[j]+1,
+                align->trace_qchar[j],
+                (align->trace_dir[j] == '2') ? NULL : p) != SUCCESS)
+            {
+                sprintf(message->text, "Cannot write binary training data");
+                return ERROR;
+            }
+        }
+
         fprintf(fout, "%d\t%c\t%d\t%d\t%c",
                 align->trace_dpos[j]+1,
                 align->trace_dchar[j],
@@ -203,8 +227,8 @@ append_align_to_train_data(FILE* fout, double** params, double *iheight,
  *******************************************************************************
  */
 int
-append_to_train_data(FILE* fout, int num_bases, int *peak_locs,
-                     double** params, double *iheight, double *iheight2,
+append_to_train_data(FILE* fout, TrainBinWriter *bout, int num_bases, 
+                     int *peak_locs, double** params, double *iheight, double *iheight2,
                      double *ave_iheight, Range clear_range, Range align_range,
                      Align* vec_start, Align* best_alignment, Align* vec_end,
                      int min_dpos, int max_dpos, 
@@ -234,9 +258,12 @@ append_to_train_data(FILE* fout, int num_bases, int *peak_locs,
 
     if (OUTPUT_VECTOR_ALIGNMENT && (vec_start->score > 0) ) {
         fprintf(fout, "# Vector\n");
-        append_align_to_train_data(fout, params, iheight, iheight2,
+        if (append_align_to_train_data(fout, bout, params, iheight, iheight2,
             ave_iheight, vec_start, vec_start->trace_dpos[0], 
-            vec_start->trace_dpos[vec_start->trace_len-1], message);
+            vec_start->trace_dpos[vec_start->trace_len-1], message) == ERROR)
+        {
+            return ERROR;
+        }
 
         if (Verbose > 0) {
             r = align_fprint(stderr, vec_start, 70, message);
@@ -244,8 +271,11 @@ append_to_train_data(FILE* fout, int num_bases, int *peak_locs,
         }
     }
 
-    append_align_to_train_data(fout, params, iheight, iheight2, 
-        ave_iheight, best_alignment, min_dpos, max_dpos, message);
+    if (append_align_to_train_data(fout, bout, params, iheight, iheight2, 
+        ave_iheight, best_alignment, min_dpos, max_dpos, message) == ERROR)
+    {
+        return ERROR;
+    }
 
     if (Verbose > 0) {
         r = align_fprint(stderr, best_alignment, 70, message);
@@ -254,9 +284,12 @@ append_to_train_data(FILE* fout, int num_bases, int *peak_locs,
 
     if (OUTPUT_VECTOR_ALIGNMENT && (vec_end->score > 0) ) {
         fprintf(fout, "# Vector\n");
-        append_align_to_train_data(fout, params, iheight, iheight2,
+        if (append_align_to_train_data(fout, bout, params, iheight, iheight2,
             ave_iheight, vec_end, vec_end->trace_dpos[0],
-            vec_end->trace_dpos[vec_end->trace_len-1], message);
+            vec_end->trace_dpos[vec_end->trace_len-1], message) == ERROR)
+        {
+            return ERROR;
+        }
 
         r = align_fprint(stderr, vec_end, 70, message);
         if ( r == ERROR ) { return ERROR; }
@@ -424,3 +457,225 @@ append_to_trainphred_data(FILE* fout, int num_bases, int *called_peak_locs,
 }
 
 
+
+/* Number of jobs per thread in a batch of TrainJobs */
+#define TRAIN_JOBS_PER_THREAD 4
+
+/* Where the output of a job is kept until it is written in order */
+typedef struct {
+    int   task;                  /* task which ran the job */
+    long  text_begin, text_end;  /* text output in the file of the task */
+    int   first_record;          /* binary output in the writer of the task */
+    int   num_records;
+} TrainJobOutput;
+
+struct TrainJobs {
+    int             num_threads;
+    int             num_tasks;   /* tasks running the current batch */
+    int             num_jobs;    /* jobs in the current batch */
+    int             max_jobs;
+    size_t          job_size;
+    char           *jobs;        /* max_jobs slots of job_size bytes each */
+    TrainJobOutput *output;
+    TrainJobRun     run;
+    TrainJobDone    done;
+    FILE           *fout;
+    TrainBinWriter *bout;
+    FILE           *text[MAX_TRAIN_THREADS];
+    TrainBinWriter *bin[MAX_TRAIN_THREADS];
+};
+
+/*********************************************************************************
+ * Function: release_train_jobs
+ *********************************************************************************
+ */
+static int
+release_train_jobs(TrainJobs *jobs)
+{
+    int i, r = SUCCESS;
+
+    for (i = 0; i < jobs->num_threads; i++) {
+        if (jobs->text[i] != NULL) {
+            (void)fclose(jobs->text[i]);
+        }
+        if ((jobs->bin[i] != NULL) && (train_bin_finish(jobs->bin[i]) != SUCCESS)) {
+            r = ERROR;
+        }
+    }
+    FREE(jobs->jobs);
+    FREE(jobs->output);
+    FREE(jobs);
+    return r;
+}
+
+/*********************************************************************************
+ * Function: train_jobs_create
+ * Purpose:  create a runner of jobs on num_threads threads. Each job is a
+ *           struct of job_size bytes, which run() processes writing its
+ *           output to the given streams; done() is then called for the jobs
+ *           in the order they were added, after their output has been
+ *           appended to fout and bout (which may be NULL)
+ * Return:   the runner, or NULL if there is not enough memory or no
+ *           temporary file can be created
+ *********************************************************************************
+ */
+TrainJobs *
+train_jobs_create(int num_threads, size_t job_size, TrainJobRun run,
+    TrainJobDone done, FILE *fout, TrainBinWriter *bout)
+{
+    int        i;
+    TrainJobs *jobs = CALLOC(TrainJobs, 1);
+
+    if (jobs == NULL) {
+        return NULL;
+    }
+    jobs->num_threads = QVMAX(1, QVMIN(num_threads, MAX_TRAIN_THREADS));
+    jobs->max_jobs    = jobs->num_threads * TRAIN_JOBS_PER_THREAD;
+    jobs->job_size    = job_size;
+    jobs->run         = run;
+    jobs->done        = done;
+    jobs->fout        = fout;
+    jobs->bout        = bout;
+
+    jobs->jobs   = CALLOC(char, jobs->max_jobs * job_size);
+    jobs->output = CALLOC(TrainJobOutput, jobs->max_jobs);
+    if ((jobs->jobs == NULL) || (jobs->output == NULL)) {
+        goto error;
+    }
+
+    /* Each task writes to its own temporary file and binary writer */
+    for (i = 0; i < jobs->num_threads; i++) {
+        if ((jobs->text[i] = tmpfile()) == NULL) {
+            goto error;
+        }
+        if ((bout != NULL) && ((jobs->bin[i] = train_bin_create(NULL)) == NULL)) {
+            goto error;
+        }
+    }
+    return jobs;
+
+error:
+    (void)release_train_jobs(jobs);
+    return NULL;
+}
+
+/*********************************************************************************
+ * Function: train_jobs_next
+ * Purpose:  return a zeroed job to be filled in by the caller, running the
+ *           current batch first if it is full
+ * Return:   the job, or NULL if running the batch failed
+ *********************************************************************************
+ */
+void *
+train_jobs_next(TrainJobs *jobs)
+{
+    char *job;
+
+    if ((jobs->num_jobs == jobs->max_jobs) && (train_jobs_flush(jobs) != SUCCESS)) {
+        return NULL;
+    }
+    job = jobs->jobs + jobs->num_jobs * jobs->job_size;
+    (void)memset(job, 0, jobs->job_size);
+    jobs->num_jobs++;
+    return job;
+}
+
+/*********************************************************************************
+ * Function: run_train_task
+ * Purpose:  run every num_tasks-th job of the batch, starting at job task,
+ *           recording where its output went
+ *********************************************************************************
+ */
+static int
+run_train_task(int task, void *arg)
+{
+    int             i;
+    TrainJobs      *jobs = (TrainJobs *)arg;
+    FILE           *text = jobs->text[task];
+    TrainBinWriter *bin  = jobs->bin[task];
+
+    rewind(text);
+    if (bin != NULL) {
+        train_bin_clear(bin);
+    }
+    for (i = task; i < jobs->num_jobs; i += jobs->num_tasks) {
+        TrainJobOutput *out = &jobs->output[i];
+
+        out->task         = task;
+        out->text_begin   = ftell(text);
+        out->first_record = (bin != NULL) ? train_bin_num_records(bin) : 0;
+        jobs->run(jobs->jobs + i * jobs->job_size, text, bin);
+        out->text_end     = ftell(text);
+        out->num_records  = (bin != NULL) ?
+            train_bin_num_records(bin) - out->first_record : 0;
+    }
+    return (ferror(text) ? ERROR : SUCCESS);
+}
+
+/*********************************************************************************
+ * Function: train_jobs_flush
+ * Purpose:  run the jobs of the current batch, then append their output and
+ *           call done() in the order the jobs were added
+ * Return:   SUCCESS, or ERROR if the output could not be copied or done()
+ *           failed; the jobs following the one which failed are dropped
+ *********************************************************************************
+ */
+int
+train_jobs_flush(TrainJobs *jobs)
+{
+    char   buffer[BUFSIZ];
+    int    i, r = SUCCESS;
+    long   size;
+    size_t n;
+
+    if (jobs->num_jobs == 0) {
+        return SUCCESS;
+    }
+    jobs->num_tasks = QVMIN(jobs->num_threads, jobs->num_jobs);
+    if (run_tasks(run_train_task, jobs->num_tasks, jobs, 1) != SUCCESS) {
+        jobs->num_jobs = 0;
+        return ERROR;
+    }
+
+    for (i = 0; (i < jobs->num_jobs) && (r == SUCCESS); i++) {
+        TrainJobOutput *out  = &jobs->output[i];
+        FILE           *text = jobs->text[out->task];
+
+        if (fseek(text, out->text_begin, SEEK_SET) != 0) {
+            r = ERROR;
+            break;
+        }
+        for (size = out->text_end - out->text_begin; size > 0; size -= n) {
+            n = fread(buffer, 1, (size_t)QVMIN(size, (long)sizeof(buffer)), text);
+            if ((n == 0) || (fwrite(buffer, 1, n, jobs->fout) != n)) {
+                r = ERROR;
+                break;
+            }
+        }
+        if ((r == SUCCESS) && (jobs->bout != NULL)) {
+            r = train_bin_copy(jobs->bout, jobs->bin[out->task],
+                out->first_record, out->num_records);
+        }
+        if (r == SUCCESS) {
+            r = jobs->done(jobs->jobs + i * jobs->job_size, jobs->fout);
+        }
+    }
+    jobs->num_jobs = 0;
+    return r;
+}
+
+/*********************************************************************************
+ * Function: train_jobs_finish
+ * Purpose:  run the jobs left in the current batch and release the runner
+ *********************************************************************************
+ */
+int
+train_jobs_finish(TrainJobs *jobs)
+{
+    int r = train_jobs_flush(jobs);
+
+    if (release_train_jobs(jobs) != SUCCESS) {
+        r = ERROR;
+    }
+    return r;
+}
@@ -26,15 +26,30 @@
 #ifndef TRAINDATA_H
 #define TRAINDATA_H 
 
-int append_align_to_train_data(FILE *, double **, double *, double *, 
-    double *, Align *, int, int, BtkMessage *);
-int append_to_train_data(FILE *, int, int *, double **, double *, double *,
-    double *, Range, Range, Align *, Align *,  Align *, int, int, int, 
-    BtkMessage *);
+int append_align_to_train_data(FILE *, TrainBinWriter *, double **, 
+    double *, double *, double *, Align *, int, int, BtkMessage *);
+int append_to_train_data(FILE *, TrainBinWriter *, int, int *, double **, 
+    double *, double *, double *, Range, Range, Align *, Align *,  Align *, 
+    int, int, int, BtkMessage *);
 int append_align_to_trainphred_data(FILE *, Align *, int, int, int *,
     int , char *, int *, int *, BtkMessage *);
 int append_to_trainphred_data(FILE *, int, int *, Range, Range, Align *,
     Align *, Align *, int, int, int *,  int, char *, int *, int *, 
     BtkMessage *);
 void release1(char *, int *, int **, int *, double **, double *);
+
+/* Fragments processed in parallel (-threads) are run in batches by
+ * TrainJobs, which writes their output in input order, as a serial run would
+ */
+#define MAX_TRAIN_THREADS 16       /* the most tasks run_tasks() runs at once */
+
+typedef void (*TrainJobRun)(void *job, FILE *, TrainBinWriter *);
+typedef int  (*TrainJobDone)(void *job, FILE *);
+typedef struct TrainJobs TrainJobs;
+
+TrainJobs *train_jobs_create(int, size_t, TrainJobRun, TrainJobDone, FILE *,
+    TrainBinWriter *);
+void *train_jobs_next(TrainJobs *);
+int train_jobs_flush(TrainJobs *);
+int train_jobs_finish(TrainJobs *);
 #endif
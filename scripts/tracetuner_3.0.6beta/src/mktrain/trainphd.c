@@ -60,6 +60,7 @@ extern __const char *__const sys_errlist[];
 #include "Btk_match_data.h"
 #include "Btk_compute_match.h"
 #include "Btk_qv_io.h"
+#include "train_bin.h"
 #include "train_data.h"
 
 #define DEBUG 0
@@ -114,6 +115,9 @@ static int GapExt;
 static char tab_file_name[BUFLEN];
 static char tab_dir_name[BUFLEN];
 
+static int Threads;                /* Number of phd files processed at once */
+static TrainJobs *Jobs;            /* Runner of the phd files if Threads > 1 */
+
 /* *****************************************************************************
  */
 static void show_usage(char** argv)
@@ -127,6 +131,7 @@ usage: %s [ -h ] \n\
         [ -r <repeat_fraction> ] [ -f <max_fraction_of_errors> ] \n\
         [ -a <min_portion_aligned> ] [ -l <min_read_length> ] \n\
         [ -t <tab_dir> ]         [ -o <output_file> ]\n\
+        [ -T <num_threads> ]\n\
         <phd_file(s)> || -d <input_phd_dir> || -j <project_file>\n",
                    argv[0]);
 }
@@ -161,6 +166,9 @@ help_message(int argc, char *argv[])
     (void)fprintf(stderr, "\t-t <tab_dir>          Instructs trainphd extract alternative base calls from TAB \n");
     (void)fprintf(stderr, "\t                      files stored in directory tab_dir and to output these \n");
     (void)fprintf(stderr, "\t                      calls, together with quality value for each alternative call \n");
+    (void)fprintf(stderr, "\t-T <num_threads>      Process up to 16 PHD files at once. The output is the \n");
+    (void)fprintf(stderr, "\t                      same as that of a single thread. Needs a build with \n");
+    (void)fprintf(stderr, "\t                      THREADS=1 \n");
     (void)fprintf(stderr, "\t-d <dir>              Read the input PHD files from specified directory \n");
     (void)fprintf(stderr, "\t-j <projectfile>      Specify the name of the projectfile which comprises \n");
     (void)fprintf(stderr, "\t                      two columns: the full path to the FASTA file which contains \n");
@@ -402,6 +410,126 @@ process_phd_file(Align_params *alp, Align_params *alpIUB, char* phd_file_name,
     return SUCCESS;
 }
 
+/* A phd file processed by Jobs. Everything it points to is only read
+ * while the batch of files runs
+ */
+typedef struct {
+    Align_params *ap;
+    Align_params *apIUB;
+    Contig       *consensus;
+    Contig       *rev_comp;
+    Vector       *vector;
+    BtkMessage   *report;           /* where an error is reported */
+    char          phd_file_name[MAXPATHLEN];
+    char          tab_file_name[MAXPATHLEN];
+    char          consensus_name[BUFLEN];
+    char          reference[BUFLEN];   /* reported before the file, if set */
+    int           result;
+    BtkMessage    message;
+} PhdJob;
+
+/*******************************************************************************
+ * Function: run_phd_job
+ * Purpose:  process the phd file of a job; called by Jobs on any thread
+ *******************************************************************************/
+static void
+run_phd_job(void *p, FILE *fout, TrainBinWriter *bout)
+{
+    PhdJob *job = (PhdJob *)p;
+
+    if (job->reference[0] != '\0') {
+        fprintf(fout, "# Reference = %s\n", job->reference);
+    }
+    job->result = process_phd_file(job->ap, job->apIUB, job->phd_file_name,
+        job->tab_file_name, fout, job->consensus_name, job->consensus,
+        job->rev_comp, job->vector, &job->message);
+}
+
+/*******************************************************************************
+ * Function: phd_job_done
+ * Purpose:  stop at the first phd file which failed, as a serial run would;
+ *           called by Jobs in the order the files were submitted
+ *******************************************************************************/
+static int
+phd_job_done(void *p, FILE *fout)
+{
+    PhdJob *job = (PhdJob *)p;
+
+    if (job->result != SUCCESS) {
+        *job->report = job->message;
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Function: submit_phd_file
+ * Purpose:  process a phd file, after reporting reference if it is not NULL.
+ *           If Threads is > 1, the file is queued to Jobs instead, to be
+ *           processed with the rest of its batch
+ * Return:   ERROR if the file, or a file queued before it, failed
+ *******************************************************************************/
+static int
+submit_phd_file(Align_params *ap, Align_params *apIUB, char *phd_file_name,
+    char *tab_file_name, FILE *fout, char *consensus_name, Contig *consensus,
+    Contig *rev_comp, Vector *vector, char *reference, BtkMessage *message)
+{
+    PhdJob *job;
+
+    if (Jobs == NULL) {
+        if (reference != NULL) {
+            fprintf(fout, "# Reference = %s\n", reference);
+        }
+        return process_phd_file(ap, apIUB, phd_file_name, tab_file_name,
+            fout, consensus_name, consensus, rev_comp, vector, message);
+    }
+
+    /* The jobs share the FastA lookup tables of the consensus, which
+     * Btk_compute_match would otherwise create on first use
+     */
+    if (((consensus->lut.length == 0) &&
+         (contig_make_fasta_lookup_table(consensus, KTUP, message) != SUCCESS))
+        ||
+        ((rev_comp->lut.length == 0) &&
+         (contig_make_fasta_lookup_table(rev_comp, KTUP, message) != SUCCESS)))
+    {
+        return ERROR;
+    }
+
+    if ((job = (PhdJob *)train_jobs_next(Jobs)) == NULL) {
+        return ERROR;
+    }
+    job->ap        = ap;
+    job->apIUB     = apIUB;
+    job->consensus = consensus;
+    job->rev_comp  = rev_comp;
+    job->vector    = vector;
+    job->report    = message;
+    (void)strncpy(job->phd_file_name, phd_file_name,
+        sizeof(job->phd_file_name) - 1);
+    (void)strncpy(job->tab_file_name, tab_file_name,
+        sizeof(job->tab_file_name) - 1);
+    (void)strncpy(job->consensus_name, consensus_name,
+        sizeof(job->consensus_name) - 1);
+    if (reference != NULL) {
+        (void)strncpy(job->reference, reference, sizeof(job->reference) - 1);
+    }
+    return SUCCESS;
+}
+
+/*******************************************************************************
+ * Function: flush_phd_files
+ * Purpose:  finish processing the phd files queued to Jobs, if any
+ *******************************************************************************/
+static int
+flush_phd_files(void)
+{
+    if (Jobs == NULL) {
+        return SUCCESS;
+    }
+    return train_jobs_flush(Jobs);
+}
+
 /******************************************************************************
  * This function prints as formatted an error message as it can, then exits
  * if the Force flag isn't set.  Its synopsis is:
@@ -574,6 +702,7 @@ process_dir( Align_params *ap, Align_params *apIUB, FILE* fout,
     struct stat statbuf;
     int r=0;
 
+    path2[0] = '\0';
     if ((d = opendir(dir)) == NULL) {
         error(dir, "couldn't open dir", errno);
         return ERROR;
@@ -610,13 +739,16 @@ process_dir( Align_params *ap, Align_params *apIUB, FILE* fout,
             }
             strcat(path2, "tab");
         }
-        if (process_phd_file(ap, apIUB, path, path2,
-            fout, ConsensusName, consensus, rev_comp, vector, message) 
+        if (submit_phd_file(ap, apIUB, path, path2,
+            fout, ConsensusName, consensus, rev_comp, vector, NULL, message) 
             != SUCCESS )
         {
             goto error;
         }
     }
+    if (flush_phd_files() != SUCCESS) {
+        goto error;
+    }
 
     (void)closedir(d);
     return SUCCESS;
@@ -626,6 +758,43 @@ error:
     return r;
 }
 
+/* Consensus sequences read by process_projectfile. With -T, the files
+ * queued to Jobs use theirs until the batch has run, so up to
+ * MAX_REFERENCES are kept and released together
+ */
+#define MAX_REFERENCES 32
+
+typedef struct {
+    Contig  consensus;
+    Contig  rev_comp;
+} Reference;
+
+/*******************************************************************************
+ * Function: release_references
+ *******************************************************************************/
+static int
+release_references(Reference *refs, int *num_refs, BtkMessage *message)
+{
+    int i;
+
+    if (flush_phd_files() != SUCCESS) {
+        sprintf(message->text, "Can not process phd file\n");
+        return ERROR;
+    }
+    for (i = 0; i < *num_refs; i++) {
+        if (contig_release( &refs[i].consensus, message ) != SUCCESS) {
+            sprintf(message->text, "Can not release consensus\n");
+            return ERROR;
+        }
+        if (contig_release( &refs[i].rev_comp, message ) != SUCCESS) {
+            sprintf(message->text, "Can not release rev_consensus\n");
+            return ERROR;
+        }
+    }
+    *num_refs = 0;
+    return SUCCESS;
+}
+
 /******************************************************************************
  * This function processes all files contained in the specified project file.
  * Its synopsis is:
@@ -653,12 +822,12 @@ process_projectfile(Align_params *ap, Align_params *apIUB, FILE* fout,
     char    buffer2[BUFLEN];
     char    previousConsensusName[BUFLEN];
     char   *current, *name;
-    Contig  consensus;
-    Contig  rev_comp;
+    Reference  refs[MAX_REFERENCES];
+    Reference *ref = NULL;
     char    phdFileName[MAXPATHLEN];
     char    tabFileName[MAXPATHLEN];
     char    string[MAXPATHLEN];
-    int     have_consensus;
+    int     num_refs, max_refs;
     FILE   *infile;
 
     if ((infile=fopen(projectFile,"r"))== NULL) {
@@ -667,7 +836,8 @@ process_projectfile(Align_params *ap, Align_params *apIUB, FILE* fout,
         return ERROR;
     }
 
-    have_consensus=0;
+    num_refs=0;
+    max_refs=(Jobs != NULL) ? MAX_REFERENCES : 1;
     buffer2[0]='\0';
     previousConsensusName[0] = '\0';
     current  = buffer1;
@@ -690,32 +860,29 @@ process_projectfile(Align_params *ap, Align_params *apIUB, FILE* fout,
 	/* If consensus is different from previous, read it in. */
 	if ( strcmp(ConsensusName, previousConsensusName) != 0 ) {
 	    /* Release previous, if necessary. */
-	    if ( have_consensus ) {
-		if (contig_release( &consensus, message ) != SUCCESS) {
-                    sprintf(message->text, "Can not release consensus\n");
-                    return ERROR;
-                }
-		if (contig_release( &rev_comp, message ) != SUCCESS) {
-                    sprintf(message->text, "Can not release rev_consensus\n");
+	    if ( num_refs == max_refs ) {
+		if (release_references( refs, &num_refs, message ) != SUCCESS) {
                     return ERROR;
                 }
-		have_consensus=0;
             }
+            ref = &refs[num_refs];
 
 	    /* Read consensus file. */
-	    if (local_read_fasta( ConsensusName, &consensus, message ) != SUCCESS) {
+	    if (local_read_fasta( ConsensusName, &ref->consensus, message ) 
+                != SUCCESS) 
+            {
                 sprintf(message->text, "Can not read consensus\n");
                 return ERROR;
 	    }
 
 	    /* Create reverse complement of consensus. */
-            if (contig_get_reverse_comp( &rev_comp, &consensus, message ) 
-                != SUCCESS) 
+            if (contig_get_reverse_comp( &ref->rev_comp, &ref->consensus, 
+                message ) != SUCCESS) 
             {
                 sprintf(message->text, "Can not get reverse consensus\n");
                 return ERROR;
             }
-	    have_consensus=1;
+	    num_refs++;
         }
 
         strcpy(previousConsensusName, ConsensusName);
@@ -738,10 +905,9 @@ process_projectfile(Align_params *ap, Align_params *apIUB, FILE* fout,
             strcat(tabFileName, "tab");
         }
 
-	fprintf( fout, "# Reference = %s\n", ConsensusName );
-        if (process_phd_file(ap, apIUB, phdFileName, tabFileName, fout, 
-            ConsensusName, &consensus, &rev_comp, vector, message) 
-            != SUCCESS) {
+        if (submit_phd_file(ap, apIUB, phdFileName, tabFileName, fout, 
+            ConsensusName, &ref->consensus, &ref->rev_comp, vector, 
+            ConsensusName, message) != SUCCESS) {
             sprintf(message->text, "Can not process phd file\n");
             return ERROR; 
         }
@@ -750,16 +916,7 @@ process_projectfile(Align_params *ap, Align_params *apIUB, FILE* fout,
     fclose(infile);
 
     /* Clean up. */
-    if ( have_consensus ) {
-	if (contig_release( &consensus, message ) != SUCCESS) {
-            return ERROR; 
-        }
-	if (contig_release( &rev_comp, message ) != SUCCESS) {
-            return ERROR; 
-        }
-    }
-
-    return SUCCESS;
+    return release_references( refs, &num_refs, message );
 }
 
 /******************************************************************************
@@ -804,10 +961,12 @@ int main(int argc, char** argv)
     min_portion_aligned = 0.;
     min_read_length     = 0;
     output_alternative_bcalls = 0;
+    Threads             = 1;
+    Jobs                = NULL;
     static char prev_option = '\0';
 
     /* Parse the command line */
-    while ( (i = getopt(argc, argv, "P:V:S:M:X:G:C:o:d:r:f:j:v:a:l:t:ghp")) != EOF ) {
+    while ( (i = getopt(argc, argv, "P:V:S:M:X:G:C:o:d:r:f:j:v:a:l:t:T:ghp")) != EOF ) {
         switch(i) {
         case 'P':
             PrimerSpecified++;
@@ -896,6 +1055,22 @@ int main(int argc, char** argv)
             (void)strncpy(tab_dir_name, optarg, sizeof(tab_dir_name));
             output_alternative_bcalls++;
             break;
+        case 'T':
+            Threads=atoi(optarg);
+            if ( (Threads < 1) || (Threads > MAX_TRAIN_THREADS) ) {
+                fprintf(stderr,
+                    "Error: the number of threads must be in the range [1,%d]\n",
+                    MAX_TRAIN_THREADS);
+                exit(2);
+            }
+#ifndef TT_THREADS
+            if (Threads > 1) {
+                fprintf(stderr,
+                    "trainphd was built without thread support; ignoring -T\n");
+                Threads = 1;
+            }
+#endif
+            break;
         default:
             if (prev_option != 'G')
             {
@@ -924,6 +1099,16 @@ int main(int argc, char** argv)
             fout=stdout;
         }
 
+        if (Threads > 1) {
+            if ((Jobs = train_jobs_create(Threads, sizeof(PhdJob), run_phd_job,
+                phd_job_done, fout, NULL)) == NULL)
+            {
+                fprintf(stderr, "Cannot create the temporary files of %d threads\n",
+                    Threads);
+                exit(ERROR);
+            }
+        }
+
         /* Set parameters for alignment with consensus */  
         if (set_alignment_parameters( &align_pars, Match, MisMatch, GapInit,
             GapExt, &message ) != SUCCESS) 
@@ -963,7 +1148,8 @@ int main(int argc, char** argv)
         } else if ( VectorSpecified 
     	      && (! PrimerSpecified) && (!SiteSpecified) ) {
         	fprintf(fout, "# Short Vector = %s\n", VectorName);
-        	if (readShortVector( VectorName, &vector, &message) == ERROR ) {
+        	if (readShortVector( VectorName, &vector, &align_pars_IUB, 
+    	        &message) == ERROR ) {
           	    fprintf(stderr, message.text);
      	        exit (ERROR);
     	    }
@@ -1044,14 +1230,20 @@ int main(int argc, char** argv)
                     strcat(tab_file_name, "tab");
                 }
 
-                if (process_phd_file(&align_pars, &align_pars_IUB, argv[i], tab_file_name, fout, 
-                    ConsensusName, &consensus, &rev_comp, vecP, &message) != SUCCESS)  
+                if (submit_phd_file(&align_pars, &align_pars_IUB, argv[i], tab_file_name, fout, 
+                    ConsensusName, &consensus, &rev_comp, vecP, NULL, &message) != SUCCESS)  
                 {
                     fprintf(stderr, "Error code=%d\n", r);
                     fprintf(stderr,"error:%s\n",message.text);
                     return ERROR;
                 }
             }
+            if (flush_phd_files() != SUCCESS)
+            {
+                fprintf(stderr, "Error code=%d\n", r);
+                fprintf(stderr,"error:%s\n",message.text);
+                return ERROR;
+            }
             break;
         }
 
@@ -1129,6 +1321,11 @@ int main(int argc, char** argv)
            exit (ERROR);
         }
 
+        if ((Jobs != NULL) && (train_jobs_finish(Jobs) != SUCCESS)) {
+           fprintf(stderr, "Error writing the output of the PHD files\n");
+           exit (ERROR);
+        }
+
         if ( ( InputType == NAME_FILES ) || ( InputType == NAME_DIR ) ) {
     	    if (contig_release( &consensus, &message ) != SUCCESS) {
 	        fprintf(stderr, message.text);